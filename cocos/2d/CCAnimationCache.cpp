@@ -143,7 +143,8 @@ void AnimationCache::parseVersion2(const ValueMap& animations)
         std::string name = iter->first;
         ValueMap& animationDict = const_cast<ValueMap&>(iter->second.asValueMap());
 
-        const Value& loops = animationDict["loops"];
+        // a copy, looking up the other keys may add them and move the elements of the map
+        Value loops = animationDict["loops"];
         bool restoreOriginalFrame = animationDict["restoreOriginalFrame"].asBool();
 
         ValueVector& frameArray = animationDict["frames"].asValueVector();
@@ -82,6 +82,7 @@ NS_CC_BEGIN
 static DisplayLinkDirector *s_SharedDirector = nullptr;
 
 #define kDefaultFPS        60  // 60 frames per second
+#define kFPSBufferSize     10  // size of the buffer the stats labels are formatted in
 extern const char* cocos2dVersion(void);
 
 const char *Director::EVENT_PROJECTION_CHANGED = "director_projection_changed";
@@ -125,8 +126,9 @@ bool Director::init(void)
     _FPSLabel = nullptr;
     _SPFLabel = nullptr;
     _drawsLabel = nullptr;
+    _autoreleasesLabel = nullptr;
     _totalFrames = _frames = 0;
-    _FPS = new char[10];
+    _FPS = new char[kFPSBufferSize];
     _lastUpdate = new struct timeval;
 
     // paused ?
@@ -179,6 +181,7 @@ Director::~Director(void)
     CC_SAFE_RELEASE(_FPSLabel);
     CC_SAFE_RELEASE(_SPFLabel);
     CC_SAFE_RELEASE(_drawsLabel);
+    CC_SAFE_RELEASE(_autoreleasesLabel);
     
     CC_SAFE_RELEASE(_runningScene);
     CC_SAFE_RELEASE(_notificationNode);
@@ -312,6 +315,9 @@ void Director::drawScene()
     {
         showStats();
     }
+    // the counters are per frame, reset them also while the stats are hidden
+    g_uNumberOfDraws = 0;
+    PoolManager::sharedPoolManager()->resetAutoreleasedCount();
 
     _renderer->render();
     _eventDispatcher->dispatchEvent(_eventAfterDraw);
@@ -751,6 +757,7 @@ void Director::purgeDirector()
     CC_SAFE_RELEASE_NULL(_FPSLabel);
     CC_SAFE_RELEASE_NULL(_SPFLabel);
     CC_SAFE_RELEASE_NULL(_drawsLabel);
+    CC_SAFE_RELEASE_NULL(_autoreleasesLabel);
     CC_SAFE_DELETE(_cullingFrustum);
 
     // purge bitmap cache
@@ -865,31 +872,33 @@ void Director::showStats()
     
     if (_displayStats)
     {
-        if (_FPSLabel && _SPFLabel && _drawsLabel)
+        if (_FPSLabel && _SPFLabel && _drawsLabel && _autoreleasesLabel)
         {
             if (_accumDt > CC_DIRECTOR_STATS_INTERVAL)
             {
-                sprintf(_FPS, "%.3f", _secondsPerFrame);
+                snprintf(_FPS, kFPSBufferSize, "%.3f", _secondsPerFrame);
                 _SPFLabel->setString(_FPS);
                 
                 _frameRate = _frames / _accumDt;
                 _frames = 0;
                 _accumDt = 0;
                 
-                sprintf(_FPS, "%.1f", _frameRate);
+                snprintf(_FPS, kFPSBufferSize, "%.1f", _frameRate);
                 _FPSLabel->setString(_FPS);
                 
-                sprintf(_FPS, "%4lu", (unsigned long)g_uNumberOfDraws);
+                snprintf(_FPS, kFPSBufferSize, "%4lu", (unsigned long)g_uNumberOfDraws);
                 _drawsLabel->setString(_FPS);
+
+                snprintf(_FPS, kFPSBufferSize, "%4lu", (unsigned long)PoolManager::sharedPoolManager()->getAutoreleasedCount());
+                _autoreleasesLabel->setString(_FPS);
             }
             
+            _autoreleasesLabel->visit();
             _drawsLabel->visit();
             _FPSLabel->visit();
             _SPFLabel->visit();
         }
-    }    
-    
-    g_uNumberOfDraws = 0;
+    }
 }
 
 void Director::calculateMPF()
@@ -917,6 +926,7 @@ void Director::createStatsLabel()
         CC_SAFE_RELEASE_NULL(_FPSLabel);
         CC_SAFE_RELEASE_NULL(_SPFLabel);
         CC_SAFE_RELEASE_NULL(_drawsLabel);
+        CC_SAFE_RELEASE_NULL(_autoreleasesLabel);
         _textureCache->removeTextureForKey("/cc_fps_images");
         FileUtils::getInstance()->purgeCachedEntries();
     }
@@ -967,8 +977,14 @@ void Director::createStatsLabel()
     _drawsLabel->initWithString("000", texture, 12, 32, '.');
     _drawsLabel->setScale(factor);
 
+    _autoreleasesLabel = new LabelAtlas;
+    _autoreleasesLabel->setIgnoreContentScaleFactor(true);
+    _autoreleasesLabel->initWithString("000", texture, 12, 32, '.');
+    _autoreleasesLabel->setScale(factor);
+
     Texture2D::setDefaultAlphaPixelFormat(currentFormat);
 
+    _autoreleasesLabel->setPosition(Point(0, 51*factor) + CC_DIRECTOR_STATS_POSITION);
     _drawsLabel->setPosition(Point(0, 34*factor) + CC_DIRECTOR_STATS_POSITION);
     _SPFLabel->setPosition(Point(0, 17*factor) + CC_DIRECTOR_STATS_POSITION);
     _FPSLabel->setPosition(CC_DIRECTOR_STATS_POSITION);
@@ -446,6 +446,7 @@ protected:
     LabelAtlas *_FPSLabel;
     LabelAtlas *_SPFLabel;
     LabelAtlas *_drawsLabel;
+    LabelAtlas *_autoreleasesLabel;
     
     /** Whether or not the Director is paused */
     bool _paused;
@@ -25,15 +25,37 @@
 #include "CCFontAtlas.h"
 #include "CCFont.h"
 #include "CCFontFreeType.h"
+#include "CCDirector.h"
+
+#include <algorithm>
 
 #define  PAGE_WIDTH 1024
 #define  PAGE_HEIGHT 1024
 
 NS_CC_BEGIN
 
+static bool s_asyncGlyphRasterization = false;
+
+void FontAtlas::setAsyncGlyphRasterization(bool enabled)
+{
+    s_asyncGlyphRasterization = enabled;
+}
+
+bool FontAtlas::isAsyncGlyphRasterization()
+{
+    return s_asyncGlyphRasterization;
+}
+
 FontAtlas::FontAtlas(Font &theFont) : 
 _font(&theFont),
-_currentPageData(nullptr)
+_generation(0),
+_nextTicket(0),
+_shelfHeight(0),
+_asyncRasterization(false),
+_rasterizerFont(nullptr),
+_rasterizerThread(nullptr),
+_needQuit(false),
+_hasRasterizedGlyphs(false)
 {
     _font->retain();
     _makeDistanceMap = _font->isDistanceFieldEnabled();
@@ -43,36 +65,32 @@ _currentPageData(nullptr)
     {
         _currentPageLineHeight = _font->getFontMaxHeight();
         _commonLineHeight = _currentPageLineHeight * 0.8f;
-        Texture2D * tex = new Texture2D;
-        _currentPage = 0;
-        _currentPageOrigX = 0;
-        _currentPageOrigY = 0;
         _letterPadding = 5;
     
         if(_makeDistanceMap)
         {
             _commonLineHeight += 2 * Font::DistanceMapSpread;
             _letterPadding += 2 * Font::DistanceMapSpread;
-            _currentPageDataSize = (PAGE_WIDTH * PAGE_HEIGHT * 1);
-        }
-        else
-        {
-            _currentPageDataSize = (PAGE_WIDTH * PAGE_HEIGHT * 1);
         }
 
-        _currentPageData = new unsigned char[_currentPageDataSize];       
-        memset(_currentPageData, 0, _currentPageDataSize);  
-        addTexture(*tex,0);
-        tex->release();
+        _shelfHeight = (int)ceilf(_currentPageLineHeight);
+        addPage();
+
+        _asyncRasterization = s_asyncGlyphRasterization;
     }
 }
 
 FontAtlas::~FontAtlas()
 {
+    stopRasterizer();
+
     _font->release();
     relaseTextures();
 
-    delete []_currentPageData;
+    for (auto &page : _pages)
+    {
+        delete []page.data;
+    }
 }
 
 void FontAtlas::relaseTextures()
@@ -103,12 +121,375 @@ bool FontAtlas::getLetterDefinitionForChar(unsigned short  letteCharUTF16, FontL
     }
 }
 
+bool FontAtlas::addPage()
+{
+    Page page;
+    page.data = new unsigned char[PAGE_WIDTH * PAGE_HEIGHT];
+    memset(page.data, 0, PAGE_WIDTH * PAGE_HEIGHT);
+    page.nextShelfY = 0;
+    page.dirtyMinY = PAGE_HEIGHT;
+    page.dirtyMaxY = 0;
+
+    // the whole page is uploaded once, then only the rows that change
+    Texture2D* tex = new Texture2D;
+    if (!tex->initWithData(page.data, PAGE_WIDTH * PAGE_HEIGHT, Texture2D::PixelFormat::A8, PAGE_WIDTH, PAGE_HEIGHT, Size(PAGE_WIDTH,PAGE_HEIGHT)))
+    {
+        delete []page.data;
+        tex->release();
+        return false;
+    }
+
+    addTexture(*tex, (int)_pages.size());
+    tex->release();
+
+    _pages.push_back(page);
+    return true;
+}
+
+bool FontAtlas::allocateFromFreeSpans(int width, GlyphSlot &outSlot)
+{
+    // best fit: the span that leaves the smallest gap
+    Span *best = nullptr;
+    int bestGap = PAGE_WIDTH;
+
+    for (size_t p = 0; p < _pages.size(); ++p)
+    {
+        auto &shelves = _pages[p].shelves;
+        for (size_t s = 0; s < shelves.size(); ++s)
+        {
+            for (auto &span : shelves[s].freeSpans)
+            {
+                int gap = span.width - width;
+                if (gap >= 0 && (!best || gap < bestGap))
+                {
+                    best = &span;
+                    bestGap = gap;
+                    outSlot.page = (int)p;
+                    outSlot.shelf = (int)s;
+                    if (gap == 0)
+                        break;
+                }
+            }
+        }
+    }
+
+    if (!best)
+        return false;
+
+    outSlot.x = best->x;
+    outSlot.width = width;
+
+    best->x += width;
+    best->width -= width;
+    if (best->width == 0)
+    {
+        auto &spans = _pages[outSlot.page].shelves[outSlot.shelf].freeSpans;
+        spans.erase(spans.begin() + (best - &spans[0]));
+    }
+
+    return true;
+}
+
+bool FontAtlas::allocateFromNewShelf(int width, GlyphSlot &outSlot)
+{
+    // the quads overlap the padding on the right of the glyphs, keep it inside the page
+    int shelfWidth = PAGE_WIDTH - (int)_letterPadding;
+    if (width > shelfWidth)
+        return false;
+
+    for (size_t p = 0; p < _pages.size(); ++p)
+    {
+        Page &page = _pages[p];
+        if (page.nextShelfY + _shelfHeight > PAGE_HEIGHT)
+            continue;
+
+        Shelf shelf;
+        shelf.y = page.nextShelfY;
+        if (width < shelfWidth)
+        {
+            Span span = { width, shelfWidth - width };
+            shelf.freeSpans.push_back(span);
+        }
+        page.shelves.push_back(shelf);
+        page.nextShelfY += _shelfHeight;
+
+        outSlot.page = (int)p;
+        outSlot.shelf = (int)page.shelves.size() - 1;
+        outSlot.x = 0;
+        outSlot.width = width;
+        return true;
+    }
+
+    return false;
+}
+
+void FontAtlas::releaseSpan(Shelf &shelf, int x, int width)
+{
+    auto &spans = shelf.freeSpans;
+
+    // keep the spans sorted and merged with their neighbours
+    auto it = spans.begin();
+    while (it != spans.end() && it->x < x)
+        ++it;
+
+    Span span = { x, width };
+    it = spans.insert(it, span);
+
+    auto next = it + 1;
+    if (next != spans.end() && it->x + it->width == next->x)
+    {
+        it->width += next->width;
+        spans.erase(next);
+    }
+    if (it != spans.begin())
+    {
+        auto prev = it - 1;
+        if (prev->x + prev->width == it->x)
+        {
+            prev->width += it->width;
+            spans.erase(it);
+        }
+    }
+}
+
+bool FontAtlas::evictLeastRecentlyUsedGlyph(unsigned int frame)
+{
+    if (_lruGlyphs.empty())
+        return false;
+
+    unsigned short letter = _lruGlyphs.front();
+    auto slotIt = _glyphSlots.find(letter);
+    CCASSERT(slotIt != _glyphSlots.end(), "FontAtlas: glyph slot not found");
+
+    // glyphs used in this frame may be on screen with their current definition
+    GlyphSlot &slot = slotIt->second;
+    if (slot.lastUsedFrame == frame)
+        return false;
+
+    Page &page = _pages[slot.page];
+    Shelf &shelf = page.shelves[slot.shelf];
+
+    // clear the pixels, the quads of the next glyph cover the whole slot
+    int clearWidth = MIN(slot.width + (int)_letterPadding, PAGE_WIDTH - slot.x);
+    for (int y = shelf.y; y < shelf.y + _shelfHeight; ++y)
+    {
+        memset(page.data + y * PAGE_WIDTH + slot.x, 0, clearWidth);
+    }
+    markDirty(page, shelf.y, _shelfHeight);
+
+    releaseSpan(shelf, slot.x, slot.width);
+
+    _lruGlyphs.pop_front();
+    _glyphSlots.erase(slotIt);
+    _fontLetterDefinitions.erase(letter);
+    _evictedLetters[letter] = ++_generation;
+
+    return true;
+}
+
+bool FontAtlas::hasEvictedLetters(const unsigned short *utf16String, unsigned int generation) const
+{
+    if (generation == _generation)
+        return false;
+
+    for (const unsigned short *letter = utf16String; *letter; ++letter)
+    {
+        auto it = _evictedLetters.find(*letter);
+        if (it != _evictedLetters.end() && it->second > generation)
+            return true;
+    }
+    return false;
+}
+
+void FontAtlas::markLettersUsed(const unsigned short *utf16String)
+{
+    if (_glyphSlots.empty())
+        return;
+
+    unsigned int frame = Director::getInstance()->getTotalFrames();
+    for (const unsigned short *letter = utf16String; *letter; ++letter)
+    {
+        auto slotIterator = _glyphSlots.find(*letter);
+        if (slotIterator != _glyphSlots.end() && slotIterator->second.lastUsedFrame != frame)
+        {
+            GlyphSlot &slot = slotIterator->second;
+            slot.lastUsedFrame = frame;
+            _lruGlyphs.splice(_lruGlyphs.end(), _lruGlyphs, slot.lruPosition);
+        }
+    }
+}
+
+bool FontAtlas::allocateGlyph(int width, unsigned int frame, GlyphSlot &outSlot)
+{
+    do
+    {
+        if (allocateFromFreeSpans(width, outSlot) || allocateFromNewShelf(width, outSlot))
+            return true;
+    } while (evictLeastRecentlyUsedGlyph(frame));
+
+    // everything in the atlas is in use
+    return addPage() && allocateFromNewShelf(width, outSlot);
+}
+
+void FontAtlas::markDirty(Page &page, int y, int height)
+{
+    page.dirtyMinY = MIN(page.dirtyMinY, y);
+    page.dirtyMaxY = MIN(MAX(page.dirtyMaxY, y + height), PAGE_HEIGHT);
+}
+
+void FontAtlas::uploadDirtyPages()
+{
+    for (size_t p = 0; p < _pages.size(); ++p)
+    {
+        Page &page = _pages[p];
+        if (page.dirtyMinY >= page.dirtyMaxY)
+            continue;
+
+        // full rows are uploaded, GLES 2 can't upload a sub rectangle of a larger buffer
+        _atlasTextures[(int)p]->updateWithData(page.data + page.dirtyMinY * PAGE_WIDTH, 0, page.dirtyMinY, PAGE_WIDTH, page.dirtyMaxY - page.dirtyMinY);
+
+        page.dirtyMinY = PAGE_HEIGHT;
+        page.dirtyMaxY = 0;
+    }
+}
+
+void FontAtlas::startRasterizer()
+{
+    _rasterizerFont = static_cast<FontFreeType*>(_font)->createThreadCopy();
+    if (!_rasterizerFont)
+    {
+        CCLOG("cocos2d: FontAtlas: can't create the font of the rasterizer thread, glyphs are rendered synchronously");
+        _asyncRasterization = false;
+        return;
+    }
+
+    _needQuit = false;
+    _rasterizerThread = new std::thread(&FontAtlas::rasterizeGlyphs, this);
+}
+
+void FontAtlas::stopRasterizer()
+{
+    if (_rasterizerThread)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_jobMutex);
+            _needQuit = true;
+        }
+        _jobCondition.notify_one();
+
+        _rasterizerThread->join();
+        delete _rasterizerThread;
+        _rasterizerThread = nullptr;
+    }
+
+    CC_SAFE_RELEASE_NULL(_rasterizerFont);
+}
+
+void FontAtlas::rasterizeGlyphs()
+{
+    std::vector<std::pair<unsigned short, unsigned int>> jobs;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_jobMutex);
+            _jobCondition.wait(lock, [this]{ return _needQuit || !_glyphJobs.empty(); });
+            if (_needQuit)
+                break;
+
+            jobs.swap(_glyphJobs);
+        }
+
+        for (const auto &job : jobs)
+        {
+            RasterizedGlyph glyph;
+            glyph.letter = job.first;
+            glyph.ticket = job.second;
+            glyph.width = 0;
+            glyph.height = 0;
+
+            unsigned char *bitmap = _rasterizerFont->getGlyphBitmap(glyph.letter, glyph.width, glyph.height);
+            if (bitmap && glyph.width > 0 && glyph.height > 0)
+            {
+                if (_makeDistanceMap)
+                {
+                    unsigned char *distanceMap = Font::makeDistanceMap(bitmap, glyph.width, glyph.height);
+                    glyph.width += 2 * Font::DistanceMapSpread;
+                    glyph.height += 2 * Font::DistanceMapSpread;
+                    glyph.bitmap.assign(distanceMap, distanceMap + glyph.width * glyph.height);
+                    free(distanceMap);
+                }
+                else
+                {
+                    glyph.bitmap.assign(bitmap, bitmap + glyph.width * glyph.height);
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(_rasterizedMutex);
+            _rasterizedGlyphs.push_back(std::move(glyph));
+            _hasRasterizedGlyphs = true;
+        }
+        jobs.clear();
+    }
+}
+
+void FontAtlas::uploadRasterizedGlyphs()
+{
+    if (!_hasRasterizedGlyphs)
+        return;
+
+    std::vector<RasterizedGlyph> glyphs;
+    {
+        std::lock_guard<std::mutex> lock(_rasterizedMutex);
+        glyphs.swap(_rasterizedGlyphs);
+        _hasRasterizedGlyphs = false;
+    }
+
+    int padding = (int)_letterPadding;
+
+    for (const auto &glyph : glyphs)
+    {
+        // the glyph may have been evicted, and its slot reused, while it was rendered
+        auto slotIterator = _glyphSlots.find(glyph.letter);
+        if (slotIterator == _glyphSlots.end() || slotIterator->second.ticket != glyph.ticket || glyph.bitmap.empty())
+            continue;
+
+        const GlyphSlot &slot = slotIterator->second;
+        Page &page = _pages[slot.page];
+        int originX = slot.x + padding;
+        int originY = page.shelves[slot.shelf].y;
+
+        int width = MIN(glyph.width, PAGE_WIDTH - originX);
+        int height = MIN(glyph.height, PAGE_HEIGHT - originY);
+        for (int y = 0; y < height; ++y)
+        {
+            memcpy(page.data + (originY + y) * PAGE_WIDTH + originX, &glyph.bitmap[y * glyph.width], width);
+        }
+        markDirty(page, originY, height);
+    }
+
+    uploadDirtyPages();
+}
+
+bool FontAtlas::prewarmLetterDefinitions(const std::string &text)
+{
+    unsigned short *utf16String = cc_utf8_to_utf16(text.c_str());
+    if (!utf16String)
+        return false;
+
+    bool ret = prepareLetterDefinitions(utf16String);
+    delete [] utf16String;
+
+    return ret;
+}
+
 bool FontAtlas::prepareLetterDefinitions(unsigned short *utf16String)
 {
-    if(_currentPageData == nullptr)
+    if(_pages.empty())
         return false;
 
     FontFreeType* fontTTf = (FontFreeType*)_font;
+    unsigned int frame = Director::getInstance()->getTotalFrames();
 
     std::unordered_map<unsigned short, FontLetterDefinition> fontDefs;
     int length = cc_wcslen(utf16String);
@@ -116,6 +497,16 @@ bool FontAtlas::prepareLetterDefinitions(unsigned short *utf16String)
     //find out new letter
     for (int i = 0; i < length; ++i)
     {
+        auto slotIterator = _glyphSlots.find(utf16String[i]);
+        if (slotIterator != _glyphSlots.end())
+        {
+            // most recently used glyphs go to the back of the list
+            GlyphSlot &slot = slotIterator->second;
+            slot.lastUsedFrame = frame;
+            _lruGlyphs.splice(_lruGlyphs.end(), _lruGlyphs, slot.lruPosition);
+            continue;
+        }
+
         auto outIterator = _fontLetterDefinitions.find(utf16String[i]);
         
         if (outIterator == _fontLetterDefinitions.end())
@@ -157,57 +548,83 @@ bool FontAtlas::prepareLetterDefinitions(unsigned short *utf16String)
         }       
     }
 
-    Size _pageContentSize = Size(PAGE_WIDTH,PAGE_HEIGHT);
+    if (fontDefs.empty())
+        return true;
+
+    // place the widest glyphs first, they are the hardest to fit
+    std::vector<FontLetterDefinition*> newDefs;
+    newDefs.reserve(fontDefs.size());
+    for (auto &item : fontDefs)
+    {
+        newDefs.push_back(&item.second);
+    }
+    std::sort(newDefs.begin(), newDefs.end(), [](const FontLetterDefinition *a, const FontLetterDefinition *b){
+        return a->width > b->width;
+    });
+
+    if (_asyncRasterization && !_rasterizerThread)
+    {
+        startRasterizer();
+    }
+
     float scaleFactor = CC_CONTENT_SCALE_FACTOR();
-    float glyphWidth;
-    Texture2D::PixelFormat  pixelFormat = _makeDistanceMap ? Texture2D::PixelFormat::A8 : Texture2D::PixelFormat::A8;
+    int padding = (int)_letterPadding;
+    bool queuedJobs = false;
 
-    for(auto it = fontDefs.begin(); it != fontDefs.end(); it++)
+    for (auto def : newDefs)
     {
-        if(it->second.validDefinition)
+        if(def->validDefinition)
         {
-            _currentPageOrigX += _letterPadding;
-            glyphWidth = it->second.width - _letterPadding;
-
-            if (_currentPageOrigX + glyphWidth > PAGE_WIDTH)
+            GlyphSlot slot;
+            if (!allocateGlyph((int)ceilf(def->width), frame, slot))
             {
-                _currentPageOrigY += _currentPageLineHeight;
-                _currentPageOrigX = 0;
-                if(_currentPageOrigY >= PAGE_HEIGHT)
-                {             
-                    _atlasTextures[_currentPage]->initWithData(_currentPageData, _currentPageDataSize, pixelFormat, PAGE_WIDTH, PAGE_HEIGHT, _pageContentSize );
-                    _currentPageOrigY = 0;
-
-                    delete []_currentPageData;
-                    _currentPageData = new unsigned char[_currentPageDataSize];
-                    if(_currentPageData == nullptr)
-                        return false;
-                    memset(_currentPageData, 0, _currentPageDataSize);
-                    _currentPage++;
-                    Texture2D* tex = new Texture2D;
-                    addTexture(*tex,_currentPage);
-                    tex->release();
+                CCLOG("cocos2d: FontAtlas: no room for glyph %d", def->letteCharUTF16);
+                def->validDefinition = false;
+            }
+            else
+            {
+                Page &page = _pages[slot.page];
+                int originX = slot.x + padding;
+                int originY = page.shelves[slot.shelf].y;
+
+                slot.ticket = ++_nextTicket;
+                if (_rasterizerThread)
+                {
+                    // the slot is already cleared, the glyph shows up once the worker is done with it
+                    std::lock_guard<std::mutex> lock(_jobMutex);
+                    _glyphJobs.push_back(std::make_pair(def->letteCharUTF16, slot.ticket));
+                    queuedJobs = true;
                 }
+                else
+                {
+                    _font->renderCharAt(def->letteCharUTF16, originX, originY, page.data, PAGE_WIDTH);
+                    markDirty(page, originY, _shelfHeight);
+                }
+
+                slot.lastUsedFrame = frame;
+                slot.lruPosition = _lruGlyphs.insert(_lruGlyphs.end(), def->letteCharUTF16);
+                _glyphSlots[def->letteCharUTF16] = slot;
+
+                def->U                = originX - 1;
+                def->V                = originY;
+                def->textureID        = slot.page;
+                // take from pixels to points
+                def->width  =    def->width  / scaleFactor;
+                def->height =    def->height / scaleFactor;
+                def->U      =    def->U      / scaleFactor;
+                def->V      =    def->V      / scaleFactor;
             }
-            _font->renderCharAt(it->second.letteCharUTF16,_currentPageOrigX,_currentPageOrigY,_currentPageData,PAGE_WIDTH);
-
-            it->second.U                = _currentPageOrigX - 1;
-            it->second.V                = _currentPageOrigY;
-            it->second.textureID        = _currentPage;
-            // take from pixels to points
-            it->second.width  =    it->second.width  / scaleFactor;
-            it->second.height =    it->second.height / scaleFactor;      
-            it->second.U      =    it->second.U      / scaleFactor;
-            it->second.V      =    it->second.V      / scaleFactor;
         }
-        else
-            glyphWidth = 0;       
-       
-        _fontLetterDefinitions[it->second.letteCharUTF16] = it->second;
-        _currentPageOrigX += glyphWidth;
-    }
-    if(fontDefs.size() > 0)
-        _atlasTextures[_currentPage]->initWithData(_currentPageData, _currentPageDataSize, pixelFormat, PAGE_WIDTH, PAGE_HEIGHT, _pageContentSize );
+
+        _fontLetterDefinitions[def->letteCharUTF16] = *def;
+    }
+
+    if (queuedJobs)
+    {
+        _jobCondition.notify_one();
+    }
+
+    uploadDirtyPages();
     return true;
 }
 
@@ -25,11 +25,18 @@
 #define _CCFontAtlas_h_
 
 #include <unordered_map>
+#include <vector>
+#include <list>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 
 NS_CC_BEGIN
 
 //fwd
 class Font;
+class FontFreeType;
 
 struct FontLetterDefinition
 {
@@ -63,32 +70,148 @@ public:
     void addLetterDefinition(const FontLetterDefinition &letterDefinition);
     bool getLetterDefinitionForChar(unsigned short  letteCharUTF16, FontLetterDefinition &outDefinition);
     
+    /** Makes sure the glyphs of the string are in the atlas.
+     For dynamic atlases the missing glyphs are rasterized in one batch, packed in shelves,
+     and only the rows of the pages that changed are uploaded to the textures.
+     When the pages are full, the least recently used glyphs that were not used in the current
+     frame are evicted; a new page is only added when nothing can be evicted.
+     With asynchronous rasterization the glyphs get their place in the atlas right away,
+     but they are rendered on a worker thread and show up once uploadRasterizedGlyphs() is called.
+     */
     bool prepareLetterDefinitions(unsigned short  *utf16String);
 
+    /** Adds the glyphs of an UTF-8 string to the atlas ahead of time, e.g. while a localized screen is loading.
+     @since v3.0
+     */
+    bool prewarmLetterDefinitions(const std::string &text);
+
+    /** Copies the glyphs rendered by the worker thread into the pages and uploads them.
+     Called by the labels before they draw, it must be called from the GL thread.
+     @since v3.0
+     */
+    void uploadRasterizedGlyphs();
+
+    /** Sets whether the dynamic atlases created from now on render their glyphs on a worker thread.
+     Disabled by default.
+     @since v3.0
+     */
+    static void setAsyncGlyphRasterization(bool enabled);
+    static bool isAsyncGlyphRasterization();
+
     void  addTexture(Texture2D &texture, int slot);
     float getCommonLineHeight() const;
     void  setCommonLineHeight(float newHeight);
     
     Texture2D& getTexture(int slot);
     const Font* getFont() const;
+
+    /** Incremented every time glyphs are evicted from the atlas.
+     Letter definitions obtained with an older generation may point to reused texture areas.
+     @since v3.0
+     */
+    inline unsigned int getGeneration() const { return _generation; }
+
+    /** Returns true if a glyph of the string was evicted after the atlas was at the given generation,
+     i.e. a layout made at that generation shows other glyphs and must be made again.
+     @since v3.0
+     */
+    bool hasEvictedLetters(const unsigned short *utf16String, unsigned int generation) const;
+
+    /** Marks the glyphs of the string as used in the current frame, so they are not evicted while they are drawn.
+     Called by the labels when they draw.
+     @since v3.0
+     */
+    void markLettersUsed(const unsigned short *utf16String);
     
 private:
 
+    struct Span
+    {
+        int x;
+        int width;
+    };
+
+    // row of glyphs, all the glyphs of a dynamic atlas have the line height
+    struct Shelf
+    {
+        int y;
+        std::vector<Span> freeSpans;
+    };
+
+    struct Page
+    {
+        unsigned char *data;
+        std::vector<Shelf> shelves;
+        int nextShelfY;
+        int dirtyMinY;
+        int dirtyMaxY;
+    };
+
+    struct GlyphSlot
+    {
+        int page;
+        int shelf;
+        int x;
+        int width;
+        unsigned int lastUsedFrame;
+        unsigned int ticket;
+        std::list<unsigned short>::iterator lruPosition;
+    };
+
+    struct RasterizedGlyph
+    {
+        unsigned short letter;
+        unsigned int ticket;
+        int width;
+        int height;
+        std::vector<unsigned char> bitmap;
+    };
+
     void relaseTextures();
+
+    bool addPage();
+    bool allocateGlyph(int width, unsigned int frame, GlyphSlot &outSlot);
+    bool allocateFromFreeSpans(int width, GlyphSlot &outSlot);
+    bool allocateFromNewShelf(int width, GlyphSlot &outSlot);
+    bool evictLeastRecentlyUsedGlyph(unsigned int frame);
+    void releaseSpan(Shelf &shelf, int x, int width);
+    void markDirty(Page &page, int y, int height);
+    void uploadDirtyPages();
+
+    void rasterizeGlyphs();
+    void startRasterizer();
+    void stopRasterizer();
+
     std::unordered_map<int, Texture2D*> _atlasTextures;
     std::unordered_map<unsigned short, FontLetterDefinition> _fontLetterDefinitions;
     float _commonLineHeight;
     Font * _font;
 
     // Dynamic GlyphCollection related stuff
-    int _currentPage;
-    unsigned char *_currentPageData;
-    int _currentPageDataSize;
-    float _currentPageOrigX;
-    float _currentPageOrigY;
+    std::vector<Page> _pages;
+    std::unordered_map<unsigned short, GlyphSlot> _glyphSlots;
+    //! glyphs in the atlas, least recently used first
+    std::list<unsigned short> _lruGlyphs;
+    unsigned int _generation;
+    //! generation at which each glyph was last evicted
+    std::unordered_map<unsigned short, unsigned int> _evictedLetters;
+    unsigned int _nextTicket;
+    int _shelfHeight;
     float _currentPageLineHeight;
     float _letterPadding;
     bool  _makeDistanceMap;
+
+    // asynchronous rasterization, the worker only touches its own copy of the font
+    bool _asyncRasterization;
+    FontFreeType *_rasterizerFont;
+    std::thread *_rasterizerThread;
+    std::vector<std::pair<unsigned short, unsigned int>> _glyphJobs;
+    std::vector<RasterizedGlyph> _rasterizedGlyphs;
+    std::mutex _jobMutex;
+    std::mutex _rasterizedMutex;
+    std::condition_variable _jobCondition;
+    bool _needQuit;
+    std::atomic<bool> _hasRasterizedGlyphs;
 };
 
 
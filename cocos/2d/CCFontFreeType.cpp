@@ -89,8 +89,11 @@ FT_Library FontFreeType::getFTLibrary()
 
 FontFreeType::FontFreeType(bool dynamicGlyphCollection)
 : _fontRef(nullptr),
+_threadLibrary(nullptr),
+_fontSize(0),
 _letterPadding(5),
-_dynamicGlyphCollection(dynamicGlyphCollection)
+_dynamicGlyphCollection(dynamicGlyphCollection),
+_hasKerning(false)
 {
     if(_distanceFieldEnabled)
         _letterPadding += 2 * DistanceMapSpread;
@@ -98,43 +101,89 @@ _dynamicGlyphCollection(dynamicGlyphCollection)
 
 bool FontFreeType::createFontObject(const std::string &fontName, int fontSize)
 {
-    FT_Face face;
-
     _ttfData = FileUtils::getInstance()->getDataFromFile(fontName);
     
     if (_ttfData.isNull())
         return false;
 
+    if (!createFaceFromData(getFTLibrary(), fontSize))
+        return false;
+    
+    // save font name locally
+    _fontName = fontName;
+    
+    // done and good
+    return true;
+}
+
+bool FontFreeType::createFaceFromData(FT_Library library, int fontSize)
+{
+    FT_Face face;
+
     // create the face from the data
-    if (FT_New_Memory_Face(getFTLibrary(), _ttfData.getBytes(), _ttfData.getSize(), 0, &face ))
+    if (FT_New_Memory_Face(library, _ttfData.getBytes(), _ttfData.getSize(), 0, &face ))
         return false;
 
     //we want to use unicode
     if (FT_Select_Charmap(face, FT_ENCODING_UNICODE))
+    {
+        FT_Done_Face(face);
         return false;
+    }
 
     // set the requested font size
     int dpi = 72;
     int fontSizePoints = (int)(64.f * fontSize);
     if (FT_Set_Char_Size(face, fontSizePoints, fontSizePoints, dpi, dpi))
+    {
+        FT_Done_Face(face);
         return false;
+    }
     
     // store the face globally
     _fontRef = face;
+    _fontSize = fontSize;
+    _hasKerning = FT_HAS_KERNING(face) != 0;
     
-    // save font name locally
-    _fontName = fontName;
-    
-    // done and good
     return true;
 }
 
+FontFreeType * FontFreeType::createThreadCopy() const
+{
+    FontFreeType *tempFont = new FontFreeType(_dynamicGlyphCollection);
+    tempFont->_distanceFieldEnabled = _distanceFieldEnabled;
+    tempFont->_letterPadding = _letterPadding;
+    tempFont->_fontName = _fontName;
+    tempFont->_ttfData = _ttfData;
+
+    // the copy owns its library, faces of the same library can't be used from different threads
+    if (FT_Init_FreeType(&tempFont->_threadLibrary))
+    {
+        tempFont->_threadLibrary = nullptr;
+        tempFont->release();
+        return nullptr;
+    }
+
+    if (!tempFont->createFaceFromData(tempFont->_threadLibrary, _fontSize))
+    {
+        tempFont->release();
+        return nullptr;
+    }
+
+    return tempFont;
+}
+
 FontFreeType::~FontFreeType()
 {
     if (_fontRef)
     {
         FT_Done_Face(_fontRef);
     }
+
+    if (_threadLibrary)
+    {
+        FT_Done_FreeType(_threadLibrary);
+    }
 }
 
 FontAtlas * FontFreeType::createFontAtlas()
@@ -147,6 +196,8 @@ FontAtlas * FontFreeType::createFontAtlas()
     } 
     else
     {
+        precomputeKerningTable();
+
         FontDefinitionTTF *def = FontDefinitionTTF::create(this);
 
         if (!def)
@@ -266,10 +317,10 @@ Size * FontFreeType::getAdvancesForTextUTF16(unsigned short *text, int &outNumLe
         int advance = 0;
         int kerning = 0;
         
-        advance = getAdvanceForChar(text[c]) - getBearingXForChar(text[c]);
+        advance = getCachedAdvanceForChar(text[c]);
         
-        if (c < (outNumLetters-1))
-            kerning = getHorizontalKerningForChars(text[c], text[c+1]);
+        if (_hasKerning && c < (outNumLetters-1))
+            kerning = getCachedKerningForChars(text[c], text[c+1]);
         
         sizes[c].width = (advance + kerning);
     }
@@ -277,6 +328,68 @@ Size * FontFreeType::getAdvancesForTextUTF16(unsigned short *text, int &outNumLe
     return sizes;
 }
 
+int FontFreeType::getCachedAdvanceForChar(unsigned short theChar) const
+{
+    auto it = _advanceTable.find(theChar);
+    if (it != _advanceTable.end())
+        return it->second;
+
+    int advance = getAdvanceForChar(theChar) - getBearingXForChar(theChar);
+    _advanceTable[theChar] = advance;
+    return advance;
+}
+
+int FontFreeType::getCachedKerningForChars(unsigned short firstChar, unsigned short secondChar) const
+{
+    unsigned int key = ((unsigned int)firstChar << 16) | secondChar;
+    auto it = _kerningTable.find(key);
+    if (it != _kerningTable.end())
+        return it->second;
+
+    // the precomputed table only keeps the pairs that have kerning
+    if (_precomputedKerningLetters.count(firstChar) && _precomputedKerningLetters.count(secondChar))
+        return 0;
+
+    int kerning = getHorizontalKerningForChars(firstChar, secondChar);
+    _kerningTable[key] = kerning;
+    return kerning;
+}
+
+void FontFreeType::precomputeKerningTable()
+{
+    if (!_hasKerning)
+        return;
+
+    const char *glyphs = getCurrentGlyphCollection();
+    if (!glyphs)
+        return;
+
+    unsigned short *utf16Glyphs = cc_utf8_to_utf16(glyphs);
+    if (!utf16Glyphs)
+        return;
+
+    // the table grows with the square of the letters, larger sets are filled as the pairs are used
+    int numGlyphs = cc_wcslen(utf16Glyphs);
+    if (numGlyphs <= 256)
+    {
+        for (int first = 0; first < numGlyphs; ++first)
+        {
+            for (int second = 0; second < numGlyphs; ++second)
+            {
+                int kerning = getHorizontalKerningForChars(utf16Glyphs[first], utf16Glyphs[second]);
+                if (kerning)
+                {
+                    _kerningTable[((unsigned int)utf16Glyphs[first] << 16) | utf16Glyphs[second]] = kerning;
+                }
+            }
+        }
+
+        _precomputedKerningLetters.insert(utf16Glyphs, utf16Glyphs + numGlyphs);
+    }
+
+    delete [] utf16Glyphs;
+}
+
 int FontFreeType::getAdvanceForChar(unsigned short theChar) const
 {
     if (!_fontRef)
@@ -29,6 +29,8 @@
 #include "CCData.h"
 
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <ft2build.h>
 
 #include FT_FREETYPE_H
@@ -54,6 +56,13 @@ public:
 
     inline bool isDynamicGlyphCollection() { return _dynamicGlyphCollection;}  
 
+    /** Creates a font with the same face and size that uses its own FreeType library.
+     FreeType objects can't be shared between threads, the copy can render glyphs on a
+     thread other than the one that uses this font.
+     @since v3.0
+     */
+    FontFreeType * createThreadCopy() const;
+
 protected:
     
     FontFreeType(bool dynamicGlyphCollection = false);
@@ -64,18 +73,31 @@ private:
 
     bool initFreeType();
     FT_Library getFTLibrary();
+    bool createFaceFromData(FT_Library library, int fontSize);
     
     int  getAdvanceForChar(unsigned short theChar) const;
     int  getBearingXForChar(unsigned short theChar) const;
     int  getHorizontalKerningForChars(unsigned short firstChar, unsigned short secondChar) const;
+    int  getCachedAdvanceForChar(unsigned short theChar) const;
+    int  getCachedKerningForChars(unsigned short firstChar, unsigned short secondChar) const;
+    void precomputeKerningTable();
     
     static FT_Library _FTlibrary;
     static bool       _FTInitialized;
     FT_Face           _fontRef;
+    FT_Library        _threadLibrary;
+    int               _fontSize;
     int               _letterPadding;
     std::string       _fontName;
     Data              _ttfData;
     bool              _dynamicGlyphCollection;
+    bool              _hasKerning;
+
+    // advances minus the bearing, and kerning pairs, FreeType is only asked once per letter or pair
+    mutable std::unordered_map<unsigned short, int>  _advanceTable;
+    mutable std::unordered_map<unsigned int, int>    _kerningTable;
+    //! letters whose kerning pairs are all in the table, missing pairs have no kerning
+    std::unordered_set<unsigned short>               _precomputedKerningLetters;
 };
 
 NS_CC_END
@@ -85,6 +85,7 @@ public:
     static const char* SHADER_NAME_POSITION_TEXTURE;
     static const char* SHADER_NAME_POSITION_TEXTURE_U_COLOR;
     static const char* SHADER_NAME_POSITION_TEXTURE_A8_COLOR;
+    static const char* SHADER_NAME_POSITION_TEXTURE_A8_COLOR_NO_MVP;
     static const char* SHADER_NAME_POSITION_U_COLOR;
     static const char* SHADER_NAME_POSITION_LENGTH_TEXTURE_COLOR;
 
@@ -26,6 +26,8 @@
 #include "CCFontDefinition.h"
 #include "CCFontAtlasCache.h"
 #include "CCLabelTextFormatter.h"
+#include "renderer/CCRenderer.h"
+#include "renderer/CCQuadCommand.h"
 
 #define DISTANCEFIELD_ATLAS_FONTSIZE 50
 
@@ -101,17 +103,20 @@ Label* Label::createWithAtlas(FontAtlas *atlas, TextHAlignment alignment, int li
 }
 
 Label::Label(FontAtlas *atlas, TextHAlignment alignment, bool useDistanceField,bool useA8Shader)
-: _reusedLetter(nullptr)
-, _lineBreakWithoutSpaces(false)
+: _lineBreakWithoutSpaces(false)
 ,_multilineEnable(true)
 , _alignment(alignment)
 , _currentUTF16String(0)
 , _originalUTF16String(0)
 , _advances(0)
 , _fontAtlas(atlas)
+, _atlasGeneration(0)
+, _lineBreakScaleX(0)
+, _layoutMultilineEnable(true)
 , _isOpacityModifyRGB(true)
 ,_useDistanceField(useDistanceField)
 ,_useA8Shader(useA8Shader)
+,_quadShader(nullptr)
 {
 }
 
@@ -123,8 +128,6 @@ Label::~Label()
     
     if (_fontAtlas)
         FontAtlasCache::releaseFontAtlas(_fontAtlas);
-
-    _reusedLetter->release();
 }
 
 bool Label::init()
@@ -132,15 +135,19 @@ bool Label::init()
     bool ret = true;
     if(_fontAtlas)
     {
-        _reusedLetter = Sprite::createWithTexture(&_fontAtlas->getTexture(0));
-        _reusedLetter->setOpacityModifyRGB(_isOpacityModifyRGB);
         ret = SpriteBatchNode::initWithTexture(&_fontAtlas->getTexture(0), 30);
-        _reusedLetter->retain();
     }
     if (_useDistanceField)
         setLabelEffect(LabelEffect::NORMAL,Color3B::BLACK);
     else if(_useA8Shader)
+    {
         setShaderProgram(ShaderCache::getInstance()->getProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE_A8_COLOR));
+        _quadShader = ShaderCache::getInstance()->getProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE_A8_COLOR_NO_MVP);
+    }
+    else
+    {
+        _quadShader = ShaderCache::getInstance()->getProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR_NO_MVP);
+    }
 
     return ret;
 }
@@ -162,14 +169,6 @@ bool Label::setText(const std::string& stringToRender, float lineWidth, TextHAli
     if (!_fontAtlas)
         return false;
     
-    // carloX
-    // reset the string
-    resetCurrentString();
-    
-    _width                  = lineWidth;
-    _alignment              = alignment;
-    _lineBreakWithoutSpaces = lineBreakWithoutSpaces;
-    
     // store locally common line height
     _commonLineHeight = _fontAtlas->getCommonLineHeight();
     if (_commonLineHeight <= 0)
@@ -179,6 +178,29 @@ bool Label::setText(const std::string& stringToRender, float lineWidth, TextHAli
     unsigned short* utf16String = cc_utf8_to_utf16(stringToRender.c_str());
     if(!utf16String)
         return false;
+
+    // score counters and the like set the same text again and again, the layout is still valid
+    int stringLength = cc_wcslen(utf16String);
+    if (_originalUTF16String
+        && lineWidth == _width
+        && alignment == _alignment
+        && lineBreakWithoutSpaces == _lineBreakWithoutSpaces
+        && _multilineEnable == _layoutMultilineEnable
+        && _atlasGeneration == _fontAtlas->getGeneration()
+        && stringLength == cc_wcslen(_originalUTF16String)
+        && memcmp(utf16String, _originalUTF16String, stringLength * sizeof(unsigned short)) == 0)
+    {
+        delete [] utf16String;
+        return true;
+    }
+    
+    // carloX
+    // reset the string
+    resetCurrentString();
+    
+    _width                  = lineWidth;
+    _alignment              = alignment;
+    _lineBreakWithoutSpaces = lineBreakWithoutSpaces;
     
     _cascadeColorEnabled = true;
     
@@ -292,8 +314,18 @@ void Label::alignText()
     if(_textureAtlas)
         _textureAtlas->removeAllQuads();  
     _fontAtlas->prepareLetterDefinitions(_currentUTF16String);
+
+    // the cached line breaks depend on the letter definitions and on the scale of the letter positions
+    if (_atlasGeneration != _fontAtlas->getGeneration() || _lineBreakScaleX != _scaleX)
+    {
+        _lineBreakCache.clear();
+        _lineBreakScaleX = _scaleX;
+    }
+    _atlasGeneration = _fontAtlas->getGeneration();
+    _layoutMultilineEnable = _multilineEnable;
+
     LabelTextFormatter::createStringSprites(this);    
-    if(_multilineEnable && LabelTextFormatter::multilineText(this) )      
+    if(_multilineEnable && LabelTextFormatter::multilineText(this, &_lineBreakCache) )      
         LabelTextFormatter::createStringSprites(this);
     
     LabelTextFormatter::alignText(this);
@@ -305,31 +337,122 @@ void Label::alignText()
             SpriteBatchNode::removeChild(child, true);
     }
 
-    _reusedLetter->setBatchNode(nullptr);
-   
-    int vaildIndex = 0;
-    Sprite* child = nullptr;
-    Rect uvRect;
+    updateQuads();
+}
+
+void Label::updateQuads()
+{
+    int strLen = cc_wcslen(_currentUTF16String);
+
+    // group the letters by atlas page, each group is drawn with one quad command
+    _quadBatches.clear();
+    ssize_t totalQuads = 0;
     for (int ctr = 0; ctr < strLen; ++ctr)
-    {        
-        if (_lettersInfo[ctr].def.validDefinition)
+    {
+        const FontLetterDefinition &def = _lettersInfo[ctr].def;
+        if (!def.validDefinition)
+            continue;
+
+        auto batch = _quadBatches.begin();
+        while (batch != _quadBatches.end() && batch->textureID != def.textureID)
+            ++batch;
+        if (batch == _quadBatches.end())
         {
-            child = static_cast<Sprite*>( this->getChildByTag(ctr) );
-            if (child)
-            {
-                uvRect.size.height = _lettersInfo[ctr].def.height;
-                uvRect.size.width  = _lettersInfo[ctr].def.width;
-                uvRect.origin.x    = _lettersInfo[ctr].def.U;
-                uvRect.origin.y    = _lettersInfo[ctr].def.V;
+            QuadBatch newBatch = { def.textureID, 0, 0 };
+            batch = _quadBatches.insert(batch, newBatch);
+        }
+        ++batch->count;
+        ++totalQuads;
+    }
 
-                child->setTexture(&_fontAtlas->getTexture(_lettersInfo[ctr].def.textureID));
-                child->setTextureRect(uvRect);              
-            }
-           
-            updateSpriteWithLetterDefinition(_reusedLetter,_lettersInfo[ctr].def,&_fontAtlas->getTexture(_lettersInfo[ctr].def.textureID));
-            _reusedLetter->setPosition(_lettersInfo[ctr].position);
-            insertQuadFromSprite(_reusedLetter,vaildIndex++);
-        }     
+    if (_textureAtlas->getCapacity() < totalQuads)
+    {
+        _textureAtlas->resizeCapacity(totalQuads);
+    }
+
+    ssize_t start = 0;
+    for (auto &batch : _quadBatches)
+    {
+        batch.start = start;
+        start += batch.count;
+        batch.count = 0;
+    }
+
+    Color4B color4( _displayedColor.r, _displayedColor.g, _displayedColor.b, _displayedOpacity );
+    if (_isOpacityModifyRGB)
+    {
+        color4.r *= _displayedOpacity/255.0f;
+        color4.g *= _displayedOpacity/255.0f;
+        color4.b *= _displayedOpacity/255.0f;
+    }
+
+    // the quads are built straight from the layout, letter sprites are only created by getLetter()
+    V3F_C4B_T2F_Quad quad;
+    quad.bl.colors = quad.br.colors = quad.tl.colors = quad.tr.colors = color4;
+    quad.bl.vertices.z = quad.br.vertices.z = quad.tl.vertices.z = quad.tr.vertices.z = 0;
+
+    for (int ctr = 0; ctr < strLen; ++ctr)
+    {
+        LetterInfo &info = _lettersInfo[ctr];
+        const FontLetterDefinition &def = info.def;
+        if (!def.validDefinition)
+            continue;
+
+        auto batch = _quadBatches.begin();
+        while (batch->textureID != def.textureID)
+            ++batch;
+        info.atlasIndex = (int)(batch->start + batch->count++);
+
+        Texture2D *texture = &_fontAtlas->getTexture(def.textureID);
+        Rect uvRect = CC_RECT_POINTS_TO_PIXELS(Rect(def.U, def.V, def.width, def.height));
+        float atlasWidth = (float)texture->getPixelsWide();
+        float atlasHeight = (float)texture->getPixelsHigh();
+
+#if CC_FIX_ARTIFACTS_BY_STRECHING_TEXEL
+        float left    = (2*uvRect.origin.x+1)/(2*atlasWidth);
+        float right   = left + (uvRect.size.width*2-2)/(2*atlasWidth);
+        float top     = (2*uvRect.origin.y+1)/(2*atlasHeight);
+        float bottom  = top + (uvRect.size.height*2-2)/(2*atlasHeight);
+#else
+        float left    = uvRect.origin.x/atlasWidth;
+        float right   = (uvRect.origin.x + uvRect.size.width) / atlasWidth;
+        float top     = uvRect.origin.y/atlasHeight;
+        float bottom  = (uvRect.origin.y + uvRect.size.height) / atlasHeight;
+#endif // CC_FIX_ARTIFACTS_BY_STRECHING_TEXEL
+
+        float x1 = info.position.x - def.width * def.anchorX;
+        float y1 = info.position.y - def.height * def.anchorY;
+        float x2 = x1 + def.width;
+        float y2 = y1 + def.height;
+
+        quad.bl.vertices.x = x1;
+        quad.bl.vertices.y = y1;
+        quad.bl.texCoords.u = left;
+        quad.bl.texCoords.v = bottom;
+        quad.br.vertices.x = x2;
+        quad.br.vertices.y = y1;
+        quad.br.texCoords.u = right;
+        quad.br.texCoords.v = bottom;
+        quad.tl.vertices.x = x1;
+        quad.tl.vertices.y = y2;
+        quad.tl.texCoords.u = left;
+        quad.tl.texCoords.v = top;
+        quad.tr.vertices.x = x2;
+        quad.tr.vertices.y = y2;
+        quad.tr.texCoords.u = right;
+        quad.tr.texCoords.v = top;
+
+        _textureAtlas->updateQuad(&quad, info.atlasIndex);
+
+        // letters returned by getLetter() keep their own position, they rewrite their quad when they are drawn
+        Sprite *child = static_cast<Sprite*>( this->getChildByTag(ctr) );
+        if (child)
+        {
+            child->setTexture(texture);
+            child->setTextureRect(Rect(def.U, def.V, def.width, def.height));
+            child->setAtlasIndex(info.atlasIndex);
+            child->setDirty(true);
+        }
     }
 }
 
@@ -400,33 +523,6 @@ void Label::resetCurrentString()
     
 }
 
-Sprite * Label::updateSpriteWithLetterDefinition(Sprite *spriteToUpdate, const FontLetterDefinition &theDefinition, Texture2D *theTexture)
-{
-    if (!spriteToUpdate)
-    {
-        return 0;
-    }
-    else
-    {
-        Rect uvRect;
-        uvRect.size.height = theDefinition.height;
-        uvRect.size.width  = theDefinition.width;
-        uvRect.origin.x    = theDefinition.U;
-        uvRect.origin.y    = theDefinition.V;
-        
-        SpriteFrame *frame = SpriteFrame::createWithTexture(theTexture, uvRect);
-        if (frame)
-        {
-            spriteToUpdate->setBatchNode(this); 
-            spriteToUpdate->setTexture(theTexture);
-            spriteToUpdate->setSpriteFrame(frame);
-            spriteToUpdate->setAnchorPoint(Point(theDefinition.anchorX, theDefinition.anchorY));                                        
-        }     
-        
-        return spriteToUpdate;
-    }
-}
-
 bool Label::recordLetterInfo(const cocos2d::Point& point,unsigned short int theChar, int spriteIndex)
 {
     if (static_cast<std::size_t>(spriteIndex) >= _lettersInfo.size())
@@ -500,25 +596,73 @@ void Label::draw()
 {
     CC_PROFILER_START("CCSpriteBatchNode - draw");
 
+    // glyphs rendered by the atlas worker thread since the last frame
+    _fontAtlas->uploadRasterizedGlyphs();
+
+    if (_currentUTF16String)
+    {
+        // lay out again only if glyphs of this label were evicted, their place may hold other glyphs now
+        if (_fontAtlas->hasEvictedLetters(_currentUTF16String, _atlasGeneration))
+        {
+            resetCurrentString();
+            alignText();
+        }
+        _atlasGeneration = _fontAtlas->getGeneration();
+
+        // the glyphs drawn in this frame can't be evicted before the next one
+        _fontAtlas->markLettersUsed(_currentUTF16String);
+    }
+
     // Optimization: Fast Dispatch
     if( _textureAtlas->getTotalQuads() == 0 )
     {
         return;
     }
 
-    CC_NODE_DRAW_SETUP();
+    for(const auto &child: _children)
+        child->updateTransform();
 
-    if (_useDistanceField && _currLabelEffect != LabelEffect::NORMAL)
+    // the distance field effects need their uniforms, they are drawn right away
+    if (_useDistanceField)
     {
-        _shaderProgram->setUniformLocationWith3f(_uniformEffectColor, _effectColor.r/255.0f,_effectColor.g/255.0f,_effectColor.b/255.0f);
-    }
+        CC_NODE_DRAW_SETUP();
 
-    for(const auto &child: _children)
-        child->updateTransform();
+        if (_currLabelEffect != LabelEffect::NORMAL)
+        {
+            _shaderProgram->setUniformLocationWith3f(_uniformEffectColor, _effectColor.r/255.0f,_effectColor.g/255.0f,_effectColor.b/255.0f);
+        }
 
-    GL::blendFunc( _blendFunc.src, _blendFunc.dst );
+        GL::blendFunc( _blendFunc.src, _blendFunc.dst );
+
+        _textureAtlas->drawQuads();
+    }
+    else
+    {
+        kmMat4 mv;
+        kmGLGetMatrix(KM_GL_MODELVIEW, &mv);
 
-    _textureAtlas->drawQuads();
+        // one command per atlas page, split when the renderer can't batch that many quads at once
+        V3F_C4B_T2F_Quad *quads = _textureAtlas->getQuads();
+        for (const auto &batch : _quadBatches)
+        {
+            GLuint textureName = _fontAtlas->getTexture(batch.textureID).getName();
+            for (ssize_t start = 0; start < batch.count; start += Renderer::VBO_SIZE - 1)
+            {
+                ssize_t count = MIN(batch.count - start, (ssize_t)Renderer::VBO_SIZE - 1);
+
+                QuadCommand* cmd = QuadCommand::getCommandPool().generateCommand();
+                cmd->init(0,
+                          _vertexZ,
+                          textureName,
+                          _quadShader,
+                          _blendFunc,
+                          quads + batch.start + start,
+                          count,
+                          mv);
+                Director::getInstance()->getRenderer()->addCommand(cmd);
+            }
+        }
+    }
 
     CC_PROFILER_STOP("CCSpriteBatchNode - draw");
 }
@@ -548,7 +692,7 @@ Sprite * Label::getLetter(int ID)
             sp->setPosition(_lettersInfo[ID].position);
             sp->setOpacity(_realOpacity);
          
-            this->addSpriteWithoutQuad(sp, ID, ID);
+            this->addSpriteWithoutQuad(sp, _lettersInfo[ID].atlasIndex, ID);
         }
         return sp;
     }
@@ -704,12 +848,11 @@ void Label::setOpacityModifyRGB(bool isOpacityModifyRGB)
         child->setOpacityModifyRGB(_isOpacityModifyRGB);
     }
 
-    _reusedLetter->setOpacityModifyRGB(true);
+    updateColor();
 }
 
 void Label::setColor(const Color3B& color)
 {
-	_reusedLetter->setColor(color);
     SpriteBatchNode::setColor(color);
 }
 
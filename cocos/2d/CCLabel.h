@@ -28,6 +28,7 @@
 
 #include "CCSpriteBatchNode.h"
 #include "CCLabelTextFormatProtocol.h"
+#include "CCLabelTextFormatter.h"
 #include "ccTypes.h"
 
 NS_CC_BEGIN
@@ -144,14 +145,20 @@ private:
     bool setOriginalString(unsigned short *stringToSet);
     void resetCurrentString();
 
-    Sprite * updateSpriteWithLetterDefinition(Sprite *spriteToUpdate, const FontLetterDefinition &theDefinition, Texture2D *theTexture);
+    void updateQuads();
 
     virtual void updateColor() override;
 
-    
-    //! used for optimization
-    Sprite              *_reusedLetter;
+    // quads of the letters that are in the same atlas page
+    struct QuadBatch
+    {
+        int     textureID;
+        ssize_t start;
+        ssize_t count;
+    };
+
     std::vector<LetterInfo>     _lettersInfo;       
+    std::vector<QuadBatch>      _quadBatches;
    
     bool                        _multilineEnable;
     float                       _commonLineHeight;
@@ -162,6 +169,12 @@ private:
     unsigned short int *        _originalUTF16String;
     Size               *        _advances;
     FontAtlas          *        _fontAtlas;
+    //! atlas generation the letters were laid out with
+    unsigned int                _atlasGeneration;
+    //! line breaks of the last layout, reused when only the end of the string changes
+    LabelTextFormatter::LineBreakCache _lineBreakCache;
+    float                       _lineBreakScaleX;
+    bool                        _layoutMultilineEnable;
     bool                        _isOpacityModifyRGB;
 
     bool                        _useDistanceField;
@@ -172,6 +185,8 @@ private:
     Color3B                     _effectColor;
 
     GLuint                      _uniformEffectColor;
+    //! shader used by the quad commands, the vertices are transformed on the CPU
+    GLProgram          *        _quadShader;
     
 };
 
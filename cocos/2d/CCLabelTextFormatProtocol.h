@@ -37,6 +37,8 @@ struct LetterInfo
     Point position;
     Size  contentSize;
     bool  visible;
+    //! index of the letter quad in the texture atlas of the label
+    int   atlasIndex;
 };
 
 class CC_DLL LabelTextFormatProtocol
@@ -32,7 +32,7 @@ using namespace std;
 
 NS_CC_BEGIN
 
-bool LabelTextFormatter::multilineText(LabelTextFormatProtocol *theLabel)
+bool LabelTextFormatter::multilineText(LabelTextFormatProtocol *theLabel, LineBreakCache *cache)
 {
     // to do if (m_fWidth > 0)
     if (theLabel->getMaxLineWidth())
@@ -57,9 +57,59 @@ bool LabelTextFormatter::multilineText(LabelTextFormatProtocol *theLabel)
         int strLen = theLabel->getStringLenght();
         std::vector<LetterInfo>  *leterInfo = theLabel->getLettersInfo();
         int tIndex = 0;
+        int j = 0;
+        int lastRead = -1;
 
-        for (int j = 0; j+skip < strLen; j++)
+        std::vector<LineBreakCache::LineState> lines;
+        if (cache && cache->width == theLabel->getMaxLineWidth() && cache->breakWithoutSpace == theLabel->breakLineWithoutSpace())
+        {
+            // start again from the last line that only depends on the unchanged beginning of the string
+            size_t common = 0;
+            size_t maxCommon = MIN(cache->source.size(), stringLength);
+            while (common < maxCommon && cache->source[common] == strWhole[common])
+                ++common;
+
+            size_t reused = 0;
+            while (reused < cache->lines.size() && cache->lines[reused].lastRead < (int)common)
+                ++reused;
+
+            if (reused > 0)
+            {
+                const LineBreakCache::LineState &state = cache->lines[reused - 1];
+                j             = state.j;
+                skip          = state.skip;
+                tIndex        = state.tIndex;
+                i             = state.i;
+                line          = state.line;
+                isStartOfWord = state.isStartOfWord;
+                startOfWord   = state.startOfWord;
+                last_word     = state.lastWord;
+                lastRead      = state.lastRead;
+                multiline_string.assign(cache->result.begin(), cache->result.begin() + state.multilineSize);
+
+                // the state is recorded again when the loop starts
+                lines.assign(cache->lines.begin(), cache->lines.begin() + (reused - 1));
+            }
+        }
+
+        for (; j+skip < strLen; j++)
         {            
+            if (cache && !isStartOfLine)
+            {
+                LineBreakCache::LineState state;
+                state.j             = j;
+                state.skip          = skip;
+                state.tIndex        = tIndex;
+                state.i             = i;
+                state.line          = line;
+                state.isStartOfWord = isStartOfWord;
+                state.startOfWord   = startOfWord;
+                state.multilineSize = multiline_string.size();
+                state.lastWord      = last_word;
+                state.lastRead      = lastRead;
+                lines.push_back(state);
+            }
+
             LetterInfo* info = &leterInfo->at(j+skip);
 
             unsigned int justSkipped = 0;                                  
@@ -71,11 +121,13 @@ bool LabelTextFormatter::multilineText(LabelTextFormatProtocol *theLabel)
             }
             skip += justSkipped;
             tIndex = j + skip;
+            lastRead = MAX(lastRead, tIndex);
             
             if (i >= stringLength)
                 break;
             
             unsigned short character = strWhole[i];
+            lastRead = MAX(lastRead, (int)i);
             
             if (!isStartOfWord)
             {
@@ -108,6 +160,7 @@ bool LabelTextFormatter::multilineText(LabelTextFormatProtocol *theLabel)
                     break;
                 
                 character = strWhole[i];
+                lastRead = MAX(lastRead, (int)i);
                 
                 if (!startOfWord)
                 {
@@ -145,6 +198,10 @@ bool LabelTextFormatter::multilineText(LabelTextFormatProtocol *theLabel)
                         cc_utf8_trim_ws(&multiline_string);
                     else
                         multiline_string.clear();
+
+                    // lines whose beginning was trimmed can't be reused
+                    while (!lines.empty() && lines.back().multilineSize > multiline_string.size())
+                        lines.pop_back();
                     
                     if (multiline_string.size() > 0)
                         multiline_string.push_back('\n');
@@ -196,6 +253,15 @@ bool LabelTextFormatter::multilineText(LabelTextFormatProtocol *theLabel)
         }
         
         multiline_string.insert(multiline_string.end(), last_word.begin(), last_word.end());
+
+        if (cache)
+        {
+            cache->source.swap(strWhole);
+            cache->result = multiline_string;
+            cache->lines.swap(lines);
+            cache->width = theLabel->getMaxLineWidth();
+            cache->breakWithoutSpace = theLabel->breakLineWithoutSpace();
+        }
         
         size_t size = multiline_string.size();
         unsigned short* strNew = new unsigned short[size + 1];
@@ -32,8 +32,39 @@ NS_CC_BEGIN
 class CC_DLL LabelTextFormatter
 {
 public:
+
+    /** Line breaks of the last string a label laid out, with the state of the line breaking at the start of each line.
+     When only the tail of the string changes, the lines that don't depend on it are reused.
+     @since v3.0
+     */
+    struct LineBreakCache
+    {
+        struct LineState
+        {
+            int                         j;
+            int                         skip;
+            int                         tIndex;
+            unsigned int                i;
+            unsigned int                line;
+            bool                        isStartOfWord;
+            float                       startOfWord;
+            size_t                      multilineSize;
+            std::vector<unsigned short> lastWord;
+            //! last letter the state depends on
+            int                         lastRead;
+        };
+
+        LineBreakCache() : width(0), breakWithoutSpace(false) {}
+        void clear() { source.clear(); result.clear(); lines.clear(); }
+
+        std::vector<unsigned short> source;
+        std::vector<unsigned short> result;
+        std::vector<LineState>      lines;
+        float                       width;
+        bool                        breakWithoutSpace;
+    };
     
-    static bool multilineText(LabelTextFormatProtocol *theLabel);
+    static bool multilineText(LabelTextFormatProtocol *theLabel, LineBreakCache *cache = nullptr);
     static bool alignText(LabelTextFormatProtocol *theLabel);
     static bool createStringSprites(LabelTextFormatProtocol *theLabel);
 
@@ -44,6 +44,7 @@ THE SOFTWARE.
 #include "CCParticleSystem.h"
 
 #include <string>
+#include <float.h>
 
 #include "CCParticleBatchNode.h"
 #include "ccTypes.h"
@@ -80,12 +81,137 @@ NS_CC_BEGIN
 //  cocos2d uses a another approach, but the results are almost identical. 
 //
 
+// number of arrays held by ParticleData
+static const int PARTICLE_DATA_ARRAYS = 26;
+
+ParticleData::ParticleData()
+: _block(nullptr)
+, _stride(0)
+, _maxCount(0)
+{
+    setupPointers();
+}
+
+ParticleData::~ParticleData()
+{
+    release();
+}
+
+bool ParticleData::init(int count)
+{
+    // keep every array 16 bytes aligned
+    int stride = (count + 3) & ~3;
+    unsigned int* block = (unsigned int*)calloc(stride * PARTICLE_DATA_ARRAYS, sizeof(unsigned int));
+    if (count > 0 && !block)
+    {
+        return false;
+    }
+
+    free(_block);
+    _block = block;
+    _stride = stride;
+    _maxCount = count;
+    setupPointers();
+
+    return true;
+}
+
+void ParticleData::release()
+{
+    CC_SAFE_FREE(_block);
+    _stride = 0;
+    _maxCount = 0;
+    setupPointers();
+}
+
+void ParticleData::setupPointers()
+{
+    float** arrays[PARTICLE_DATA_ARRAYS - 1] = {
+        &posx, &posy, &startPosX, &startPosY,
+        &colorR, &colorG, &colorB, &colorA,
+        &deltaColorR, &deltaColorG, &deltaColorB, &deltaColorA,
+        &size, &deltaSize, &rotation, &deltaRotation, &timeToLive,
+        &modeA.dirX, &modeA.dirY, &modeA.radialAccel, &modeA.tangentialAccel,
+        &modeB.angle, &modeB.degreesPerSecond, &modeB.radius, &modeB.deltaRadius,
+    };
+
+    for (int i = 0; i < PARTICLE_DATA_ARRAYS - 1; ++i)
+    {
+        *arrays[i] = _block ? (float*)(_block + i * _stride) : nullptr;
+    }
+    atlasIndex = _block ? _block + (PARTICLE_DATA_ARRAYS - 1) * _stride : nullptr;
+}
+
+void ParticleData::copyParticle(int p1, int p2)
+{
+    // all the values are 32 bits wide, copy them as raw words
+    unsigned int* block = _block;
+    for (int i = 0; i < PARTICLE_DATA_ARRAYS; ++i, block += _stride)
+    {
+        block[p1] = block[p2];
+    }
+}
+
+// xorshift32, returns a value in [-1, 1)
+static inline float nextRandomMinus1_1(unsigned int& state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+
+    // 23 random bits as the mantissa of a float in [1, 2)
+    union { unsigned int i; float f; } u;
+    u.i = 0x3f800000u | (state >> 9);
+    return u.f * 2.0f - 3.0f;
+}
+
+// 1 / sqrt(x) without branches, so that the loops calling it can be vectorized.
+// Two Newton steps give a relative error below 1e-5.
+static inline float invSqrt(float x)
+{
+    union { float f; unsigned int i; } u;
+    u.f = x;
+    u.i = 0x5f375a86 - (u.i >> 1);
+    float y = u.f;
+    y = y * (1.5f - 0.5f * x * y * y);
+    y = y * (1.5f - 0.5f * x * y * y);
+    return y;
+}
+
+// Gravity mode integration: the arrays don't overlap, which lets the compiler vectorize the loop
+static void updateGravityParticles(float* __restrict posx, float* __restrict posy,
+                                   float* __restrict dirX, float* __restrict dirY,
+                                   const float* __restrict radialAccel, const float* __restrict tangentialAccel,
+                                   int count, float dt, float gravityX, float gravityY, float posDt)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        // radial acceleration, a zero position gives a zero radial direction
+        float x = posx[i];
+        float y = posy[i];
+        float invLength = invSqrt(x * x + y * y + FLT_MIN);
+        float radialX = x * invLength;
+        float radialY = y * invLength;
+
+        // tangential acceleration is the radial direction rotated by 90 degrees
+        float radial = radialAccel[i] * dt;
+        float tangential = tangentialAccel[i] * dt;
+
+        // (gravity + radial + tangential) * dt
+        dirX[i] += radialX * radial - radialY * tangential + gravityX;
+        dirY[i] += radialY * radial + radialX * tangential + gravityY;
+
+        posx[i] = x + dirX[i] * posDt;
+        posy[i] = y + dirY[i] * posDt;
+    }
+}
+
 ParticleSystem::ParticleSystem()
 : _isBlendAdditive(false)
 , _isAutoRemoveOnFinish(false)
 , _plistFile("")
 , _elapsed(0)
-, _particles(nullptr)
+, _randomState((unsigned int)rand() | 1)
 , _configName("")
 , _emitCounter(0)
 , _particleIdx(0)
@@ -426,11 +552,7 @@ bool ParticleSystem::initWithTotalParticles(int numberOfParticles)
 {
     _totalParticles = numberOfParticles;
 
-    CC_SAFE_FREE(_particles);
-    
-    _particles = (tParticle*)calloc(_totalParticles, sizeof(tParticle));
-
-    if( ! _particles )
+    if( ! _particleData.init(_totalParticles) )
     {
         CCLOG("Particle system: not enough memory");
         this->release();
@@ -442,7 +564,7 @@ bool ParticleSystem::initWithTotalParticles(int numberOfParticles)
     {
         for (int i = 0; i < _totalParticles; i++)
         {
-            _particles[i].atlasIndex=i;
+            _particleData.atlasIndex[i] = i;
         }
     }
     // default, active
@@ -479,7 +601,7 @@ ParticleSystem::~ParticleSystem()
     // Since the scheduler retains the "target (in this case the ParticleSystem)
 	// it is not needed to call "unscheduleUpdate" here. In fact, it will be called in "cleanup"
     //unscheduleUpdate();
-    CC_SAFE_FREE(_particles);
+    _particleData.release();
     CC_SAFE_RELEASE(_texture);
 }
 
@@ -490,123 +612,186 @@ bool ParticleSystem::addParticle()
         return false;
     }
 
-    tParticle * particle = &_particles[ _particleCount ];
-    this->initParticle(particle);
-    ++_particleCount;
+    addParticles(1);
 
     return true;
 }
 
-void ParticleSystem::initParticle(tParticle* particle)
+void ParticleSystem::addParticles(int count)
 {
+    count = MIN(count, _totalParticles - _particleCount);
+    if (count <= 0)
+    {
+        return;
+    }
+
+    int start = _particleCount;
+    int end = _particleCount + count;
+    _particleCount = end;
+
+    ParticleData& data = _particleData;
+    unsigned int& seed = _randomState;
+
     // timeToLive
     // no negative life. prevent division by 0
-    particle->timeToLive = _life + _lifeVar * CCRANDOM_MINUS1_1();
-    particle->timeToLive = MAX(0, particle->timeToLive);
+    for (int i = start; i < end; ++i)
+    {
+        data.timeToLive[i] = MAX(0, _life + _lifeVar * nextRandomMinus1_1(seed));
+    }
 
     // position
-    particle->pos.x = _sourcePosition.x + _posVar.x * CCRANDOM_MINUS1_1();
-
-    particle->pos.y = _sourcePosition.y + _posVar.y * CCRANDOM_MINUS1_1();
-
+    for (int i = start; i < end; ++i)
+    {
+        data.posx[i] = _sourcePosition.x + _posVar.x * nextRandomMinus1_1(seed);
+    }
+    for (int i = start; i < end; ++i)
+    {
+        data.posy[i] = _sourcePosition.y + _posVar.y * nextRandomMinus1_1(seed);
+    }
 
-    // Color
-    Color4F start;
-    start.r = clampf(_startColor.r + _startColorVar.r * CCRANDOM_MINUS1_1(), 0, 1);
-    start.g = clampf(_startColor.g + _startColorVar.g * CCRANDOM_MINUS1_1(), 0, 1);
-    start.b = clampf(_startColor.b + _startColorVar.b * CCRANDOM_MINUS1_1(), 0, 1);
-    start.a = clampf(_startColor.a + _startColorVar.a * CCRANDOM_MINUS1_1(), 0, 1);
+    // color
+#define SET_COLOR(c, b, v)                                                          \
+    for (int i = start; i < end; ++i)                                               \
+    {                                                                               \
+        c[i] = clampf(b + v * nextRandomMinus1_1(seed), 0, 1);                      \
+    }
 
-    Color4F end;
-    end.r = clampf(_endColor.r + _endColorVar.r * CCRANDOM_MINUS1_1(), 0, 1);
-    end.g = clampf(_endColor.g + _endColorVar.g * CCRANDOM_MINUS1_1(), 0, 1);
-    end.b = clampf(_endColor.b + _endColorVar.b * CCRANDOM_MINUS1_1(), 0, 1);
-    end.a = clampf(_endColor.a + _endColorVar.a * CCRANDOM_MINUS1_1(), 0, 1);
+    SET_COLOR(data.colorR, _startColor.r, _startColorVar.r);
+    SET_COLOR(data.colorG, _startColor.g, _startColorVar.g);
+    SET_COLOR(data.colorB, _startColor.b, _startColorVar.b);
+    SET_COLOR(data.colorA, _startColor.a, _startColorVar.a);
+
+    // the end colors are stored in the deltas, then turned into per second deltas
+    SET_COLOR(data.deltaColorR, _endColor.r, _endColorVar.r);
+    SET_COLOR(data.deltaColorG, _endColor.g, _endColorVar.g);
+    SET_COLOR(data.deltaColorB, _endColor.b, _endColorVar.b);
+    SET_COLOR(data.deltaColorA, _endColor.a, _endColorVar.a);
+#undef SET_COLOR
+
+#define SET_DELTA_COLOR(c, dc)                                                      \
+    for (int i = start; i < end; ++i)                                               \
+    {                                                                               \
+        dc[i] = (dc[i] - c[i]) / data.timeToLive[i];                                \
+    }
 
-    particle->color = start;
-    particle->deltaColor.r = (end.r - start.r) / particle->timeToLive;
-    particle->deltaColor.g = (end.g - start.g) / particle->timeToLive;
-    particle->deltaColor.b = (end.b - start.b) / particle->timeToLive;
-    particle->deltaColor.a = (end.a - start.a) / particle->timeToLive;
+    SET_DELTA_COLOR(data.colorR, data.deltaColorR);
+    SET_DELTA_COLOR(data.colorG, data.deltaColorG);
+    SET_DELTA_COLOR(data.colorB, data.deltaColorB);
+    SET_DELTA_COLOR(data.colorA, data.deltaColorA);
+#undef SET_DELTA_COLOR
 
     // size
-    float startS = _startSize + _startSizeVar * CCRANDOM_MINUS1_1();
-    startS = MAX(0, startS); // No negative value
-
-    particle->size = startS;
+    for (int i = start; i < end; ++i)
+    {
+        data.size[i] = MAX(0, _startSize + _startSizeVar * nextRandomMinus1_1(seed)); // No negative value
+    }
 
     if (_endSize == START_SIZE_EQUAL_TO_END_SIZE)
     {
-        particle->deltaSize = 0;
+        for (int i = start; i < end; ++i)
+        {
+            data.deltaSize[i] = 0;
+        }
     }
     else
     {
-        float endS = _endSize + _endSizeVar * CCRANDOM_MINUS1_1();
-        endS = MAX(0, endS); // No negative values
-        particle->deltaSize = (endS - startS) / particle->timeToLive;
+        for (int i = start; i < end; ++i)
+        {
+            float endS = MAX(0, _endSize + _endSizeVar * nextRandomMinus1_1(seed)); // No negative values
+            data.deltaSize[i] = (endS - data.size[i]) / data.timeToLive[i];
+        }
     }
 
     // rotation
-    float startA = _startSpin + _startSpinVar * CCRANDOM_MINUS1_1();
-    float endA = _endSpin + _endSpinVar * CCRANDOM_MINUS1_1();
-    particle->rotation = startA;
-    particle->deltaRotation = (endA - startA) / particle->timeToLive;
+    for (int i = start; i < end; ++i)
+    {
+        float startA = _startSpin + _startSpinVar * nextRandomMinus1_1(seed);
+        float endA = _endSpin + _endSpinVar * nextRandomMinus1_1(seed);
+        data.rotation[i] = startA;
+        data.deltaRotation[i] = (endA - startA) / data.timeToLive[i];
+    }
 
     // position
+    Point startPos;
     if (_positionType == PositionType::FREE)
     {
-        particle->startPos = this->convertToWorldSpace(Point::ZERO);
+        startPos = this->convertToWorldSpace(Point::ZERO);
     }
     else if (_positionType == PositionType::RELATIVE)
     {
-        particle->startPos = _position;
+        startPos = _position;
+    }
+    for (int i = start; i < end; ++i)
+    {
+        data.startPosX[i] = startPos.x;
+        data.startPosY[i] = startPos.y;
     }
-
-    // direction
-    float a = CC_DEGREES_TO_RADIANS( _angle + _angleVar * CCRANDOM_MINUS1_1() );    
 
     // Mode Gravity: A
     if (_emitterMode == Mode::GRAVITY)
     {
-        Point v(cosf( a ), sinf( a ));
-        float s = modeA.speed + modeA.speedVar * CCRANDOM_MINUS1_1();
-
-        // direction
-        particle->modeA.dir = v * s ;
+        for (int i = start; i < end; ++i)
+        {
+            // direction
+            float a = CC_DEGREES_TO_RADIANS( _angle + _angleVar * nextRandomMinus1_1(seed) );
+            float s = modeA.speed + modeA.speedVar * nextRandomMinus1_1(seed);
+            data.modeA.dirX[i] = cosf( a ) * s;
+            data.modeA.dirY[i] = sinf( a ) * s;
+        }
 
         // radial accel
-        particle->modeA.radialAccel = modeA.radialAccel + modeA.radialAccelVar * CCRANDOM_MINUS1_1();
- 
+        for (int i = start; i < end; ++i)
+        {
+            data.modeA.radialAccel[i] = modeA.radialAccel + modeA.radialAccelVar * nextRandomMinus1_1(seed);
+        }
 
         // tangential accel
-        particle->modeA.tangentialAccel = modeA.tangentialAccel + modeA.tangentialAccelVar * CCRANDOM_MINUS1_1();
+        for (int i = start; i < end; ++i)
+        {
+            data.modeA.tangentialAccel[i] = modeA.tangentialAccel + modeA.tangentialAccelVar * nextRandomMinus1_1(seed);
+        }
 
         // rotation is dir
         if(modeA.rotationIsDir)
-            particle->rotation = -CC_RADIANS_TO_DEGREES(particle->modeA.dir.getAngle());
+        {
+            for (int i = start; i < end; ++i)
+            {
+                data.rotation[i] = -CC_RADIANS_TO_DEGREES(atan2f(data.modeA.dirY[i], data.modeA.dirX[i]));
+            }
+        }
     }
 
     // Mode Radius: B
-    else 
+    else
     {
+        for (int i = start; i < end; ++i)
+        {
+            data.modeB.angle[i] = CC_DEGREES_TO_RADIANS( _angle + _angleVar * nextRandomMinus1_1(seed) );
+        }
+
         // Set the default diameter of the particle from the source position
-        float startRadius = modeB.startRadius + modeB.startRadiusVar * CCRANDOM_MINUS1_1();
-        float endRadius = modeB.endRadius + modeB.endRadiusVar * CCRANDOM_MINUS1_1();
+        for (int i = start; i < end; ++i)
+        {
+            float startRadius = modeB.startRadius + modeB.startRadiusVar * nextRandomMinus1_1(seed);
+            float endRadius = modeB.endRadius + modeB.endRadiusVar * nextRandomMinus1_1(seed);
 
-        particle->modeB.radius = startRadius;
+            data.modeB.radius[i] = startRadius;
 
-        if (modeB.endRadius == START_RADIUS_EQUAL_TO_END_RADIUS)
-        {
-            particle->modeB.deltaRadius = 0;
+            if (modeB.endRadius == START_RADIUS_EQUAL_TO_END_RADIUS)
+            {
+                data.modeB.deltaRadius[i] = 0;
+            }
+            else
+            {
+                data.modeB.deltaRadius[i] = (endRadius - startRadius) / data.timeToLive[i];
+            }
         }
-        else
+
+        for (int i = start; i < end; ++i)
         {
-            particle->modeB.deltaRadius = (endRadius - startRadius) / particle->timeToLive;
+            data.modeB.degreesPerSecond[i] = CC_DEGREES_TO_RADIANS(modeB.rotatePerSecond + modeB.rotatePerSecondVar * nextRandomMinus1_1(seed));
         }
-
-        particle->modeB.angle = a;
-        particle->modeB.degreesPerSecond = CC_DEGREES_TO_RADIANS(modeB.rotatePerSecond + modeB.rotatePerSecondVar * CCRANDOM_MINUS1_1());
-    }    
+    }
 }
 
 void ParticleSystem::stopSystem()
@@ -620,10 +805,9 @@ void ParticleSystem::resetSystem()
 {
     _isActive = true;
     _elapsed = 0;
-    for (_particleIdx = 0; _particleIdx < _particleCount; ++_particleIdx)
+    for (int i = 0; i < _particleCount; ++i)
     {
-        tParticle *p = &_particles[_particleIdx];
-        p->timeToLive = 0;
+        _particleData.timeToLive[i] = 0;
     }
 }
 bool ParticleSystem::isFull()
@@ -645,10 +829,11 @@ void ParticleSystem::update(float dt)
             _emitCounter += dt;
         }
         
-        while (_particleCount < _totalParticles && _emitCounter > rate) 
+        if (_particleCount < _totalParticles && _emitCounter > rate)
         {
-            this->addParticle();
-            _emitCounter -= rate;
+            int emitCount = MIN(_totalParticles - _particleCount, (int)(_emitCounter / rate));
+            this->addParticles(emitCount);
+            _emitCounter -= rate * emitCount;
         }
 
         _elapsed += dt;
@@ -658,157 +843,119 @@ void ParticleSystem::update(float dt)
         }
     }
 
-    _particleIdx = 0;
-
-    Point currentPosition = Point::ZERO;
-    if (_positionType == PositionType::FREE)
-    {
-        currentPosition = this->convertToWorldSpace(Point::ZERO);
-    }
-    else if (_positionType == PositionType::RELATIVE)
-    {
-        currentPosition = _position;
-    }
-
     if (_visible)
     {
-        while (_particleIdx < _particleCount)
-        {
-            tParticle *p = &_particles[_particleIdx];
+        ParticleData& data = _particleData;
 
-            // life
-            p->timeToLive -= dt;
+        // life
+        for (int i = 0; i < _particleCount; ++i)
+        {
+            data.timeToLive[i] -= dt;
+        }
 
-            if (p->timeToLive > 0) 
+        // remove the dead particles, the last particle takes the place of the dead one
+        bool particlesRemoved = false;
+        for (int i = 0; i < _particleCount; )
+        {
+            if (data.timeToLive[i] > 0)
             {
-                // Mode A: gravity, direction, tangential accel & radial accel
-                if (_emitterMode == Mode::GRAVITY)
-                {
-                    Point tmp, radial, tangential;
-
-                    radial = Point::ZERO;
-                    // radial acceleration
-                    if (p->pos.x || p->pos.y)
-                    {
-                        radial = p->pos.normalize();
-                    }
-                    tangential = radial;
-                    radial = radial * p->modeA.radialAccel;
-
-                    // tangential acceleration
-                    float newy = tangential.x;
-                    tangential.x = -tangential.y;
-                    tangential.y = newy;
-                    tangential = tangential * p->modeA.tangentialAccel;
-
-                    // (gravity + radial + tangential) * dt
-                    tmp = radial + tangential + modeA.gravity;
-                    tmp = tmp * dt;
-                    p->modeA.dir = p->modeA.dir + tmp;
-					if (_configName.length()>0)
-					{
-						if (_yCoordFlipped == -1)
-						{
-							 tmp = p->modeA.dir * dt;
-						}
-						else
-						{
-							 tmp = p->modeA.dir * -dt;
-						}
-					}
-					else
-					{
-						 tmp = p->modeA.dir * dt;
-					}
-                    p->pos = p->pos + tmp;
-                }
-
-                // Mode B: radius movement
-                else 
-                {                
-                    // Update the angle and radius of the particle.
-                    p->modeB.angle += p->modeB.degreesPerSecond * dt;
-                    p->modeB.radius += p->modeB.deltaRadius * dt;
-
-                    p->pos.x = - cosf(p->modeB.angle) * p->modeB.radius;
-                    p->pos.y = - sinf(p->modeB.angle) * p->modeB.radius;
-                    if (_yCoordFlipped == 1)
-                    {
-                      p->pos.y = -p->pos.y;
-                    }
-				}
+                ++i;
+                continue;
+            }
 
-                // color
-                p->color.r += (p->deltaColor.r * dt);
-                p->color.g += (p->deltaColor.g * dt);
-                p->color.b += (p->deltaColor.b * dt);
-                p->color.a += (p->deltaColor.a * dt);
+            int last = _particleCount - 1;
+            unsigned int currentIndex = data.atlasIndex[i];
+            if (i != last)
+            {
+                data.copyParticle(i, last);
+            }
+            if (_batchNode)
+            {
+                //disable the switched particle
+                _batchNode->disableParticle(_atlasIndex+currentIndex);
 
-                // size
-                p->size += (p->deltaSize * dt);
-                p->size = MAX( 0, p->size );
+                //switch indexes
+                data.atlasIndex[last] = currentIndex;
+            }
 
-                // angle
-                p->rotation += (p->deltaRotation * dt);
+            --_particleCount;
+            particlesRemoved = true;
+        }
 
-                //
-                // update values in quad
-                //
+        if( particlesRemoved && _particleCount == 0 && _isAutoRemoveOnFinish )
+        {
+            this->unscheduleUpdate();
+            _parent->removeChild(this, true);
+            return;
+        }
 
-                Point    newPos;
+        // The loops below don't branch per particle and write each array linearly,
+        // so that the compiler can vectorize them.
 
-                if (_positionType == PositionType::FREE || _positionType == PositionType::RELATIVE)
-                {
-                    Point diff = currentPosition - p->startPos;
-                    newPos = p->pos - diff;
-                } 
-                else
-                {
-                    newPos = p->pos;
-                }
+        // Mode A: gravity, direction, tangential accel & radial accel
+        if (_emitterMode == Mode::GRAVITY)
+        {
+            const float gravityX = modeA.gravity.x * dt;
+            const float gravityY = modeA.gravity.y * dt;
 
-                // translate newPos to correct position, since matrix transform isn't performed in batchnode
-                // don't update the particle with the new position information, it will interfere with the radius and tangential calculations
-                if (_batchNode)
-                {
-                    newPos.x+=_position.x;
-                    newPos.y+=_position.y;
-                }
+            // particles loaded from a plist move along y in the other direction, unless the y coordinate is flipped
+            const float posDt = (_configName.length() > 0 && _yCoordFlipped != -1) ? -dt : dt;
 
-                updateQuadWithParticle(p, newPos);
-                //updateParticleImp(self, updateParticleSel, p, newPos);
+            updateGravityParticles(data.posx, data.posy, data.modeA.dirX, data.modeA.dirY,
+                                   data.modeA.radialAccel, data.modeA.tangentialAccel,
+                                   _particleCount, dt, gravityX, gravityY, posDt);
+        }
 
-                // update particle counter
-                ++_particleIdx;
-            } 
-            else 
+        // Mode B: radius movement
+        else
+        {
+            float* angle = data.modeB.angle;
+            float* radius = data.modeB.radius;
+            const float* degreesPerSecond = data.modeB.degreesPerSecond;
+            const float* deltaRadius = data.modeB.deltaRadius;
+            const float ySign = (_yCoordFlipped == 1) ? 1.0f : -1.0f;
+
+            // Update the angle and radius of the particle.
+            for (int i = 0; i < _particleCount; ++i)
             {
-                // life < 0
-                int currentIndex = p->atlasIndex;
-                if( _particleIdx != _particleCount-1 )
-                {
-                    _particles[_particleIdx] = _particles[_particleCount-1];
-                }
-                if (_batchNode)
-                {
-                    //disable the switched particle
-                    _batchNode->disableParticle(_atlasIndex+currentIndex);
+                angle[i] += degreesPerSecond[i] * dt;
+                radius[i] += deltaRadius[i] * dt;
+            }
+            for (int i = 0; i < _particleCount; ++i)
+            {
+                data.posx[i] = - cosf(angle[i]) * radius[i];
+                data.posy[i] = ySign * sinf(angle[i]) * radius[i];
+            }
+        }
 
-                    //switch indexes
-                    _particles[_particleCount-1].atlasIndex = currentIndex;
-                }
+        // color
+        for (int i = 0; i < _particleCount; ++i)
+        {
+            data.colorR[i] += data.deltaColorR[i] * dt;
+            data.colorG[i] += data.deltaColorG[i] * dt;
+            data.colorB[i] += data.deltaColorB[i] * dt;
+            data.colorA[i] += data.deltaColorA[i] * dt;
+        }
 
+        // size
+        for (int i = 0; i < _particleCount; ++i)
+        {
+            float size = data.size[i] + data.deltaSize[i] * dt;
+            data.size[i] = size > 0 ? size : 0;
+        }
 
-                --_particleCount;
+        // angle
+        for (int i = 0; i < _particleCount; ++i)
+        {
+            data.rotation[i] += data.deltaRotation[i] * dt;
+        }
+
+        //
+        // update values in quads
+        //
+        updateParticleQuads();
+        _particleIdx = _particleCount;
 
-                if( _particleCount == 0 && _isAutoRemoveOnFinish )
-                {
-                    this->unscheduleUpdate();
-                    _parent->removeChild(this, true);
-                    return;
-                }
-            }
-        } //while
         _transformSystemDirty = false;
     }
     if (! _batchNode)
@@ -824,10 +971,8 @@ void ParticleSystem::updateWithNoTime(void)
     this->update(0.0f);
 }
 
-void ParticleSystem::updateQuadWithParticle(tParticle* particle, const Point& newPosition)
+void ParticleSystem::updateParticleQuads()
 {
-    CC_UNUSED_PARAM(particle);
-    CC_UNUSED_PARAM(newPosition);
     // should be overridden
 }
 
@@ -1125,7 +1270,7 @@ void ParticleSystem::setBatchNode(ParticleBatchNode* batchNode)
             //each particle needs a unique index
             for (int i = 0; i < _totalParticles; i++)
             {
-                _particles[i].atlasIndex=i;
+                _particleData.atlasIndex[i] = i;
             }
         }
     }
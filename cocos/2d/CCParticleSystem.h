@@ -40,42 +40,74 @@ NS_CC_BEGIN
 
 class ParticleBatchNode;
 
-/**
-Structure that contains the values of each particle
+/** @brief Values of the particles, stored as a structure of arrays.
+Each value has its own contiguous array indexed by particle, so the update loops
+of ParticleSystem walk the memory linearly and can be vectorized by the compiler.
+All the arrays live in a single allocation.
+@since v3.0
 */
-typedef struct sParticle {
-    Point     pos;
-    Point     startPos;
-
-    Color4F    color;
-    Color4F    deltaColor;
-
-    float        size;
-    float        deltaSize;
-
-    float        rotation;
-    float        deltaRotation;
-
-    float        timeToLive;
-
-    unsigned int    atlasIndex;
+class CC_DLL ParticleData
+{
+public:
+    float* posx;
+    float* posy;
+    float* startPosX;
+    float* startPosY;
+
+    float* colorR;
+    float* colorG;
+    float* colorB;
+    float* colorA;
+
+    float* deltaColorR;
+    float* deltaColorG;
+    float* deltaColorB;
+    float* deltaColorA;
+
+    float* size;
+    float* deltaSize;
+    float* rotation;
+    float* deltaRotation;
+    float* timeToLive;
+    unsigned int* atlasIndex;
 
     //! Mode A: gravity, direction, radial accel, tangential accel
     struct {
-        Point        dir;
-        float        radialAccel;
-        float        tangentialAccel;
+        float* dirX;
+        float* dirY;
+        float* radialAccel;
+        float* tangentialAccel;
     } modeA;
 
     //! Mode B: radius mode
     struct {
-        float        angle;
-        float        degreesPerSecond;
-        float        radius;
-        float        deltaRadius;
+        float* angle;
+        float* degreesPerSecond;
+        float* radius;
+        float* deltaRadius;
     } modeB;
 
-}tParticle;
+    ParticleData();
+    ~ParticleData();
+
+    /** allocates zeroed storage for count particles. On failure the previous storage is kept */
+    bool init(int count);
+    /** frees the storage */
+    void release();
+    inline int getMaxCount() const { return _maxCount; }
+
+    /** copies the values of the particle p2 over the particle p1 */
+    void copyParticle(int p1, int p2);
+
+private:
+    void setupPointers();
+
+    unsigned int* _block;
+    int _stride;
+    int _maxCount;
+
+    CC_DISALLOW_COPY_AND_ASSIGN(ParticleData);
+};
 
 //typedef void (*CC_UPDATE_PARTICLE_IMP)(id, SEL, tParticle*, Point);
 
@@ -174,8 +206,10 @@ public:
 
     //! Add a particle to the emitter
     bool addParticle();
-    //! Initializes a particle
-    void initParticle(tParticle* particle);
+    /** Add count particles to the emitter. The new particles are initialized attribute by attribute
+     @since v3.0
+     */
+    void addParticles(int count);
     //! stop emitting particles. Running particles will continue to run until they die
     void stopSystem();
     //! Kill all living particles.
@@ -183,8 +217,10 @@ public:
     //! whether or not the system is full
     bool isFull();
 
-    //! should be overridden by subclasses
-    virtual void updateQuadWithParticle(tParticle* particle, const Point& newPosition);
+    /** Updates the quads of all the living particles in one pass. Should be overridden by subclasses
+     @since v3.0
+     */
+    virtual void updateParticleQuads();
     //! should be overridden by subclasses
     virtual void postStep();
 
@@ -454,8 +490,10 @@ protected:
         float rotatePerSecondVar;
     } modeB;
 
-    //! Array of particles
-    tParticle *_particles;
+    //! Particles values
+    ParticleData _particleData;
+    //! State of the random generator used when emitting particles
+    unsigned int _randomState;
 
     //Emitter name
     std::string _configName;
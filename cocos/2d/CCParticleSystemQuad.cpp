@@ -247,87 +247,111 @@ void ParticleSystemQuad::initIndices()
     }
 }
 
-void ParticleSystemQuad::updateQuadWithParticle(tParticle* particle, const Point& newPosition)
+void ParticleSystemQuad::updateParticleQuads()
 {
-    V3F_C4B_T2F_Quad *quad;
+    if (_particleCount <= 0)
+    {
+        return;
+    }
 
-    if (_batchNode)
+    Point currentPosition = Point::ZERO;
+    if (_positionType == PositionType::FREE)
     {
-        V3F_C4B_T2F_Quad *batchQuads = _batchNode->getTextureAtlas()->getQuads();
-        quad = &(batchQuads[_atlasIndex+particle->atlasIndex]);
+        currentPosition = this->convertToWorldSpace(Point::ZERO);
     }
-    else
+    else if (_positionType == PositionType::RELATIVE)
     {
-        quad = &(_quads[_particleIdx]);
+        currentPosition = _position;
     }
-    Color4B color = (_opacityModifyRGB)
-        ? Color4B( particle->color.r*particle->color.a*255, particle->color.g*particle->color.a*255, particle->color.b*particle->color.a*255, particle->color.a*255)
-        : Color4B( particle->color.r*255, particle->color.g*255, particle->color.b*255, particle->color.a*255);
 
-    quad->bl.colors = color;
-    quad->br.colors = color;
-    quad->tl.colors = color;
-    quad->tr.colors = color;
+    // translate the particles to their position, since matrix transform isn't performed in batchnode.
+    // the particle positions themselves are not modified, it would interfere with the radius and tangential calculations
+    Point offset = Point::ZERO;
+    if (_batchNode)
+    {
+        offset = _position;
+    }
 
-    // vertices
-    GLfloat size_2 = particle->size/2;
-    if (particle->rotation) 
+    V3F_C4B_T2F_Quad *batchQuads = _batchNode ? _batchNode->getTextureAtlas()->getQuads() + _atlasIndex : nullptr;
+    const ParticleData& data = _particleData;
+    const bool moveWithStartPos = (_positionType == PositionType::FREE || _positionType == PositionType::RELATIVE);
+
+    for (int i = 0; i < _particleCount; ++i)
     {
-        GLfloat x1 = -size_2;
-        GLfloat y1 = -size_2;
-
-        GLfloat x2 = size_2;
-        GLfloat y2 = size_2;
-        GLfloat x = newPosition.x;
-        GLfloat y = newPosition.y;
-
-        GLfloat r = (GLfloat)-CC_DEGREES_TO_RADIANS(particle->rotation);
-        GLfloat cr = cosf(r);
-        GLfloat sr = sinf(r);
-        GLfloat ax = x1 * cr - y1 * sr + x;
-        GLfloat ay = x1 * sr + y1 * cr + y;
-        GLfloat bx = x2 * cr - y1 * sr + x;
-        GLfloat by = x2 * sr + y1 * cr + y;
-        GLfloat cx = x2 * cr - y2 * sr + x;
-        GLfloat cy = x2 * sr + y2 * cr + y;
-        GLfloat dx = x1 * cr - y2 * sr + x;
-        GLfloat dy = x1 * sr + y2 * cr + y;
-
-        // bottom-left
-        quad->bl.vertices.x = ax;
-        quad->bl.vertices.y = ay;
+        V3F_C4B_T2F_Quad *quad = batchQuads ? &batchQuads[data.atlasIndex[i]] : &_quads[i];
 
-        // bottom-right vertex:
-        quad->br.vertices.x = bx;
-        quad->br.vertices.y = by;
+        float x = data.posx[i] + offset.x;
+        float y = data.posy[i] + offset.y;
+        if (moveWithStartPos)
+        {
+            x -= currentPosition.x - data.startPosX[i];
+            y -= currentPosition.y - data.startPosY[i];
+        }
 
-        // top-left vertex:
-        quad->tl.vertices.x = dx;
-        quad->tl.vertices.y = dy;
+        float r = data.colorR[i];
+        float g = data.colorG[i];
+        float b = data.colorB[i];
+        float a = data.colorA[i];
+        Color4B color = (_opacityModifyRGB)
+            ? Color4B( r*a*255, g*a*255, b*a*255, a*255)
+            : Color4B( r*255, g*255, b*255, a*255);
+
+        quad->bl.colors = color;
+        quad->br.colors = color;
+        quad->tl.colors = color;
+        quad->tr.colors = color;
+
+        // vertices
+        GLfloat size_2 = data.size[i]/2;
+        if (data.rotation[i])
+        {
+            GLfloat x1 = -size_2;
+            GLfloat y1 = -size_2;
 
-        // top-right vertex:
-        quad->tr.vertices.x = cx;
-        quad->tr.vertices.y = cy;
-    } 
-    else 
-    {
-        // bottom-left vertex:
-        quad->bl.vertices.x = newPosition.x - size_2;
-        quad->bl.vertices.y = newPosition.y - size_2;
+            GLfloat x2 = size_2;
+            GLfloat y2 = size_2;
 
-        // bottom-right vertex:
-        quad->br.vertices.x = newPosition.x + size_2;
-        quad->br.vertices.y = newPosition.y - size_2;
+            GLfloat rad = (GLfloat)-CC_DEGREES_TO_RADIANS(data.rotation[i]);
+            GLfloat cr = cosf(rad);
+            GLfloat sr = sinf(rad);
 
-        // top-left vertex:
-        quad->tl.vertices.x = newPosition.x - size_2;
-        quad->tl.vertices.y = newPosition.y + size_2;
+            // bottom-left
+            quad->bl.vertices.x = x1 * cr - y1 * sr + x;
+            quad->bl.vertices.y = x1 * sr + y1 * cr + y;
 
-        // top-right vertex:
-        quad->tr.vertices.x = newPosition.x + size_2;
-        quad->tr.vertices.y = newPosition.y + size_2;                
+            // bottom-right vertex:
+            quad->br.vertices.x = x2 * cr - y1 * sr + x;
+            quad->br.vertices.y = x2 * sr + y1 * cr + y;
+
+            // top-left vertex:
+            quad->tl.vertices.x = x1 * cr - y2 * sr + x;
+            quad->tl.vertices.y = x1 * sr + y2 * cr + y;
+
+            // top-right vertex:
+            quad->tr.vertices.x = x2 * cr - y2 * sr + x;
+            quad->tr.vertices.y = x2 * sr + y2 * cr + y;
+        }
+        else
+        {
+            // bottom-left vertex:
+            quad->bl.vertices.x = x - size_2;
+            quad->bl.vertices.y = y - size_2;
+
+            // bottom-right vertex:
+            quad->br.vertices.x = x + size_2;
+            quad->br.vertices.y = y - size_2;
+
+            // top-left vertex:
+            quad->tl.vertices.x = x - size_2;
+            quad->tl.vertices.y = y + size_2;
+
+            // top-right vertex:
+            quad->tr.vertices.x = x + size_2;
+            quad->tr.vertices.y = y + size_2;
+        }
     }
 }
+
 void ParticleSystemQuad::postStep()
 {
     glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[0]);
@@ -457,24 +481,21 @@ void ParticleSystemQuad::setTotalParticles(int tp)
     if( tp > _allocatedParticles )
     {
         // Allocate new memory
-        size_t particlesSize = tp * sizeof(tParticle);
         size_t quadsSize = sizeof(_quads[0]) * tp * 1;
         size_t indicesSize = sizeof(_indices[0]) * tp * 6 * 1;
 
-        tParticle* particlesNew = (tParticle*)realloc(_particles, particlesSize);
         V3F_C4B_T2F_Quad* quadsNew = (V3F_C4B_T2F_Quad*)realloc(_quads, quadsSize);
         GLushort* indicesNew = (GLushort*)realloc(_indices, indicesSize);
 
-        if (particlesNew && quadsNew && indicesNew)
+        // the particle data is cleared by init()
+        if (_particleData.init(tp) && quadsNew && indicesNew)
         {
             // Assign pointers
-            _particles = particlesNew;
             _quads = quadsNew;
             _indices = indicesNew;
 
             // Clear the memory
             // XXX: Bug? If the quads are cleared, then drawing doesn't work... WHY??? XXX
-            memset(_particles, 0, particlesSize);
             memset(_quads, 0, quadsSize);
             memset(_indices, 0, indicesSize);
 
@@ -483,7 +504,6 @@ void ParticleSystemQuad::setTotalParticles(int tp)
         else
         {
             // Out of memory, failed to resize some array
-            if (particlesNew) _particles = particlesNew;
             if (quadsNew) _quads = quadsNew;
             if (indicesNew) _indices = indicesNew;
 
@@ -498,7 +518,7 @@ void ParticleSystemQuad::setTotalParticles(int tp)
         {
             for (int i = 0; i < _totalParticles; i++)
             {
-                _particles[i].atlasIndex=i;
+                _particleData.atlasIndex[i] = i;
             }
         }
 
@@ -97,7 +97,7 @@ public:
      * @js NA
      * @lua NA
      */
-    virtual void updateQuadWithParticle(tParticle* particle, const Point& newPosition) override;
+    virtual void updateParticleQuads() override;
     /**
      * @js NA
      * @lua NA
@@ -223,6 +223,27 @@ void Timer::update(float dt)
     }
 }
 
+bool Timer::updateScriptTimer(float dt, float* elapsed)
+{
+    if (_elapsed == -1)
+    {
+        _elapsed = 0;
+        _timesExecuted = 0;
+        return false;
+    }
+
+    // script timers repeat forever and have no delay
+    _elapsed += dt;
+    if (_elapsed >= _interval)
+    {
+        *elapsed = _elapsed;
+        _elapsed = 0;
+        _timesExecuted += 1;
+        return true;
+    }
+    return false;
+}
+
 float Timer::getInterval() const
 {
     return _interval;
@@ -953,8 +974,26 @@ void Scheduler::update(float dt)
             }
             else if (!eachEntry->isPaused())
             {
-                eachEntry->getTimer()->update(dt);
+                SchedulerScriptBatchEntry due;
+                if (eachEntry->getTimer()->updateScriptTimer(dt, &due.elapse))
+                {
+                    // a callback may unschedule all the entries, keep them alive until the batch is done
+                    due.entry = eachEntry;
+                    due.entry->retain();
+                    _scriptBatch.push_back(due);
+                }
+            }
+        }
+
+        // call the due callbacks in one go, so the script engine only has to set up the call once
+        if (!_scriptBatch.empty())
+        {
+            ScriptEngineManager::getInstance()->getScriptEngine()->executeScheduleBatch(_scriptBatch);
+            for (const auto& due : _scriptBatch)
+            {
+                due.entry->release();
             }
+            _scriptBatch.clear();
         }
     }
 
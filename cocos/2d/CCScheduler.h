@@ -84,6 +84,13 @@ public:
 
     /** triggers the timer */
     void update(float dt);
+
+    /** advances a script timer without calling its handler.
+     @return true if the handler is due, elapsed is then set to the time passed since its last call.
+     The scheduler uses it to dispatch all the script callbacks of a frame in one batch.
+     @since v3.0
+     */
+    bool updateScriptTimer(float dt, float* elapsed);
     
     inline int getScriptHandler() const { return _scriptHandler; };
 
@@ -109,6 +116,13 @@ struct _hashSelectorEntry;
 struct _hashUpdateEntry;
 class SchedulerScriptHandlerEntry;
 
+/** A script callback that is due in the current frame, see ScriptEngineProtocol::executeScheduleBatch() */
+struct SchedulerScriptBatchEntry
+{
+    SchedulerScriptHandlerEntry* entry;
+    float elapse;
+};
+
 /** @brief Scheduler is responsible for triggering the scheduled callbacks.
 You should not use NSTimer. Instead use this class.
 
@@ -292,6 +306,8 @@ protected:
     // If true unschedule will not remove anything from a hash. Elements will only be marked for deletion.
     bool _updateHashLocked;
     Vector<SchedulerScriptHandlerEntry*> _scriptHandlerEntries;
+    // script callbacks that are due in the current frame, kept to reuse its storage
+    std::vector<SchedulerScriptBatchEntry> _scriptBatch;
 
     // Used for "perform Function"
     std::vector<std::function<void()>> _functionsToPerform;
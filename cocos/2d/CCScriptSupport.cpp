@@ -110,6 +110,22 @@ bool TouchScriptHandlerEntry::init(bool isMultiTouches, int priority, bool swall
     return true;
 }
 
+// #pragma mark -
+// #pragma mark ScriptEngineProtocol
+
+void ScriptEngineProtocol::executeScheduleBatch(const std::vector<SchedulerScriptBatchEntry>& batch)
+{
+    for (const auto& due : batch)
+    {
+        if (due.entry->isMarkedForDeletion() || due.entry->isPaused())
+            continue;
+
+        SchedulerScriptData data(due.entry->getHandler(), due.elapse);
+        ScriptEvent event(kScheduleEvent, &data);
+        sendEvent(&event);
+    }
+}
+
 // #pragma mark -
 // #pragma mark ScriptEngineManager
 
@@ -33,6 +33,7 @@
 #include <map>
 #include <string>
 #include <list>
+#include <vector>
 
 typedef struct lua_State lua_State;
 
@@ -44,6 +45,7 @@ class MenuItem;
 class NotificationCenter;
 class CallFunc;
 class Acceleration;
+struct SchedulerScriptBatchEntry;
 
 enum ccScriptType {
     kScriptTypeNone = 0,
@@ -431,6 +433,15 @@ public:
      * @lua NA
      */
     virtual int sendEvent(ScriptEvent* evt) = 0;
+
+    /** called by Scheduler with the script callbacks that are due in the current frame.
+     Entries that an earlier callback of the batch unscheduled or paused are skipped.
+     The default implementation sends a kScheduleEvent for each entry.
+     * @since v3.0
+     * @js NA
+     * @lua NA
+     */
+    virtual void executeScheduleBatch(const std::vector<SchedulerScriptBatchEntry>& batch);
     
     /** called by CCAssert to allow scripting engine to handle failed assertions
      * @return true if the assert was handled by the script engine, false otherwise.
@@ -39,6 +39,7 @@ enum {
     kShaderType_PositionTexture,
     kShaderType_PositionTexture_uColor,
     kShaderType_PositionTextureA8Color,
+    kShaderType_PositionTextureA8Color_noMVP,
     kShaderType_Position_uColor,
     kShaderType_PositionLengthTexureColor,
     kShaderType_LabelDistanceFieldNormal,
@@ -145,6 +146,13 @@ void ShaderCache::loadDefaultShaders()
     loadDefaultShader(p, kShaderType_PositionTextureA8Color);
     _programs.insert( std::make_pair(GLProgram::SHADER_NAME_POSITION_TEXTURE_A8_COLOR, p) );
 
+    //
+    // Position Texture A8 Color without MVP shader
+    //
+    p = new GLProgram();
+    loadDefaultShader(p, kShaderType_PositionTextureA8Color_noMVP);
+    _programs.insert( std::make_pair(GLProgram::SHADER_NAME_POSITION_TEXTURE_A8_COLOR_NO_MVP, p) );
+
     //
     // Position and 1 color passed as a uniform (to simulate glColor4ub )
     //
@@ -217,6 +225,13 @@ void ShaderCache::reloadDefaultShaders()
     p = getProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE_A8_COLOR);
     p->reset();
     loadDefaultShader(p, kShaderType_PositionTextureA8Color);
+
+    //
+    // Position Texture A8 Color without MVP shader
+    //
+    p = getProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE_A8_COLOR_NO_MVP);
+    p->reset();
+    loadDefaultShader(p, kShaderType_PositionTextureA8Color_noMVP);
     
     //
     // Position and 1 color passed as a uniform (to simulate glColor4ub )
@@ -305,6 +320,14 @@ void ShaderCache::loadDefaultShader(GLProgram *p, int type)
             p->addAttribute(GLProgram::ATTRIBUTE_NAME_COLOR, GLProgram::VERTEX_ATTRIB_COLOR);
             p->addAttribute(GLProgram::ATTRIBUTE_NAME_TEX_COORD, GLProgram::VERTEX_ATTRIB_TEX_COORDS);
 
+            break;
+        case kShaderType_PositionTextureA8Color_noMVP:
+            p->initWithVertexShaderByteArray(ccPositionTextureColor_noMVP_vert, ccPositionTextureA8Color_frag);
+
+            p->addAttribute(GLProgram::ATTRIBUTE_NAME_POSITION, GLProgram::VERTEX_ATTRIB_POSITION);
+            p->addAttribute(GLProgram::ATTRIBUTE_NAME_COLOR, GLProgram::VERTEX_ATTRIB_COLOR);
+            p->addAttribute(GLProgram::ATTRIBUTE_NAME_TEX_COORD, GLProgram::VERTEX_ATTRIB_TEX_COORDS);
+
             break;
         case kShaderType_Position_uColor:
             p->initWithVertexShaderByteArray(ccPosition_uColor_vert, ccPosition_uColor_frag);    
@@ -38,12 +38,98 @@ THE SOFTWARE.
 #include "CCArray.h"
 #include "CCDictionary.h"
 #include "CCDirector.h"
+#include "CCData.h"
 #include <vector>
 
 using namespace std;
 
 NS_CC_BEGIN
 
+// binary frame table, written by tools/spriteframe-converter/plist2sfb.py
+// all the values are little endian
+static const unsigned char BINARY_FRAMES_SIGNATURE[4] = { 'C', 'C', 'S', 'F' };
+static const unsigned short BINARY_FRAMES_VERSION = 1;
+static const unsigned int BINARY_FRAMES_NO_TEXTURE = 0xffffffff;
+
+struct BinaryFramesHeader
+{
+    unsigned char   sig[4];
+    unsigned short  version;
+    unsigned short  reserved;
+    unsigned int    frameCount;
+    unsigned int    aliasCount;
+    unsigned int    textureNameOffset;
+    unsigned int    textureNameLength;
+    unsigned int    stringTableSize;
+};
+
+struct BinaryFrameRecord
+{
+    unsigned int    nameOffset;
+    unsigned int    nameLength;
+    float           rect[4];
+    float           offset[2];
+    float           originalSize[2];
+    unsigned int    rotated;
+};
+
+struct BinaryAliasRecord
+{
+    unsigned int    nameOffset;
+    unsigned int    nameLength;
+    unsigned int    frameIndex;
+};
+
+// whether a string of the string table lies within it, written so that it can't overflow
+static bool isValidBinaryString(unsigned int offset, unsigned int length, unsigned int stringTableSize)
+{
+    return offset <= stringTableSize && length <= stringTableSize - offset;
+}
+
+// returns the header if the data holds a complete binary frame table, every record
+// is checked up front so that a corrupt file adds no frames at all
+static const BinaryFramesHeader* getBinaryFramesHeader(const Data& data)
+{
+    const unsigned char* bytes = data.getBytes();
+    ssize_t size = data.getSize();
+    if (data.isNull() || size < (ssize_t)sizeof(BinaryFramesHeader))
+        return nullptr;
+
+    const BinaryFramesHeader* header = reinterpret_cast<const BinaryFramesHeader*>(bytes);
+    if (memcmp(header->sig, BINARY_FRAMES_SIGNATURE, sizeof(header->sig)) != 0 || header->version != BINARY_FRAMES_VERSION)
+        return nullptr;
+
+    unsigned long long expected = sizeof(BinaryFramesHeader)
+        + (unsigned long long)header->frameCount * sizeof(BinaryFrameRecord)
+        + (unsigned long long)header->aliasCount * sizeof(BinaryAliasRecord)
+        + header->stringTableSize;
+    if ((unsigned long long)size < expected)
+        return nullptr;
+
+    const BinaryFrameRecord* frames = reinterpret_cast<const BinaryFrameRecord*>(header + 1);
+    for (unsigned int i = 0; i < header->frameCount; ++i)
+    {
+        if (!isValidBinaryString(frames[i].nameOffset, frames[i].nameLength, header->stringTableSize))
+        {
+            CCLOG("cocos2d: SpriteFrameCache: invalid name in binary frame table");
+            return nullptr;
+        }
+    }
+
+    const BinaryAliasRecord* aliases = reinterpret_cast<const BinaryAliasRecord*>(frames + header->frameCount);
+    for (unsigned int i = 0; i < header->aliasCount; ++i)
+    {
+        if (aliases[i].frameIndex >= header->frameCount
+            || !isValidBinaryString(aliases[i].nameOffset, aliases[i].nameLength, header->stringTableSize))
+        {
+            CCLOG("cocos2d: SpriteFrameCache: invalid alias in binary frame table");
+            return nullptr;
+        }
+    }
+
+    return header;
+}
+
 static SpriteFrameCache *_sharedSpriteFrameCache = nullptr;
 
 SpriteFrameCache* SpriteFrameCache::getInstance()
@@ -197,8 +283,133 @@ void SpriteFrameCache::addSpriteFramesWithDictionary(ValueMap& dictionary, Textu
     }
 }
 
+bool SpriteFrameCache::isBinaryFramesFile(const std::string& file)
+{
+    size_t pos = file.find_last_of('.');
+    return pos != std::string::npos && file.compare(pos, std::string::npos, ".sfb") == 0;
+}
+
+bool SpriteFrameCache::addSpriteFramesWithBinaryData(const Data& data, Texture2D* texture)
+{
+    const BinaryFramesHeader* header = getBinaryFramesHeader(data);
+    if (!header)
+        return false;
+
+    const BinaryFrameRecord* frames = reinterpret_cast<const BinaryFrameRecord*>(header + 1);
+    const BinaryAliasRecord* aliases = reinterpret_cast<const BinaryAliasRecord*>(frames + header->frameCount);
+    const char* strings = reinterpret_cast<const char*>(aliases + header->aliasCount);
+
+    _spriteFrames.reserve(_spriteFrames.size() + header->frameCount);
+
+    for (unsigned int i = 0; i < header->frameCount; ++i)
+    {
+        const BinaryFrameRecord& record = frames[i];
+        std::string spriteFrameName(strings + record.nameOffset, record.nameLength);
+        if (_spriteFrames.at(spriteFrameName))
+        {
+            continue;
+        }
+
+        SpriteFrame* spriteFrame = new SpriteFrame();
+        spriteFrame->initWithTexture(texture,
+                                     Rect(record.rect[0], record.rect[1], record.rect[2], record.rect[3]),
+                                     record.rotated != 0,
+                                     Point(record.offset[0], record.offset[1]),
+                                     Size(record.originalSize[0], record.originalSize[1]));
+
+        _spriteFrames.insert(spriteFrameName, spriteFrame);
+        spriteFrame->release();
+    }
+
+    for (unsigned int i = 0; i < header->aliasCount; ++i)
+    {
+        const BinaryAliasRecord& alias = aliases[i];
+        std::string oneAlias(strings + alias.nameOffset, alias.nameLength);
+        if (_spriteFramesAliases.find(oneAlias) != _spriteFramesAliases.end())
+        {
+            CCLOGWARN("cocos2d: WARNING: an alias with name %s already exists", oneAlias.c_str());
+        }
+
+        const BinaryFrameRecord& record = frames[alias.frameIndex];
+        _spriteFramesAliases[oneAlias] = Value(std::string(strings + record.nameOffset, record.nameLength));
+    }
+
+    return true;
+}
+
+void SpriteFrameCache::addSpriteFramesWithBinaryFile(const std::string& file, Texture2D *texture)
+{
+    std::string fullPath = FileUtils::getInstance()->fullPathForFilename(file);
+    Data data = FileUtils::getInstance()->getDataFromFile(fullPath);
+
+    if (!addSpriteFramesWithBinaryData(data, texture))
+    {
+        CCLOG("cocos2d: SpriteFrameCache: %s is not a valid binary frame table", file.c_str());
+    }
+}
+
+void SpriteFrameCache::addSpriteFramesWithBinaryFile(const std::string& file)
+{
+    CCASSERT(file.size()>0, "file name should not be empty");
+
+    if (_loadedFileNames->find(file) != _loadedFileNames->end())
+        return;
+
+    std::string fullPath = FileUtils::getInstance()->fullPathForFilename(file);
+    Data data = FileUtils::getInstance()->getDataFromFile(fullPath);
+
+    const BinaryFramesHeader* header = getBinaryFramesHeader(data);
+    if (!header)
+    {
+        CCLOG("cocos2d: SpriteFrameCache: %s is not a valid binary frame table", file.c_str());
+        return;
+    }
+
+    std::string texturePath;
+    if (header->textureNameOffset != BINARY_FRAMES_NO_TEXTURE
+        && isValidBinaryString(header->textureNameOffset, header->textureNameLength, header->stringTableSize))
+    {
+        const char* strings = reinterpret_cast<const char*>(data.getBytes())
+            + sizeof(BinaryFramesHeader)
+            + header->frameCount * sizeof(BinaryFrameRecord)
+            + header->aliasCount * sizeof(BinaryAliasRecord);
+        texturePath.assign(strings + header->textureNameOffset, header->textureNameLength);
+        // build texture path relative to the frame table
+        texturePath = FileUtils::getInstance()->fullPathFromRelativeFile(texturePath.c_str(), file);
+    }
+    else
+    {
+        // build texture path by replacing file extension
+        texturePath = file;
+        texturePath = texturePath.erase(texturePath.find_last_of("."));
+        texturePath = texturePath.append(".png");
+
+        CCLOG("cocos2d: SpriteFrameCache: Trying to use file %s as texture", texturePath.c_str());
+    }
+
+    Texture2D *texture = Director::getInstance()->getTextureCache()->addImage(texturePath.c_str());
+
+    if (texture)
+    {
+        if (addSpriteFramesWithBinaryData(data, texture))
+        {
+            _loadedFileNames->insert(file);
+        }
+    }
+    else
+    {
+        CCLOG("cocos2d: SpriteFrameCache: Couldn't load texture");
+    }
+}
+
 void SpriteFrameCache::addSpriteFramesWithFile(const std::string& pszPlist, Texture2D *pobTexture)
 {
+    if (isBinaryFramesFile(pszPlist))
+    {
+        addSpriteFramesWithBinaryFile(pszPlist, pobTexture);
+        return;
+    }
+
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(pszPlist);
     ValueMap dict = FileUtils::getInstance()->getValueMapFromFile(fullPath);
 
@@ -224,6 +435,12 @@ void SpriteFrameCache::addSpriteFramesWithFile(const std::string& pszPlist)
 {
     CCASSERT(pszPlist.size()>0, "plist filename should not be nullptr");
 
+    if (isBinaryFramesFile(pszPlist))
+    {
+        addSpriteFramesWithBinaryFile(pszPlist);
+        return;
+    }
+
     if (_loadedFileNames->find(pszPlist) == _loadedFileNames->end())
     {
         std::string fullPath = FileUtils::getInstance()->fullPathForFilename(pszPlist);
@@ -336,6 +553,32 @@ void SpriteFrameCache::removeSpriteFrameByName(const std::string& name)
 void SpriteFrameCache::removeSpriteFramesFromFile(const std::string& plist)
 {
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(plist);
+
+    if (isBinaryFramesFile(plist))
+    {
+        Data data = FileUtils::getInstance()->getDataFromFile(fullPath);
+        const BinaryFramesHeader* header = getBinaryFramesHeader(data);
+        if (!header)
+        {
+            CCLOG("cocos2d:SpriteFrameCache:removeSpriteFramesFromFile: %s is not a valid binary frame table.",plist.c_str());
+            return;
+        }
+
+        const BinaryFrameRecord* frames = reinterpret_cast<const BinaryFrameRecord*>(header + 1);
+        const char* strings = reinterpret_cast<const char*>(frames + header->frameCount)
+            + header->aliasCount * sizeof(BinaryAliasRecord);
+
+        std::vector<std::string> keysToRemove;
+        keysToRemove.reserve(header->frameCount);
+        for (unsigned int i = 0; i < header->frameCount; ++i)
+        {
+            keysToRemove.push_back(std::string(strings + frames[i].nameOffset, frames[i].nameLength));
+        }
+        _spriteFrames.erase(keysToRemove);
+        _loadedFileNames->erase(plist);
+        return;
+    }
+
     ValueMap dict = FileUtils::getInstance()->getValueMapFromFile(fullPath);
     if (dict.empty())
     {
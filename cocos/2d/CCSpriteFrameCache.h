@@ -45,6 +45,7 @@ THE SOFTWARE.
 NS_CC_BEGIN
 
 class Sprite;
+class Data;
 
 /**
  * @addtogroup sprite_nodes
@@ -104,6 +105,19 @@ public:
      */
     void addSpriteFramesWithFile(const std::string&plist, Texture2D *texture);
 
+    /** Adds multiple Sprite Frames from a binary frame table (.sfb).
+     * Binary frame tables are created from plist files with tools/spriteframe-converter/plist2sfb.py.
+     * The file is read at once and no string is parsed per frame, so it loads much faster than the plist.
+     * The texture is the one stored in the table, or the file name with the suffix replaced by .png.
+     * @since v3.0
+     */
+    void addSpriteFramesWithBinaryFile(const std::string& file);
+
+    /** Adds multiple Sprite Frames from a binary frame table (.sfb). The texture will be associated with the created sprite frames.
+     * @since v3.0
+     */
+    void addSpriteFramesWithBinaryFile(const std::string& file, Texture2D *texture);
+
     /** Adds an sprite frame with a given name.
      If the name already exists, then the contents of the old name will be replaced with the new one.
      */
@@ -160,6 +174,14 @@ private:
     */
     void removeSpriteFramesFromDictionary(ValueMap& dictionary);
 
+    /** Adds multiple Sprite Frames from the content of a binary frame table.
+     * @return false if the data is not a valid binary frame table
+     */
+    bool addSpriteFramesWithBinaryData(const Data& data, Texture2D *texture);
+
+    /** Returns whether the file is a binary frame table, judging by its suffix */
+    static bool isBinaryFramesFile(const std::string& file);
+
 protected:
     Map<std::string, SpriteFrame*> _spriteFrames;
     ValueMap _spriteFramesAliases;
@@ -32,9 +32,20 @@ THE SOFTWARE.
 #include "CCGLProgram.h"
 #include "ccCArray.h"
 #include "CCDirector.h"
+#include "CCCustomCommand.h"
+#include "CCRenderer.h"
+#include "CCNotificationCenter.h"
+#include "CCEventType.h"
+#include "ccGLStateCache.h"
 
 NS_CC_BEGIN
 
+// chunk size used by the layers without a "cc_chunk_size" property, 0 means no chunks
+static int s_defaultChunkSize = 0;
+
+// the vertices of the biggest chunk must be addressable with GLushort indices
+static const int MAX_CHUNK_SIZE = 64;
+
 
 // TMXLayer - init & alloc & dealloc
 
@@ -55,6 +66,30 @@ bool TMXLayer::initWithTilesetInfo(TMXTilesetInfo *tilesetInfo, TMXLayerInfo *la
     float totalNumberOfTiles = size.width * size.height;
     float capacity = totalNumberOfTiles * 0.35f + 1; // 35 percent is occupied ?
 
+    int chunkSize = s_defaultChunkSize;
+    auto chunkSizeProperty = layerInfo->_properties.find("cc_chunk_size");
+    if (chunkSizeProperty != layerInfo->_properties.end())
+    {
+        chunkSize = chunkSizeProperty->second.asInt();
+    }
+    chunkSize = MIN(chunkSize, MAX_CHUNK_SIZE);
+
+    // the chunks are drawn one after the other, which only keeps the draw order of the
+    // tile sprites when no tile overlaps its neighbours
+    if (chunkSize > 0 && tilesetInfo
+        && (tilesetInfo->_tileSize.width > mapInfo->getTileSize().width
+            || tilesetInfo->_tileSize.height > mapInfo->getTileSize().height))
+    {
+        CCLOG("cocos2d: TMXLayer: %s has tiles bigger than the map tiles, it can't be rendered in chunks", layerInfo->_name.c_str());
+        chunkSize = 0;
+    }
+
+    // chunked layers don't keep any quad in the texture atlas
+    if (chunkSize > 0)
+    {
+        capacity = 1;
+    }
+
     Texture2D *texture = nullptr;
     if( tilesetInfo )
     {
@@ -66,7 +101,7 @@ bool TMXLayer::initWithTilesetInfo(TMXTilesetInfo *tilesetInfo, TMXLayerInfo *la
         // layerInfo
         _layerName = layerInfo->_name;
         _layerSize = size;
-        _tiles = layerInfo->_tiles;
+        _tiles = layerInfo->getTiles();
         _minGID = layerInfo->_minGID;
         _maxGID = layerInfo->_maxGID;
         _opacity = layerInfo->_opacity;
@@ -85,7 +120,11 @@ bool TMXLayer::initWithTilesetInfo(TMXTilesetInfo *tilesetInfo, TMXLayerInfo *la
         Point offset = this->calculateLayerOffset(layerInfo->_offset);
         this->setPosition(CC_POINT_PIXELS_TO_POINTS(offset));
 
-        _atlasIndexArray = ccCArrayNew((unsigned int)totalNumberOfTiles);
+        _chunkSize = MAX(chunkSize, 0);
+        if (_chunkSize == 0)
+        {
+            _atlasIndexArray = ccCArrayNew((unsigned int)totalNumberOfTiles);
+        }
 
         this->setContentSize(CC_SIZE_PIXELS_TO_POINTS(Size(_layerSize.width * _mapTileSize.width, _layerSize.height * _mapTileSize.height)));
 
@@ -112,10 +151,16 @@ TMXLayer::TMXLayer()
 ,_tiles(nullptr)
 ,_tileSet(nullptr)
 ,_layerOrientation(TMXOrientationOrtho)
+,_chunkSize(0)
+,_chunksWide(0)
+,_chunksHigh(0)
+,_chunkIndicesVBO(0)
 {}
 
 TMXLayer::~TMXLayer()
 {
+    releaseChunks();
+
     CC_SAFE_RELEASE(_tileSet);
     CC_SAFE_RELEASE(_reusedTile);
 
@@ -128,8 +173,25 @@ TMXLayer::~TMXLayer()
     CC_SAFE_DELETE_ARRAY(_tiles);
 }
 
+void TMXLayer::setDefaultChunkSize(int chunkSize)
+{
+    s_defaultChunkSize = chunkSize;
+}
+
+int TMXLayer::getDefaultChunkSize()
+{
+    return s_defaultChunkSize;
+}
+
 void TMXLayer::releaseMap()
 {
+    // chunks are built from the tiles map, it can't be released
+    if (_chunkSize > 0)
+    {
+        CCLOG("cocos2d: TMXLayer: the tiles map of a chunked layer can't be released");
+        return;
+    }
+
     if (_tiles)
     {
         delete [] _tiles;
@@ -177,7 +239,11 @@ void TMXLayer::setupTiles()
             // XXX: gid == 0 --> empty tile
             if (gid != 0) 
             {
-                this->appendTileForGID(gid, Point(x, y));
+                // chunked layers build their quads when they become visible
+                if (_chunkSize == 0)
+                {
+                    this->appendTileForGID(gid, Point(x, y));
+                }
 
                 // Optimization: update min and max GID rendered by the layer
                 _minGID = MIN(gid, _minGID);
@@ -188,6 +254,11 @@ void TMXLayer::setupTiles()
 
     CCASSERT( _maxGID >= _tileSet->_firstGid &&
         _minGID >= _tileSet->_firstGid, "TMX: Only 1 tileset per layer is supported");    
+
+    if (_chunkSize > 0)
+    {
+        setupChunks();
+    }
 }
 
 // TMXLayer - Properties
@@ -316,6 +387,14 @@ Sprite* TMXLayer::reusedTileWithRect(Rect rect)
 Sprite * TMXLayer::getTileAt(const Point& pos)
 {
     CCASSERT(pos.x < _layerSize.width && pos.y < _layerSize.height && pos.x >=0 && pos.y >=0, "TMXLayer: invalid position");
+
+    // tiles of chunked layers are not sprites
+    if (_chunkSize > 0)
+    {
+        CCLOG("cocos2d: TMXLayer: getTileAt is not supported by chunked layers");
+        return nullptr;
+    }
+
     CCASSERT(_tiles && _atlasIndexArray, "TMXLayer: the tiles map has been released");
 
     Sprite *tile = nullptr;
@@ -351,7 +430,7 @@ Sprite * TMXLayer::getTileAt(const Point& pos)
 unsigned int TMXLayer::getTileGIDAt(const Point& pos, ccTMXTileFlags* flags/* = nullptr*/)
 {
     CCASSERT(pos.x < _layerSize.width && pos.y < _layerSize.height && pos.x >=0 && pos.y >=0, "TMXLayer: invalid position");
-    CCASSERT(_tiles && _atlasIndexArray, "TMXLayer: the tiles map has been released");
+    CCASSERT(_tiles && (_atlasIndexArray || _chunkSize > 0), "TMXLayer: the tiles map has been released");
 
     int idx = (int)(pos.x + pos.y * _layerSize.width);
     // Bits on the far end of the 32-bit global tile ID are used for tile flags
@@ -491,7 +570,7 @@ void TMXLayer::setTileGID(unsigned int gid, const Point& pos)
 void TMXLayer::setTileGID(unsigned int gid, const Point& pos, ccTMXTileFlags flags)
 {
     CCASSERT(pos.x < _layerSize.width && pos.y < _layerSize.height && pos.x >=0 && pos.y >=0, "TMXLayer: invalid position");
-    CCASSERT(_tiles && _atlasIndexArray, "TMXLayer: the tiles map has been released");
+    CCASSERT(_tiles && (_atlasIndexArray || _chunkSize > 0), "TMXLayer: the tiles map has been released");
     CCASSERT(gid == 0 || gid >= _tileSet->_firstGid, "TMXLayer: invalid gid" );
 
     ccTMXTileFlags currentFlags;
@@ -501,6 +580,14 @@ void TMXLayer::setTileGID(unsigned int gid, const Point& pos, ccTMXTileFlags fla
     {
         unsigned gidAndFlags = gid | flags;
 
+        // only the chunk of the tile has to be rebuilt
+        if (_chunkSize > 0)
+        {
+            _tiles[(int)(pos.x + pos.y * _layerSize.width)] = gid ? gidAndFlags : 0;
+            setChunkDirtyAt(pos);
+            return;
+        }
+
         // setting gid=0 is equal to remove the tile
         if (gid == 0)
         {
@@ -565,6 +652,13 @@ void TMXLayer::removeChild(Node* node, bool cleanup)
 void TMXLayer::removeTileAt(const Point& pos)
 {
     CCASSERT(pos.x < _layerSize.width && pos.y < _layerSize.height && pos.x >=0 && pos.y >=0, "TMXLayer: invalid position");
+
+    if (_chunkSize > 0)
+    {
+        setTileGID(0, pos);
+        return;
+    }
+
     CCASSERT(_tiles && _atlasIndexArray, "TMXLayer: the tiles map has been released");
 
     unsigned int gid = getTileGIDAt(pos);
@@ -698,6 +792,358 @@ int TMXLayer::getVertexZForPos(const Point& pos)
     return ret;
 }
 
+// TMXLayer - chunked rendering
+void TMXLayer::setupChunks()
+{
+    _chunksWide = ((int)_layerSize.width + _chunkSize - 1) / _chunkSize;
+    _chunksHigh = ((int)_layerSize.height + _chunkSize - 1) / _chunkSize;
+
+    // the vertex buffers are created when the chunks become visible
+    TileChunk emptyChunk = { 0, 0, true };
+    _chunks.assign(_chunksWide * _chunksHigh, emptyChunk);
+
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+    NotificationCenter::getInstance()->addObserver(this,
+                                                   callfuncO_selector(TMXLayer::listenBackToForeground),
+                                                   EVNET_COME_TO_FOREGROUND,
+                                                   nullptr);
+#endif
+}
+
+void TMXLayer::setupChunkIndices()
+{
+    // all the chunks share the same indices
+    int quadsPerChunk = _chunkSize * _chunkSize;
+    std::vector<GLushort> indices(quadsPerChunk * 6);
+    for (int i = 0; i < quadsPerChunk; i++)
+    {
+        indices[i*6+0] = i*4+0;
+        indices[i*6+1] = i*4+1;
+        indices[i*6+2] = i*4+2;
+        indices[i*6+3] = i*4+3;
+        indices[i*6+4] = i*4+2;
+        indices[i*6+5] = i*4+1;
+    }
+
+    glGenBuffers(1, &_chunkIndicesVBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _chunkIndicesVBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices[0]) * indices.size(), &indices[0], GL_STATIC_DRAW);
+    CHECK_GL_ERROR_DEBUG();
+}
+
+void TMXLayer::releaseChunks()
+{
+    if (_chunkSize == 0)
+    {
+        return;
+    }
+
+    for (auto& chunk : _chunks)
+    {
+        if (chunk.vbo)
+        {
+            glDeleteBuffers(1, &chunk.vbo);
+        }
+    }
+    _chunks.clear();
+
+    if (_chunkIndicesVBO)
+    {
+        glDeleteBuffers(1, &_chunkIndicesVBO);
+        _chunkIndicesVBO = 0;
+    }
+
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+    NotificationCenter::getInstance()->removeObserver(this, EVNET_COME_TO_FOREGROUND);
+#endif
+}
+
+void TMXLayer::listenBackToForeground(Object *obj)
+{
+    // the buffers were lost with the GL context, they are rebuilt when drawn
+    for (auto& chunk : _chunks)
+    {
+        chunk.vbo = 0;
+        chunk.dirty = true;
+    }
+    _chunkIndicesVBO = 0;
+}
+
+void TMXLayer::setChunkDirtyAt(const Point& pos)
+{
+    int index = ((int)pos.y / _chunkSize) * _chunksWide + (int)pos.x / _chunkSize;
+    _chunks[index].dirty = true;
+}
+
+Point TMXLayer::getTileCoordinateForPosition(const Point& position)
+{
+    // inverse of getPositionAt, the result is not rounded
+    Point pixels = CC_POINT_POINTS_TO_PIXELS(position);
+    Point ret = Point::ZERO;
+    switch (_layerOrientation)
+    {
+    case TMXOrientationOrtho:
+        ret = Point(pixels.x / _mapTileSize.width,
+                    _layerSize.height - 1 - pixels.y / _mapTileSize.height);
+        break;
+    case TMXOrientationIso:
+        {
+            // a = x - y, b = x + y
+            float a = pixels.x * 2 / _mapTileSize.width - _layerSize.width + 1;
+            float b = _layerSize.height * 2 - 2 - pixels.y * 2 / _mapTileSize.height;
+            ret = Point((a + b) / 2, (b - a) / 2);
+        }
+        break;
+    case TMXOrientationHex:
+        ret = Point(pixels.x / (_mapTileSize.width * 3 / 4),
+                    _layerSize.height - 1 - pixels.y / _mapTileSize.height);
+        break;
+    }
+    return ret;
+}
+
+void TMXLayer::updateVisibleChunks()
+{
+    _visibleChunks.clear();
+
+    // visible area in the coordinates of the layer
+    Director* director = Director::getInstance();
+    Rect visibleRect(director->getVisibleOrigin().x, director->getVisibleOrigin().y,
+                     director->getVisibleSize().width, director->getVisibleSize().height);
+    visibleRect = RectApplyAffineTransform(visibleRect, getWorldToNodeAffineTransform());
+
+    Point corners[4] = {
+        Point(visibleRect.getMinX(), visibleRect.getMinY()),
+        Point(visibleRect.getMaxX(), visibleRect.getMinY()),
+        Point(visibleRect.getMinX(), visibleRect.getMaxY()),
+        Point(visibleRect.getMaxX(), visibleRect.getMaxY()),
+    };
+
+    Point minTile = getTileCoordinateForPosition(corners[0]);
+    Point maxTile = minTile;
+    for (int i = 1; i < 4; i++)
+    {
+        Point tile = getTileCoordinateForPosition(corners[i]);
+        minTile = Point(MIN(minTile.x, tile.x), MIN(minTile.y, tile.y));
+        maxTile = Point(MAX(maxTile.x, tile.x), MAX(maxTile.y, tile.y));
+    }
+
+    // tiles can be bigger than the map tiles and overlap their neighbours
+    float marginX = 1 + ceilf(_tileSet->_tileSize.width / _mapTileSize.width);
+    float marginY = 1 + ceilf(_tileSet->_tileSize.height / _mapTileSize.height);
+
+    int tileMinX = (int)MAX(0.0f, floorf(minTile.x - marginX));
+    int tileMinY = (int)MAX(0.0f, floorf(minTile.y - marginY));
+    int tileMaxX = (int)MIN(_layerSize.width - 1, ceilf(maxTile.x + marginX));
+    int tileMaxY = (int)MIN(_layerSize.height - 1, ceilf(maxTile.y + marginY));
+
+    int chunkMinX = tileMinX / _chunkSize;
+    int chunkMinY = tileMinY / _chunkSize;
+    int chunkMaxX = tileMaxX / _chunkSize;
+    int chunkMaxY = tileMaxY / _chunkSize;
+
+    for (int index = 0; index < (int)_chunks.size(); index++)
+    {
+        int x = index % _chunksWide;
+        int y = index / _chunksWide;
+
+        if (tileMinX <= tileMaxX && tileMinY <= tileMaxY
+            && x >= chunkMinX && x <= chunkMaxX && y >= chunkMinY && y <= chunkMaxY)
+        {
+            _visibleChunks.push_back(index);
+        }
+        // keep the buffers of the chunks around the visible area, release the others
+        else if (_chunks[index].vbo
+                 && (x < chunkMinX - 1 || x > chunkMaxX + 1 || y < chunkMinY - 1 || y > chunkMaxY + 1))
+        {
+            glDeleteBuffers(1, &_chunks[index].vbo);
+            _chunks[index].vbo = 0;
+            _chunks[index].quadCount = 0;
+            _chunks[index].dirty = true;
+        }
+    }
+}
+
+void TMXLayer::updateChunk(int chunkIndex)
+{
+    TileChunk& chunk = _chunks[chunkIndex];
+
+    int startX = (chunkIndex % _chunksWide) * _chunkSize;
+    int startY = (chunkIndex / _chunksWide) * _chunkSize;
+    int endX = MIN(startX + _chunkSize, (int)_layerSize.width);
+    int endY = MIN(startY + _chunkSize, (int)_layerSize.height);
+
+    Texture2D* texture = _textureAtlas->getTexture();
+    float atlasWidth = (float)texture->getPixelsWide();
+    float atlasHeight = (float)texture->getPixelsHigh();
+
+    _chunkQuads.clear();
+    _chunkQuads.reserve(_chunkSize * _chunkSize);
+
+    for (int y = startY; y < endY; y++)
+    {
+        for (int x = startX; x < endX; x++)
+        {
+            unsigned int gid = _tiles[x + y * (int)_layerSize.width];
+            if (gid == 0)
+            {
+                continue;
+            }
+
+            Rect rect = _tileSet->rectForGID(gid);
+
+            float left = rect.origin.x / atlasWidth;
+            float right = (rect.origin.x + rect.size.width) / atlasWidth;
+            float top = rect.origin.y / atlasHeight;
+            float bottom = (rect.origin.y + rect.size.height) / atlasHeight;
+
+            // texture coordinates shown at each corner of the tile
+            Tex2F tl(left, top);
+            Tex2F bl(left, bottom);
+            Tex2F tr(right, top);
+            Tex2F br(right, bottom);
+            float width = rect.size.width / _contentScaleFactor;
+            float height = rect.size.height / _contentScaleFactor;
+
+            // same result as the rotations and flips of setupTileSprite
+            if (gid & kTMXTileDiagonalFlag)
+            {
+                std::swap(tr, bl);
+                std::swap(width, height);
+            }
+            if (gid & kTMXTileHorizontalFlag)
+            {
+                std::swap(tl, tr);
+                std::swap(bl, br);
+            }
+            if (gid & kTMXTileVerticalFlag)
+            {
+                std::swap(tl, bl);
+                std::swap(tr, br);
+            }
+
+            Point tilePos(x, y);
+            Point origin = getPositionAt(tilePos);
+            float z = (float)getVertexZForPos(tilePos);
+
+            V3F_C4B_T2F_Quad quad;
+            quad.tl.vertices = Vertex3F(origin.x, origin.y + height, z);
+            quad.bl.vertices = Vertex3F(origin.x, origin.y, z);
+            quad.tr.vertices = Vertex3F(origin.x + width, origin.y + height, z);
+            quad.br.vertices = Vertex3F(origin.x + width, origin.y, z);
+            // the color is set for the whole layer when drawing
+            quad.tl.colors = quad.bl.colors = quad.tr.colors = quad.br.colors = Color4B::WHITE;
+            quad.tl.texCoords = tl;
+            quad.bl.texCoords = bl;
+            quad.tr.texCoords = tr;
+            quad.br.texCoords = br;
+
+            _chunkQuads.push_back(quad);
+        }
+    }
+
+    chunk.quadCount = (int)_chunkQuads.size();
+    chunk.dirty = false;
+
+    if (chunk.quadCount == 0)
+    {
+        if (chunk.vbo)
+        {
+            glDeleteBuffers(1, &chunk.vbo);
+            chunk.vbo = 0;
+        }
+        return;
+    }
+
+    if (!chunk.vbo)
+    {
+        glGenBuffers(1, &chunk.vbo);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, chunk.vbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(_chunkQuads[0]) * _chunkQuads.size(), &_chunkQuads[0], GL_STATIC_DRAW);
+    CHECK_GL_ERROR_DEBUG();
+}
+
+void TMXLayer::draw()
+{
+    if (_chunkSize == 0)
+    {
+        SpriteBatchNode::draw();
+        return;
+    }
+
+    updateVisibleChunks();
+    if (_visibleChunks.empty())
+    {
+        return;
+    }
+
+    CustomCommand* cmd = CustomCommand::getCommandPool().generateCommand();
+    cmd->init(0, _vertexZ);
+    cmd->func = CC_CALLBACK_0(TMXLayer::onDrawChunks, this);
+    Director::getInstance()->getRenderer()->addCommand(cmd);
+}
+
+void TMXLayer::onDrawChunks()
+{
+    CC_NODE_DRAW_SETUP();
+
+    GL::blendFunc(_blendFunc.src, _blendFunc.dst);
+    GL::bindTexture2D(_textureAtlas->getTexture()->getName());
+    GL::bindVAO(0);
+    GL::enableVertexAttribs(GL::VERTEX_ATTRIB_FLAG_POSITION | GL::VERTEX_ATTRIB_FLAG_TEX_COORDS);
+
+    // same color as the tile sprites get from the layer, passed as a constant attribute
+    // so that fading or tinting the layer doesn't rebuild the chunks
+    Color3B color = _cascadeColorEnabled ? _displayedColor : Color3B::WHITE;
+    float opacity = _opacity / 255.0f;
+    if (_cascadeOpacityEnabled)
+    {
+        opacity *= _displayedOpacity / 255.0f;
+    }
+    float premultiply = _textureAtlas->getTexture()->hasPremultipliedAlpha() ? opacity : 1.0f;
+    glVertexAttrib4f(GLProgram::VERTEX_ATTRIB_COLOR,
+                     color.r / 255.0f * premultiply,
+                     color.g / 255.0f * premultiply,
+                     color.b / 255.0f * premultiply,
+                     opacity);
+
+    if (!_chunkIndicesVBO)
+    {
+        setupChunkIndices();
+    }
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _chunkIndicesVBO);
+
+#define kQuadSize sizeof(V3F_C4B_T2F)
+    int draws = 0;
+    for (const auto index : _visibleChunks)
+    {
+        if (_chunks[index].dirty)
+        {
+            updateChunk(index);
+        }
+
+        const TileChunk& chunk = _chunks[index];
+        if (chunk.quadCount == 0)
+        {
+            continue;
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, chunk.vbo);
+        glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, kQuadSize, (GLvoid*) offsetof(V3F_C4B_T2F, vertices));
+        glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORDS, 2, GL_FLOAT, GL_FALSE, kQuadSize, (GLvoid*) offsetof(V3F_C4B_T2F, texCoords));
+        glDrawElements(GL_TRIANGLES, (GLsizei)chunk.quadCount * 6, GL_UNSIGNED_SHORT, (GLvoid*)0);
+        draws++;
+    }
+#undef kQuadSize
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    CC_INCREMENT_GL_DRAWS(draws);
+    CHECK_GL_ERROR_DEBUG();
+}
+
 std::string TMXLayer::getDescription() const
 {
     return StringUtils::format("<TMXLayer | tag = %d, size = %d,%d>", _tag, (int)_mapTileSize.width, (int)_mapTileSize.height);
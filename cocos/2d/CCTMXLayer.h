@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "CCSpriteBatchNode.h"
 #include "CCTMXXMLParser.h"
 #include "ccCArray.h"
+#include <vector>
 NS_CC_BEGIN
 
 class TMXMapInfo;
@@ -66,6 +67,14 @@ For further information, please see the programming guide:
 
 http://www.cocos2d-iphone.org/wiki/doku.php/prog_guide:tiled_maps
 
+Big layers can be rendered in chunks instead: if the layer contains a property named "cc_chunk_size" with a positive integer
+(or TMXLayer::setDefaultChunkSize() was called before loading the map), only the GID array is kept in memory.
+The layer is split in chunks of chunkSize x chunkSize tiles, each one with its own vertex buffer, and only the chunks
+inside the visible area are built and drawn. setTileGID() and removeTileAt() rebuild the chunk of the tile only.
+In this mode the tiles can't be accessed as Sprite objects, getTileAt() returns nullptr.
+The chunks are drawn one after the other, so a layer whose tileset tiles are bigger than the map tiles
+is always rendered with sprites: its tiles overlap their neighbours and the draw order would change.
+
 @since v0.8.1
 Tiles can have tile flags for additional properties. At the moment only flip horizontal and flip vertical are used. These bit flags are defined in TMXXMLParser.h.
 
@@ -143,6 +152,18 @@ public:
     /** Creates the tiles */
     void setupTiles();
 
+    /** Sets the chunk size (in tiles) used by the layers that don't have a "cc_chunk_size" property.
+     0, the default value, renders those layers with a TextureAtlas.
+     @since v3.0
+     */
+    static void setDefaultChunkSize(int chunkSize);
+    static int getDefaultChunkSize();
+
+    /** chunk size in tiles, 0 if the layer is not rendered in chunks
+     @since v3.0
+     */
+    inline int getChunkSize() const { return _chunkSize; };
+
     inline const std::string& getLayerName(){ return _layerName; }
     inline void setLayerName(const std::string& layerName){ _layerName = layerName; }
 
@@ -189,8 +210,15 @@ public:
     virtual void addChild(Node * child, int zOrder, int tag) override;
     // super method
     void removeChild(Node* child, bool cleanup) override;
+    virtual void draw() override;
     virtual std::string getDescription() const override;
 
+    /** listen the event that coming to foreground on Android
+     * @js NA
+     * @lua NA
+     */
+    void listenBackToForeground(Object *obj);
+
 private:
     Point getPositionForIsoAt(const Point& pos);
     Point getPositionForOrthoAt(const Point& pos);
@@ -212,6 +240,16 @@ private:
     // index
     ssize_t atlasIndexForExistantZ(unsigned int z);
     ssize_t atlasIndexForNewZ(int z);
+
+    /* chunked rendering */
+    void setupChunks();
+    void setupChunkIndices();
+    void releaseChunks();
+    void setChunkDirtyAt(const Point& pos);
+    void updateVisibleChunks();
+    void updateChunk(int chunkIndex);
+    Point getTileCoordinateForPosition(const Point& position);
+    void onDrawChunks();
     
 protected:
     //! name of the layer
@@ -245,6 +283,25 @@ protected:
     unsigned int _layerOrientation;
     /** properties from the layer. They can be added using Tiled */
     ValueMap _properties;
+
+    /** a block of chunkSize x chunkSize tiles with its own vertex buffer */
+    struct TileChunk
+    {
+        GLuint vbo;
+        int quadCount;
+        bool dirty;
+    };
+
+    int _chunkSize;
+    int _chunksWide;
+    int _chunksHigh;
+    std::vector<TileChunk> _chunks;
+    //! chunks to be drawn this frame
+    std::vector<int> _visibleChunks;
+    //! indices shared by all the chunks
+    GLuint _chunkIndicesVBO;
+    //! scratch buffer used to build the quads of a chunk
+    std::vector<V3F_C4B_T2F_Quad> _chunkQuads;
 };
 
 // end of tilemap_parallax_nodes group
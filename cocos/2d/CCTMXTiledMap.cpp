@@ -114,7 +114,9 @@ TMXTilesetInfo * TMXTiledMap::tilesetForLayer(TMXLayerInfo *layerInfo, TMXMapInf
 {
     Size size = layerInfo->_layerSize;
     auto& tilesets = mapInfo->getTilesets();
-    if (tilesets.size()>0)
+    // decodes the layer data if the map was parsed with lazy or background decoding
+    unsigned int* tiles = layerInfo->getTiles();
+    if (tiles && tilesets.size()>0)
     {
         TMXTilesetInfo* tileset = nullptr;
         for (auto iter = tilesets.crbegin(); iter != tilesets.crend(); ++iter)
@@ -127,7 +129,7 @@ TMXTilesetInfo * TMXTiledMap::tilesetForLayer(TMXLayerInfo *layerInfo, TMXMapInf
                     for( unsigned int x=0; x < size.width; x++ ) 
                     {
                         unsigned int pos = (unsigned int)(x + size.width * y);
-                        unsigned int gid = layerInfo->_tiles[ pos ];
+                        unsigned int gid = tiles[ pos ];
 
                         // gid are stored in little endian.
                         // if host is big endian, then swap
@@ -38,6 +38,35 @@ using namespace std;
 
 NS_CC_BEGIN
 
+static TMXMapInfo::LayerDecoding s_layerDecoding = TMXMapInfo::LayerDecoding::IMMEDIATE;
+static bool s_layerCacheEnabled = false;
+
+// decoded layer cache file header
+static const char TMX_LAYER_CACHE_MAGIC[4] = { 'C', 'C', 'T', 'L' };
+static const unsigned int TMX_LAYER_CACHE_VERSION = 1;
+
+struct TMXLayerCacheHeader
+{
+    char magic[4];
+    unsigned int version;
+    unsigned int width;
+    unsigned int height;
+    unsigned int dataHash;
+    unsigned int dataLength;
+};
+
+// FNV-1a
+static unsigned int hashString(const std::string& str)
+{
+    unsigned int hash = 2166136261u;
+    for (const auto& c : str)
+    {
+        hash ^= (unsigned char)c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
 // implementation TMXLayerInfo
 TMXLayerInfo::TMXLayerInfo()
 : _name("")
@@ -46,12 +75,17 @@ TMXLayerInfo::TMXLayerInfo()
 , _minGID(100000)
 , _maxGID(0)        
 , _offset(Point::ZERO)
+, _encodedAttribs(0)
 {
 }
 
 TMXLayerInfo::~TMXLayerInfo()
 {
     CCLOGINFO("deallocing TMXLayerInfo: %p", this);
+    if (_decodeFuture.valid())
+    {
+        _decodeFuture.wait();
+    }
     if( _ownTiles && _tiles )
     {
         free(_tiles);
@@ -68,6 +102,166 @@ void TMXLayerInfo::setProperties(ValueMap var)
     _properties = var;
 }
 
+unsigned int* TMXLayerInfo::getTiles()
+{
+    // waits for a background decoding in flight, or decodes the layer now
+    decodeTiles();
+    return _tiles;
+}
+
+bool TMXLayerInfo::isDecodePending()
+{
+    std::lock_guard<std::mutex> lock(_decodeMutex);
+    return !_encodedData.empty();
+}
+
+void TMXLayerInfo::decodeTilesAsync()
+{
+    if (_decodeFuture.valid() || !isDecodePending())
+        return;
+
+    _decodeFuture = std::async(std::launch::async, [this](){
+        decodeTiles();
+    });
+}
+
+bool TMXLayerInfo::decodeTiles()
+{
+    std::lock_guard<std::mutex> lock(_decodeMutex);
+
+    if (_encodedData.empty())
+        return _tiles != nullptr;
+
+    unsigned int dataHash = 0;
+    if (!_cacheFile.empty())
+    {
+        dataHash = hashString(_encodedData);
+        if (loadCachedTiles(dataHash))
+        {
+            std::string().swap(_encodedData);
+            return true;
+        }
+    }
+
+    bool ret = false;
+    unsigned char *buffer = nullptr;
+
+    do
+    {
+        ssize_t len = base64Decode((unsigned char*)_encodedData.c_str(), (unsigned int)_encodedData.length(), &buffer);
+        if( ! buffer )
+        {
+            CCLOG("cocos2d: TiledMap: decode data error");
+            break;
+        }
+
+        if( _encodedAttribs & (TMXLayerAttribGzip | TMXLayerAttribZlib) )
+        {
+            unsigned char *deflated = nullptr;
+            Size s = _layerSize;
+            ssize_t sizeHint = s.width * s.height * sizeof(unsigned int);
+
+            ssize_t CC_UNUSED inflatedLen = ZipUtils::inflateMemoryWithHint(buffer, len, &deflated, sizeHint);
+            CCASSERT(inflatedLen == sizeHint, "");
+
+            free(buffer);
+            buffer = nullptr;
+
+            if( ! deflated )
+            {
+                CCLOG("cocos2d: TiledMap: inflate data error");
+                break;
+            }
+
+            _tiles = (unsigned int*) deflated;
+        }
+        else
+        {
+            _tiles = (unsigned int*) buffer;
+        }
+
+        if (!_cacheFile.empty())
+        {
+            saveCachedTiles(dataHash);
+        }
+
+        ret = true;
+    } while (0);
+
+    std::string().swap(_encodedData);
+    return ret;
+}
+
+bool TMXLayerInfo::loadCachedTiles(unsigned int dataHash)
+{
+    // may run on the decoding thread: the cache path is absolute and resolved while parsing,
+    // so it's read with stdio instead of FileUtils whose path cache isn't thread safe
+    FILE* fp = fopen(_cacheFile.c_str(), "rb");
+    if (!fp)
+        return false;
+
+    unsigned int width = (unsigned int)_layerSize.width;
+    unsigned int height = (unsigned int)_layerSize.height;
+    ssize_t tilesSize = width * height * sizeof(unsigned int);
+
+    TMXLayerCacheHeader header;
+    bool valid = fread(&header, sizeof(header), 1, fp) == 1
+        && memcmp(header.magic, TMX_LAYER_CACHE_MAGIC, sizeof(header.magic)) == 0
+        && header.version == TMX_LAYER_CACHE_VERSION
+        && header.width == width
+        && header.height == height
+        && header.dataHash == dataHash
+        && header.dataLength == (unsigned int)_encodedData.length();
+
+    unsigned int* tiles = nullptr;
+    if (valid)
+    {
+        tiles = (unsigned int*)malloc(tilesSize);
+        // the file must end right after the tiles
+        valid = tiles
+            && fread(tiles, 1, tilesSize, fp) == (size_t)tilesSize
+            && fgetc(fp) == EOF;
+    }
+    fclose(fp);
+
+    if (!valid)
+    {
+        free(tiles);
+        return false;
+    }
+
+    _tiles = tiles;
+    return true;
+}
+
+void TMXLayerInfo::saveCachedTiles(unsigned int dataHash)
+{
+    TMXLayerCacheHeader header;
+    memcpy(header.magic, TMX_LAYER_CACHE_MAGIC, sizeof(header.magic));
+    header.version = TMX_LAYER_CACHE_VERSION;
+    header.width = (unsigned int)_layerSize.width;
+    header.height = (unsigned int)_layerSize.height;
+    header.dataHash = dataHash;
+    header.dataLength = (unsigned int)_encodedData.length();
+
+    FILE* fp = fopen(_cacheFile.c_str(), "wb");
+    if (!fp)
+    {
+        CCLOG("cocos2d: TiledMap: can't write the layer cache %s", _cacheFile.c_str());
+        return;
+    }
+
+    size_t tilesCount = header.width * header.height;
+    bool ok = fwrite(&header, sizeof(header), 1, fp) == 1
+        && fwrite(_tiles, sizeof(unsigned int), tilesCount, fp) == tilesCount;
+    fclose(fp);
+
+    if (!ok)
+    {
+        remove(_cacheFile.c_str());
+    }
+}
+
 // implementation TMXTilesetInfo
 TMXTilesetInfo::TMXTilesetInfo()
     :_firstGid(0)
@@ -98,6 +292,26 @@ Rect TMXTilesetInfo::rectForGID(unsigned int gid)
 
 // implementation TMXMapInfo
 
+void TMXMapInfo::setLayerDecoding(LayerDecoding decoding)
+{
+    s_layerDecoding = decoding;
+}
+
+TMXMapInfo::LayerDecoding TMXMapInfo::getLayerDecoding()
+{
+    return s_layerDecoding;
+}
+
+void TMXMapInfo::setLayerCacheEnabled(bool enabled)
+{
+    s_layerCacheEnabled = enabled;
+}
+
+bool TMXMapInfo::isLayerCacheEnabled()
+{
+    return s_layerCacheEnabled;
+}
+
 TMXMapInfo * TMXMapInfo::create(const std::string& tmxFile)
 {
     TMXMapInfo *ret = new TMXMapInfo();
@@ -142,6 +356,7 @@ void TMXMapInfo::internalInit(const std::string& tmxFileName, const std::string&
     _layerAttribs = TMXLayerAttribNone;
     _parentElement = TMXPropertyNone;
     _currentFirstGID = 0;
+    _layerDecoding = s_layerDecoding;
 }
 bool TMXMapInfo::initWithXML(const std::string& tmxString, const std::string& resourcePath)
 {
@@ -161,6 +376,7 @@ TMXMapInfo::TMXMapInfo()
 , _layerAttribs(0)
 , _storingCharacters(false)
 , _currentFirstGID(0)
+, _layerDecoding(LayerDecoding::IMMEDIATE)
 {
 }
 
@@ -640,8 +856,6 @@ void TMXMapInfo::endElement(void *ctx, const char *name)
     TMXMapInfo *tmxMapInfo = this;
     std::string elementName = (char*)name;
 
-    int len = 0;
-
     if(elementName == "data")
     {
         if (tmxMapInfo->getLayerAttribs() & TMXLayerAttribBase64)
@@ -649,42 +863,23 @@ void TMXMapInfo::endElement(void *ctx, const char *name)
             tmxMapInfo->setStoringCharacters(false);
             
             TMXLayerInfo* layer = tmxMapInfo->getLayers().back();
-            
-            std::string currentString = tmxMapInfo->getCurrentString();
-            unsigned char *buffer;
-            len = base64Decode((unsigned char*)currentString.c_str(), (unsigned int)currentString.length(), &buffer);
-            if( ! buffer )
+
+            // keep the layer data encoded, it is decoded when the layer is used
+            layer->_encodedData.swap(_currentString);
+            layer->_encodedAttribs = tmxMapInfo->getLayerAttribs();
+
+            if (s_layerCacheEnabled && !_TMXFileName.empty())
             {
-                CCLOG("cocos2d: TiledMap: decode data error");
-                return;
+                char suffix[32];
+                snprintf(suffix, sizeof(suffix), "_%08x_%u.tmxl", hashString(_TMXFileName), (unsigned int)(_layers.size() - 1));
+                layer->_cacheFile = FileUtils::getInstance()->getWritablePath() + "tmxcache" + suffix;
             }
-            
-            if( tmxMapInfo->getLayerAttribs() & (TMXLayerAttribGzip | TMXLayerAttribZlib) )
-            {
-                unsigned char *deflated = nullptr;
-                Size s = layer->_layerSize;
-                // int sizeHint = s.width * s.height * sizeof(uint32_t);
-                ssize_t sizeHint = s.width * s.height * sizeof(unsigned int);
-                
-                ssize_t CC_UNUSED inflatedLen = ZipUtils::inflateMemoryWithHint(buffer, len, &deflated, sizeHint);
-                CCASSERT(inflatedLen == sizeHint, "");
-                
-                free(buffer);
-                buffer = nullptr;
-                
-                if( ! deflated )
-                {
-                    CCLOG("cocos2d: TiledMap: inflate data error");
-                    return;
-                }
-                
-                layer->_tiles = (unsigned int*) deflated;
-            }
-            else
+
+            if (_layerDecoding == LayerDecoding::IMMEDIATE)
             {
-                layer->_tiles = (unsigned int*) buffer;
+                layer->decodeTiles();
             }
-            
+
             tmxMapInfo->setCurrentString("");
         }
         else if (tmxMapInfo->getLayerAttribs() & TMXLayerAttribNone)
@@ -705,6 +900,18 @@ void TMXMapInfo::endElement(void *ctx, const char *name)
     {
         // The map element has ended
         tmxMapInfo->setParentElement(TMXPropertyNone);
+
+        if (_layerDecoding == LayerDecoding::BACKGROUND)
+        {
+            // hidden layers won't create a TMXLayer, leave them encoded
+            for (const auto& layer : _layers)
+            {
+                if (layer->_visible)
+                {
+                    layer->decodeTilesAsync();
+                }
+            }
+        }
     }    
     else if (elementName == "layer")
     {
@@ -727,13 +934,11 @@ void TMXMapInfo::textHandler(void *ctx, const char *ch, int len)
 {
     CC_UNUSED_PARAM(ctx);
     TMXMapInfo *tmxMapInfo = this;
-    std::string text((char*)ch,0,len);
 
     if (tmxMapInfo->isStoringCharacters())
     {
-        std::string currentString = tmxMapInfo->getCurrentString();
-        currentString += text;
-        tmxMapInfo->setCurrentString(currentString.c_str());
+        // append in place, large layers are delivered in many chunks
+        _currentString.append(ch, len);
     }
 }
 
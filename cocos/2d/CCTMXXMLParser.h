@@ -34,6 +34,8 @@ THE SOFTWARE.
 #include "CCVector.h"
 #include "CCValue.h"
 #include <string>
+#include <mutex>
+#include <future>
 
 NS_CC_BEGIN
 
@@ -104,6 +106,22 @@ public:
     void setProperties(ValueMap properties);
     ValueMap getProperties();
 
+    /** Returns the tile GIDs of the layer.
+     If the layer data was not decoded while parsing, it is decoded (or loaded from the layer cache) now.
+     Returns nullptr if the layer data could not be decoded.
+     @since v3.0
+     */
+    unsigned int* getTiles();
+    /** Returns true if the layer still holds its encoded data and the tiles have not been decoded yet.
+     @since v3.0
+     */
+    bool isDecodePending();
+    /** Starts decoding the pending layer data on a background thread.
+     getTiles() waits for it if the decoding is still in flight.
+     @since v3.0
+     */
+    void decodeTilesAsync();
+
     ValueMap           _properties;
     std::string         _name;
     Size                _layerSize;
@@ -114,6 +132,22 @@ public:
     unsigned int        _minGID;
     unsigned int        _maxGID;
     Point               _offset;
+
+protected:
+    bool decodeTiles();
+    bool loadCachedTiles(unsigned int dataHash);
+    void saveCachedTiles(unsigned int dataHash);
+
+    friend class TMXMapInfo;
+
+    //! base64 layer data waiting to be decoded
+    std::string         _encodedData;
+    //! TMXLayerAttrib flags of the encoded data
+    int                 _encodedAttribs;
+    //! absolute path of the decoded layer cache file, empty if the cache is not used
+    std::string         _cacheFile;
+    std::mutex          _decodeMutex;
+    std::future<void>   _decodeFuture;
 };
 
 /** @brief TMXTilesetInfo contains the information about the tilesets like:
@@ -167,6 +201,34 @@ This information is obtained from the TMX file.
 class CC_DLL TMXMapInfo : public Object, public SAXDelegator
 {    
 public:    
+    /** How the base64 tile data of the layers is decoded
+     @since v3.0
+     */
+    enum class LayerDecoding
+    {
+        /** decoded by the parser as soon as the layer data is read (default) */
+        IMMEDIATE,
+        /** kept encoded until the layer tiles are first used */
+        LAZY,
+        /** decoded on background threads once the whole map has been parsed */
+        BACKGROUND,
+    };
+
+    /** sets how the layers of the maps parsed from now on are decoded. Default is LayerDecoding::IMMEDIATE
+     @since v3.0
+     */
+    static void setLayerDecoding(LayerDecoding decoding);
+    static LayerDecoding getLayerDecoding();
+
+    /** Enables the decoded layer cache.
+     The decoded tiles of every base64 layer are stored in a binary file in the writable path,
+     and the next time the same layer data is parsed the tiles are read back from it instead of
+     being decoded and inflated again. Disabled by default.
+     @since v3.0
+     */
+    static void setLayerCacheEnabled(bool enabled);
+    static bool isLayerCacheEnabled();
+
     /** creates a TMX Format with a tmx file */
     static TMXMapInfo * create(const std::string& tmxFile);
     /** creates a TMX Format with an XML string and a TMX resource path */
@@ -313,6 +375,8 @@ protected:
     //! tile properties
     ValueMapIntKey _tileProperties;
     unsigned int _currentFirstGID;
+    //! layer decoding used by this map, sampled when the parsing starts
+    LayerDecoding _layerDecoding;
 };
 
 // end of tilemap_parallax_nodes group
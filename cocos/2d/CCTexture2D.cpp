@@ -546,6 +546,30 @@ bool Texture2D::initWithData(const void *data, ssize_t dataLen, Texture2D::Pixel
 
 }
 
+bool Texture2D::updateWithData(const void *data, int offsetX, int offsetY, int width, int height)
+{
+    if (_name == 0)
+    {
+        return false;
+    }
+
+    CCASSERT(offsetX >= 0 && offsetY >= 0 && offsetX + width <= (int)_pixelsWide && offsetY + height <= (int)_pixelsHigh, "Invalid rect");
+
+    const PixelFormatInfo& info = _pixelFormatInfoTables.at(_pixelFormat);
+    if (info.compressed)
+    {
+        CCLOG("cocos2d: WARNING: compressed textures can't be updated");
+        return false;
+    }
+
+    GL::bindTexture2D(_name);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, offsetX, offsetY, width, height, info.format, info.type, data);
+
+    CHECK_GL_ERROR_DEBUG();
+    return true;
+}
+
 bool Texture2D::initWithMipmaps(MipmapInfo* mipmaps, int mipmapsNum, PixelFormat pixelFormat, int pixelsWide, int pixelsHigh)
 {
     //the pixelFormat must be a certain value 
@@ -222,6 +222,14 @@ public:
     /** Initializes with mipmaps */
     bool initWithMipmaps(MipmapInfo* mipmaps, int mipmapsNum, Texture2D::PixelFormat pixelFormat, int pixelsWide, int pixelsHigh);
 
+    /** Updates a rectangle of an initialized, uncompressed texture with glTexSubImage2D.
+     The data must be tightly packed and use the pixel format of the texture.
+     * @js NA
+     * @lua NA
+     * @since v3.0
+     */
+    bool updateWithData(const void *data, int offsetX, int offsetY, int width, int height);
+
     /**
     Drawing extensions to make it easy to draw basic quads using a Texture2D object.
     These functions require GL_TEXTURE_2D and both GL_VERTEX_ARRAY and GL_TEXTURE_COORD_ARRAY client states to be enabled.
@@ -31,6 +31,12 @@
 #include "platform/CCFileUtils.h"
 #include "unzip.h"
 #include <map>
+#include <mutex>
+
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_WIN32)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 NS_CC_BEGIN
 
@@ -483,22 +489,221 @@ void ZipUtils::setPvrEncryptionKey(unsigned int keyPart1, unsigned int keyPart2,
 // from unzip.cpp
 #define UNZ_MAXFILENAMEINZIP 256
 
+// zip format records, see APPNOTE.TXT
+#define ZIP_LOCAL_HEADER_SIGNATURE      0x04034b50
+#define ZIP_LOCAL_HEADER_SIZE           30
+#define ZIP_CENTRAL_HEADER_SIGNATURE    0x02014b50
+#define ZIP_CENTRAL_HEADER_SIZE         46
+#define ZIP_END_OF_CENTRAL_SIGNATURE    0x06054b50
+#define ZIP_END_OF_CENTRAL_SIZE         22
+#define ZIP_MAX_COMMENT_SIZE            0xffff
+#define ZIP_METHOD_STORED               0
+#define ZIP_METHOD_DEFLATED             8
+
 struct ZipEntryInfo
 {
     unz_file_pos pos;
     uLong uncompressed_size;
 };
 
+struct PackEntryInfo
+{
+    ssize_t offset;             // offset of the entry data in the mapped archive
+    uLong compressed_size;
+    uLong uncompressed_size;
+    unsigned short method;
+};
+
 class ZipFilePrivate
 {
 public:
+    ZipFilePrivate()
+    : zipFile(nullptr)
+    , mode(ZipFile::Mode::UNZIP)
+    , packData(nullptr)
+    , packSize(0)
+    , packMapped(false)
+    {
+    }
+
+    bool openPack(const std::string &path);
+    void closePack();
+    bool buildPackIndex(const std::string &filter);
+
     unzFile zipFile;
+    // minizip keeps the current file in zipFile, serialize the readers
+    std::mutex zipFileMutex;
     
     // std::unordered_map is faster if available on the platform
     typedef std::unordered_map<std::string, struct ZipEntryInfo> FileListContainer;
     FileListContainer fileList;
+
+    ZipFile::Mode mode;
+
+    // whole archive, mmap()ed or read into memory in Mode::PACK
+    unsigned char *packData;
+    ssize_t packSize;
+    bool packMapped;
+
+    typedef std::unordered_map<std::string, PackEntryInfo> PackListContainer;
+    PackListContainer packList;
 };
 
+static inline unsigned short readLE16(const unsigned char *p)
+{
+    return (unsigned short)(p[0] | (p[1] << 8));
+}
+
+static inline unsigned int readLE32(const unsigned char *p)
+{
+    return (unsigned int)p[0] | ((unsigned int)p[1] << 8) | ((unsigned int)p[2] << 16) | ((unsigned int)p[3] << 24);
+}
+
+bool ZipFilePrivate::openPack(const std::string &path)
+{
+    FILE *fp = fopen(path.c_str(), "rb");
+    if (!fp)
+        return false;
+
+    fseek(fp, 0, SEEK_END);
+    long length = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    if (length < ZIP_END_OF_CENTRAL_SIZE)
+    {
+        fclose(fp);
+        return false;
+    }
+
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_WIN32)
+    void *mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fileno(fp), 0);
+    if (mapped != MAP_FAILED)
+    {
+        packData = static_cast<unsigned char*>(mapped);
+        packMapped = true;
+    }
+#endif
+
+    if (!packData)
+    {
+        // mapping is not available, keep the whole archive in memory instead
+        packData = static_cast<unsigned char*>(malloc(length));
+        if (packData && fread(packData, 1, length, fp) != (size_t)length)
+        {
+            free(packData);
+            packData = nullptr;
+        }
+    }
+    fclose(fp);
+
+    if (!packData)
+        return false;
+
+    packSize = length;
+    return true;
+}
+
+void ZipFilePrivate::closePack()
+{
+    if (packData)
+    {
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_WIN32)
+        if (packMapped)
+            ::munmap(packData, packSize);
+        else
+#endif
+            free(packData);
+    }
+    packData = nullptr;
+    packSize = 0;
+    packMapped = false;
+    packList.clear();
+}
+
+bool ZipFilePrivate::buildPackIndex(const std::string &filter)
+{
+    packList.clear();
+
+    // locate the end of central directory record, it's followed by an optional comment
+    const unsigned char *eocd = nullptr;
+    ssize_t minOffset = std::max<ssize_t>(0, packSize - ZIP_END_OF_CENTRAL_SIZE - ZIP_MAX_COMMENT_SIZE);
+    for (ssize_t offset = packSize - ZIP_END_OF_CENTRAL_SIZE; offset >= minOffset; --offset)
+    {
+        if (readLE32(packData + offset) == ZIP_END_OF_CENTRAL_SIGNATURE)
+        {
+            eocd = packData + offset;
+            break;
+        }
+    }
+    if (!eocd)
+        return false;
+
+    // spanned archives are not supported
+    if (readLE16(eocd + 4) != 0 || readLE16(eocd + 6) != 0)
+        return false;
+
+    unsigned short entries = readLE16(eocd + 10);
+    ssize_t directoryOffset = readLE32(eocd + 16);
+    // zip64 archives store 0xffffffff here
+    if (directoryOffset >= packSize)
+        return false;
+
+    packList.reserve(entries);
+
+    const unsigned char *end = packData + packSize;
+    const unsigned char *p = packData + directoryOffset;
+    for (unsigned short i = 0; i < entries; ++i)
+    {
+        if (p + ZIP_CENTRAL_HEADER_SIZE > end || readLE32(p) != ZIP_CENTRAL_HEADER_SIGNATURE)
+            return false;
+
+        unsigned short flags = readLE16(p + 8);
+        unsigned short method = readLE16(p + 10);
+        uLong compressedSize = readLE32(p + 20);
+        uLong uncompressedSize = readLE32(p + 24);
+        unsigned short nameLength = readLE16(p + 28);
+        unsigned short extraLength = readLE16(p + 30);
+        unsigned short commentLength = readLE16(p + 32);
+        ssize_t localOffset = readLE32(p + 42);
+
+        const char *name = reinterpret_cast<const char*>(p + ZIP_CENTRAL_HEADER_SIZE);
+        p += ZIP_CENTRAL_HEADER_SIZE + nameLength + extraLength + commentLength;
+        if (p > end)
+            return false;
+
+        // encrypted entries and unknown compression methods are not indexed
+        if ((flags & 1) || (method != ZIP_METHOD_STORED && method != ZIP_METHOD_DEFLATED))
+            continue;
+
+        // stored entries are copied or used in place, their sizes must agree
+        if (method == ZIP_METHOD_STORED && compressedSize != uncompressedSize)
+            continue;
+
+        if (!filter.empty()
+            && (nameLength < filter.length() || filter.compare(0, filter.length(), name, filter.length()) != 0))
+            continue;
+
+        // the local header may have a different extra field, data starts right after it
+        if (localOffset + ZIP_LOCAL_HEADER_SIZE > packSize)
+            continue;
+        const unsigned char *local = packData + localOffset;
+        if (readLE32(local) != ZIP_LOCAL_HEADER_SIGNATURE)
+            continue;
+
+        PackEntryInfo entry;
+        entry.offset = localOffset + ZIP_LOCAL_HEADER_SIZE + readLE16(local + 26) + readLE16(local + 28);
+        entry.compressed_size = compressedSize;
+        entry.uncompressed_size = uncompressedSize;
+        entry.method = method;
+        if (entry.offset + (ssize_t)compressedSize > packSize)
+            continue;
+
+        packList[std::string(name, nameLength)] = entry;
+    }
+
+    return true;
+}
+
 ZipFile::ZipFile(const std::string &zipFile, const std::string &filter)
 : _data(new ZipFilePrivate)
 {
@@ -506,22 +711,57 @@ ZipFile::ZipFile(const std::string &zipFile, const std::string &filter)
     setFilter(filter);
 }
 
+ZipFile::ZipFile(const std::string &zipFile, const std::string &filter, Mode mode)
+: _data(new ZipFilePrivate)
+{
+    if (mode == Mode::PACK && _data->openPack(zipFile))
+    {
+        if (_data->buildPackIndex(filter))
+        {
+            _data->mode = Mode::PACK;
+            return;
+        }
+
+        CCLOG("ZipFile: %s can't be opened as a pack file, fall back to unzip", zipFile.c_str());
+        _data->closePack();
+    }
+
+    _data->zipFile = unzOpen(zipFile.c_str());
+    setFilter(filter);
+}
+
 ZipFile::~ZipFile()
 {
     if (_data && _data->zipFile)
     {
         unzClose(_data->zipFile);
     }
+    if (_data)
+    {
+        _data->closePack();
+    }
 
     CC_SAFE_DELETE(_data);
 }
 
+ZipFile::Mode ZipFile::getMode() const
+{
+    return _data->mode;
+}
+
 bool ZipFile::setFilter(const std::string &filter)
 {
     bool ret = false;
     do
     {
         CC_BREAK_IF(!_data);
+
+        if (_data->mode == Mode::PACK)
+        {
+            ret = _data->buildPackIndex(filter) && !_data->packList.empty();
+            break;
+        }
+
         CC_BREAK_IF(!_data->zipFile);
         
         // clear existing file list
@@ -568,6 +808,12 @@ bool ZipFile::fileExists(const std::string &fileName) const
     do
     {
         CC_BREAK_IF(!_data);
+
+        if (_data->mode == Mode::PACK)
+        {
+            ret = _data->packList.find(fileName) != _data->packList.end();
+            break;
+        }
         
         ret = _data->fileList.find(fileName) != _data->fileList.end();
     } while(false);
@@ -581,6 +827,61 @@ unsigned char *ZipFile::getFileData(const std::string &fileName, ssize_t *size)
     if (size)
         *size = 0;
 
+    if (_data->mode == Mode::PACK)
+    {
+        do
+        {
+            CC_BREAK_IF(fileName.empty());
+
+            ZipFilePrivate::PackListContainer::const_iterator it = _data->packList.find(fileName);
+            CC_BREAK_IF(it == _data->packList.end());
+
+            const PackEntryInfo &entry = it->second;
+            const unsigned char *source = _data->packData + entry.offset;
+
+            // malloc(0) may return nullptr, keep a valid pointer for empty files
+            buffer = (unsigned char*)malloc(std::max<uLong>(entry.uncompressed_size, 1));
+            CC_BREAK_IF(!buffer);
+
+            if (entry.method == ZIP_METHOD_STORED)
+            {
+                memcpy(buffer, source, entry.uncompressed_size);
+            }
+            else
+            {
+                // raw deflate stream, every call has its own z_stream so readers don't block each other
+                z_stream stream;
+                memset(&stream, 0, sizeof(stream));
+                stream.next_in = const_cast<Bytef*>(source);
+                stream.avail_in = static_cast<uInt>(entry.compressed_size);
+                stream.next_out = buffer;
+                stream.avail_out = static_cast<uInt>(entry.uncompressed_size);
+
+                int err = inflateInit2(&stream, -MAX_WBITS);
+                if (err == Z_OK)
+                {
+                    err = inflate(&stream, Z_FINISH);
+                    inflateEnd(&stream);
+                }
+
+                if (err != Z_STREAM_END || stream.total_out != entry.uncompressed_size)
+                {
+                    CCLOG("ZipFile: failed to inflate %s", fileName.c_str());
+                    free(buffer);
+                    buffer = nullptr;
+                    break;
+                }
+            }
+
+            if (size)
+            {
+                *size = entry.uncompressed_size;
+            }
+        } while (0);
+
+        return buffer;
+    }
+
     do
     {
         CC_BREAK_IF(!_data->zipFile);
@@ -590,6 +891,8 @@ unsigned char *ZipFile::getFileData(const std::string &fileName, ssize_t *size)
         CC_BREAK_IF(it ==  _data->fileList.end());
         
         ZipEntryInfo fileInfo = it->second;
+
+        std::lock_guard<std::mutex> lock(_data->zipFileMutex);
         
         int nRet = unzGoToFilePos(_data->zipFile, &fileInfo.pos);
         CC_BREAK_IF(UNZ_OK != nRet);
@@ -611,4 +914,28 @@ unsigned char *ZipFile::getFileData(const std::string &fileName, ssize_t *size)
     return buffer;
 }
 
+const unsigned char *ZipFile::getStoredFileData(const std::string &fileName, ssize_t *size) const
+{
+    const unsigned char *data = nullptr;
+    if (size)
+        *size = 0;
+
+    do
+    {
+        CC_BREAK_IF(_data->mode != Mode::PACK);
+
+        ZipFilePrivate::PackListContainer::const_iterator it = _data->packList.find(fileName);
+        CC_BREAK_IF(it == _data->packList.end());
+        CC_BREAK_IF(it->second.method != ZIP_METHOD_STORED);
+
+        data = _data->packData + it->second.offset;
+        if (size)
+        {
+            *size = it->second.uncompressed_size;
+        }
+    } while (0);
+
+    return data;
+}
+
 NS_CC_END
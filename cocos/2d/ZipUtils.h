@@ -225,6 +225,15 @@ namespace cocos2d
     class ZipFile
     {
     public:
+        /** How the archive is accessed */
+        enum class Mode
+        {
+            /** every read seeks and inflates through minizip */
+            UNZIP,
+            /** the central directory is indexed once and the archive is mapped into memory */
+            PACK,
+        };
+
         /**
         * Constructor, open zip file and store file list.
         *
@@ -235,14 +244,40 @@ namespace cocos2d
         * @since v2.0.5
         */
         ZipFile(const std::string &zipFile, const std::string &filter = std::string());
+
+        /**
+        * Constructor, open zip file in the given mode.
+        *
+        * In Mode::PACK the archive is mapped into memory and its central directory is read
+        * once into a hashed file index. Reads never touch minizip, stored (uncompressed)
+        * entries can be accessed in place with getStoredFileData(), and getFileData() may be
+        * called from several threads at once.
+        * If the archive can not be opened as a pack file (zip64, spanned archives...),
+        * it falls back to Mode::UNZIP.
+        *
+        * @param zipFile Zip file name
+        * @param filter The first part of file names, which should be accessible.
+        * @param mode Access mode
+        *
+        * @since v3.0
+        */
+        ZipFile(const std::string &zipFile, const std::string &filter, Mode mode);
         virtual ~ZipFile();
 
+        /**
+        * Returns the mode the archive was actually opened with.
+        *
+        * @since v3.0
+        */
+        Mode getMode() const;
+
         /**
         * Regenerate accessible file list based on a new filter string.
         *
         * @param filter New filter string (first part of files names)
         * @return true whenever zip file is open successfully and it is possible to locate
         *              at least the first file, false otherwise
+        * @warning Not thread safe, don't call it while other threads are reading files.
         *
         * @since v2.0.5
         */
@@ -269,6 +304,19 @@ namespace cocos2d
         */
         unsigned char *getFileData(const std::string &fileName, ssize_t *size);
 
+        /**
+        * Get a stored (uncompressed) file directly from the mapped archive, without copying.
+        * Only available in Mode::PACK.
+        * @param fileName File name
+        * @param[out] size If the file is found and stored, it will be the data size, otherwise 0.
+        * @return A pointer into the mapped archive, valid as long as this ZipFile is alive,
+        *         or nullptr if the file does not exist, is compressed or the archive is not a pack file.
+        * @warning Don't free() or modify the returned pointer.
+        *
+        * @since v3.0
+        */
+        const unsigned char *getStoredFileData(const std::string &fileName, ssize_t *size) const;
+
     private:
         /** Internal data like zip file pointer / file list array and so on */
         ZipFilePrivate *_data;
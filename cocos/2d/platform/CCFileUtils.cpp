@@ -27,6 +27,7 @@ THE SOFTWARE.
 #include "ccMacros.h"
 #include "CCDirector.h"
 #include "CCSAXParser.h"
+#include "ZipUtils.h"
 #include "tinyxml2.h"
 #include "unzip.h"
 #include <stack>
@@ -477,6 +478,7 @@ FileUtils::FileUtils()
 
 FileUtils::~FileUtils()
 {
+    removeAllSearchPacks();
 }
 
 
@@ -545,16 +547,71 @@ static Data getData(const std::string& filename, bool forString)
 
 std::string FileUtils::getStringFromFile(const std::string& filename)
 {
-    Data data = getData(filename, true);
+    Data data = getDataFromSearchPacks(filename);
+    if (!data.isNull())
+    {
+        return std::string((const char*)data.getBytes(), data.getSize());
+    }
+
+    data = getData(filename, true);
     std::string ret((const char*)data.getBytes());
     return ret;
 }
 
 Data FileUtils::getDataFromFile(const std::string& filename)
 {
+    Data data = getDataFromSearchPacks(filename);
+    if (!data.isNull())
+    {
+        return data;
+    }
+
     return getData(filename, false);
 }
 
+Data FileUtils::getDataFromSearchPacks(const std::string& filename) const
+{
+    Data ret;
+    // packed files are named relative to the archive, and the archive index is only read here,
+    // so this doesn't touch _fullPathCache and is safe from the loader threads
+    if (_searchPacks.empty() || filename.empty() || isAbsolutePath(filename))
+    {
+        return ret;
+    }
+
+    for (auto pack : _searchPacks)
+    {
+        if (pack->fileExists(filename))
+        {
+            ssize_t size = 0;
+            unsigned char* buffer = pack->getFileData(filename, &size);
+            if (buffer)
+            {
+                ret.fastSet(buffer, size);
+            }
+            break;
+        }
+    }
+    return ret;
+}
+
+bool FileUtils::isFileInSearchPacks(const std::string& filename) const
+{
+    if (filename.empty() || isAbsolutePath(filename))
+    {
+        return false;
+    }
+
+    for (auto pack : _searchPacks)
+    {
+        if (pack->fileExists(filename))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 unsigned char* FileUtils::getFileData(const std::string& filename, const char* mode, ssize_t *size)
 {
     unsigned char * buffer = nullptr;
@@ -684,6 +741,20 @@ std::string FileUtils::fullPathForFilename(const std::string &filename)
     std::string newFilename( getNewFilename(filename) );
     
     string fullpath = "";
+
+    // Packed files come first, their name in the archive is used as full path.
+    for (auto packIt = _searchPacks.begin(); packIt != _searchPacks.end(); ++packIt) {
+        for (auto resolutionIt = _searchResolutionsOrderArray.begin(); resolutionIt != _searchResolutionsOrderArray.end(); ++resolutionIt) {
+            
+            fullpath = *resolutionIt + newFilename;
+            
+            if ((*packIt)->fileExists(fullpath))
+            {
+                _fullPathCache.insert(std::pair<std::string, std::string>(filename, fullpath));
+                return fullpath;
+            }
+        }
+    }
     
     for (auto searchIt = _searchPathArray.begin(); searchIt != _searchPathArray.end(); ++searchIt) {
         for (auto resolutionIt = _searchResolutionsOrderArray.begin(); resolutionIt != _searchResolutionsOrderArray.end(); ++resolutionIt) {
@@ -800,6 +871,32 @@ void FileUtils::addSearchPath(const std::string &searchpath)
     _searchPathArray.push_back(path);
 }
 
+bool FileUtils::addSearchPack(const std::string& packFile)
+{
+    std::string fullPath = fullPathForFilename(packFile);
+    ZipFile* pack = new ZipFile(fullPath, std::string(), ZipFile::Mode::PACK);
+    if (pack->getMode() != ZipFile::Mode::PACK)
+    {
+        CCLOG("cocos2d: FileUtils: %s can't be opened as a pack file.", packFile.c_str());
+        delete pack;
+        return false;
+    }
+
+    _fullPathCache.clear();
+    _searchPacks.push_back(pack);
+    return true;
+}
+
+void FileUtils::removeAllSearchPacks()
+{
+    _fullPathCache.clear();
+    for (auto pack : _searchPacks)
+    {
+        delete pack;
+    }
+    _searchPacks.clear();
+}
+
 void FileUtils::setFilenameLookupDictionary(const ValueMap& filenameLookupDict)
 {
     _fullPathCache.clear();    
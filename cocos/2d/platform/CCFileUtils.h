@@ -34,6 +34,8 @@ THE SOFTWARE.
 
 NS_CC_BEGIN
 
+class ZipFile;
+
 /**
  * @addtogroup platform
  * @{
@@ -275,6 +277,41 @@ public:
      */
     virtual const std::vector<std::string>& getSearchPaths() const;
 
+    /**
+     *  Adds a zip archive whose files are found before the ones in the search paths.
+     *
+     *  The archive is opened in ZipFile::Mode::PACK, its file index is read once so finding and
+     *  reading a packed file doesn't open a file on the disk. The files are found with the
+     *  resolution directories, e.g. "hd/Images/grossini.png" in the archive for "Images/grossini.png".
+     *  fullPathForFilename() returns the name of a packed file as it is in the archive, and
+     *  getDataFromFile() and getStringFromFile() read it from the archive, also from the
+     *  TextureCache loader thread. isFileExist() only checks the disk, use isFileInSearchPacks()
+     *  for the packed files.
+     *
+     *  @note Add the packs at startup, before files are loaded from other threads. On Android the
+     *        archive has to be outside of the apk, e.g. in the writable path.
+     *  @param packFile The zip file, it could be a relative or absolute path.
+     *  @return false if the archive can't be opened as a pack file.
+     *  @since v3.0
+     */
+    bool addSearchPack(const std::string& packFile);
+
+    /**
+     *  Removes the archives added by addSearchPack().
+     *
+     *  @since v3.0
+     */
+    void removeAllSearchPacks();
+
+    /**
+     *  Checks whether an archive added by addSearchPack() contains a file.
+     *
+     *  @param filename The name of the file in the archive, as returned by fullPathForFilename().
+     *  @return true if the file is packed, false for absolute paths and files on the disk.
+     *  @since v3.0
+     */
+    bool isFileInSearchPacks(const std::string& filename) const;
+
     /**
      *  Gets the writable path.
      *  @return  The path that can be write/read a file in
@@ -372,6 +409,14 @@ protected:
      *  @return The full path of the file, if the file can't be found, it will return an empty string.
      */
     virtual std::string getFullPathForDirectoryAndFilename(const std::string& directory, const std::string& filename);
+
+    /**
+     *  Reads a file from the archives added by addSearchPack().
+     *
+     *  @param filename The name of the file in the archive.
+     *  @return The file data, or Data::Null if no archive contains the file.
+     */
+    Data getDataFromSearchPacks(const std::string& filename) const;
     
     
     /** Dictionary used to lookup filenames based on a key.
@@ -409,6 +454,11 @@ protected:
      *  This variable is used for improving the performance of file search.
      */
     std::unordered_map<std::string, std::string> _fullPathCache;
+
+    /**
+     *  The archives added by addSearchPack(), searched in the order they were added.
+     */
+    std::vector<ZipFile*> _searchPacks;
     
     /**
      *  The singleton pointer of FileUtils.
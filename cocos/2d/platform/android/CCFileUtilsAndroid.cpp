@@ -237,13 +237,25 @@ Data FileUtilsAndroid::getData(const std::string& filename, bool forString)
 
 std::string FileUtilsAndroid::getStringFromFile(const std::string& filename)
 {
-    Data data = getData(filename, true);
+    Data data = getDataFromSearchPacks(filename);
+    if (!data.isNull())
+    {
+        return std::string((const char*)data.getBytes(), data.getSize());
+    }
+
+    data = getData(filename, true);
     std::string ret((const char*)data.getBytes());
     return ret;
 }
     
 Data FileUtilsAndroid::getDataFromFile(const std::string& filename)
 {
+    Data data = getDataFromSearchPacks(filename);
+    if (!data.isNull())
+    {
+        return data;
+    }
+
     return getData(filename, false);
 }
 
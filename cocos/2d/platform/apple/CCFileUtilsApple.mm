@@ -220,6 +220,16 @@ static void addObjectToNSDict(const std::string& key, const Value& value, NSMuta
 
 static NSFileManager* s_fileManager = [NSFileManager defaultManager];
 
+// parses a plist read from a search pack, nil if there's no data
+static id propertyListFromData(const Data& data)
+{
+    if (data.isNull())
+        return nil;
+    
+    NSData* nsData = [NSData dataWithBytes:data.getBytes() length:data.getSize()];
+    return [NSPropertyListSerialization propertyListWithData:nsData options:NSPropertyListImmutable format:NULL error:NULL];
+}
+
 FileUtils* FileUtils::getInstance()
 {
     if (s_sharedFileUtils == nullptr)
@@ -313,8 +323,18 @@ std::string FileUtilsApple::getFullPathForDirectoryAndFilename(const std::string
 ValueMap FileUtilsApple::getValueMapFromFile(const std::string& filename)
 {
     std::string fullPath = fullPathForFilename(filename);
-    NSString* path = [NSString stringWithUTF8String:fullPath.c_str()];
-    NSDictionary* dict = [NSDictionary dictionaryWithContentsOfFile:path];
+    NSDictionary* dict = nil;
+    id plist = propertyListFromData(getDataFromSearchPacks(fullPath));
+    if (plist != nil)
+    {
+        if ([plist isKindOfClass:[NSDictionary class]])
+            dict = plist;
+    }
+    else
+    {
+        NSString* path = [NSString stringWithUTF8String:fullPath.c_str()];
+        dict = [NSDictionary dictionaryWithContentsOfFile:path];
+    }
     
     ValueMap ret;
     
@@ -354,8 +374,18 @@ ValueVector FileUtilsApple::getValueVectorFromFile(const std::string& filename)
     //    pPath = [[NSBundle mainBundle] pathForResource:pPath ofType:pathExtension];
     //    fixing cannot read data using Array::createWithContentsOfFile
     std::string fullPath = fullPathForFilename(filename);
-    NSString* path = [NSString stringWithUTF8String:fullPath.c_str()];
-    NSArray* array = [NSArray arrayWithContentsOfFile:path];
+    NSArray* array = nil;
+    id plist = propertyListFromData(getDataFromSearchPacks(fullPath));
+    if (plist != nil)
+    {
+        if ([plist isKindOfClass:[NSArray class]])
+            array = plist;
+    }
+    else
+    {
+        NSString* path = [NSString stringWithUTF8String:fullPath.c_str()];
+        array = [NSArray arrayWithContentsOfFile:path];
+    }
     
     ValueVector ret;
     
@@ -40,41 +40,43 @@ AutoreleasePool::~AutoreleasePool()
 
 void AutoreleasePool::addObject(Object* object)
 {
-    _managedObjectArray.pushBack(object);
+    CCASSERT(object->_reference > 0, "reference count should be greater than 0");
 
-    CCASSERT(object->_reference > 1, "reference count should be greater than 1");
+    // the pool takes over a reference of the object, it isn't retained here
+    _managedObjectArray.push_back(object);
     ++(object->_autoReleaseCount);
-    object->release(); // no ref count, in this case autorelease pool added.
 }
 
 void AutoreleasePool::removeObject(Object* object)
 {
-    for (unsigned int i = 0; i < object->_autoReleaseCount; ++i)
+    // recently autoreleased objects are the most likely to be removed
+    for (auto iter = _managedObjectArray.rbegin(); object->_autoReleaseCount > 0 && iter != _managedObjectArray.rend(); ++iter)
     {
-       _managedObjectArray.eraseObject(object, false);
+        if (*iter == object)
+        {
+            *iter = nullptr;
+            --(object->_autoReleaseCount);
+        }
     }
 }
 
 void AutoreleasePool::clear()
 {
-    if (!_managedObjectArray.empty())
+    // objects may be autoreleased or removed while others are released, so the array
+    // is walked by index and every entry is cleared before its object is released
+    for (size_t i = 0; i < _managedObjectArray.size(); ++i)
     {
-        //CCAutoreleasePool* pReleasePool;
-#ifdef _DEBUG
-        int nIndex = _managedObjectArray.size() - 1;
-#endif
-
-        for(const auto &obj : _managedObjectArray) {
+        Object* obj = _managedObjectArray[i];
+        if (obj)
+        {
+            _managedObjectArray[i] = nullptr;
             --(obj->_autoReleaseCount);
-            //(*it)->release();
-            //delete (*it);
-#ifdef _DEBUG
-            nIndex--;
-#endif
+            obj->release();
         }
-
-        _managedObjectArray.clear();
     }
+
+    // the capacity is kept for the next frame
+    _managedObjectArray.clear();
 }
 
 
@@ -102,6 +104,7 @@ PoolManager::PoolManager()
 {
     _releasePoolStack.reserve(150);
     _curReleasePool = 0;
+    _autoreleasedCount = 0;
 }
 
 PoolManager::~PoolManager()
@@ -164,12 +167,17 @@ void PoolManager::removeObject(Object* object)
 {
     CCASSERT(_curReleasePool, "current auto release pool should not be null");
 
-    _curReleasePool->removeObject(object);
+    // the object may have been autoreleased into pools pushed before the current one
+    for (ssize_t i = _releasePoolStack.size() - 1; i >= 0; --i)
+    {
+        _releasePoolStack.at(i)->removeObject(object);
+    }
 }
 
 void PoolManager::addObject(Object* object)
 {
     getCurReleasePool()->addObject(object);
+    ++_autoreleasedCount;
 }
 
 
@@ -26,6 +26,7 @@ THE SOFTWARE.
 
 #include "CCObject.h"
 #include "CCVector.h"
+#include <vector>
 
 NS_CC_BEGIN
 
@@ -39,13 +40,13 @@ class CC_DLL AutoreleasePool : public Object
     /**
      * The underlying array of object managed by the pool.
      *
-     * Although Array retains the object once when an object is added, proper
-     * Object::release() is called outside the array to make sure that the pool
-     * does not affect the managed object's reference count. So an object can
-     * be destructed properly by calling Object::release() even if the object
-     * is in the pool.
+     * The array holds plain pointers, adding an object doesn't retain it. The
+     * reference the object is created with is handed over to the pool, which
+     * releases it once per add when the pool is cleared. An object destructed
+     * while it is still in the pool has its entries set to nullptr, see
+     * removeObject().
      */
-    Vector<Object*> _managedObjectArray;
+    std::vector<Object*> _managedObjectArray;
 public:
     /**
      * @js NA
@@ -74,6 +75,9 @@ public:
     /**
      * Remove a given object from this pool.
      *
+     * Every entry of the object is cleared without releasing it, searching from
+     * the most recently added objects.
+     *
      * @param object    The object to be removed from the pool.
      * @js NA
      * @lua NA
@@ -95,6 +99,7 @@ class CC_DLL PoolManager
 {
     Vector<AutoreleasePool*> _releasePoolStack;
     AutoreleasePool *_curReleasePool;
+    unsigned int _autoreleasedCount;
 
     AutoreleasePool *getCurReleasePool();
 public:
@@ -166,6 +171,22 @@ public:
      * @lua NA
      */
     void addObject(Object *object);
+
+    /**
+     * Returns how many objects were autoreleased since the count was reset.
+     *
+     * The Director resets it every frame and shows it with its stats.
+     * @js NA
+     * @lua NA
+     */
+    unsigned int getAutoreleasedCount() const { return _autoreleasedCount; }
+
+    /**
+     * Resets the count of autoreleased objects.
+     * @js NA
+     * @lua NA
+     */
+    void resetAutoreleasedCount() { _autoreleasedCount = 0; }
     /**
      * @js NA
      * @lua NA
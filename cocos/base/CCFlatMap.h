@@ -0,0 +1,444 @@
+/****************************************************************************
+ Copyright (c) 2013 cocos2d-x.org
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __CCFLATMAP_H__
+#define __CCFLATMAP_H__
+
+#include "ccMacros.h"
+#include <stdint.h>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+NS_CC_BEGIN
+
+/**
+ * @addtogroup data_structures
+ * @{
+ */
+
+/**
+ * A hash map keeping its elements in one contiguous array.
+ *
+ * The elements are stored in insertion order in a std::vector, and found through
+ * a power of two table of element indices which is probed linearly. A lookup
+ * touches the index table and one element instead of walking the per element
+ * nodes of std::unordered_map, and a map costs two allocations whatever its size.
+ *
+ * It has the part of the std::unordered_map interface the engine uses, with one
+ * difference: inserting or erasing elements may move the other elements, so
+ * references and iterators to elements are invalidated by both. Erasing an
+ * element moves the last element into its place, so `iter = map.erase(iter)`
+ * still visits every element.
+ */
+template <class K, class V, class H = std::hash<K> >
+class FlatMap
+{
+public:
+    typedef K key_type;
+    typedef V mapped_type;
+    typedef std::pair<K, V> value_type;
+    typedef H hasher;
+    typedef size_t size_type;
+    typedef typename std::vector<value_type>::iterator iterator;
+    typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+    FlatMap() {}
+
+    FlatMap(std::initializer_list<value_type> list)
+    {
+        reserve(list.size());
+        for (const auto& element : list)
+        {
+            insert(element);
+        }
+    }
+
+    FlatMap(const FlatMap& other)
+    : _elements(other._elements)
+    , _buckets(other._buckets)
+    {
+    }
+
+    FlatMap(FlatMap&& other)
+    {
+        swap(other);
+    }
+
+    FlatMap& operator= (const FlatMap& other)
+    {
+        if (this != &other)
+        {
+            _elements = other._elements;
+            _buckets = other._buckets;
+        }
+        return *this;
+    }
+
+    FlatMap& operator= (FlatMap&& other)
+    {
+        if (this != &other)
+        {
+            clear();
+            swap(other);
+        }
+        return *this;
+    }
+
+    // ------------------------------------------
+    // Iterators
+    // ------------------------------------------
+
+    iterator begin() { return _elements.begin(); }
+    const_iterator begin() const { return _elements.begin(); }
+
+    iterator end() { return _elements.end(); }
+    const_iterator end() const { return _elements.end(); }
+
+    const_iterator cbegin() const { return _elements.cbegin(); }
+    const_iterator cend() const { return _elements.cend(); }
+
+    // ------------------------------------------
+    // Capacity
+    // ------------------------------------------
+
+    size_type size() const { return _elements.size(); }
+    bool empty() const { return _elements.empty(); }
+
+    /** Makes room for `count` elements, so inserting up to `count` elements doesn't grow the arrays. */
+    void reserve(size_type count)
+    {
+        if (count > _elements.capacity())
+        {
+            reallocate(count);
+        }
+
+        size_type bucketCount = _buckets.empty() ? MIN_BUCKET_COUNT : _buckets.size();
+        while (count * 4 > bucketCount * 3)
+        {
+            bucketCount *= 2;
+        }
+        if (bucketCount != _buckets.size())
+        {
+            rehash(bucketCount);
+        }
+    }
+
+    // ------------------------------------------
+    // Lookup
+    // ------------------------------------------
+
+    iterator find(const K& key)
+    {
+        size_type index = indexOf(key);
+        return index == NOT_FOUND ? _elements.end() : _elements.begin() + index;
+    }
+
+    const_iterator find(const K& key) const
+    {
+        size_type index = indexOf(key);
+        return index == NOT_FOUND ? _elements.end() : _elements.begin() + index;
+    }
+
+    size_type count(const K& key) const
+    {
+        return indexOf(key) == NOT_FOUND ? 0 : 1;
+    }
+
+    V& at(const K& key)
+    {
+        size_type index = indexOf(key);
+        if (index == NOT_FOUND)
+        {
+            throw std::out_of_range("FlatMap::at: key not found");
+        }
+        return _elements[index].second;
+    }
+
+    const V& at(const K& key) const
+    {
+        size_type index = indexOf(key);
+        if (index == NOT_FOUND)
+        {
+            throw std::out_of_range("FlatMap::at: key not found");
+        }
+        return _elements[index].second;
+    }
+
+    // ------------------------------------------
+    // Modifiers
+    // ------------------------------------------
+
+    V& operator[] (const K& key)
+    {
+        return emplaceKey(key).first->second;
+    }
+
+    V& operator[] (K&& key)
+    {
+        return emplaceKey(std::move(key)).first->second;
+    }
+
+    std::pair<iterator, bool> insert(const value_type& element)
+    {
+        auto ret = emplaceKey(element.first);
+        if (ret.second)
+        {
+            ret.first->second = element.second;
+        }
+        return ret;
+    }
+
+    std::pair<iterator, bool> insert(value_type&& element)
+    {
+        auto ret = emplaceKey(std::move(element.first));
+        if (ret.second)
+        {
+            ret.first->second = std::move(element.second);
+        }
+        return ret;
+    }
+
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    {
+        for (; first != last; ++first)
+        {
+            insert(*first);
+        }
+    }
+
+    template <class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args)
+    {
+        return insert(value_type(std::forward<Args>(args)...));
+    }
+
+    /** Erases the element at `position`, the last element is moved into its place. */
+    iterator erase(const_iterator position)
+    {
+        size_type index = position - _elements.cbegin();
+        CCASSERT(index < _elements.size(), "FlatMap::erase: invalid position");
+
+        removeBucket(findBucket(index));
+
+        size_type last = _elements.size() - 1;
+        if (index != last)
+        {
+            _buckets[findBucket(last)].index = static_cast<uint32_t>(index);
+            _elements[index] = std::move(_elements[last]);
+        }
+        _elements.pop_back();
+
+        return _elements.begin() + index;
+    }
+
+    size_type erase(const K& key)
+    {
+        size_type index = indexOf(key);
+        if (index == NOT_FOUND)
+        {
+            return 0;
+        }
+        erase(_elements.cbegin() + index);
+        return 1;
+    }
+
+    /** Removes all the elements, the storage is kept. */
+    void clear()
+    {
+        _elements.clear();
+        for (auto& bucket : _buckets)
+        {
+            bucket.index = EMPTY;
+        }
+    }
+
+    void swap(FlatMap& other)
+    {
+        _elements.swap(other._elements);
+        _buckets.swap(other._buckets);
+    }
+
+private:
+    struct Bucket
+    {
+        uint32_t index;
+        uint32_t hash;
+    };
+
+    static const uint32_t EMPTY = 0xffffffff;
+    static const size_type NOT_FOUND = static_cast<size_type>(-1);
+    static const size_type MIN_BUCKET_COUNT = 8;
+
+    static uint32_t hashOf(const K& key)
+    {
+        // folds and mixes the hash, the low bits select the bucket
+        uint64_t h = static_cast<uint64_t>(H()(key));
+        h ^= h >> 32;
+        h *= 0x9E3779B97F4A7C15ULL;
+        return static_cast<uint32_t>(h >> 32);
+    }
+
+    /** Returns the bucket of `key`, or the empty bucket it would be inserted at. */
+    size_type probe(const K& key, uint32_t hash) const
+    {
+        size_type mask = _buckets.size() - 1;
+        size_type i = hash & mask;
+        while (_buckets[i].index != EMPTY)
+        {
+            if (_buckets[i].hash == hash && _elements[_buckets[i].index].first == key)
+            {
+                break;
+            }
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    size_type indexOf(const K& key) const
+    {
+        if (_elements.empty())
+        {
+            return NOT_FOUND;
+        }
+        uint32_t index = _buckets[probe(key, hashOf(key))].index;
+        return index == EMPTY ? NOT_FOUND : index;
+    }
+
+    /** Returns the bucket pointing at the element at `index`. */
+    size_type findBucket(size_type index) const
+    {
+        size_type mask = _buckets.size() - 1;
+        size_type i = hashOf(_elements[index].first) & mask;
+        while (_buckets[i].index != index)
+        {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    /** Empties a bucket, shifting back the buckets probed past it. */
+    void removeBucket(size_type hole)
+    {
+        size_type mask = _buckets.size() - 1;
+        for (size_type i = (hole + 1) & mask; _buckets[i].index != EMPTY; i = (i + 1) & mask)
+        {
+            // the bucket may fill the hole if the hole lies on its probe sequence
+            size_type home = _buckets[i].hash & mask;
+            if (((i - home) & mask) >= ((i - hole) & mask))
+            {
+                _buckets[hole] = _buckets[i];
+                hole = i;
+            }
+        }
+        _buckets[hole].index = EMPTY;
+    }
+
+    template <class KeyType>
+    std::pair<iterator, bool> emplaceKey(KeyType&& key)
+    {
+        uint32_t hash = hashOf(key);
+        size_type bucket = 0;
+        if (!_buckets.empty())
+        {
+            bucket = probe(key, hash);
+            if (_buckets[bucket].index != EMPTY)
+            {
+                return std::make_pair(_elements.begin() + _buckets[bucket].index, false);
+            }
+        }
+
+        size_type count = _elements.size() + 1;
+        if (count * 4 > _buckets.size() * 3)
+        {
+            rehash(_buckets.empty() ? MIN_BUCKET_COUNT : _buckets.size() * 2);
+            bucket = probe(key, hash);
+        }
+        if (count > _elements.capacity())
+        {
+            reallocate(_elements.capacity() * 2);
+        }
+
+        _buckets[bucket].index = static_cast<uint32_t>(_elements.size());
+        _buckets[bucket].hash = hash;
+        _elements.push_back(value_type(std::forward<KeyType>(key), V()));
+        return std::make_pair(_elements.end() - 1, true);
+    }
+
+    void rehash(size_type bucketCount)
+    {
+        std::vector<Bucket> buckets(bucketCount);
+        for (auto& bucket : buckets)
+        {
+            bucket.index = EMPTY;
+        }
+
+        // the hashes are kept in the buckets, so the keys aren't hashed again
+        size_type mask = bucketCount - 1;
+        for (const auto& bucket : _buckets)
+        {
+            if (bucket.index != EMPTY)
+            {
+                size_type i = bucket.hash & mask;
+                while (buckets[i].index != EMPTY)
+                {
+                    i = (i + 1) & mask;
+                }
+                buckets[i] = bucket;
+            }
+        }
+        _buckets.swap(buckets);
+    }
+
+    /** Grows the element array by moving the elements, std::vector would copy them unless moving can't throw. */
+    void reallocate(size_type capacity)
+    {
+        if (capacity < MIN_BUCKET_COUNT)
+        {
+            capacity = MIN_BUCKET_COUNT;
+        }
+
+        std::vector<value_type> elements;
+        elements.reserve(capacity);
+        for (auto& element : _elements)
+        {
+            elements.push_back(std::move(element));
+        }
+        _elements.swap(elements);
+    }
+
+    std::vector<value_type> _elements;
+    std::vector<Bucket> _buckets;
+};
+
+// end of data_structures group
+/// @}
+
+NS_CC_END
+
+#endif // __CCFLATMAP_H__
@@ -27,6 +27,7 @@ THE SOFTWARE.
 #include "CCAutoreleasePool.h"
 #include "ccMacros.h"
 #include "CCScriptSupport.h"
+#include <atomic>
 
 NS_CC_BEGIN
 
@@ -35,7 +36,8 @@ Object::Object()
 , _reference(1) // when the object is created, the reference count of it is 1
 , _autoReleaseCount(0)
 {
-    static unsigned int uObjectCount = 0;
+    // objects are also created by loading jobs, e.g. the async armature loading of cocostudio
+    static std::atomic<unsigned int> uObjectCount(0);
 
     _ID = ++uObjectCount;
 }
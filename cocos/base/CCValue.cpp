@@ -24,151 +24,142 @@
 
 #include "CCValue.h"
 #include <sstream>
+#include <string.h>
+#include <stdlib.h>
 
 NS_CC_BEGIN
 
 const Value Value::Null;
 
 Value::Value()
-: _vectorData(new ValueVector())
-, _mapData(new ValueMap())
-, _intKeyMapData(new ValueMapIntKey())
-, _type(Type::NONE)
+: _type(Type::NONE)
+, _strLength(0)
 {
-    
+    memset(&_field, 0, sizeof(_field));
 }
 
 Value::Value(unsigned char v)
-: _vectorData(nullptr)
-, _mapData(nullptr)
-, _intKeyMapData(nullptr)
-, _type(Type::BYTE)
+: _type(Type::BYTE)
+, _strLength(0)
 {
-    _baseData.byteVal = v;
+    _field.byteVal = v;
 }
 
 Value::Value(int v)
-: _vectorData(nullptr)
-, _mapData(nullptr)
-, _intKeyMapData(nullptr)
-, _type(Type::INTEGER)
+: _type(Type::INTEGER)
+, _strLength(0)
 {
-    _baseData.intVal = v;
+    _field.intVal = v;
 }
 
 Value::Value(float v)
-: _vectorData(nullptr)
-, _mapData(nullptr)
-, _intKeyMapData(nullptr)
-, _type(Type::FLOAT)
+: _type(Type::FLOAT)
+, _strLength(0)
 {
-    _baseData.floatVal = v;
+    _field.floatVal = v;
 }
 
 Value::Value(double v)
-: _vectorData(nullptr)
-, _mapData(nullptr)
-, _intKeyMapData(nullptr)
-, _type(Type::DOUBLE)
+: _type(Type::DOUBLE)
+, _strLength(0)
 {
-    _baseData.doubleVal = v;
+    _field.doubleVal = v;
 }
 
 Value::Value(bool v)
-: _vectorData(nullptr)
-, _mapData(nullptr)
-, _intKeyMapData(nullptr)
-, _type(Type::BOOLEAN)
+: _type(Type::BOOLEAN)
+, _strLength(0)
 {
-    _baseData.boolVal = v;
+    _field.boolVal = v;
 }
 
 Value::Value(const char* v)
-: _vectorData(nullptr)
-, _mapData(nullptr)
-, _intKeyMapData(nullptr)
-, _type(Type::STRING)
+: _type(Type::NONE)
+, _strLength(0)
 {
-    _strData = v;
+    setString(v ? v : "", v ? strlen(v) : 0);
 }
 
 Value::Value(const std::string& v)
-: _vectorData(nullptr)
-, _mapData(nullptr)
-, _intKeyMapData(nullptr)
-, _type(Type::STRING)
+: _type(Type::NONE)
+, _strLength(0)
 {
-    _strData = v;
+    setString(v.c_str(), v.length());
 }
 
 Value::Value(const ValueVector& v)
-: _vectorData(new ValueVector())
-, _mapData(nullptr)
-, _intKeyMapData(nullptr)
-, _type(Type::VECTOR)
+: _type(Type::VECTOR)
+, _strLength(0)
 {
-    *_vectorData = v;
+    _field.vectorVal = new ValueVector(v);
 }
 
 Value::Value(ValueVector&& v)
-: _vectorData(new ValueVector())
-, _mapData(nullptr)
-, _intKeyMapData(nullptr)
-, _type(Type::VECTOR)
+: _type(Type::VECTOR)
+, _strLength(0)
 {
-    *_vectorData = std::move(v);
+    _field.vectorVal = new ValueVector(std::move(v));
 }
 
 Value::Value(const ValueMap& v)
-: _vectorData(nullptr)
-, _mapData(new ValueMap())
-, _intKeyMapData(nullptr)
-, _type(Type::MAP)
+: _type(Type::MAP)
+, _strLength(0)
 {
-    *_mapData = v;
+    _field.mapVal = new ValueMap(v);
 }
 
 Value::Value(ValueMap&& v)
-: _vectorData(nullptr)
-, _mapData(new ValueMap())
-, _intKeyMapData(nullptr)
-, _type(Type::MAP)
+: _type(Type::MAP)
+, _strLength(0)
 {
-    *_mapData = std::move(v);
+    _field.mapVal = new ValueMap(std::move(v));
 }
 
 Value::Value(const ValueMapIntKey& v)
-: _vectorData(nullptr)
-, _mapData(nullptr)
-, _intKeyMapData(new ValueMapIntKey())
-, _type(Type::INT_KEY_MAP)
+: _type(Type::INT_KEY_MAP)
+, _strLength(0)
 {
-    *_intKeyMapData = v;
+    _field.intKeyMapVal = new ValueMapIntKey(v);
 }
 
 Value::Value(ValueMapIntKey&& v)
-: _vectorData(nullptr)
-, _mapData(nullptr)
-, _intKeyMapData(new ValueMapIntKey())
-, _type(Type::INT_KEY_MAP)
+: _type(Type::INT_KEY_MAP)
+, _strLength(0)
 {
-    *_intKeyMapData = std::move(v);
+    _field.intKeyMapVal = new ValueMapIntKey(std::move(v));
 }
 
 Value::Value(const Value& other)
-: _vectorData(nullptr)
-, _mapData(nullptr)
-, _intKeyMapData(nullptr)
+: _field(other._field)
+, _type(other._type)
+, _strLength(other._strLength)
 {
-    *this = other;
+    // scalars and short strings are copied with the union, the rest is owned by each value
+    switch (_type) {
+        case Type::STRING:
+            if (_strLength == LONG_STRING)
+                _field.strVal = new std::string(*other._field.strVal);
+            break;
+        case Type::VECTOR:
+            _field.vectorVal = new ValueVector(*other._field.vectorVal);
+            break;
+        case Type::MAP:
+            _field.mapVal = new ValueMap(*other._field.mapVal);
+            break;
+        case Type::INT_KEY_MAP:
+            _field.intKeyMapVal = new ValueMapIntKey(*other._field.intKeyMapVal);
+            break;
+        default:
+            break;
+    }
 }
 
 Value::Value(Value&& other)
-: _vectorData(nullptr)
-, _mapData(nullptr)
-, _intKeyMapData(nullptr)
+: _field(other._field)
+, _type(other._type)
+, _strLength(other._strLength)
 {
-    *this = std::move(other);
+    other._type = Type::NONE;
 }
 
 Value::~Value()
@@ -176,92 +167,26 @@ Value::~Value()
     clear();
 }
 
+/* The assignments build the new value first and swap it in, so a value can be
+   assigned from an element of its own container. */
+
 Value& Value::operator= (const Value& other)
 {
-    switch (other._type) {
-        case Type::BYTE:
-            _baseData.byteVal = other._baseData.byteVal;
-            break;
-        case Type::INTEGER:
-            _baseData.intVal = other._baseData.intVal;
-            break;
-        case Type::FLOAT:
-            _baseData.floatVal = other._baseData.floatVal;
-            break;
-        case Type::DOUBLE:
-            _baseData.doubleVal = other._baseData.doubleVal;
-            break;
-        case Type::BOOLEAN:
-            _baseData.boolVal = other._baseData.boolVal;
-            break;
-        case Type::STRING:
-            _strData = other._strData;
-            break;
-        case Type::VECTOR:
-            if (_vectorData == nullptr)
-                _vectorData = new ValueVector();
-            *_vectorData = *other._vectorData;
-            break;
-        case Type::MAP:
-            if (_mapData == nullptr)
-                _mapData = new ValueMap();
-            *_mapData = *other._mapData;
-            break;
-        case Type::INT_KEY_MAP:
-            if (_intKeyMapData == nullptr)
-                _intKeyMapData = new ValueMapIntKey();
-            *_intKeyMapData = *other._intKeyMapData;
-            break;
-        default:
-            break;
+    if (this != &other)
+    {
+        Value copy(other);
+        swap(copy);
     }
-    _type = other._type;
     return *this;
 }
 
 Value& Value::operator= (Value&& other)
 {
-    switch (other._type) {
-        case Type::BYTE:
-            _baseData.byteVal = other._baseData.byteVal;
-            break;
-        case Type::INTEGER:
-            _baseData.intVal = other._baseData.intVal;
-            break;
-        case Type::FLOAT:
-            _baseData.floatVal = other._baseData.floatVal;
-            break;
-        case Type::DOUBLE:
-            _baseData.doubleVal = other._baseData.doubleVal;
-            break;
-        case Type::BOOLEAN:
-            _baseData.boolVal = other._baseData.boolVal;
-            break;
-        case Type::STRING:
-            _strData = other._strData;
-            break;
-        case Type::VECTOR:
-            CC_SAFE_DELETE(_vectorData);
-            _vectorData = other._vectorData;
-            break;
-        case Type::MAP:
-            CC_SAFE_DELETE(_mapData);
-            _mapData = other._mapData;
-            break;
-        case Type::INT_KEY_MAP:
-            CC_SAFE_DELETE(_intKeyMapData);
-            _intKeyMapData = other._intKeyMapData;
-            break;
-        default:
-            break;
+    if (this != &other)
+    {
+        Value moved(std::move(other));
+        swap(moved);
     }
-    _type = other._type;
-    
-    other._vectorData = nullptr;
-    other._mapData = nullptr;
-    other._intKeyMapData = nullptr;
-    other._type = Type::NONE;
-    
     return *this;
 }
 
@@ -269,7 +194,7 @@ Value& Value::operator= (unsigned char v)
 {
     clear();
     _type = Type::BYTE;
-    _baseData.byteVal = v;
+    _field.byteVal = v;
     return *this;
 }
 
@@ -277,7 +202,7 @@ Value& Value::operator= (int v)
 {
     clear();
     _type = Type::INTEGER;
-    _baseData.intVal = v;
+    _field.intVal = v;
     return *this;
 }
 
@@ -285,7 +210,7 @@ Value& Value::operator= (float v)
 {
     clear();
     _type = Type::FLOAT;
-    _baseData.floatVal = v;
+    _field.floatVal = v;
     return *this;
 }
 
@@ -293,7 +218,7 @@ Value& Value::operator= (double v)
 {
     clear();
     _type = Type::DOUBLE;
-    _baseData.doubleVal = v;
+    _field.doubleVal = v;
     return *this;
 }
 
@@ -301,113 +226,162 @@ Value& Value::operator= (bool v)
 {
     clear();
     _type = Type::BOOLEAN;
-    _baseData.boolVal = v;
+    _field.boolVal = v;
     return *this;
 }
 
 Value& Value::operator= (const char* v)
 {
-    clear();
-    _type = Type::STRING;
-    _strData = v ? v : "";
+    Value str(v);
+    swap(str);
     return *this;
 }
 
 Value& Value::operator= (const std::string& v)
 {
-    clear();
-    _type = Type::STRING;
-    _strData = v;
+    Value str(v);
+    swap(str);
     return *this;
 }
 
 Value& Value::operator= (const ValueVector& v)
 {
-    clear();
-    _type = Type::VECTOR;
-    _vectorData = new ValueVector();
-    *_vectorData = v;
+    Value vector(v);
+    swap(vector);
     return *this;
 }
 
 Value& Value::operator= (ValueVector&& v)
 {
-    clear();
-    _type = Type::VECTOR;
-    _vectorData = new ValueVector();
-    *_vectorData = std::move(v);
+    Value vector(std::move(v));
+    swap(vector);
     return *this;
 }
 
 Value& Value::operator= (const ValueMap& v)
 {
-    clear();
-    _type = Type::MAP;
-    _mapData = new ValueMap();
-    *_mapData = v;
+    Value map(v);
+    swap(map);
     return *this;
 }
 
 Value& Value::operator= (ValueMap&& v)
 {
-    clear();
-    _type = Type::MAP;
-    _mapData = new ValueMap();
-    *_mapData = std::move(v);
+    Value map(std::move(v));
+    swap(map);
     return *this;
 }
 
 Value& Value::operator= (const ValueMapIntKey& v)
 {
-    clear();
-    _type = Type::INT_KEY_MAP;
-    _intKeyMapData = new ValueMapIntKey();
-    *_intKeyMapData = v;
+    Value map(v);
+    swap(map);
     return *this;
 }
 
 Value& Value::operator= (ValueMapIntKey&& v)
 {
-    clear();
-    _type = Type::INT_KEY_MAP;
-    _intKeyMapData = new ValueMapIntKey();
-    *_intKeyMapData = std::move(v);
+    Value map(std::move(v));
+    swap(map);
     return *this;
 }
 
 ///
+ValueVector& Value::asValueVector()
+{
+    if (_type == Type::NONE)
+    {
+        *this = ValueVector();
+    }
+    CCASSERT(_type == Type::VECTOR, "The value isn't a ValueVector");
+    return *_field.vectorVal;
+}
+
+const ValueVector& Value::asValueVector() const
+{
+    static const ValueVector EMPTY_VALUE_VECTOR;
+    if (_type == Type::NONE)
+    {
+        return EMPTY_VALUE_VECTOR;
+    }
+    CCASSERT(_type == Type::VECTOR, "The value isn't a ValueVector");
+    return *_field.vectorVal;
+}
+
+ValueMap& Value::asValueMap()
+{
+    if (_type == Type::NONE)
+    {
+        *this = ValueMap();
+    }
+    CCASSERT(_type == Type::MAP, "The value isn't a ValueMap");
+    return *_field.mapVal;
+}
+
+const ValueMap& Value::asValueMap() const
+{
+    static const ValueMap EMPTY_VALUE_MAP;
+    if (_type == Type::NONE)
+    {
+        return EMPTY_VALUE_MAP;
+    }
+    CCASSERT(_type == Type::MAP, "The value isn't a ValueMap");
+    return *_field.mapVal;
+}
+
+ValueMapIntKey& Value::asIntKeyMap()
+{
+    if (_type == Type::NONE)
+    {
+        *this = ValueMapIntKey();
+    }
+    CCASSERT(_type == Type::INT_KEY_MAP, "The value isn't a ValueMapIntKey");
+    return *_field.intKeyMapVal;
+}
+
+const ValueMapIntKey& Value::asIntKeyMap() const
+{
+    static const ValueMapIntKey EMPTY_VALUE_MAP_INT_KEY;
+    if (_type == Type::NONE)
+    {
+        return EMPTY_VALUE_MAP_INT_KEY;
+    }
+    CCASSERT(_type == Type::INT_KEY_MAP, "The value isn't a ValueMapIntKey");
+    return *_field.intKeyMapVal;
+}
+
 unsigned char Value::asByte() const
 {
     CCASSERT(_type != Type::VECTOR && _type != Type::MAP, "");
     
     if (_type == Type::BYTE)
     {
-        return _baseData.byteVal;
+        return _field.byteVal;
     }
     
     if (_type == Type::INTEGER)
     {
-        return static_cast<unsigned char>(_baseData.intVal);
+        return static_cast<unsigned char>(_field.intVal);
     }
     
     if (_type == Type::STRING)
     {
-        return static_cast<unsigned char>(atoi(_strData.c_str()));
+        return static_cast<unsigned char>(atoi(getCString()));
     }
     
     if (_type == Type::FLOAT)
     {
-        return static_cast<unsigned char>(_baseData.floatVal);
+        return static_cast<unsigned char>(_field.floatVal);
     }
     
     if (_type == Type::DOUBLE)
     {
-        return static_cast<unsigned char>(_baseData.doubleVal);
+        return static_cast<unsigned char>(_field.doubleVal);
     }
     
     if (_type == Type::BOOLEAN)
     {
-        return _baseData.boolVal ? 1 : 0;
+        return _field.boolVal ? 1 : 0;
     }
     
     return 0;
@@ -418,32 +392,32 @@ int Value::asInt() const
     CCASSERT(_type != Type::VECTOR && _type != Type::MAP, "");
     if (_type == Type::INTEGER)
     {
-        return _baseData.intVal;
+        return _field.intVal;
     }
     
     if (_type == Type::BYTE)
     {
-        return _baseData.byteVal;
+        return _field.byteVal;
     }
     
     if (_type == Type::STRING)
     {
-        return atoi(_strData.c_str());
+        return atoi(getCString());
     }
     
     if (_type == Type::FLOAT)
     {
-        return static_cast<int>(_baseData.floatVal);
+        return static_cast<int>(_field.floatVal);
     }
     
     if (_type == Type::DOUBLE)
     {
-        return static_cast<int>(_baseData.doubleVal);
+        return static_cast<int>(_field.doubleVal);
     }
     
     if (_type == Type::BOOLEAN)
     {
-        return _baseData.boolVal ? 1 : 0;
+        return _field.boolVal ? 1 : 0;
     }
     
     return 0;
@@ -454,32 +428,32 @@ float Value::asFloat() const
     CCASSERT(_type != Type::VECTOR && _type != Type::MAP, "");
     if (_type == Type::FLOAT)
     {
-        return _baseData.floatVal;
+        return _field.floatVal;
     }
     
     if (_type == Type::BYTE)
     {
-        return static_cast<float>(_baseData.byteVal);
+        return static_cast<float>(_field.byteVal);
     }
     
     if (_type == Type::STRING)
     {
-        return atof(_strData.c_str());
+        return atof(getCString());
     }
     
     if (_type == Type::INTEGER)
     {
-        return static_cast<float>(_baseData.intVal);
+        return static_cast<float>(_field.intVal);
     }
     
     if (_type == Type::DOUBLE)
     {
-        return static_cast<float>(_baseData.doubleVal);
+        return static_cast<float>(_field.doubleVal);
     }
     
     if (_type == Type::BOOLEAN)
     {
-        return _baseData.boolVal ? 1.0f : 0.0f;
+        return _field.boolVal ? 1.0f : 0.0f;
     }
     
     return 0.0f;
@@ -490,32 +464,32 @@ double Value::asDouble() const
     CCASSERT(_type != Type::VECTOR && _type != Type::MAP, "");
     if (_type == Type::DOUBLE)
     {
-        return _baseData.doubleVal;
+        return _field.doubleVal;
     }
     
     if (_type == Type::BYTE)
     {
-        return static_cast<double>(_baseData.byteVal);
+        return static_cast<double>(_field.byteVal);
     }
     
     if (_type == Type::STRING)
     {
-        return static_cast<double>(atof(_strData.c_str()));
+        return static_cast<double>(atof(getCString()));
     }
     
     if (_type == Type::INTEGER)
     {
-        return static_cast<double>(_baseData.intVal);
+        return static_cast<double>(_field.intVal);
     }
     
     if (_type == Type::FLOAT)
     {
-        return static_cast<double>(_baseData.floatVal);
+        return static_cast<double>(_field.floatVal);
     }
     
     if (_type == Type::BOOLEAN)
     {
-        return _baseData.boolVal ? 1.0 : 0.0;
+        return _field.boolVal ? 1.0 : 0.0;
     }
     
     return 0.0;
@@ -526,32 +500,33 @@ bool Value::asBool() const
     CCASSERT(_type != Type::VECTOR && _type != Type::MAP, "");
     if (_type == Type::BOOLEAN)
     {
-        return _baseData.boolVal;
+        return _field.boolVal;
     }
     
     if (_type == Type::BYTE)
     {
-        return _baseData.byteVal == 0 ? false : true;
+        return _field.byteVal == 0 ? false : true;
     }
     
     if (_type == Type::STRING)
     {
-        return (_strData == "0" || _strData == "false") ? false : true;
+        const char* str = getCString();
+        return (strcmp(str, "0") == 0 || strcmp(str, "false") == 0) ? false : true;
     }
     
     if (_type == Type::INTEGER)
     {
-        return _baseData.intVal == 0 ? false : true;
+        return _field.intVal == 0 ? false : true;
     }
     
     if (_type == Type::FLOAT)
     {
-        return _baseData.floatVal == 0.0f ? false : true;
+        return _field.floatVal == 0.0f ? false : true;
     }
     
     if (_type == Type::DOUBLE)
     {
-        return _baseData.doubleVal == 0.0 ? false : true;
+        return _field.doubleVal == 0.0 ? false : true;
     }
     
     return true;
@@ -563,26 +538,30 @@ std::string Value::asString() const
     
     if (_type == Type::STRING)
     {
-        return _strData;
+        if (_strLength == LONG_STRING)
+        {
+            return *_field.strVal;
+        }
+        return std::string(_field.shortStrVal, _strLength);
     }
     
     std::stringstream ret;
     
     switch (_type) {
         case Type::BYTE:
-            ret << _baseData.byteVal;
+            ret << _field.byteVal;
             break;
         case Type::INTEGER:
-            ret << _baseData.intVal;
+            ret << _field.intVal;
             break;
         case Type::FLOAT:
-            ret << _baseData.floatVal;
+            ret << _field.floatVal;
             break;
         case Type::DOUBLE:
-            ret << _baseData.doubleVal;
+            ret << _field.doubleVal;
             break;
         case Type::BOOLEAN:
-            ret << (_baseData.boolVal ? "true" : "false");
+            ret << (_field.boolVal ? "true" : "false");
             break;
         default:
             break;
@@ -687,12 +666,54 @@ std::string Value::getDescription()
 
 void Value::clear()
 {
+    switch (_type) {
+        case Type::STRING:
+            if (_strLength == LONG_STRING)
+                delete _field.strVal;
+            break;
+        case Type::VECTOR:
+            delete _field.vectorVal;
+            break;
+        case Type::MAP:
+            delete _field.mapVal;
+            break;
+        case Type::INT_KEY_MAP:
+            delete _field.intKeyMapVal;
+            break;
+        default:
+            break;
+    }
     _type = Type::NONE;
-    _baseData.doubleVal = 0.0;
-    _strData.clear();
-    CC_SAFE_DELETE(_vectorData);
-    CC_SAFE_DELETE(_mapData);
-    CC_SAFE_DELETE(_intKeyMapData);
+    _strLength = 0;
+    memset(&_field, 0, sizeof(_field));
+}
+
+void Value::swap(Value& other)
+{
+    std::swap(_field, other._field);
+    std::swap(_type, other._type);
+    std::swap(_strLength, other._strLength);
+}
+
+void Value::setString(const char* str, size_t length)
+{
+    _type = Type::STRING;
+    if (length < SHORT_STRING_SIZE)
+    {
+        memcpy(_field.shortStrVal, str, length);
+        _field.shortStrVal[length] = '\0';
+        _strLength = static_cast<unsigned char>(length);
+    }
+    else
+    {
+        _field.strVal = new std::string(str, length);
+        _strLength = LONG_STRING;
+    }
+}
+
+const char* Value::getCString() const
+{
+    return _strLength == LONG_STRING ? _field.strVal->c_str() : _field.shortStrVal;
 }
 
 NS_CC_END
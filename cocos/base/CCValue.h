@@ -27,6 +27,7 @@
 
 #include "CCPlatformMacros.h"
 #include "ccMacros.h"
+#include "CCFlatMap.h"
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -36,7 +37,7 @@ NS_CC_BEGIN
 class Value;
 
 typedef std::vector<Value> ValueVector;
-typedef std::unordered_map<std::string, Value> ValueMap;
+typedef FlatMap<std::string, Value> ValueMap;
 typedef std::unordered_map<int, Value> ValueMapIntKey;
 
 class Value
@@ -94,14 +95,15 @@ public:
     bool asBool() const;
     std::string asString() const;
     
-    inline ValueVector& asValueVector() { return *_vectorData; }
-    inline const ValueVector& asValueVector() const { return *_vectorData; }
+    /* A null value turns into an empty container when it is accessed as one. */
+    ValueVector& asValueVector();
+    const ValueVector& asValueVector() const;
     
-    inline ValueMap& asValueMap() { return *_mapData; }
-    inline const ValueMap& asValueMap() const { return *_mapData; }
+    ValueMap& asValueMap();
+    const ValueMap& asValueMap() const;
     
-    inline ValueMapIntKey& asIntKeyMap() { return *_intKeyMapData; }
-    inline const ValueMapIntKey& asIntKeyMap() const { return *_intKeyMapData; }
+    ValueMapIntKey& asIntKeyMap();
+    const ValueMapIntKey& asIntKeyMap() const;
 
     inline bool isNull() const { return _type == Type::NONE; }
     
@@ -125,6 +127,16 @@ public:
     
 private:
     void clear();
+    void swap(Value& other);
+    void setString(const char* str, size_t length);
+    const char* getCString() const;
+    
+    enum
+    {
+        /* strings shorter than this are stored in the value, longer ones in a heap allocated std::string */
+        SHORT_STRING_SIZE = 24,
+        LONG_STRING = 0xff
+    };
     
     union
     {
@@ -133,14 +145,17 @@ private:
         float floatVal;
         double doubleVal;
         bool boolVal;
-    }_baseData;
+        
+        char shortStrVal[SHORT_STRING_SIZE];
+        std::string* strVal;
+        ValueVector* vectorVal;
+        ValueMap* mapVal;
+        ValueMapIntKey* intKeyMapVal;
+    }_field;
     
-    std::string _strData;
-    ValueVector* _vectorData;
-    ValueMap* _mapData;
-    ValueMapIntKey* _intKeyMapData;
-
     Type _type;
+    /* the length of a string in _field.shortStrVal, or LONG_STRING for a string in _field.strVal */
+    unsigned char _strLength;
 };
 
 NS_CC_END
@@ -12,6 +12,7 @@
 #include "CCBKeyframe.h"
 
 #include <ctype.h>
+#include <unordered_map>
 
 using namespace std;
 using namespace cocos2d;
@@ -19,6 +20,29 @@ using namespace cocos2d::extension;
 
 namespace cocosbuilder {;
 
+/*************************************************************************
+ Implementation of CCBTemplate
+ *************************************************************************/
+
+/** The values a .ccbi file decodes to after its string cache, in the order the reader and the node loaders read them.
+ */
+class CCBTemplate
+{
+public:
+    union Token
+    {
+        int intValue;
+        float floatValue;
+    };
+
+    bool jsControlled;
+    std::vector<std::string> strings;
+    std::vector<Token> tokens;
+};
+
+static bool s_templateCacheEnabled = false;
+static std::unordered_map<std::string, std::shared_ptr<CCBTemplate>> s_templateCache;
+
 /*************************************************************************
  Implementation of CCBFile
  *************************************************************************/
@@ -58,6 +82,7 @@ CCBReader::CCBReader(NodeLoaderLibrary * pNodeLoaderLibrary, CCBMemberVariableAs
 , _bytes(nullptr)
 , _currentByte(-1)
 , _currentBit(-1)
+, _templatePosition(0)
 , _owner(nullptr)
 , _animationManager(nullptr)
 , _animatedProps(nullptr)
@@ -75,6 +100,7 @@ CCBReader::CCBReader(CCBReader * ccbReader)
 , _bytes(nullptr)
 , _currentByte(-1)
 , _currentBit(-1)
+, _templatePosition(0)
 , _owner(nullptr)
 , _animationManager(nullptr)
 , _animatedProps(nullptr)
@@ -97,6 +123,7 @@ CCBReader::CCBReader()
 , _bytes(nullptr)
 , _currentByte(-1)
 , _currentBit(-1)
+, _templatePosition(0)
 , _owner(nullptr)
 , _animationManager(nullptr)
 , _nodeLoaderLibrary(nullptr)
@@ -218,19 +245,56 @@ Node* CCBReader::readNodeGraphFromFile(const char *pCCBFileName, Object *pOwner,
 
     std::string strPath = FileUtils::getInstance()->fullPathForFilename(strCCBFileName.c_str());
 
-    auto dataPtr = std::make_shared<Data>(FileUtils::getInstance()->getDataFromFile(strPath));
+    openFile(strPath);
     
-    Node *ret =  this->readNodeGraphFromData(dataPtr, pOwner, parentSize);
+    Node *ret =  this->readRootNodeGraph(pOwner, parentSize);
     
     return ret;
 }
 
 Node* CCBReader::readNodeGraphFromData(std::shared_ptr<cocos2d::Data> data, Object *pOwner, const Size &parentSize)
+{
+    setData(data);
+
+    return readRootNodeGraph(pOwner, parentSize);
+}
+
+void CCBReader::openFile(const std::string& fullPath)
+{
+    if (s_templateCacheEnabled)
+    {
+        auto iter = s_templateCache.find(fullPath);
+        if (iter != s_templateCache.end())
+        {
+            setData(nullptr);
+            _template = iter->second;
+            return;
+        }
+    }
+
+    setData(std::make_shared<Data>(FileUtils::getInstance()->getDataFromFile(fullPath)));
+
+    // record the file while it is read
+    if (s_templateCacheEnabled)
+    {
+        _templatePath = fullPath;
+    }
+}
+
+void CCBReader::setData(std::shared_ptr<cocos2d::Data> data)
 {
     _data = data;
-    _bytes =_data->getBytes();
+    _bytes = _data ? _data->getBytes() : nullptr;
     _currentByte = 0;
     _currentBit = 0;
+
+    _template = nullptr;
+    _templatePosition = 0;
+    _templatePath.clear();
+}
+
+Node* CCBReader::readRootNodeGraph(Object *pOwner, const Size &parentSize)
+{
     _owner = pOwner;
     CC_SAFE_RETAIN(_owner);
 
@@ -294,18 +358,36 @@ void CCBReader::cleanUpNodeGraph(Node *node)
 
 Node* CCBReader::readFileWithCleanUp(bool bCleanUp, CCBAnimationManagerMapPtr am)
 {
-    if (! readHeader())
+    if (_template)
     {
-        return nullptr;
+        // the header and the string cache were read when the template was recorded
+        _jsControlled = _template->jsControlled;
+        _animationManager->_jsControlled = _jsControlled;
+        _templatePosition = 0;
     }
-    
-    if (! readStringCache())
+    else
     {
-        return nullptr;
+        if (! readHeader())
+        {
+            return nullptr;
+        }
+
+        if (! readStringCache())
+        {
+            return nullptr;
+        }
+
+        if (! _templatePath.empty())
+        {
+            _recording = std::make_shared<CCBTemplate>();
+            _recording->jsControlled = _jsControlled;
+            _recording->strings = _stringCache;
+        }
     }
     
     if (! readSequences())
     {
+        _recording = nullptr;
         return nullptr;
     }
     
@@ -313,6 +395,21 @@ Node* CCBReader::readFileWithCleanUp(bool bCleanUp, CCBAnimationManagerMapPtr am
 
     Node *pNode = readNodeGraph(nullptr);
 
+    if (_recording)
+    {
+        // a failed read stops in the middle of the file, only complete recordings can be replayed
+        if (pNode)
+        {
+            s_templateCache[_templatePath] = _recording;
+        }
+        _recording = nullptr;
+    }
+
+    if (pNode == nullptr)
+    {
+        return nullptr;
+    }
+
     _animationManagers->insert(pNode, _animationManager);
 
     if (bCleanUp)
@@ -363,6 +460,24 @@ bool CCBReader::readHeader()
 }
 
 unsigned char CCBReader::readByte()
+{
+    if (_template)
+    {
+        CCASSERT(_templatePosition < _template->tokens.size(), "CCBReader: read past the end of the template");
+        return (unsigned char)_template->tokens[_templatePosition++].intValue;
+    }
+
+    unsigned char byte = this->decodeByte();
+    if (_recording)
+    {
+        CCBTemplate::Token token;
+        token.intValue = byte;
+        _recording->tokens.push_back(token);
+    }
+    return byte;
+}
+
+unsigned char CCBReader::decodeByte()
 {
     unsigned char byte = this->_bytes[this->_currentByte];
     this->_currentByte++;
@@ -421,6 +536,23 @@ void CCBReader::alignBits() {
 }
 
 int CCBReader::readInt(bool pSigned) {
+    if (_template)
+    {
+        CCASSERT(_templatePosition < _template->tokens.size(), "CCBReader: read past the end of the template");
+        return _template->tokens[_templatePosition++].intValue;
+    }
+
+    int num = this->decodeInt(pSigned);
+    if (_recording)
+    {
+        CCBTemplate::Token token;
+        token.intValue = num;
+        _recording->tokens.push_back(token);
+    }
+    return num;
+}
+
+int CCBReader::decodeInt(bool pSigned) {
     // Read encoded int
     int numBits = 0;
     while(!this->getBit()) {
@@ -455,7 +587,25 @@ int CCBReader::readInt(bool pSigned) {
 
 float CCBReader::readFloat()
 {
-    FloatType type = static_cast<FloatType>(this->readByte());
+    if (_template)
+    {
+        CCASSERT(_templatePosition < _template->tokens.size(), "CCBReader: read past the end of the template");
+        return _template->tokens[_templatePosition++].floatValue;
+    }
+
+    float f = this->decodeFloat();
+    if (_recording)
+    {
+        CCBTemplate::Token token;
+        token.floatValue = f;
+        _recording->tokens.push_back(token);
+    }
+    return f;
+}
+
+float CCBReader::decodeFloat()
+{
+    FloatType type = static_cast<FloatType>(this->decodeByte());
     
     switch (type)
     {
@@ -468,7 +618,7 @@ float CCBReader::readFloat()
         case FloatType::_05:
             return 0.5f;
         case FloatType::INTEGER:
-            return (float)this->readInt(true);
+            return (float)this->decodeInt(true);
         default:
             {
                 /* using a memcpy since the compiler isn't
@@ -496,10 +646,10 @@ float CCBReader::readFloat()
     }
 }
 
-std::string CCBReader::readCachedString()
+const std::string& CCBReader::readCachedString()
 {
     int n = this->readInt(false);
-    return this->_stringCache[n];
+    return _template ? _template->strings[n] : this->_stringCache[n];
 }
 
 Node * CCBReader::readNodeGraph(Node * pParent)
@@ -1079,4 +1229,23 @@ void CCBReader::setResolutionScale(float scale)
     __ccbResolutionScale = scale;
 }
 
+void CCBReader::setTemplateCacheEnabled(bool enabled)
+{
+    s_templateCacheEnabled = enabled;
+    if (! enabled)
+    {
+        purgeTemplateCache();
+    }
+}
+
+bool CCBReader::isTemplateCacheEnabled()
+{
+    return s_templateCacheEnabled;
+}
+
+void CCBReader::purgeTemplateCache()
+{
+    s_templateCache.clear();
+}
+
 };
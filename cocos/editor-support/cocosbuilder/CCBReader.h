@@ -58,6 +58,7 @@ class CCBMemberVariableAssigner;
 class CCBSelectorResolver;
 class CCBAnimationManager;
 class CCBKeyframe;
+class CCBTemplate;
 
 /**
  * @brief Parse CCBI file which is generated by CocosBuilder
@@ -272,7 +273,7 @@ public:
      * @js NA
      * @lua NA
      */
-    std::string readCachedString();
+    const std::string& readCachedString();
     /**
      * @js NA
      * @lua NA
@@ -332,6 +333,22 @@ public:
      */
     static float getResolutionScale();
     static void setResolutionScale(float scale);
+
+    /**
+     * When enabled, the first read of a .ccbi file records the values it decodes into a template, keyed by the
+     * full path of the file. Later reads of the file, also as a sub ccb file, replay the template: the file is not
+     * read again and no bits are decoded, while the node loaders, the owner and member variable assignment and
+     * the animation managers run as for a fresh read. Disabled by default.
+     * @js NA
+     * @lua NA
+     */
+    static void setTemplateCacheEnabled(bool enabled);
+    static bool isTemplateCacheEnabled();
+    /** Releases the cached templates, e.g. when the .ccbi files change on disk.
+     * @js NA
+     * @lua NA
+     */
+    static void purgeTemplateCache();
     /**
      * @js NA
      * @lua NA
@@ -355,6 +372,15 @@ private:
     bool getBit();
     void alignBits();
 
+    void openFile(const std::string& fullPath);
+    void setData(std::shared_ptr<cocos2d::Data> data);
+    cocos2d::Node* readRootNodeGraph(cocos2d::Object *pOwner, const cocos2d::Size &parentSize);
+
+    // decode from _bytes, the read methods record or replay their results on top of them
+    int decodeInt(bool pSigned);
+    unsigned char decodeByte();
+    float decodeFloat();
+
     bool init();
     
     friend class NodeLoader;
@@ -366,6 +392,11 @@ private:
     int _currentBit;
     
     std::vector<std::string> _stringCache;
+
+    std::shared_ptr<CCBTemplate> _template;     // replayed instead of decoding _bytes
+    size_t _templatePosition;
+    std::shared_ptr<CCBTemplate> _recording;    // filled while decoding a file which isn't cached yet
+    std::string _templatePath;
     std::set<std::string> _loadedSpriteSheets;
     
     cocos2d::Object *_owner;
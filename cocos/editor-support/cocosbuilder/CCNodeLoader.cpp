@@ -42,7 +42,7 @@ void NodeLoader::parseProperties(Node * pNode, Node * pParent, CCBReader * ccbRe
     for(int i = 0; i < propertyCount; i++) {
         bool isExtraProp = (i >= numRegularProps);
         CCBReader::PropertyType type = (CCBReader::PropertyType)ccbReader->readInt(false);
-        std::string propertyName = ccbReader->readCachedString();
+        const std::string& propertyName = ccbReader->readCachedString();
 
         // Check if the property can be set for this platform
         bool setProp = false;
@@ -924,17 +924,13 @@ Node * NodeLoader::parsePropTypeCCBFile(Node * pNode, Node * pParent, CCBReader
     // Load sub file
     std::string path = FileUtils::getInstance()->fullPathForFilename(ccbFileName.c_str());
 
-    auto dataPtr = std::make_shared<Data>(FileUtils::getInstance()->getDataFromFile(path));
-    
     CCBReader * reader = new CCBReader(pCCBReader);
     reader->autorelease();
     reader->getAnimationManager()->setRootContainerSize(pParent->getContentSize());
     
     
-    reader->_data = dataPtr;
-    reader->_bytes = dataPtr->getBytes();
-    reader->_currentByte = 0;
-    reader->_currentBit = 0;
+    // replays the template of the file if it is cached
+    reader->openFile(path);
     CC_SAFE_RETAIN(pCCBReader->_owner);
     reader->_owner = pCCBReader->_owner;
     
@@ -28,6 +28,7 @@ CCDataReaderHelper.cpp \
 CCSpriteFrameCacheHelper.cpp \
 CCTransformHelp.cpp \
 CCTweenFunction.cpp \
+CCWorkerPool.cpp \
 CCUtilMath.cpp \
 CCComAttribute.cpp \
 CCComAudio.cpp \
@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "cocostudio/CCDataReaderHelper.h"
 #include "cocostudio/CCDatas.h"
 #include "cocostudio/CCSkin.h"
+#include "cocostudio/CCWorkerPool.h"
 #include "CCQuadCommand.h"
 #include "CCRenderer.h"
 #include "CCGroupCommand.h"
@@ -43,6 +44,10 @@ using namespace cocos2d;
 
 namespace cocostudio {
 
+static std::vector<Armature*> s_queuedArmatures;
+static bool s_updatingQueuedArmatures = false;
+static EventListenerCustom *s_afterUpdateListener = nullptr;
+
 Armature *Armature::create()
 {
     Armature *armature = new Armature();
@@ -86,6 +91,12 @@ Armature::Armature()
     , _parentBone(nullptr)
     , _armatureTransformDirty(true)
     , _animation(nullptr)
+    , _childBonesDirty(true)
+    , _parallelUpdateEnabled(false)
+    , _parallelUpdateDirty(true)
+    , _canUpdateInParallel(false)
+    , _updateQueued(false)
+    , _queuedDelta(0)
 {
 }
 
@@ -367,8 +378,122 @@ bool Armature::getArmatureTransformDirty() const
     return _armatureTransformDirty;
 }
 
+void Armature::setParallelUpdateEnabled(bool enabled)
+{
+    _parallelUpdateEnabled = enabled;
+
+    if (enabled && s_afterUpdateListener == nullptr)
+    {
+        s_afterUpdateListener = Director::getInstance()->getEventDispatcher()->addCustomEventListener(Director::EVENT_AFTER_UPDATE, [](EventCustom*){
+            Armature::updateQueuedArmatures();
+        });
+    }
+}
+
+bool Armature::isUpdatingQueuedArmatures()
+{
+    return s_updatingQueuedArmatures;
+}
+
+void Armature::updateQueuedArmatures()
+{
+    if (s_queuedArmatures.empty() || s_updatingQueuedArmatures)
+    {
+        return;
+    }
+
+    std::vector<Armature*> armatures;
+    armatures.swap(s_queuedArmatures);
+
+    // armatures only touch their own bones, tweens and skins here, everything
+    // reaching into the scene graph or user code waits for finishQueuedUpdate()
+    s_updatingQueuedArmatures = true;
+    WorkerPool::getInstance()->parallelFor((int)armatures.size(), [&armatures](int index){
+        Armature *armature = armatures[index];
+        armature->update(armature->_queuedDelta);
+    });
+    s_updatingQueuedArmatures = false;
+
+    for (auto& armature : armatures)
+    {
+        armature->finishQueuedUpdate();
+        armature->_updateQueued = false;
+        armature->_queuedDelta = 0;
+        armature->release();
+    }
+}
+
+void Armature::finishQueuedUpdate()
+{
+    for (auto& element : _boneDic)
+    {
+        Bone *bone = element.second;
+
+        DisplayManager *displayManager = bone->getDisplayManager();
+        if (displayManager->isDisplayChangePending())
+        {
+            displayManager->applyPendingDisplayChange();
+            // the new display wasn't transformed by the bone update yet
+            DisplayFactory::updateDisplay(bone, 0, true);
+        }
+
+        if (bone->isZOrderPending())
+        {
+            bone->updateZOrder();
+        }
+    }
+
+    // the callbacks see the displays of the new frame, and the display changes they make are kept
+    _animation->dispatchEvents();
+}
+
+bool Armature::canUpdateInParallel() const
+{
+    if (!_parallelUpdateDirty)
+    {
+        return _canUpdateInParallel;
+    }
+    _parallelUpdateDirty = false;
+
+    // particle systems and child armatures are reset and played when their display is shown,
+    // these armatures update on the main thread
+    _canUpdateInParallel = false;
+    for (auto& element : _boneDic)
+    {
+        Bone *bone = element.second;
+        if (bone->getChildArmature() != nullptr)
+        {
+            return false;
+        }
+
+        for (auto& decoDisplay : bone->getDisplayManager()->getDecorativeDisplayList())
+        {
+            DisplayData *displayData = decoDisplay->getDisplayData();
+            if (displayData != nullptr
+                && (displayData->displayType == CS_DISPLAY_PARTICLE || displayData->displayType == CS_DISPLAY_ARMATURE))
+            {
+                return false;
+            }
+        }
+    }
+    _canUpdateInParallel = true;
+    return true;
+}
+
 void Armature::update(float dt)
 {
+    if (_parallelUpdateEnabled && _running && !s_updatingQueuedArmatures && canUpdateInParallel())
+    {
+        if (!_updateQueued)
+        {
+            _updateQueued = true;
+            retain();
+            s_queuedArmatures.push_back(this);
+        }
+        _queuedDelta += dt;
+        return;
+    }
+
     _animation->update(dt);
 
     for(const auto &bone : _topBoneList) {
@@ -385,10 +510,12 @@ void Armature::draw()
         CC_NODE_DRAW_SETUP();
     }
 
+    updateChildBones();
 
-    for (auto& object : _children)
+    int count = (int)_childBones.size();
+    for (int i = 0; i < count; i++)
     {
-        if (Bone *bone = dynamic_cast<Bone *>(object))
+        if (Bone *bone = _childBones[i])
         {
             Node *node = bone->getDisplayRenderNode();
 
@@ -424,14 +551,57 @@ void Armature::draw()
             break;
             }
         }
-        else if(Node *node = dynamic_cast<Node *>(object))
+        else
         {
-            node->visit();
+            _children.at(i)->visit();
             CC_NODE_DRAW_SETUP();
         }
     }
 }
 
+void Armature::addChild(Node *child, int zOrder, int tag)
+{
+    Node::addChild(child, zOrder, tag);
+    _childBonesDirty = true;
+}
+
+void Armature::removeChild(Node* child, bool cleanup)
+{
+    Node::removeChild(child, cleanup);
+    _childBonesDirty = true;
+}
+
+void Armature::removeAllChildrenWithCleanup(bool cleanup)
+{
+    Node::removeAllChildrenWithCleanup(cleanup);
+    _childBonesDirty = true;
+}
+
+void Armature::sortAllChildren()
+{
+    if (_reorderChildDirty)
+    {
+        Node::sortAllChildren();
+        _childBonesDirty = true;
+    }
+}
+
+void Armature::updateChildBones() const
+{
+    if (!_childBonesDirty)
+    {
+        return;
+    }
+
+    _childBones.clear();
+    _childBones.reserve(_children.size());
+    for (const auto& child : _children)
+    {
+        _childBones.push_back(dynamic_cast<Bone *>(child));
+    }
+    _childBonesDirty = false;
+}
+
 
 void Armature::visit()
 {
@@ -460,9 +630,11 @@ Rect Armature::getBoundingBox() const
 
     Rect boundingBox = Rect(0, 0, 0, 0);
 
-    for (const auto& object : _children)
+    updateChildBones();
+
+    for (const auto& bone : _childBones)
     {
-        if (Bone *bone = dynamic_cast<Bone *>(object))
+        if (bone != nullptr)
         {
             Rect r = bone->getDisplayManager()->getBoundingBox();
 
@@ -493,13 +665,15 @@ Rect Armature::getBoundingBox() const
 
 Bone *Armature::getBoneAtPoint(float x, float y) const 
 {
-    long length = _children.size();
+    updateChildBones();
+
+    long length = _childBones.size();
     Bone *bs;
 
     for(long i = length - 1; i >= 0; i--)
     {
-        bs = static_cast<Bone*>( _children.at(i) );
-        if(bs->getDisplayManager()->containPoint(x, y))
+        bs = _childBones[i];
+        if(bs != nullptr && bs->getDisplayManager()->containPoint(x, y))
         {
             return bs;
         }
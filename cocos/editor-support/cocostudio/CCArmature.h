@@ -161,6 +161,12 @@ public:
     virtual void update(float dt) override;
     virtual void draw() override;
 
+    using Node::addChild;
+    virtual void addChild(cocos2d::Node *child, int zOrder, int tag) override;
+    virtual void removeChild(cocos2d::Node* child, bool cleanup = true) override;
+    virtual void removeAllChildrenWithCleanup(bool cleanup) override;
+    virtual void sortAllChildren() override;
+
     virtual const kmMat4& getNodeToParentTransform() const override;
     /**
      *  @js NA
@@ -210,6 +216,30 @@ public:
     virtual void setBatchNode(BatchNode *batchNode) { _batchNode = batchNode; }
     virtual BatchNode *getBatchNode() const { return _batchNode; }
 
+    /**
+     * In parallel update mode the scheduled update only queues the armature. After the scheduler
+     * update all queued armatures advance their animation and bone transforms on the WorkerPool.
+     * Display changes, z order changes and frame and movement events are applied on the main
+     * thread afterwards, so the event callbacks run after the scheduler update.
+     * Armatures with particle system or child armature displays always update on the main thread.
+     */
+    virtual void setParallelUpdateEnabled(bool enabled);
+    virtual bool isParallelUpdateEnabled() const { return _parallelUpdateEnabled; }
+
+    /**
+     * Updates the armatures queued in parallel update mode, called after every scheduler update.
+     */
+    static void updateQueuedArmatures();
+    /**
+     * Whether queued armatures are being updated on the worker threads.
+     */
+    static bool isUpdatingQueuedArmatures();
+    /**
+     * Makes the armature check its displays again before the next parallel update, called when
+     * a bone is added or removed, or its displays or child armature change.
+     */
+    void setParallelUpdateDirty() { _parallelUpdateDirty = true; }
+
 #if ENABLE_PHYSICS_BOX2D_DETECT
     virtual b2Fixture *getShapeList();
     /**
@@ -249,6 +279,28 @@ protected:
      */
     Bone *createBone(const std::string& boneName );
 
+    /*
+     * Applies the parts of a queued update which must run on the main thread
+     * @js NA
+     * @lua NA
+     */
+    void finishQueuedUpdate();
+
+    /*
+     * Whether no bone of the armature shows a particle system or a child armature, checked again
+     * after setParallelUpdateDirty()
+     * @js NA
+     * @lua NA
+     */
+    bool canUpdateInParallel() const;
+
+    /*
+     * Rebuilds _childBones after the children changed
+     * @js NA
+     * @lua NA
+     */
+    void updateChildBones() const;
+
 protected:
     ArmatureData *_armatureData;
 
@@ -271,6 +323,15 @@ protected:
 
     ArmatureAnimation *_animation;
 
+    mutable std::vector<Bone*> _childBones;                 //! The bone of every entry in _children in the same order, nullptr for other nodes
+    mutable bool _childBonesDirty;
+
+    bool _parallelUpdateEnabled;
+    mutable bool _parallelUpdateDirty;
+    mutable bool _canUpdateInParallel;
+    bool _updateQueued;
+    float _queuedDelta;
+
 #if ENABLE_PHYSICS_BOX2D_DETECT
     b2Body *_body;
 #elif ENABLE_PHYSICS_CHIPMUNK_DETECT
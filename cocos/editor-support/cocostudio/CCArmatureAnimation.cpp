@@ -221,7 +221,11 @@ void ArmatureAnimation::play(const std::string& animationName, int durationTo,
         if(movementBoneData && movementBoneData->frameList.size() > 0)
         {
             _tweenList.pushBack(tween);
-            movementBoneData->duration = _movementData->duration;
+            if (movementBoneData->duration != _movementData->duration)
+            {
+                // shared by every armature playing this movement, avoid writing it from several threads
+                movementBoneData->duration = _movementData->duration;
+            }
             tween->play(movementBoneData, durationTo, durationTween, loop, tweenEasing);
 
             tween->setProcessScale(_processScale);
@@ -338,6 +342,14 @@ void ArmatureAnimation::update(float dt)
         tween->update(dt);
     }
 
+    if (!Armature::isUpdatingQueuedArmatures())
+    {
+        dispatchEvents();
+    }
+}
+
+void ArmatureAnimation::dispatchEvents()
+{
     while (_frameEventQueue.size() > 0)
     {
         FrameEvent *event = _frameEventQueue.front();
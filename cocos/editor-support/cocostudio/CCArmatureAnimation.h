@@ -173,6 +173,12 @@ public:
 
     void update(float dt);
 
+    /**
+     * Calls the frame and movement event listeners for the events queued by update(). update()
+     * does this itself except for armatures updated on the worker threads in parallel update mode.
+     */
+    void dispatchEvents();
+
     /**
      * Get current movementID
      * @return The name of current movement
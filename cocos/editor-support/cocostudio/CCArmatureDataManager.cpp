@@ -27,6 +27,7 @@ THE SOFTWARE.
 #include "cocostudio/CCTransformHelp.h"
 #include "cocostudio/CCDataReaderHelper.h"
 #include "cocostudio/CCSpriteFrameCacheHelper.h"
+#include "cocostudio/CCWorkerPool.h"
 
 using namespace cocos2d;
 
@@ -51,6 +52,7 @@ void ArmatureDataManager::destoryInstance()
 {
     SpriteFrameCacheHelper::purge();
     DataReaderHelper::purge();
+    WorkerPool::destroyInstance();
     CC_SAFE_RELEASE_NULL(s_sharedArmatureDataManager);
 }
 
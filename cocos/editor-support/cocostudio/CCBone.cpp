@@ -76,6 +76,7 @@ Bone::Bone()
     _boneTransformDirty = true;
     _blendFunc = BlendFunc::ALPHA_NON_PREMULTIPLIED;
     _blendDirty = false;
+    _zOrderPending = false;
     _worldInfo = nullptr;
 
     _armatureParentBone = nullptr;
@@ -157,12 +158,18 @@ BoneData *Bone::getBoneData() const
 
 void Bone::setArmature(Armature *armature)
 {
+    if (_armature)
+    {
+        _armature->setParallelUpdateDirty();
+    }
+
     _armature = armature;
     if (_armature)
     {
         _tween->setAnimation(_armature->getAnimation());
         _dataVersion = _armature->getArmatureData()->dataVersion;
         _armatureParentBone = _armature->getParentBone();
+        _armature->setParallelUpdateDirty();
     }
     else
     {
@@ -280,6 +287,14 @@ void Bone::updateColor()
 
 void Bone::updateZOrder()
 {
+    if (Armature::isUpdatingQueuedArmatures())
+    {
+        // reordering touches the parent and the event dispatcher, Armature::finishQueuedUpdate() applies it
+        _zOrderPending = true;
+        return;
+    }
+    _zOrderPending = false;
+
     if (_dataVersion >= VERSION_COMBINED)
     {
         int zorder = _tweenData->zOrder + _boneData->zOrder;
@@ -361,6 +376,11 @@ void Bone::setChildArmature(Armature *armature)
         CC_SAFE_RETAIN(armature);
         CC_SAFE_RELEASE(_childArmature);
         _childArmature = armature;
+
+        if (_armature)
+        {
+            _armature->setParallelUpdateDirty();
+        }
     }
 }
 
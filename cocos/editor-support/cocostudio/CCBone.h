@@ -139,6 +139,8 @@ public:
 
     //! Update zorder
     void updateZOrder();
+    //! Whether a zorder change of a queued armature update waits for the main thread
+    bool isZOrderPending() const { return _zOrderPending; }
 
     virtual void setZOrder(int zOrder) override;
 
@@ -233,6 +235,8 @@ protected:
     cocos2d::BlendFunc _blendFunc;
     bool _blendDirty;
 
+    bool _zOrderPending;
+
     Tween *_tween;				//! Calculate tween effect
 
     //! Used for making tween effect in every frame
@@ -29,6 +29,9 @@ THE SOFTWARE.
 #include "cocostudio/CCUtilMath.h"
 #include "cocostudio/CCArmatureDefine.h"
 #include "cocostudio/CCDatas.h"
+#include "cocostudio/CCWorkerPool.h"
+
+#include <chrono>
 
 using namespace cocos2d;
 
@@ -143,64 +146,68 @@ DataReaderHelper *DataReaderHelper::_dataReaderHelper = nullptr;
 
 
 
-//! Async load
-void DataReaderHelper::loadData()
+//! Async load, runs on the WorkerPool
+void DataReaderHelper::loadData(AsyncStruct *pAsyncStruct)
 {
-    AsyncStruct *pAsyncStruct = nullptr;
+    Data data = FileUtils::getInstance()->getDataFromFile(pAsyncStruct->fullPath);
+    if (!data.isNull())
+    {
+        pAsyncStruct->fileContent.assign((const char *)data.getBytes(), data.getSize());
+    }
 
-    while (true)
+    // generate data info
+    DataInfo *pDataInfo = new DataInfo();
+    pDataInfo->asyncStruct = pAsyncStruct;
+    pDataInfo->filename = pAsyncStruct->filename;
+    pDataInfo->baseFilePath = pAsyncStruct->baseFilePath;
+
+    if (pAsyncStruct->configType == DragonBone_XML)
     {
-        std::queue<AsyncStruct *> *pQueue = _asyncStructQueue;
-        _asyncStructQueueMutex.lock(); // get async struct from queue
-        if (pQueue->empty())
-        {
-            _asyncStructQueueMutex.unlock();
-            if (need_quit)
-            {
-                break;
-            }
-            else
-            {
-				std::unique_lock<std::mutex> lk(_sleepMutex);
-				_sleepCondition.wait(lk);
-                continue;
-            }
-        }
-        else
+        DataReaderHelper::addDataFromCache(pAsyncStruct->fileContent, pDataInfo);
+    }
+    else if(pAsyncStruct->configType == CocoStudio_JSON)
+    {
+        DataReaderHelper::addDataFromJsonCache(pAsyncStruct->fileContent, pDataInfo);
+    }
+    else if(pAsyncStruct->configType == CocoStudio_Binary)
+    {
+        DataReaderHelper::addDataFromBinaryCache(pAsyncStruct->fileContent, pDataInfo);
+    }
+
+    // decode the textures of the sprite files here as well, the main thread only has to upload them.
+    // They are looked up next to the config file, finishAsyncData() drops them if the file utils resolve elsewhere.
+    std::string directory = pAsyncStruct->fullPath.substr(0, pAsyncStruct->fullPath.find_last_of("/") + 1);
+    std::queue<std::string> configFileQueue = pDataInfo->configFileQueue;
+    while (!configFileQueue.empty())
+    {
+        std::string imagePath = directory + configFileQueue.front() + ".png";
+        configFileQueue.pop();
+
+        Data imageData = FileUtils::getInstance()->getDataFromFile(imagePath);
+        if (imageData.isNull())
         {
-            pAsyncStruct = pQueue->front();
-            pQueue->pop();
-            _asyncStructQueueMutex.unlock();
+            continue;
         }
 
-        // generate data info
-        DataInfo *pDataInfo = new DataInfo();
-        pDataInfo->asyncStruct = pAsyncStruct;
-        pDataInfo->filename = pAsyncStruct->filename;
-        pDataInfo->baseFilePath = pAsyncStruct->baseFilePath;
-
-        if (pAsyncStruct->configType == DragonBone_XML)
+        Image *image = new Image();
+        if (image->initWithImageData(imageData.getBytes(), imageData.getSize()))
         {
-            DataReaderHelper::addDataFromCache(pAsyncStruct->fileContent.c_str(), pDataInfo);
+            pDataInfo->decodedImages.push_back(std::make_pair(imagePath, image));
         }
-        else if(pAsyncStruct->configType == CocoStudio_JSON)
+        else
         {
-            DataReaderHelper::addDataFromJsonCache(pAsyncStruct->fileContent.c_str(), pDataInfo);
+            image->release();
         }
-
-        // put the image info into the queue
-        _dataInfoMutex.lock();
-        _dataQueue->push(pDataInfo);
-        _dataInfoMutex.unlock();
     }
 
-    if( _asyncStructQueue != nullptr )
-    {
-        delete _asyncStructQueue;
-        _asyncStructQueue = nullptr;
-        delete _dataQueue;
-        _dataQueue = nullptr;
-    }
+    // put the data info into the queue
+    _dataInfoMutex.lock();
+    _dataQueue->push(pDataInfo);
+    _dataInfoMutex.unlock();
+
+    std::lock_guard<std::mutex> lock(_asyncJobMutex);
+    --_asyncJobCount;
+    _asyncJobCondition.notify_all();
 }
 
 
@@ -233,11 +240,10 @@ void DataReaderHelper::purge()
 
 
 DataReaderHelper::DataReaderHelper()
-	: _loadingThread(nullptr)
+	: _asyncJobCount(0)
 	, _asyncRefCount(0)
 	, _asyncRefTotalCount(0)
-	, need_quit(false)
-	, _asyncStructQueue(nullptr)
+	, _asyncTimeBudget(1 / 120.0f)
 	, _dataQueue(nullptr)
 {
 
@@ -245,15 +251,62 @@ DataReaderHelper::DataReaderHelper()
 
 DataReaderHelper::~DataReaderHelper()
 {
-    need_quit = true;
+    // the loading jobs still running use this object
+    {
+        std::unique_lock<std::mutex> lock(_asyncJobMutex);
+        _asyncJobCondition.wait(lock, [this]{ return _asyncJobCount == 0; });
+    }
 
-	_sleepCondition.notify_one();
-	if (_loadingThread) _loadingThread->join();
+    if (_dataQueue != nullptr)
+    {
+        while (!_dataQueue->empty())
+        {
+            DataInfo *pDataInfo = _dataQueue->front();
+            _dataQueue->pop();
+
+            for (auto& decodedImage : pDataInfo->decodedImages)
+            {
+                decodedImage.second->release();
+            }
+            CC_SAFE_RELEASE(pDataInfo->asyncStruct->target);
+            delete pDataInfo->asyncStruct;
+            delete pDataInfo;
+        }
+        CC_SAFE_DELETE(_dataQueue);
+    }
 
-	CC_SAFE_DELETE(_loadingThread);
 	_dataReaderHelper = nullptr;
 }
 
+void DataReaderHelper::setAsyncTimeBudget(float seconds)
+{
+    _asyncTimeBudget = seconds;
+}
+
+float DataReaderHelper::getAsyncTimeBudget() const
+{
+    return _asyncTimeBudget;
+}
+
+float DataReaderHelper::getAsyncProgress() const
+{
+    if (_asyncRefTotalCount == 0)
+    {
+        return 1;
+    }
+    return (_asyncRefTotalCount - _asyncRefCount) / (float)_asyncRefTotalCount;
+}
+
+int DataReaderHelper::getAsyncPendingCount() const
+{
+    return (int)_asyncRefCount;
+}
+
+bool DataReaderHelper::isAsyncLoadingFinished() const
+{
+    return _asyncRefCount == 0;
+}
+
 void DataReaderHelper::addDataFromFile(const std::string& filePath)
 {
     /*
@@ -289,7 +342,19 @@ void DataReaderHelper::addDataFromFile(const std::string& filePath)
 
     // Read content from file
     std::string fullPath = CCFileUtils::getInstance()->fullPathForFilename(filePath);
-    std::string contentStr = FileUtils::getInstance()->getStringFromFile(fullPath);
+    std::string contentStr;
+    if (str == ".csb")
+    {
+        Data data = FileUtils::getInstance()->getDataFromFile(fullPath);
+        if (!data.isNull())
+        {
+            contentStr.assign((const char *)data.getBytes(), data.getSize());
+        }
+    }
+    else
+    {
+        contentStr = FileUtils::getInstance()->getStringFromFile(fullPath);
+    }
 
     DataInfo dataInfo;
     dataInfo.filename = filePathStr;
@@ -304,6 +369,10 @@ void DataReaderHelper::addDataFromFile(const std::string& filePath)
     {
         DataReaderHelper::addDataFromJsonCache(contentStr, &dataInfo);
     }
+    else if(str == ".csb")
+    {
+        DataReaderHelper::addDataFromBinaryCache(contentStr, &dataInfo);
+    }
 }
 
 void DataReaderHelper::addDataFromFileAsync(const std::string& imagePath, const std::string& plistPath, const std::string& filePath, Object *target, SEL_SCHEDULE selector)
@@ -346,15 +415,9 @@ void DataReaderHelper::addDataFromFileAsync(const std::string& imagePath, const
 
 
     // lazy init
-    if (_asyncStructQueue == nullptr)
+    if (_dataQueue == nullptr)
     {
-        _asyncStructQueue = new std::queue<AsyncStruct *>();
         _dataQueue = new std::queue<DataInfo *>();
-
-		// create a new thread to load images
-		_loadingThread = new std::thread(&DataReaderHelper::loadData, this);
-
-        need_quit = false;
     }
 
     if (0 == _asyncRefCount)
@@ -385,10 +448,8 @@ void DataReaderHelper::addDataFromFileAsync(const std::string& imagePath, const
     size_t startPos = filePathStr.find_last_of(".");
     std::string str = &filePathStr[startPos];
 
-    std::string fullPath = CCFileUtils::getInstance()->fullPathForFilename(filePath);
-
-    // XXX fileContent is being leaked
-    data->fileContent = FileUtils::getInstance()->getStringFromFile(fullPath);
+    // the path is resolved here, the file utils cache is not thread safe. The file is read by the loading job.
+    data->fullPath = FileUtils::getInstance()->fullPathForFilename(filePath);
 
     if (str == ".xml")
     {
@@ -398,73 +459,109 @@ void DataReaderHelper::addDataFromFileAsync(const std::string& imagePath, const
     {
         data->configType = CocoStudio_JSON;
     }
+    else if(str == ".csb")
+    {
+        data->configType = CocoStudio_Binary;
+    }
 
 
-    // add async struct into queue
-    _asyncStructQueueMutex.lock();
-    _asyncStructQueue->push(data);
-    _asyncStructQueueMutex.unlock();
-
-    _sleepCondition.notify_one();
+    // files are parsed concurrently, so they can be finished in a different order than they were added
+    {
+        std::lock_guard<std::mutex> lock(_asyncJobMutex);
+        ++_asyncJobCount;
+    }
+    WorkerPool::getInstance()->addJob(std::bind(&DataReaderHelper::loadData, this, data));
 }
 
 void DataReaderHelper::addDataAsyncCallBack(float dt)
 {
-    // the data is generated in loading thread
-    std::queue<DataInfo *> *dataQueue = _dataQueue;
+    // the data is generated by the loading jobs, finish as many files as the time budget allows
+    auto start = std::chrono::steady_clock::now();
 
-    _dataInfoMutex.lock();
-    if (dataQueue->empty())
-    {
-        _dataInfoMutex.unlock();
-    }
-    else
+    while (true)
     {
+        std::queue<DataInfo *> *dataQueue = _dataQueue;
+
+        _dataInfoMutex.lock();
+        if (dataQueue->empty())
+        {
+            _dataInfoMutex.unlock();
+            break;
+        }
         DataInfo *pDataInfo = dataQueue->front();
         dataQueue->pop();
         _dataInfoMutex.unlock();
 
-        AsyncStruct *pAsyncStruct = pDataInfo->asyncStruct;
+        finishAsyncData(pDataInfo);
 
-
-        if (pAsyncStruct->imagePath != "" && pAsyncStruct->plistPath != "")
+        if (0 == _asyncRefCount)
         {
-            _getFileMutex.lock();
-            ArmatureDataManager::getInstance()->addSpriteFrameFromFile(pAsyncStruct->plistPath.c_str(), pAsyncStruct->imagePath.c_str());
-            _getFileMutex.unlock();
+            _asyncRefTotalCount = 0;
+            CCDirector::getInstance()->getScheduler()->unscheduleSelector(schedule_selector(DataReaderHelper::addDataAsyncCallBack), this);
+            break;
         }
 
-        while (!pDataInfo->configFileQueue.empty())
+        std::chrono::duration<float> elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() >= _asyncTimeBudget)
         {
-            std::string configPath = pDataInfo->configFileQueue.front();
-            _getFileMutex.lock();
-            ArmatureDataManager::getInstance()->addSpriteFrameFromFile((pAsyncStruct->baseFilePath + configPath + ".plist").c_str(), (pAsyncStruct->baseFilePath + configPath + ".png").c_str());
-            _getFileMutex.unlock();
-            pDataInfo->configFileQueue.pop();
+            break;
         }
+    }
+}
 
+void DataReaderHelper::finishAsyncData(DataInfo *pDataInfo)
+{
+    AsyncStruct *pAsyncStruct = pDataInfo->asyncStruct;
 
-        Object *target = pAsyncStruct->target;
-        SEL_SCHEDULE selector = pAsyncStruct->selector;
 
-        --_asyncRefCount;
+    if (pAsyncStruct->imagePath != "" && pAsyncStruct->plistPath != "")
+    {
+        _getFileMutex.lock();
+        ArmatureDataManager::getInstance()->addSpriteFrameFromFile(pAsyncStruct->plistPath.c_str(), pAsyncStruct->imagePath.c_str());
+        _getFileMutex.unlock();
+    }
 
-        if (target && selector)
+    while (!pDataInfo->configFileQueue.empty())
+    {
+        std::string configPath = pDataInfo->configFileQueue.front();
+
+        // upload the texture decoded by the loading job, unless the image resolves to another file
+        std::string imagePath = FileUtils::getInstance()->fullPathForFilename(pAsyncStruct->baseFilePath + configPath + ".png");
+        for (auto& decodedImage : pDataInfo->decodedImages)
         {
-            (target->*selector)((_asyncRefTotalCount - _asyncRefCount) / (float)_asyncRefTotalCount);
-            target->release();
+            if (decodedImage.first == imagePath)
+            {
+                Director::getInstance()->getTextureCache()->addImage(decodedImage.second, imagePath);
+                break;
+            }
         }
 
+        _getFileMutex.lock();
+        ArmatureDataManager::getInstance()->addSpriteFrameFromFile((pAsyncStruct->baseFilePath + configPath + ".plist").c_str(), (pAsyncStruct->baseFilePath + configPath + ".png").c_str());
+        _getFileMutex.unlock();
+        pDataInfo->configFileQueue.pop();
+    }
 
-        delete pAsyncStruct;
-        delete pDataInfo;
+    for (auto& decodedImage : pDataInfo->decodedImages)
+    {
+        decodedImage.second->release();
+    }
 
-        if (0 == _asyncRefCount)
-        {
-            _asyncRefTotalCount = 0;
-            CCDirector::getInstance()->getScheduler()->unscheduleSelector(schedule_selector(DataReaderHelper::addDataAsyncCallBack), this);
-        }
+
+    Object *target = pAsyncStruct->target;
+    SEL_SCHEDULE selector = pAsyncStruct->selector;
+
+    --_asyncRefCount;
+
+    if (target && selector)
+    {
+        (target->*selector)((_asyncRefTotalCount - _asyncRefCount) / (float)_asyncRefTotalCount);
+        target->release();
     }
+
+
+    delete pAsyncStruct;
+    delete pDataInfo;
 }
 
 
@@ -685,7 +782,16 @@ AnimationData *DataReaderHelper::decodeAnimation(tinyxml2::XMLElement *animation
 
     const char	*name = animationXML->Attribute(A_NAME);
 
+    // other loading jobs add armatures to the manager meanwhile
+    if (dataInfo->asyncStruct)
+    {
+        _dataReaderHelper->_addDataMutex.lock();
+    }
     ArmatureData *armatureData = ArmatureDataManager::getInstance()->getArmatureData(name);
+    if (dataInfo->asyncStruct)
+    {
+        _dataReaderHelper->_addDataMutex.unlock();
+    }
 
     aniData->name = name;
 
@@ -781,6 +887,7 @@ MovementData *DataReaderHelper::decodeMovement(tinyxml2::XMLElement *movementXML
         }
 
         MovementBoneData *moveBoneData = decodeMovementBone(movBoneXml, parentXml, boneData, dataInfo);
+        moveBoneData->bakeSamples(movementData->tweenEasing);
         movementData->addMovementBoneData(moveBoneData);
         moveBoneData->release();
 
@@ -1183,6 +1290,23 @@ void DataReaderHelper::addDataFromJsonCache(const std::string& fileContent, Data
     JsonDictionary json;
     json.initWithDescription(fileContent.c_str());
 
+    addDataFromJsonDictionary(json, dataInfo);
+}
+
+void DataReaderHelper::addDataFromBinaryCache(const std::string& fileContent, DataInfo *dataInfo)
+{
+    JsonDictionary json;
+    if (!json.initWithBinary((const unsigned char *)fileContent.data(), fileContent.size()))
+    {
+        CCLOG("DataReaderHelper: invalid binary file %s", dataInfo->filename.c_str());
+        return;
+    }
+
+    addDataFromJsonDictionary(json, dataInfo);
+}
+
+void DataReaderHelper::addDataFromJsonDictionary(JsonDictionary &json, DataInfo *dataInfo)
+{
     dataInfo->contentScale = json.getItemFloatValue(CONTENT_SCALE, 1);
 
     // Decode armatures
@@ -1463,6 +1587,7 @@ MovementData *DataReaderHelper::decodeMovement(JsonDictionary &json, DataInfo *d
     {
         JsonDictionary *dic = json.getSubItemFromArray(MOVEMENT_BONE_DATA, i);
         MovementBoneData *movementBoneData = decodeMovementBone(*dic, dataInfo);
+        movementBoneData->bakeSamples(movementData->tweenEasing);
         movementData->addMovementBoneData(movementBoneData);
         movementBoneData->release();
 
@@ -33,8 +33,9 @@ THE SOFTWARE.
 #include <string>
 #include <queue>
 #include <list>
+#include <vector>
 #include <mutex>
-#include <thread>
+#include <condition_variable>
 
 namespace tinyxml2
 {
@@ -54,12 +55,14 @@ protected:
 	enum ConfigType
 	{
 		DragonBone_XML,
-		CocoStudio_JSON
+		CocoStudio_JSON,
+		CocoStudio_Binary
 	};
 
 	typedef struct _AsyncStruct
 	{
 		std::string    filename;
+		std::string    fullPath;
 		std::string    fileContent;
 		ConfigType     configType;
 		std::string    baseFilePath;
@@ -80,6 +83,8 @@ protected:
         std::string    baseFilePath;
         float flashToolVersion;
         float cocoStudioVersion;
+        //! textures of the sprite files decoded by the loading job, keyed by their full path
+        std::vector<std::pair<std::string, cocos2d::Image *>> decodedImages;
 	} DataInfo;
 
 public:
@@ -113,6 +118,23 @@ public:
 
     void addDataAsyncCallBack(float dt);
 
+    /**
+     * Files added by addDataFromFileAsync() are read and parsed on the WorkerPool, the main thread then
+     * finishes them from a scheduled callback until this many seconds are spent in a frame.
+     * At least one file is finished per frame. Defaults to 1/120.
+     */
+    void setAsyncTimeBudget(float seconds);
+    float getAsyncTimeBudget() const;
+
+    /**
+     * Fraction of the files added by addDataFromFileAsync() which are finished, 1 when nothing is loading.
+     * Loading screens can poll this instead of passing a selector for every file.
+     */
+    float getAsyncProgress() const;
+    //! Number of files added by addDataFromFileAsync() which are not finished yet
+    int getAsyncPendingCount() const;
+    bool isAsyncLoadingFinished() const;
+
     void removeConfigFile(const std::string& configFile);
 public:
 
@@ -155,6 +177,12 @@ public:
 
 public:
     static void addDataFromJsonCache(const std::string& fileContent, DataInfo *dataInfo = nullptr);
+    /**
+     * Decode the binary documents converted from .ExportJson files by tools/cocostudio-converter/json2csb.py,
+     * the same decoders run on views into the file, nothing is parsed.
+     */
+    static void addDataFromBinaryCache(const std::string& fileContent, DataInfo *dataInfo = nullptr);
+    static void addDataFromJsonDictionary(JsonDictionary &json, DataInfo *dataInfo);
 
     static ArmatureData *decodeArmature(JsonDictionary &json, DataInfo *dataInfo);
     static BoneData *decodeBone(JsonDictionary &json, DataInfo *dataInfo);
@@ -172,18 +200,16 @@ public:
     static void decodeNode(BaseData *node, JsonDictionary &json, DataInfo *dataInfo);
 
 protected:
-	void loadData();
-
-
+	void loadData(AsyncStruct *pAsyncStruct);
+	void finishAsyncData(DataInfo *pDataInfo);
 
 
-	std::condition_variable		_sleepCondition;
 
-	std::thread     *_loadingThread;
 
-	std::mutex      _sleepMutex;
+	std::condition_variable		_asyncJobCondition;
+	std::mutex      _asyncJobMutex;
+	int             _asyncJobCount;
 
-	std::mutex      _asyncStructQueueMutex;
 	std::mutex      _dataInfoMutex;
 
 	std::mutex      _addDataMutex;
@@ -194,9 +220,8 @@ protected:
 	unsigned long _asyncRefCount;
 	unsigned long _asyncRefTotalCount;
 
-	bool need_quit;
+	float _asyncTimeBudget;
 
-	std::queue<AsyncStruct *> *_asyncStructQueue;
 	std::queue<DataInfo *>   *_dataQueue;
 
     static std::vector<std::string> _configFileList;
@@ -291,6 +291,7 @@ void FrameData::copy(const BaseData *baseData)
         }
 
         blendFunc = frameData->blendFunc;
+        isTween = frameData->isTween;
     }
 }
 
@@ -299,6 +300,8 @@ MovementBoneData::MovementBoneData()
     , scale(1.0f)
     , duration(0)
     , name("")
+    , sampleStart(0)
+    , sampleEasing(Linear)
 {
 }
 
@@ -321,6 +324,91 @@ FrameData *MovementBoneData::getFrameData(int index)
     return frameList.at(index);
 }
 
+static FrameSample makeFrameSample(const BaseData &from, const BaseData &between, float percent)
+{
+    FrameSample sample;
+    sample.x = from.x + percent * between.x;
+    sample.y = from.y + percent * between.y;
+    sample.scaleX = from.scaleX + percent * between.scaleX;
+    sample.scaleY = from.scaleY + percent * between.scaleY;
+    sample.skewX = from.skewX + percent * between.skewX;
+    sample.skewY = from.skewY + percent * between.skewY;
+    sample.a = from.a + percent * between.a;
+    sample.r = from.r + percent * between.r;
+    sample.g = from.g + percent * between.g;
+    sample.b = from.b + percent * between.b;
+    return sample;
+}
+
+void MovementBoneData::bakeSamples(TweenType movementEasing)
+{
+    samples.clear();
+    sampleEasing = movementEasing;
+
+    long length = frameList.size();
+    if (length < 2)
+    {
+        return;
+    }
+
+    for (long i = 1; i < length; i++)
+    {
+        if (frameList.at(i)->frameID < frameList.at(i - 1)->frameID)
+        {
+            return;
+        }
+    }
+
+    sampleStart = frameList.at(0)->frameID;
+    samples.reserve(frameList.at(length - 1)->frameID - sampleStart + 1);
+
+    FrameData from;
+    BaseData between;
+
+    for (long i = 0; i < length - 1; i++)
+    {
+        FrameData *fromFrame = frameList.at(i);
+        FrameData *toFrame = frameList.at(i + 1);
+
+        //! same from and between values as Tween::setBetween(fromFrame, toFrame, false)
+        between.isUseColorInfo = false;
+        if (fromFrame->displayIndex < 0 && toFrame->displayIndex >= 0)
+        {
+            from.copy(toFrame);
+            between.subtract(toFrame, toFrame, false);
+        }
+        else if (toFrame->displayIndex < 0 && fromFrame->displayIndex >= 0)
+        {
+            from.copy(fromFrame);
+            between.subtract(toFrame, toFrame, false);
+        }
+        else
+        {
+            from.copy(fromFrame);
+            between.subtract(fromFrame, toFrame, false);
+        }
+
+        TweenType tweenType = (fromFrame->tweenEasing != Linear) ? fromFrame->tweenEasing : movementEasing;
+        int frameCount = toFrame->frameID - fromFrame->frameID;
+
+        for (int frame = 0; frame < frameCount; frame++)
+        {
+            //! a key frame which doesn't tween holds its value until the next one, as in Tween::tweenNodeTo()
+            float percent = from.isTween ? (float)frame / frameCount : 0;
+            if (from.isTween && tweenType != TWEEN_EASING_MAX && tweenType != Linear && tweenType != CUSTOM_EASING)
+            {
+                percent = TweenFunction::tweenTo(percent, tweenType, from.easingParams);
+            }
+            samples.push_back(makeFrameSample(from, between, percent));
+        }
+
+        if (i == length - 2)
+        {
+            samples.push_back(makeFrameSample(from, between, 1));
+        }
+    }
+}
+
 
 
 MovementData::MovementData(void)
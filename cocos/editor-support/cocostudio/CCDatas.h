@@ -351,6 +351,19 @@ public:
     std::string strSoundEffect;
 };
 
+/**
+ * Transform and color of a bone at one frame, baked from the key frames of a MovementBoneData
+ *  @js NA
+ *  @lua NA
+ */
+struct FrameSample
+{
+    float x, y;
+    float scaleX, scaleY;
+    float skewX, skewY;
+    float a, r, g, b;
+};
+
 /**
  *  @js NA
  *  @lua NA
@@ -374,6 +387,14 @@ public:
 
     void addFrameData(FrameData *frameData);
     FrameData *getFrameData(int index);
+
+    /*
+    * Samples the eased key frames once per frame, from the first to the last key frame, so
+    * Tween only interpolates between two samples during playback. Called after the frames are loaded.
+    *
+    * @param  movementEasing  The tween easing of the MovementData, used by frames with Linear easing
+    */
+    void bakeSamples(TweenType movementEasing);
 public:
     float delay;             //! movement delay percent, this value can produce a delay effect
     float scale;             //! scale this movement
@@ -381,6 +402,10 @@ public:
     std::string name;    //! bone name
 
     cocos2d::Vector<FrameData*> frameList;
+
+    std::vector<FrameSample> samples;   //! one sample per frame starting at sampleStart, empty if the frames are not baked
+    int sampleStart;                    //! frameID of samples[0]
+    TweenType sampleEasing;             //! the movement tween easing the samples were baked with
 };
 
 /**
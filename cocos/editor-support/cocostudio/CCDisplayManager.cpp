@@ -51,6 +51,8 @@ DisplayManager::DisplayManager()
     , _currentDecoDisplay(nullptr)
     , _displayIndex(-1)
     , _forceChangeDisplay(false)
+    , _pendingDisplayIndex(-1)
+    , _displayChangePending(false)
     , _visible(true)
     , _bone(nullptr)
 {
@@ -104,6 +106,11 @@ void DisplayManager::addDisplay(DisplayData *displayData, int index)
 
     DisplayFactory::addDisplay(_bone, decoDisplay, displayData);
 
+    if (Armature *armature = _bone->getArmature())
+    {
+        armature->setParallelUpdateDirty();
+    }
+
     //! if changed display index is current display index, then change current display to the new display
     if(index == _displayIndex)
     {
@@ -189,6 +196,11 @@ void DisplayManager::addDisplay(Node *display, int index)
     decoDisplay->setDisplay(display);
     decoDisplay->setDisplayData(displayData);
 
+    if (Armature *armature = _bone->getArmature())
+    {
+        armature->setParallelUpdateDirty();
+    }
+
     //! if changed display index is current display index, then change current display to the new display
     if(index == _displayIndex)
     {
@@ -206,6 +218,11 @@ void DisplayManager::removeDisplay(int index)
     }
 
     _decoDisplayList.erase(index);
+
+    if (Armature *armature = _bone->getArmature())
+    {
+        armature->setParallelUpdateDirty();
+    }
 }
 
 const cocos2d::Vector<DecorativeDisplay*>& DisplayManager::getDecorativeDisplayList() const
@@ -219,6 +236,15 @@ void DisplayManager::changeDisplayByIndex(int index, bool force)
 
     _forceChangeDisplay = force;
 
+    if (Armature::isUpdatingQueuedArmatures())
+    {
+        // switching the display node touches the scene graph, Armature::finishQueuedUpdate() applies it
+        _pendingDisplayIndex = index;
+        _displayChangePending = true;
+        return;
+    }
+    _displayChangePending = false;
+
     //! If index is equal to current display index,then do nothing
     if ( _displayIndex == index)
         return;
@@ -243,6 +269,14 @@ void DisplayManager::changeDisplayByIndex(int index, bool force)
     setCurrentDecorativeDisplay(decoDisplay);
 }
 
+void DisplayManager::applyPendingDisplayChange()
+{
+    if (_displayChangePending)
+    {
+        changeDisplayByIndex(_pendingDisplayIndex, _forceChangeDisplay);
+    }
+}
+
 void CCDisplayManager::changeDisplayByName(const std::string& name, bool force)
 {
     for (int i = 0; i<_decoDisplayList.size(); i++)
@@ -341,6 +375,11 @@ void DisplayManager::initDisplayList(BoneData *boneData)
 {
     _decoDisplayList.clear();
 
+    if (Armature *armature = _bone->getArmature())
+    {
+        armature->setParallelUpdateDirty();
+    }
+
     CS_RETURN_IF(!boneData);
 
     for(auto& object : boneData->displayDataList)
@@ -129,6 +129,15 @@ public:
 
     virtual void setForceChangeDisplay(bool force) { _forceChangeDisplay = force; }
     virtual bool isForceChangeDisplay() const { return _forceChangeDisplay; }
+
+    /**
+     * Whether a display change made while queued armatures were updated waits to be applied.
+     */
+    bool isDisplayChangePending() const { return _displayChangePending; }
+    /**
+     * Applies the display change recorded while queued armatures were updated, called on the main thread.
+     */
+    void applyPendingDisplayChange();
 protected:
     cocos2d::Vector<DecorativeDisplay*> _decoDisplayList;
     //! Display render node.
@@ -142,6 +151,10 @@ protected:
 
     bool _forceChangeDisplay;
 
+    //! Display index recorded by changeDisplayByIndex() while queued armatures were updated
+    int _pendingDisplayIndex;
+    bool _displayChangePending;
+
     //! Whether of not the bone is visible. Default is true
     bool _visible;
 
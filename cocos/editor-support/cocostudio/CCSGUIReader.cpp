@@ -126,15 +126,29 @@ Widget* GUIReader::widgetFromJsonFile(const char *fileName)
     int pos = jsonpath.find_last_of('/');
     m_strFilePath = jsonpath.substr(0,pos+1);
 
-    std::string des = FileUtils::getInstance()->getStringFromFile(jsonpath);
-    if (des.empty())
+    Data data = FileUtils::getInstance()->getDataFromFile(jsonpath);
+    if (data.isNull())
     {
         CCLOG("read json file[%s] error!\n", fileName);
         return nullptr;
     }
 
     jsonDict = new JsonDictionary();
-    jsonDict->initWithDescription(des.c_str());
+    // layouts converted by json2csb.py are read in place, no json is parsed
+    if (JsonDictionary::isBinaryData(data.getBytes(), data.getSize()))
+    {
+        if (!jsonDict->initWithBinary(data.getBytes(), data.getSize()))
+        {
+            CCLOG("read binary file[%s] error!\n", fileName);
+            delete jsonDict;
+            return nullptr;
+        }
+    }
+    else
+    {
+        std::string des((const char *)data.getBytes(), data.getSize());
+        jsonDict->initWithDescription(des.c_str());
+    }
     
     Widget* widget = nullptr;
     const char* fileVersion = dicHelper->getStringValue_json(jsonDict, "version");
@@ -29,20 +29,15 @@ using namespace cocos2d;
 
 namespace cocostudio {
 
-AffineTransform TransformHelp::helpMatrix1;
-AffineTransform TransformHelp::helpMatrix2;
-
-Point TransformHelp::helpPoint1;
-Point TransformHelp::helpPoint2;
-
-BaseData helpParentNode;
-
 TransformHelp::TransformHelp()
 {
 }
 
 void TransformHelp::transformFromParent(BaseData &node, const BaseData &parentNode)
 {
+    // no static scratch state, armature files are decoded on several threads
+    AffineTransform helpMatrix1, helpMatrix2;
+
     nodeToMatrix(node, helpMatrix1);
     nodeToMatrix(parentNode, helpMatrix2);
 
@@ -54,6 +49,7 @@ void TransformHelp::transformFromParent(BaseData &node, const BaseData &parentNo
 
 void TransformHelp::transformToParent(BaseData &node, const BaseData &parentNode)
 {
+    AffineTransform helpMatrix1, helpMatrix2;
 
     nodeToMatrix(node, helpMatrix1);
     nodeToMatrix(parentNode, helpMatrix2);
@@ -65,6 +61,8 @@ void TransformHelp::transformToParent(BaseData &node, const BaseData &parentNode
 
 void TransformHelp::transformFromParentWithoutScale(BaseData &node, const BaseData &parentNode)
 {
+    AffineTransform helpMatrix1, helpMatrix2;
+    BaseData helpParentNode;
 
     helpParentNode.copy(&parentNode);
     helpParentNode.scaleX = 1;
@@ -81,6 +79,8 @@ void TransformHelp::transformFromParentWithoutScale(BaseData &node, const BaseDa
 
 void TransformHelp::transformToParentWithoutScale(BaseData &node, const BaseData &parentNode)
 {
+    AffineTransform helpMatrix1, helpMatrix2;
+    BaseData helpParentNode;
 
     helpParentNode.copy(&parentNode);
     helpParentNode.scaleX = 1;
@@ -151,6 +151,8 @@ void TransformHelp::matrixToNode(const AffineTransform &matrix, BaseData &node)
      *  In as3 language, there is a function called "deltaTransformPoint", it calculate a point used give Transform
      *  but not used the tx, ty value. we simulate the function here
      */
+    Point helpPoint1, helpPoint2;
+
     helpPoint1.x = 0;
     helpPoint1.y = 1;
     helpPoint1 = PointApplyAffineTransform(helpPoint1, matrix);
@@ -177,6 +179,8 @@ void TransformHelp::matrixToNode(const kmMat4 &matrix, BaseData &node)
      *  In as3 language, there is a function called "deltaTransformPoint", it calculate a point used give Transform
      *  but not used the tx, ty value. we simulate the function here
      */
+    Point helpPoint1, helpPoint2;
+
     helpPoint1.x = 0;
     helpPoint1.y = 1;
     helpPoint1 = PointApplyTransform(helpPoint1, matrix);
@@ -53,12 +53,6 @@ public:
 
     static void nodeConcat(BaseData &target, BaseData &source);
     static void nodeSub(BaseData &target, BaseData &source);
-public:
-    static cocos2d::AffineTransform helpMatrix1;
-    static cocos2d::AffineTransform helpMatrix2;
-
-    static cocos2d::Point helpPoint1;
-    static cocos2d::Point helpPoint2;
 };
 
 }
@@ -62,6 +62,8 @@ Tween::Tween()
     , _toIndex(0)
     , _animation(nullptr)
     , _passLastFrame(false)
+    , _sampleIndex(-1)
+    , _sampleWeight(0)
 {
 
 }
@@ -289,6 +291,8 @@ void Tween::updateHandler()
 
 void Tween::setBetween(FrameData *from, FrameData *to, bool limit)
 {
+    _sampleIndex = -1;
+
     do
     {
         if(from->displayIndex < 0 && to->displayIndex >= 0)
@@ -356,6 +360,35 @@ FrameData *Tween::tweenNodeTo(float percent, FrameData *node)
 {
     node = node == nullptr ? _tweenData : node;
 
+    if (_sampleIndex >= 0)
+    {
+        //! the key frames were baked, interpolate between the two samples around the played frame
+        const FrameSample &from = _movementBoneData->samples[_sampleIndex];
+        const FrameSample &to = _movementBoneData->samples[_sampleIndex + 1];
+        float weight = _sampleWeight;
+        _sampleIndex = -1;
+
+        node->x = from.x + weight * (to.x - from.x);
+        node->y = from.y + weight * (to.y - from.y);
+        node->scaleX = from.scaleX + weight * (to.scaleX - from.scaleX);
+        node->scaleY = from.scaleY + weight * (to.scaleY - from.scaleY);
+        node->skewX = from.skewX + weight * (to.skewX - from.skewX);
+        node->skewY = from.skewY + weight * (to.skewY - from.skewY);
+
+        _bone->setTransformDirty(true);
+
+        if (_between->isUseColorInfo)
+        {
+            node->a = from.a + weight * (to.a - from.a);
+            node->r = from.r + weight * (to.r - from.r);
+            node->g = from.g + weight * (to.g - from.g);
+            node->b = from.b + weight * (to.b - from.b);
+            _bone->updateColor();
+        }
+
+        return node;
+    }
+
     if (!_from->isTween)
     {
         percent = 0;
@@ -389,6 +422,8 @@ void Tween::tweenColorTo(float percent, FrameData *node)
 
 float Tween::updateFrameData(float currentPercent)
 {
+    _sampleIndex = -1;
+
     if (currentPercent > 1 && _movementBoneData->delay != 0)
     {
         currentPercent = fmodf(currentPercent, 1);
@@ -475,6 +510,23 @@ float Tween::updateFrameData(float currentPercent)
      *  If frame tween easing equal to TWEEN_EASING_MAX, then it will not do tween.
      */
     TweenType tweenType = (_frameTweenEasing != Linear) ? _frameTweenEasing : _tweenEasing;
+
+    /*
+     *  Use the baked samples unless the frame has a custom easing or holds its value, tweenNodeTo() reads them.
+     *  Between the last two samples of a held frame they would blend towards the next key frame.
+     */
+    if (tweenType != CUSTOM_EASING && _from->isTween && !_passLastFrame && !_movementBoneData->samples.empty() && _movementBoneData->sampleEasing == _tweenEasing)
+    {
+        float sampleFrame = playedTime - _movementBoneData->sampleStart;
+        int index = (int)sampleFrame;
+        if (sampleFrame >= 0 && index + 1 < (int)_movementBoneData->samples.size())
+        {
+            _sampleIndex = index;
+            _sampleWeight = sampleFrame - index;
+            return currentPercent;
+        }
+    }
+
     if (tweenType != TWEEN_EASING_MAX && tweenType != Linear && !_passLastFrame)
     {
         currentPercent = TweenFunction::tweenTo(currentPercent, tweenType, _from->easingParams);
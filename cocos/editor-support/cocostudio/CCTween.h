@@ -144,6 +144,9 @@ protected:
     ArmatureAnimation *_animation;
 
     bool _passLastFrame;            //! If current frame index is more than the last frame's index
+
+    int _sampleIndex;               //! Index in the baked samples of MovementBoneData for the next tweenNodeTo(), -1 to tween the key frames
+    float _sampleWeight;            //! Weight of the sample after _sampleIndex
 };
 
 }
@@ -0,0 +1,195 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+
+#include "cocostudio/CCWorkerPool.h"
+
+namespace cocostudio {
+
+static WorkerPool *s_sharedWorkerPool = nullptr;
+
+WorkerPool *WorkerPool::getInstance()
+{
+    if (s_sharedWorkerPool == nullptr)
+    {
+        s_sharedWorkerPool = new WorkerPool();
+    }
+    return s_sharedWorkerPool;
+}
+
+void WorkerPool::destroyInstance()
+{
+    CC_SAFE_DELETE(s_sharedWorkerPool);
+}
+
+WorkerPool::WorkerPool()
+    : _quit(false)
+{
+    int hardwareThreads = (int)std::thread::hardware_concurrency();
+    startThreads(hardwareThreads > 1 ? hardwareThreads - 1 : 0);
+}
+
+WorkerPool::~WorkerPool()
+{
+    stopThreads();
+}
+
+void WorkerPool::setThreadCount(int count)
+{
+    if (count != getThreadCount())
+    {
+        stopThreads();
+        startThreads(count);
+    }
+}
+
+int WorkerPool::getThreadCount() const
+{
+    return (int)_threads.size();
+}
+
+void WorkerPool::startThreads(int count)
+{
+    _quit = false;
+    for (int i = 0; i < count; ++i)
+    {
+        _threads.push_back(std::thread(&WorkerPool::workerLoop, this));
+    }
+}
+
+void WorkerPool::stopThreads()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _quit = true;
+    }
+    _condition.notify_all();
+
+    for (auto& thread : _threads)
+    {
+        thread.join();
+    }
+    _threads.clear();
+}
+
+void WorkerPool::workerLoop()
+{
+    while (true)
+    {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condition.wait(lock, [this]{ return _quit || !_jobs.empty(); });
+            // pending jobs are finished before quitting, parallelFor waits for them
+            if (_jobs.empty())
+            {
+                return;
+            }
+            job = std::move(_jobs.front());
+            _jobs.pop_front();
+        }
+        job();
+    }
+}
+
+void WorkerPool::parallelFor(int count, const std::function<void(int)>& task)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    int helpers = std::min(getThreadCount(), count - 1);
+    if (helpers == 0)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            task(i);
+        }
+        return;
+    }
+
+    // tasks are claimed one at a time, the caller keeps claiming until all are taken and then waits for the
+    // ones still running on the workers
+    struct Batch
+    {
+        std::atomic<int> next;
+        int finished;
+        std::mutex mutex;
+        std::condition_variable condition;
+    };
+    auto batch = std::make_shared<Batch>();
+    batch->next = 0;
+    batch->finished = 0;
+
+    auto run = [batch, count, &task]() {
+        int done = 0;
+        for (int i = batch->next++; i < count; i = batch->next++)
+        {
+            task(i);
+            ++done;
+        }
+        if (done > 0)
+        {
+            std::lock_guard<std::mutex> lock(batch->mutex);
+            batch->finished += done;
+            if (batch->finished == count)
+            {
+                batch->condition.notify_one();
+            }
+        }
+    };
+
+    // the caller is waiting, so the helpers go ahead of the jobs queued by addJob()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (int i = 0; i < helpers; ++i)
+        {
+            _jobs.push_front(run);
+        }
+    }
+    _condition.notify_all();
+
+    run();
+
+    std::unique_lock<std::mutex> lock(batch->mutex);
+    batch->condition.wait(lock, [&batch, count]{ return batch->finished == count; });
+}
+
+void WorkerPool::addJob(const std::function<void()>& job)
+{
+    if (getThreadCount() == 0)
+    {
+        job();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _jobs.push_back(job);
+    }
+    _condition.notify_one();
+}
+
+}
@@ -0,0 +1,92 @@
+/****************************************************************************
+Copyright (c) 2013 cocos2d-x.org
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+
+#ifndef __CCWORKERPOOL_H__
+#define __CCWORKERPOOL_H__
+
+#include "cocostudio/CCArmatureDefine.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cocostudio {
+
+/**
+ * A fixed set of worker threads shared by the armature runtime.
+ * Jobs must not touch the scene graph, the scheduler or autorelease pools, those are not thread safe.
+ *  @js NA
+ *  @lua NA
+ */
+class  WorkerPool
+{
+public:
+    static WorkerPool *getInstance();
+    static void destroyInstance();
+
+public:
+    WorkerPool();
+    ~WorkerPool();
+
+    /**
+     * Runs task(0) ... task(count - 1) on the workers and the calling thread, and returns when all of them finished.
+     * Tasks may run in any order and concurrently, with no workers they all run on the calling thread.
+     */
+    void parallelFor(int count, const std::function<void(int)>& task);
+
+    /**
+     * Queues a job and returns without waiting for it, jobs queued by parallelFor() run first.
+     * With no workers the job runs on the calling thread before addJob() returns.
+     */
+    void addJob(const std::function<void()>& job);
+
+    /**
+     * Sets the number of worker threads, the calling thread is not counted.
+     * Defaults to one less than the hardware concurrency. Must not be called from a job.
+     */
+    void setThreadCount(int count);
+    int getThreadCount() const;
+
+protected:
+    void startThreads(int count);
+    void stopThreads();
+    void workerLoop();
+
+    std::vector<std::thread> _threads;
+    std::deque<std::function<void()>> _jobs;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    bool _quit;
+};
+
+}
+
+#endif /*__CCWORKERPOOL_H__*/
@@ -25,11 +25,123 @@
  */
 
 #include <iostream>
+#include <string.h>
 #include "cocostudio/CSContentJsonDictionary.h"
 
 namespace cocostudio {
     
+    /*
+     * Binary documents are written by tools/cocostudio-converter/json2csb.py, all values little endian.
+     * Every value is an 8 byte record. Arrays and objects point to a block holding a uint32 count and
+     * then the items, 8 byte values for arrays and a uint32 key string index plus a value for objects.
+     * Keys and strings are indices into a table of null terminated strings.
+     */
+    struct JsonBinaryValue
+    {
+        unsigned char type;             //! DicItemType
+        unsigned char reserved[3];
+        union
+        {
+            int intValue;
+            unsigned int uintValue;
+            float floatValue;
+            unsigned int index;         //! string index, or boolean value
+            unsigned int offset;        //! block offset of arrays and objects
+        };
+    };
+
+    struct JsonBinaryMember
+    {
+        unsigned int key;
+        JsonBinaryValue value;
+    };
+
+    struct JsonBinaryHeader
+    {
+        char signature[4];
+        unsigned short version;
+        unsigned short reserved;
+        unsigned int stringCount;
+        unsigned int stringOffsets;     //! offset of a uint32 file offset per string
+        unsigned int stringData;        //! offset and size of the string characters
+        unsigned int stringDataSize;
+        JsonBinaryValue root;
+    };
+
+    static const char JSON_BINARY_SIGNATURE[4] = {'C', 'C', 'S', 'B'};
+    static const unsigned short JSON_BINARY_VERSION = 1;
+    static const int JSON_BINARY_MAX_DEPTH = 1000;
+
+    static_assert(sizeof(JsonBinaryValue) == 8, "JsonBinaryValue must match the file layout");
+    static_assert(sizeof(JsonBinaryMember) == 12, "JsonBinaryMember must match the file layout");
+    static_assert(sizeof(JsonBinaryHeader) == 32, "JsonBinaryHeader must match the file layout");
+
+    static inline bool isBinaryNumeric(const JsonBinaryValue *value)
+    {
+        return value->type == EDIC_TYPEINT || value->type == EDIC_TYPEUINT || value->type == EDIC_TYPEFLOAT || value->type == EDIC_TYPEBOOLEN;
+    }
+
+    static inline bool isBinaryContainer(const JsonBinaryValue *value)
+    {
+        return value->type == EDIC_TYPEARRAY || value->type == EDIC_TYPEOBJECT;
+    }
+
+    static inline double binaryNumber(const JsonBinaryValue *value)
+    {
+        switch (value->type)
+        {
+            case EDIC_TYPEINT:
+                return value->intValue;
+            case EDIC_TYPEUINT:
+                return value->uintValue;
+            case EDIC_TYPEFLOAT:
+                return value->floatValue;
+            default:
+                return value->index != 0 ? 1 : 0;
+        }
+    }
+
+    static inline int binaryInt(const JsonBinaryValue *value)
+    {
+        switch (value->type)
+        {
+            case EDIC_TYPEINT:
+                return value->intValue;
+            case EDIC_TYPEUINT:
+                return (int)value->uintValue;
+            case EDIC_TYPEFLOAT:
+                return (int)value->floatValue;
+            default:
+                return value->index != 0 ? 1 : 0;
+        }
+    }
+
+    /*
+     * Returns the items of an array or object block, or nullptr if the block is damaged. Blocks always
+     * follow the value pointing at them, so a damaged document can't make the lookups loop.
+     */
+    static const unsigned char *getBinaryBlock(const std::string &data, const JsonBinaryValue *value, unsigned int *count)
+    {
+        const unsigned char *base = (const unsigned char *)data.data();
+        size_t length = data.size();
+        size_t position = (const unsigned char *)value - base;
+        size_t offset = value->offset;
+        size_t recordSize = value->type == EDIC_TYPEOBJECT ? sizeof(JsonBinaryMember) : sizeof(JsonBinaryValue);
+
+        if (offset <= position || (offset & 3) != 0 || offset > length || length - offset < 4)
+            return nullptr;
+
+        unsigned int itemCount;
+        memcpy(&itemCount, base + offset, 4);
+        if (itemCount > (length - offset - 4) / recordSize)
+            return nullptr;
+
+        *count = itemCount;
+        return base + offset + 4;
+    }
+
     JsonDictionary::JsonDictionary()
+    : m_pBinaryValue(nullptr)
     {
         m_cValue.clear();
     }
@@ -41,9 +153,17 @@ namespace cocostudio {
     }
     
     
+    bool JsonDictionary::isBinaryData(const unsigned char *pData, long nLength)
+    {
+        return pData && nLength >= (long)sizeof(JsonBinaryHeader) && memcmp(pData, JSON_BINARY_SIGNATURE, 4) == 0;
+    }
+
+
     void JsonDictionary::initWithDescription(const char *pszDescription)
     {
         Json::Reader cReader;
+        m_pBinaryData.reset();
+        m_pBinaryValue = nullptr;
         m_cValue.clear();
         if (pszDescription && *pszDescription)
         {
@@ -53,43 +173,237 @@ namespace cocostudio {
     }
     
     
+    bool JsonDictionary::initWithBinary(const unsigned char *pData, long nLength)
+    {
+        m_pBinaryData.reset();
+        m_pBinaryValue = nullptr;
+        m_cValue.clear();
+
+        if (!isBinaryData(pData, nLength))
+            return false;
+
+        std::shared_ptr<std::string> data = std::make_shared<std::string>((const char *)pData, (size_t)nLength);
+        const unsigned char *base = (const unsigned char *)data->data();
+        size_t length = data->size();
+        const JsonBinaryHeader *header = (const JsonBinaryHeader *)base;
+
+        if (header->version != JSON_BINARY_VERSION || !isBinaryContainer(&header->root))
+            return false;
+
+        // every string has to end inside the string data, the lookups rely on it
+        if (header->stringData > length || header->stringDataSize == 0 || header->stringDataSize > length - header->stringData
+            || base[header->stringData + header->stringDataSize - 1] != 0)
+            return false;
+        if ((header->stringOffsets & 3) != 0 || header->stringOffsets > length || header->stringCount > (length - header->stringOffsets) / 4)
+            return false;
+
+        const unsigned int *offsets = (const unsigned int *)(base + header->stringOffsets);
+        for (unsigned int i = 0; i < header->stringCount; i++)
+        {
+            if (offsets[i] < header->stringData || offsets[i] - header->stringData >= header->stringDataSize)
+                return false;
+        }
+
+        m_pBinaryData = data;
+        m_pBinaryValue = &header->root;
+        return true;
+    }
+
+
     void JsonDictionary::initWithValue(Json::Value& value)
     {
         m_cValue = value;
     }
     
     
+    void JsonDictionary::initWithBinaryValue(const std::shared_ptr<std::string>& data, const JsonBinaryValue *value)
+    {
+        m_pBinaryData = data;
+        m_pBinaryValue = value;
+    }
+
+
+    void JsonDictionary::convertBinaryToValue()
+    {
+        if (!m_pBinaryData)
+            return;
+
+        Json::Value value = binaryToValue(m_pBinaryValue, 0);
+        m_pBinaryData.reset();
+        m_pBinaryValue = nullptr;
+        m_cValue = value;
+    }
+
+
+    const JsonBinaryValue *JsonDictionary::getBinaryItem(const JsonBinaryValue *container, int nIndex, const char **pszKey)
+    {
+        unsigned int count = 0;
+        const unsigned char *items = getBinaryBlock(*m_pBinaryData, container, &count);
+        if (!items || nIndex < 0 || (unsigned int)nIndex >= count)
+            return nullptr;
+
+        if (container->type == EDIC_TYPEOBJECT)
+        {
+            const JsonBinaryMember *member = (const JsonBinaryMember *)items + nIndex;
+            if (pszKey)
+            {
+                JsonBinaryValue key;
+                key.type = EDIC_TYPESTRING;
+                key.index = member->key;
+                *pszKey = getBinaryString(&key);
+            }
+            return &member->value;
+        }
+
+        if (pszKey)
+            *pszKey = nullptr;
+        return (const JsonBinaryValue *)items + nIndex;
+    }
+
+
+    int JsonDictionary::getBinaryItemCount(const JsonBinaryValue *container)
+    {
+        unsigned int count = 0;
+        if (!isBinaryContainer(container) || !getBinaryBlock(*m_pBinaryData, container, &count))
+            return 0;
+
+        return (int)count;
+    }
+
+
+    const char *JsonDictionary::getBinaryString(const JsonBinaryValue *value)
+    {
+        const JsonBinaryHeader *header = (const JsonBinaryHeader *)m_pBinaryData->data();
+        if (value->type != EDIC_TYPESTRING || value->index >= header->stringCount)
+            return nullptr;
+
+        const unsigned int *offsets = (const unsigned int *)(m_pBinaryData->data() + header->stringOffsets);
+        return m_pBinaryData->data() + offsets[value->index];
+    }
+
+
+    const JsonBinaryValue *JsonDictionary::getBinaryMember(const char *pszKey)
+    {
+        if (m_pBinaryValue->type != EDIC_TYPEOBJECT || !pszKey)
+            return nullptr;
+
+        unsigned int count = 0;
+        const JsonBinaryMember *members = (const JsonBinaryMember *)getBinaryBlock(*m_pBinaryData, m_pBinaryValue, &count);
+        if (!members)
+            return nullptr;
+
+        const JsonBinaryHeader *header = (const JsonBinaryHeader *)m_pBinaryData->data();
+        const unsigned int *offsets = (const unsigned int *)(m_pBinaryData->data() + header->stringOffsets);
+        for (unsigned int i = 0; i < count; i++)
+        {
+            if (members[i].key < header->stringCount && strcmp(m_pBinaryData->data() + offsets[members[i].key], pszKey) == 0)
+                return &members[i].value;
+        }
+
+        return nullptr;
+    }
+
+
+    const JsonBinaryValue *JsonDictionary::getBinaryArrayItem(const char *pszArrayKey, int nIndex)
+    {
+        const JsonBinaryValue *array = getBinaryMember(pszArrayKey);
+        if (!array || array->type != EDIC_TYPEARRAY)
+            return nullptr;
+
+        return getBinaryItem(array, nIndex, nullptr);
+    }
+
+
+    JsonDictionary *JsonDictionary::createBinarySubDictionary(const JsonBinaryValue *value)
+    {
+        JsonDictionary * pNewDictionary = new JsonDictionary();
+        pNewDictionary->initWithBinaryValue(m_pBinaryData, value);
+        return pNewDictionary;
+    }
+
+
+    Json::Value JsonDictionary::binaryToValue(const JsonBinaryValue *value, int depth)
+    {
+        switch (value->type)
+        {
+            case EDIC_TYPEINT:
+                return Json::Value(value->intValue);
+            case EDIC_TYPEUINT:
+                return Json::Value(value->uintValue);
+            case EDIC_TYPEFLOAT:
+                return Json::Value((double)value->floatValue);
+            case EDIC_TYPESTRING:
+            {
+                const char *str = getBinaryString(value);
+                return str ? Json::Value(str) : Json::Value();
+            }
+            case EDIC_TYPEBOOLEN:
+                return Json::Value(value->index != 0);
+            case EDIC_TYPEARRAY:
+            case EDIC_TYPEOBJECT:
+            {
+                Json::Value container(value->type == EDIC_TYPEARRAY ? Json::arrayValue : Json::objectValue);
+                if (depth >= JSON_BINARY_MAX_DEPTH)
+                    return container;
+
+                int count = getBinaryItemCount(value);
+                for (int i = 0; i < count; i++)
+                {
+                    const char *key = nullptr;
+                    const JsonBinaryValue *item = getBinaryItem(value, i, &key);
+                    if (value->type == EDIC_TYPEARRAY)
+                        container.append(binaryToValue(item, depth + 1));
+                    else if (key)
+                        container[key] = binaryToValue(item, depth + 1);
+                }
+                return container;
+            }
+            default:
+                return Json::Value();
+        }
+    }
+
+
     void JsonDictionary::insertItem(const char *pszKey, int nValue)
     {
+        convertBinaryToValue();
         m_cValue[pszKey] = nValue;
     }
     
     
     void JsonDictionary::insertItem(const char *pszKey, double fValue)
     {
+        convertBinaryToValue();
         m_cValue[pszKey] = fValue;
     }
     
     
     void JsonDictionary::insertItem(const char *pszKey, const char * pszValue)
     {
+        convertBinaryToValue();
         m_cValue[pszKey] = pszValue;
     }
     
     void JsonDictionary::insertItem(const char *pszKey, bool bValue)
     {
+        convertBinaryToValue();
         m_cValue[pszKey] = bValue;
     }
     
     void JsonDictionary::insertItem(const char *pszKey, JsonDictionary * subDictionary)
     {
+        convertBinaryToValue();
         if (subDictionary)
+        {
+            subDictionary->convertBinaryToValue();
             m_cValue[pszKey] = subDictionary->m_cValue;
+        }
     }
     
     
     bool JsonDictionary::deleteItem(const char *pszKey)
     {
+        convertBinaryToValue();
         if(!m_cValue.isMember(pszKey))
             return false;
         
@@ -101,18 +415,29 @@ namespace cocostudio {
     
     void JsonDictionary::cleanUp()
     {
+        m_pBinaryData.reset();
+        m_pBinaryValue = nullptr;
         m_cValue.clear();
     }
     
     
     bool JsonDictionary::isKeyValidate(const char *pszKey)
     {
+        if (m_pBinaryData)
+            return getBinaryMember(pszKey) != nullptr;
+
         return m_cValue.isMember(pszKey);
     }
     
     
     int JsonDictionary::getItemIntValue(const char *pszKey, int nDefaultValue)
     {
+        if (m_pBinaryData)
+        {
+            const JsonBinaryValue *value = getBinaryMember(pszKey);
+            return value && isBinaryNumeric(value) ? binaryInt(value) : nDefaultValue;
+        }
+
         if (!isKeyValidate(pszKey, m_cValue) || !m_cValue[pszKey].isNumeric())
             return nDefaultValue;
         
@@ -122,6 +447,12 @@ namespace cocostudio {
     
     double JsonDictionary::getItemFloatValue(const char *pszKey, double fDefaultValue)
     {
+        if (m_pBinaryData)
+        {
+            const JsonBinaryValue *value = getBinaryMember(pszKey);
+            return value && isBinaryNumeric(value) ? binaryNumber(value) : fDefaultValue;
+        }
+
         if (!isKeyValidate(pszKey, m_cValue) || !m_cValue[pszKey].isNumeric())
             return fDefaultValue;
         
@@ -131,6 +462,12 @@ namespace cocostudio {
     
     const char * JsonDictionary::getItemStringValue(const char *pszKey)
     {
+        if (m_pBinaryData)
+        {
+            const JsonBinaryValue *value = getBinaryMember(pszKey);
+            return value ? getBinaryString(value) : nullptr;
+        }
+
         if (!isKeyValidate(pszKey, m_cValue) || !m_cValue[pszKey].isString())
             return nullptr;
         
@@ -139,6 +476,12 @@ namespace cocostudio {
     
     bool JsonDictionary::getItemBoolvalue(const char *pszKey, bool bDefaultValue)
     {
+        if (m_pBinaryData)
+        {
+            const JsonBinaryValue *value = getBinaryMember(pszKey);
+            return value && value->type == EDIC_TYPEBOOLEN ? value->index != 0 : bDefaultValue;
+        }
+
         if (!isKeyValidate(pszKey, m_cValue) || !m_cValue[pszKey].isBool())
             return bDefaultValue;
         
@@ -148,6 +491,17 @@ namespace cocostudio {
     
     JsonDictionary * JsonDictionary::getSubDictionary(const char *pszKey)
     {
+        if (m_pBinaryData)
+        {
+            const JsonBinaryValue *value = getBinaryMember(pszKey);
+            if (!value)
+                return nullptr;
+            // like Json::Value, null converts to an empty dictionary
+            if (value->type == EDIC_TYPENULL)
+                return new JsonDictionary();
+            return isBinaryContainer(value) ? createBinarySubDictionary(value) : nullptr;
+        }
+
         JsonDictionary * pNewDictionary;
         if (!isKeyValidate(pszKey, m_cValue) || (!m_cValue[pszKey].isArray() &&
                                                  !m_cValue[pszKey].isObject() &&
@@ -167,6 +521,9 @@ namespace cocostudio {
     
     std::string JsonDictionary::getDescription()
     {
+        if (m_pBinaryData)
+            return binaryToValue(m_pBinaryValue, 0).toStyledString();
+
         std::string strReturn = m_cValue.toStyledString();
         return strReturn;
     }
@@ -174,6 +531,7 @@ namespace cocostudio {
     
     bool JsonDictionary::insertItemToArray(const char *pszArrayKey, int nValue)
     {
+        convertBinaryToValue();
         Json::Value array;
         if(m_cValue.isMember(pszArrayKey))
         {
@@ -192,6 +550,7 @@ namespace cocostudio {
     
     bool JsonDictionary::insertItemToArray(const char *pszArrayKey, double fValue)
     {
+        convertBinaryToValue();
         Json::Value array;
         if(m_cValue.isMember(pszArrayKey))
         {
@@ -210,6 +569,7 @@ namespace cocostudio {
     
     bool JsonDictionary::insertItemToArray(const char *pszArrayKey, const char * pszValue)
     {
+        convertBinaryToValue();
         Json::Value array;
         if(m_cValue.isMember(pszArrayKey))
         {
@@ -228,6 +588,8 @@ namespace cocostudio {
     
     bool JsonDictionary::insertItemToArray(const char *pszArrayKey, JsonDictionary * subDictionary)
     {
+        convertBinaryToValue();
+        subDictionary->convertBinaryToValue();
         Json::Value array;
         if(m_cValue.isMember(pszArrayKey))
         {
@@ -246,29 +608,67 @@ namespace cocostudio {
     
     int JsonDictionary::getItemCount()
     {
+        if (m_pBinaryData)
+            return getBinaryItemCount(m_pBinaryValue);
+
         return m_cValue.size();
     }
     
     
     DicItemType JsonDictionary::getItemType(int nIndex)
     {
+        if (m_pBinaryData)
+        {
+            const JsonBinaryValue *value = m_pBinaryValue->type == EDIC_TYPEARRAY ? getBinaryItem(m_pBinaryValue, nIndex, nullptr) : nullptr;
+            return value && value->type <= EDIC_TYPEOBJECT ? (DicItemType)value->type : EDIC_TYPENULL;
+        }
+
         return (DicItemType)m_cValue[nIndex].type();
     }
     
     
     DicItemType JsonDictionary::getItemType(const char *pszKey)
     {
+        if (m_pBinaryData)
+        {
+            const JsonBinaryValue *value = getBinaryMember(pszKey);
+            return value && value->type <= EDIC_TYPEOBJECT ? (DicItemType)value->type : EDIC_TYPENULL;
+        }
+
         return (DicItemType)m_cValue[pszKey].type();
     }
     
     std::vector<std::string> JsonDictionary::getAllMemberNames()
     {
+        if (m_pBinaryData)
+        {
+            std::vector<std::string> names;
+            if (m_pBinaryValue->type == EDIC_TYPEOBJECT)
+            {
+                int count = getBinaryItemCount(m_pBinaryValue);
+                for (int i = 0; i < count; i++)
+                {
+                    const char *key = nullptr;
+                    getBinaryItem(m_pBinaryValue, i, &key);
+                    if (key)
+                        names.push_back(key);
+                }
+            }
+            return names;
+        }
+
         return m_cValue.getMemberNames();
     }
     
     
     int JsonDictionary::getArrayItemCount(const char *pszArrayKey)
     {
+        if (m_pBinaryData)
+        {
+            const JsonBinaryValue *value = getBinaryMember(pszArrayKey);
+            return value ? getBinaryItemCount(value) : 0;
+        }
+
         int nRet = 0;
         if (!isKeyValidate(pszArrayKey, m_cValue) ||
             (!m_cValue[pszArrayKey].isArray() && !m_cValue[pszArrayKey].isObject() &&
@@ -288,6 +688,12 @@ namespace cocostudio {
     
     int JsonDictionary::getIntValueFromArray(const char *pszArrayKey, int nIndex, int nDefaultValue)
     {
+        if (m_pBinaryData)
+        {
+            const JsonBinaryValue *value = getBinaryArrayItem(pszArrayKey, nIndex);
+            return value && isBinaryNumeric(value) ? binaryInt(value) : nDefaultValue;
+        }
+
         int nRet = nDefaultValue;
         Json::Value * arrayValue = validateArrayItem(pszArrayKey, nIndex);
         if (arrayValue)
@@ -302,6 +708,12 @@ namespace cocostudio {
     
     double JsonDictionary::getFloatValueFromArray(const char *pszArrayKey, int nIndex, double fDefaultValue)
     {
+        if (m_pBinaryData)
+        {
+            const JsonBinaryValue *value = getBinaryArrayItem(pszArrayKey, nIndex);
+            return value && isBinaryNumeric(value) ? binaryNumber(value) : fDefaultValue;
+        }
+
         double fRet = fDefaultValue;
         Json::Value * arrayValue = validateArrayItem(pszArrayKey, nIndex);
         if (arrayValue)
@@ -315,6 +727,12 @@ namespace cocostudio {
     
     bool JsonDictionary::getBoolValueFromArray(const char *pszArrayKey, int nIndex, bool bDefaultValue)
     {
+        if (m_pBinaryData)
+        {
+            const JsonBinaryValue *value = getBinaryArrayItem(pszArrayKey, nIndex);
+            return value && isBinaryNumeric(value) ? binaryNumber(value) != 0 : bDefaultValue;
+        }
+
         bool bRet = bDefaultValue;
         Json::Value * arrayValue = validateArrayItem(pszArrayKey, nIndex);
         if (arrayValue)
@@ -329,6 +747,12 @@ namespace cocostudio {
     
     const char * JsonDictionary::getStringValueFromArray(const char *pszArrayKey, int nIndex)
     {
+        if (m_pBinaryData)
+        {
+            const JsonBinaryValue *value = getBinaryArrayItem(pszArrayKey, nIndex);
+            return value ? getBinaryString(value) : nullptr;
+        }
+
         Json::Value * arrayValue = validateArrayItem(pszArrayKey, nIndex);
         if (arrayValue)
         {
@@ -342,6 +766,12 @@ namespace cocostudio {
     
     JsonDictionary * JsonDictionary::getSubItemFromArray(const char *pszArrayKey, int nIndex)
     {
+        if (m_pBinaryData)
+        {
+            const JsonBinaryValue *value = getBinaryArrayItem(pszArrayKey, nIndex);
+            return value && isBinaryContainer(value) ? createBinarySubDictionary(value) : nullptr;
+        }
+
         Json::Value * arrayValue = validateArrayItem(pszArrayKey, nIndex);
         if (arrayValue)
         {
@@ -359,6 +789,12 @@ namespace cocostudio {
     
     DicItemType JsonDictionary::getItemTypeFromArray(const char *pszArrayKey, int nIndex)
     {
+        if (m_pBinaryData)
+        {
+            const JsonBinaryValue *value = getBinaryArrayItem(pszArrayKey, nIndex);
+            return value && value->type <= EDIC_TYPEOBJECT ? (DicItemType)value->type : EDIC_TYPENULL;
+        }
+
         Json::Value * arrayValue = validateArrayItem(pszArrayKey, nIndex);
         if (arrayValue)
             return (DicItemType)((*arrayValue)[nIndex].type());
@@ -31,6 +31,7 @@
 #include "json/json.h"
 #include <vector>
 #include <string>
+#include <memory>
 
 namespace cocostudio {
 
@@ -49,14 +50,28 @@ namespace cocostudio {
      *  @js NA
      *  @lua NA
      */
+    struct JsonBinaryValue;
+
     class JsonDictionary
     {
     public:
         JsonDictionary();
         virtual ~JsonDictionary();
 
+        /**
+         * Whether the data is a binary document written by tools/cocostudio-converter/json2csb.py.
+         */
+        static bool isBinaryData(const unsigned char *pData, long nLength);
+
     public:
         void    initWithDescription(const char *pszDescription);
+        /**
+         * Reads a binary document without parsing it, the lookups work on the binary records directly.
+         * Sub dictionaries share the data instead of copying their part of the document.
+         * The dictionary is converted to a Json::Value on the first modification.
+         * @return false if the data is not a valid binary document
+         */
+        bool    initWithBinary(const unsigned char *pData, long nLength);
         void    insertItem(const char *pszKey, int nValue);
         void    insertItem(const char *pszKey, double fValue);
         void    insertItem(const char *pszKey, const char * pszValue);
@@ -95,8 +110,22 @@ namespace cocostudio {
     protected:
         Json::Value m_cValue;
 
+        std::shared_ptr<std::string> m_pBinaryData;     //! binary document shared with the sub dictionaries, null for Json::Value dictionaries
+        const JsonBinaryValue *m_pBinaryValue;         //! the object or array in m_pBinaryData this dictionary reads
+
     private:
         void initWithValue(Json::Value& value);
+        void initWithBinaryValue(const std::shared_ptr<std::string>& data, const JsonBinaryValue *value);
+        void convertBinaryToValue();
+
+        const JsonBinaryValue *getBinaryMember(const char *pszKey);
+        const JsonBinaryValue *getBinaryArrayItem(const char *pszArrayKey, int nIndex);
+        const JsonBinaryValue *getBinaryItem(const JsonBinaryValue *container, int nIndex, const char **pszKey);
+        int getBinaryItemCount(const JsonBinaryValue *container);
+        const char *getBinaryString(const JsonBinaryValue *value);
+        JsonDictionary *createBinarySubDictionary(const JsonBinaryValue *value);
+        Json::Value binaryToValue(const JsonBinaryValue *value, int depth);
+
         inline bool isKeyValidate(const char *pszKey, Json::Value& root);
         inline Json::Value * validateArrayItem(const char *pszArrayKey, int nIndex);
     };
@@ -33,6 +33,9 @@
 
 #include <spine/CCSkeleton.h>
 #include <spine/spine-cocos2dx.h>
+#include <spine/CCSkeletonAnimation.h>
+#include "CCQuadCommand.h"
+#include "CCCustomCommand.h"
 
 USING_NS_CC;
 using std::min;
@@ -69,7 +72,7 @@ void Skeleton::initialize () {
     
 	setOpacityModifyRGB(true);
 
-    setShaderProgram(ShaderCache::getInstance()->getProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR));
+    setShaderProgram(ShaderCache::getInstance()->getProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR_NO_MVP));
 	scheduleUpdate();
 }
 
@@ -117,7 +120,11 @@ Skeleton::Skeleton (const char* skeletonDataFile, const char* atlasFile, float s
 }
 
 Skeleton::~Skeleton () {
-	if (ownsSkeletonData) spSkeletonData_dispose(skeleton->data);
+	if (ownsSkeletonData) {
+		SkeletonPoseCache* poseCache = SkeletonPoseCache::getExistingInstance();
+		if (poseCache) poseCache->removeSkeletonData(skeleton->data);
+		spSkeletonData_dispose(skeleton->data);
+	}
 	if (atlas) spAtlas_dispose(atlas);
 	spSkeleton_dispose(skeleton);
 }
@@ -127,9 +134,6 @@ void Skeleton::update (float deltaTime) {
 }
 
 void Skeleton::draw () {
-	CC_NODE_DRAW_SETUP();
-
-    GL::blendFunc(blendFunc.src, blendFunc.dst);
 	Color3B color = getColor();
 	skeleton->r = color.r / (float)255;
 	skeleton->g = color.g / (float)255;
@@ -141,8 +145,12 @@ void Skeleton::draw () {
 		skeleton->b *= skeleton->a;
 	}
 
-	int additive = 0;
-	TextureAtlas* textureAtlas = 0;
+	// Slots are emitted as one quad command per run of slots sharing a texture and a blend function,
+	// the renderer batches the runs of consecutive skeletons using the same atlas page.
+	Texture2D* texture = nullptr;
+	BlendFunc blend = blendFunc;
+	ssize_t runStart = 0;
+	quads.clear();
 	V3F_C4B_T2F_Quad quad;
 	quad.tl.vertices.z = 0;
 	quad.tr.vertices.z = 0;
@@ -152,36 +160,38 @@ void Skeleton::draw () {
 		spSlot* slot = skeleton->drawOrder[i];
 		if (!slot->attachment || slot->attachment->type != ATTACHMENT_REGION) continue;
 		spRegionAttachment* attachment = (spRegionAttachment*)slot->attachment;
-		TextureAtlas* regionTextureAtlas = getTextureAtlas(attachment);
-
-		if (slot->data->additiveBlending != additive) {
-			if (textureAtlas) {
-				textureAtlas->drawQuads();
-				textureAtlas->removeAllQuads();
-			}
-			additive = !additive;
-            GL::blendFunc(blendFunc.src, additive ? GL_ONE : blendFunc.dst);
-		} else if (regionTextureAtlas != textureAtlas && textureAtlas) {
-			textureAtlas->drawQuads();
-			textureAtlas->removeAllQuads();
-		}
-		textureAtlas = regionTextureAtlas;
-        setFittedBlendingFunc(textureAtlas);
-
-		ssize_t quadCount = textureAtlas->getTotalQuads();
-		if (textureAtlas->getCapacity() == quadCount) {
-			textureAtlas->drawQuads();
-			textureAtlas->removeAllQuads();
-			if (!textureAtlas->resizeCapacity(textureAtlas->getCapacity() * 2)) return;
+		Texture2D* regionTexture = getTextureAtlas(attachment)->getTexture();
+		BlendFunc regionBlend = getFittedBlendFunc(regionTexture, slot->data->additiveBlending != 0);
+
+		if (texture && (regionTexture != texture || !(regionBlend == blend))) {
+			addQuadCommand(texture, blend, runStart, quads.size() - runStart);
+			runStart = quads.size();
 		}
+		texture = regionTexture;
+		blend = regionBlend;
 
 		spRegionAttachment_updateQuad(attachment, slot, &quad, premultipliedAlpha);
-		textureAtlas->updateQuad(&quad, quadCount);
+		quads.push_back(quad);
 	}
-	if (textureAtlas) {
-		textureAtlas->drawQuads();
-		textureAtlas->removeAllQuads();
+	if (texture) addQuadCommand(texture, blend, runStart, quads.size() - runStart);
+
+	if (debugSlots || debugBones) {
+		CustomCommand* cmd = CustomCommand::getCommandPool().generateCommand();
+		cmd->init(0, _vertexZ);
+		cmd->func = CC_CALLBACK_0(Skeleton::drawDebug, this);
+		Director::getInstance()->getRenderer()->addCommand(cmd);
 	}
+}
+
+void Skeleton::addQuadCommand (Texture2D* texture, const BlendFunc& blend, ssize_t start, ssize_t count) {
+	QuadCommand* cmd = QuadCommand::getCommandPool().generateCommand();
+	cmd->init(0, _vertexZ, texture->getName(), _shaderProgram, blend, &quads[start], count, _modelViewTransform);
+	Director::getInstance()->getRenderer()->addCommand(cmd);
+}
+
+void Skeleton::drawDebug () {
+	kmGLPushMatrix();
+	kmGLLoadMatrix(&_modelViewTransform);
 
 	if (debugSlots) {
 		// Slots.
@@ -220,6 +230,8 @@ void Skeleton::draw () {
 			if (i == 0) DrawPrimitives::setDrawColor4B(0, 255, 0, 255);
 		}
 	}
+
+	kmGLPopMatrix();
 }
 
 TextureAtlas* Skeleton::getTextureAtlas (spRegionAttachment* regionAttachment) const {
@@ -302,16 +314,10 @@ void Skeleton::setBlendFunc (const cocos2d::BlendFunc& aBlendFunc) {
     this->blendFunc = aBlendFunc;
 }
     
-void Skeleton::setFittedBlendingFunc(cocos2d::TextureAtlas * nextRenderedTexture)
-{
-    if(nextRenderedTexture->getTexture() && nextRenderedTexture->getTexture()->hasPremultipliedAlpha())
-    {
-        GL::blendFunc(BlendFunc::ALPHA_PREMULTIPLIED.src, BlendFunc::ALPHA_PREMULTIPLIED.dst);
-    }
-    else
-    {
-        GL::blendFunc(BlendFunc::ALPHA_NON_PREMULTIPLIED.src, BlendFunc::ALPHA_NON_PREMULTIPLIED.dst);
-    }
+BlendFunc Skeleton::getFittedBlendFunc (Texture2D* texture, bool additive) const {
+    BlendFunc blend = texture->hasPremultipliedAlpha() ? blendFunc : BlendFunc::ALPHA_NON_PREMULTIPLIED;
+    if (additive) blend.dst = GL_ONE;
+    return blend;
 }
 
 }
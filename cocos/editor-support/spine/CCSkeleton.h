@@ -100,9 +100,13 @@ protected:
 private:
 	bool ownsSkeletonData;
 	spAtlas* atlas;
+	// Quads of the slots drawn in the current frame, kept to reuse the storage.
+	std::vector<cocos2d::V3F_C4B_T2F_Quad> quads;
 	void initialize ();
-    // Util function that setting blend-function by nextRenderedTexture's premultiplied flag
-    void setFittedBlendingFunc(cocos2d::TextureAtlas * nextRenderedTexture);
+	void addQuadCommand (cocos2d::Texture2D* texture, const cocos2d::BlendFunc& blend, ssize_t start, ssize_t count);
+	void drawDebug ();
+    // Util function that returns the blend-function fitting the texture's premultiplied flag
+    cocos2d::BlendFunc getFittedBlendFunc(cocos2d::Texture2D* texture, bool additive) const;
 };
 
 }
@@ -42,6 +42,170 @@ using std::vector;
 
 namespace spine {
 
+// --- SkeletonPoseCache
+
+static SkeletonPoseCache* sharedPoseCache = 0;
+/* Carried over to the next instance, so pointers baked by a destroyed instance are seen as stale. */
+static unsigned int lastPoseCacheGeneration = 0;
+
+static const int BONE_FLOATS = 9;
+static const int SLOT_FLOATS = 4;
+
+SkeletonPoseCache* SkeletonPoseCache::getInstance () {
+	if (!sharedPoseCache) sharedPoseCache = new SkeletonPoseCache();
+	return sharedPoseCache;
+}
+
+SkeletonPoseCache* SkeletonPoseCache::getExistingInstance () {
+	return sharedPoseCache;
+}
+
+void SkeletonPoseCache::destroyInstance () {
+	if (!sharedPoseCache) return;
+	lastPoseCacheGeneration = sharedPoseCache->generation + 1;
+	delete sharedPoseCache;
+	sharedPoseCache = 0;
+}
+
+SkeletonPoseCache::SkeletonPoseCache ()
+		: generation(lastPoseCacheGeneration) {
+}
+
+SkeletonPoseCache::~SkeletonPoseCache () {
+	removeAll();
+}
+
+bool SkeletonPoseCache::Key::operator< (const Key& other) const {
+	if (skeletonData != other.skeletonData) return skeletonData < other.skeletonData;
+	if (skin != other.skin) return skin < other.skin;
+	if (animation != other.animation) return animation < other.animation;
+	if (flipX != other.flipX) return flipX < other.flipX;
+	if (flipY != other.flipY) return flipY < other.flipY;
+	return sampleRate < other.sampleRate;
+}
+
+const SkeletonPoseCache::BakedAnimation* SkeletonPoseCache::getAnimation (spSkeletonData* skeletonData, spSkin* skin,
+		spAnimation* animation, bool flipX, bool flipY, float sampleRate) {
+	Key key = {skeletonData, skin, animation, flipX, flipY, sampleRate};
+	auto iter = animations.find(key);
+	if (iter != animations.end()) return iter->second;
+
+	BakedAnimation* baked = bake(key);
+	animations[key] = baked;
+	return baked;
+}
+
+SkeletonPoseCache::BakedAnimation* SkeletonPoseCache::bake (const Key& key) {
+	spAnimation* animation = key.animation;
+	for (int i = 0; i < animation->timelineCount; ++i)
+		if (animation->timelines[i]->type == TIMELINE_EVENT) return 0;
+
+	BakedAnimation* baked = new BakedAnimation();
+	baked->sampleRate = key.sampleRate;
+	baked->duration = animation->duration;
+	baked->frameCount = (int)ceilf(animation->duration * key.sampleRate) + 1;
+	baked->boneCount = key.skeletonData->boneCount;
+	baked->slotCount = key.skeletonData->slotCount;
+	baked->bones.resize(baked->frameCount * baked->boneCount * BONE_FLOATS);
+	baked->slotColors.resize(baked->frameCount * baked->slotCount * SLOT_FLOATS);
+	baked->attachments.resize(baked->frameCount * baked->slotCount);
+	baked->drawOrder.resize(baked->frameCount * baked->slotCount);
+
+	spSkeleton* skeleton = spSkeleton_create(key.skeletonData);
+	spSkeleton_setSkin(skeleton, key.skin);
+	skeleton->flipX = key.flipX;
+	skeleton->flipY = key.flipY;
+	float* bone = &baked->bones[0];
+	float* color = baked->slotCount ? &baked->slotColors[0] : 0;
+	for (int frame = 0; frame < baked->frameCount; ++frame) {
+		float time = min(frame / key.sampleRate, animation->duration);
+		spSkeleton_setToSetupPose(skeleton);
+		spAnimation_apply(animation, skeleton, time, time, false, 0, 0);
+		spSkeleton_updateWorldTransform(skeleton);
+
+		for (int i = 0; i < baked->boneCount; ++i, bone += BONE_FLOATS) {
+			spBone* source = skeleton->bones[i];
+			bone[0] = source->m00;
+			bone[1] = source->m01;
+			bone[2] = source->m10;
+			bone[3] = source->m11;
+			bone[4] = source->worldX;
+			bone[5] = source->worldY;
+			bone[6] = source->worldRotation;
+			bone[7] = source->worldScaleX;
+			bone[8] = source->worldScaleY;
+		}
+		for (int i = 0; i < baked->slotCount; ++i, color += SLOT_FLOATS) {
+			spSlot* slot = skeleton->slots[i];
+			color[0] = slot->r;
+			color[1] = slot->g;
+			color[2] = slot->b;
+			color[3] = slot->a;
+			baked->attachments[frame * baked->slotCount + i] = slot->attachment;
+
+			int slotIndex = 0;
+			while (skeleton->slots[slotIndex] != skeleton->drawOrder[i])
+				++slotIndex;
+			baked->drawOrder[frame * baked->slotCount + i] = slotIndex;
+		}
+	}
+	spSkeleton_dispose(skeleton);
+
+	return baked;
+}
+
+void SkeletonPoseCache::removeSkeletonData (spSkeletonData* skeletonData) {
+	for (auto iter = animations.begin(); iter != animations.end();) {
+		if (iter->first.skeletonData == skeletonData) {
+			delete iter->second;
+			animations.erase(iter++);
+		} else
+			++iter;
+	}
+	++generation;
+}
+
+void SkeletonPoseCache::removeAll () {
+	for (auto iter = animations.begin(); iter != animations.end(); ++iter)
+		delete iter->second;
+	animations.clear();
+	++generation;
+}
+
+void SkeletonPoseCache::BakedAnimation::apply (spSkeleton* skeleton, float time, bool loop) const {
+	if (loop && duration) time = FMOD(time, duration);
+	int frame = (int)(time * sampleRate + 0.5f);
+	if (frame >= frameCount) frame = frameCount - 1;
+
+	const float* bone = &bones[frame * boneCount * BONE_FLOATS];
+	for (int i = 0; i < boneCount; ++i, bone += BONE_FLOATS) {
+		spBone* target = skeleton->bones[i];
+		CONST_CAST(float, target->m00) = bone[0];
+		CONST_CAST(float, target->m01) = bone[1];
+		CONST_CAST(float, target->m10) = bone[2];
+		CONST_CAST(float, target->m11) = bone[3];
+		CONST_CAST(float, target->worldX) = bone[4];
+		CONST_CAST(float, target->worldY) = bone[5];
+		CONST_CAST(float, target->worldRotation) = bone[6];
+		CONST_CAST(float, target->worldScaleX) = bone[7];
+		CONST_CAST(float, target->worldScaleY) = bone[8];
+	}
+
+	int first = frame * slotCount;
+	const float* color = slotCount ? &slotColors[first * SLOT_FLOATS] : 0;
+	for (int i = 0; i < slotCount; ++i, color += SLOT_FLOATS) {
+		spSlot* slot = skeleton->slots[i];
+		slot->r = color[0];
+		slot->g = color[1];
+		slot->b = color[2];
+		slot->a = color[3];
+		CONST_CAST(spAttachment*, slot->attachment) = attachments[first + i];
+		skeleton->drawOrder[i] = skeleton->slots[drawOrder[first + i]];
+	}
+}
+
+// --- SkeletonAnimation
+
 static void callback (spAnimationState* state, int trackIndex, spEventType type, spEvent* event, int loopCount) {
 	((SkeletonAnimation*)state->context)->onAnimationStateEvent(trackIndex, type, event, loopCount);
 }
@@ -69,6 +233,13 @@ void SkeletonAnimation::initialize () {
 	listenerMethod = 0;
 
 	ownsAnimationStateData = true;
+	poseSampleRate = 0;
+	bakedAnimation = 0;
+	bakedAnimationSource = 0;
+	bakedSkin = 0;
+	bakedFlipX = false;
+	bakedFlipY = false;
+	bakedGeneration = 0;
 	state = spAnimationState_create(spAnimationStateData_create(skeleton->data));
 	state->context = this;
 	state->listener = callback;
@@ -99,8 +270,54 @@ void SkeletonAnimation::update (float deltaTime) {
 
 	deltaTime *= timeScale;
 	spAnimationState_update(state, deltaTime);
-	spAnimationState_apply(state, skeleton);
-	spSkeleton_updateWorldTransform(skeleton);
+	if (!applyBakedPose()) {
+		spAnimationState_apply(state, skeleton);
+		spSkeleton_updateWorldTransform(skeleton);
+	}
+}
+
+void SkeletonAnimation::setPoseBakingEnabled (bool enabled, float sampleRate) {
+	CCAssert(!enabled || sampleRate > 0, "sampleRate must be positive.");
+	poseSampleRate = enabled ? sampleRate : 0;
+	bakedAnimation = 0;
+	bakedAnimationSource = 0;
+}
+
+bool SkeletonAnimation::applyBakedPose () {
+	if (poseSampleRate <= 0 || state->trackCount < 1) return false;
+	for (int i = 1; i < state->trackCount; ++i)
+		if (state->tracks[i]) return false;
+	spTrackEntry* current = state->tracks[0];
+	if (!current || current->previous) return false;
+
+	SkeletonPoseCache* cache = SkeletonPoseCache::getInstance();
+	bool flipX = skeleton->flipX != 0;
+	bool flipY = skeleton->flipY != 0;
+	if (bakedAnimationSource != current->animation || bakedSkin != skeleton->skin || bakedFlipX != flipX || bakedFlipY != flipY
+			|| bakedGeneration != cache->getGeneration()) {
+		bakedAnimation = cache->getAnimation(skeleton->data, skeleton->skin, current->animation, flipX, flipY, poseSampleRate);
+		bakedAnimationSource = current->animation;
+		bakedSkin = skeleton->skin;
+		bakedFlipX = flipX;
+		bakedFlipY = flipY;
+		bakedGeneration = cache->getGeneration();
+	}
+	if (!bakedAnimation) return false;
+
+	float time = current->time;
+	if (!current->loop && time > current->endTime) time = current->endTime;
+	bakedAnimation->apply(skeleton, time, current->loop != 0);
+
+	/* Same bookkeeping as spAnimationState_apply. */
+	if (current->loop ? (FMOD(current->lastTime, current->endTime) > FMOD(time, current->endTime))
+			: (current->lastTime < current->endTime && time >= current->endTime)) {
+		int count = (int)(time / current->endTime);
+		if (current->listener) current->listener(state, 0, ANIMATION_COMPLETE, 0, count);
+		if (state->listener) state->listener(state, 0, ANIMATION_COMPLETE, 0, count);
+		if (state->trackCount < 1 || state->tracks[0] != current) return true;
+	}
+	current->lastTime = current->time;
+	return true;
 }
 
 void SkeletonAnimation::setAnimationStateData (spAnimationStateData* stateData) {
@@ -37,6 +37,8 @@
 #include <spine/spine.h>
 #include <spine/CCSkeleton.h>
 #include "cocos2d.h"
+#include <map>
+#include <vector>
 
 namespace spine {
 
@@ -44,6 +46,67 @@ class SkeletonAnimation;
 typedef void (cocos2d::Object::*SEL_AnimationStateEvent)(spine::SkeletonAnimation* node, int trackIndex, spEventType type, spEvent* event, int loopCount);
 #define animationStateEvent_selector(_SELECTOR) (SEL_AnimationStateEvent)(&_SELECTOR)
 
+/** Poses of skeleton animations sampled at a fixed rate, shared by all the SkeletonAnimations that play them with
+  * pose baking enabled. A pose holds the world transform of every bone and the color, attachment and draw order of every
+  * slot, so applying it replaces spAnimationState_apply and spSkeleton_updateWorldTransform. */
+class SkeletonPoseCache {
+public:
+	class BakedAnimation {
+	public:
+		/* Copies the pose sampled closest to time into the skeleton. */
+		void apply (spSkeleton* skeleton, float time, bool loop) const;
+
+	private:
+		friend class SkeletonPoseCache;
+		float sampleRate;
+		float duration;
+		int frameCount;
+		int boneCount;
+		int slotCount;
+		std::vector<float> bones; /* m00, m01, m10, m11, worldX, worldY, worldRotation, worldScaleX, worldScaleY per bone */
+		std::vector<float> slotColors; /* r, g, b, a per slot */
+		std::vector<spAttachment*> attachments;
+		std::vector<int> drawOrder; /* slot indices */
+	};
+
+	static SkeletonPoseCache* getInstance ();
+	/* Returns the cache without creating it, 0 if nothing was baked since it was last destroyed. */
+	static SkeletonPoseCache* getExistingInstance ();
+	/* Frees every baked animation. Call it when the director is purged, e.g. from the AppDelegate destructor. */
+	static void destroyInstance ();
+
+	/* Returns the baked animation, baking it on first use. Returns 0 for animations firing events, they must be applied
+	 * live. */
+	const BakedAnimation* getAnimation (spSkeletonData* skeletonData, spSkin* skin, spAnimation* animation, bool flipX,
+			bool flipY, float sampleRate);
+
+	/* Must be called before disposing skeleton data that was played with pose baking. Skeletons owning their data do it
+	 * themselves. */
+	void removeSkeletonData (spSkeletonData* skeletonData);
+	void removeAll ();
+
+	/* Changes whenever baked animations are removed, so users can tell their pointers are stale. */
+	unsigned int getGeneration () const { return generation; }
+
+private:
+	struct Key {
+		spSkeletonData* skeletonData;
+		spSkin* skin;
+		spAnimation* animation;
+		bool flipX;
+		bool flipY;
+		float sampleRate;
+		bool operator< (const Key& other) const;
+	};
+
+	SkeletonPoseCache ();
+	~SkeletonPoseCache ();
+	BakedAnimation* bake (const Key& key);
+
+	std::map<Key, BakedAnimation*> animations;
+	unsigned int generation;
+};
+
 /** Draws an animated skeleton, providing an AnimationState for applying one or more animations and queuing animations to be
   * played later. */
 class SkeletonAnimation: public Skeleton {
@@ -74,6 +137,13 @@ public:
 
 	virtual void onAnimationStateEvent (int trackIndex, spEventType type, spEvent* event, int loopCount);
 
+	/* Plays animations from poses sampled sampleRate times per second, shared with every instance using the same skeleton
+	 * data and skin through SkeletonPoseCache. Only an animation playing alone on track 0 is baked; mixing, several tracks
+	 * and animations firing events use the live path. Baked poses start from the setup pose, so attachments set by hand are
+	 * overridden. Meant for crowds, disabled by default. */
+	void setPoseBakingEnabled (bool enabled, float sampleRate = 30);
+	bool isPoseBakingEnabled () const { return poseSampleRate > 0; }
+
 protected:
 	SkeletonAnimation ();
 
@@ -82,8 +152,17 @@ private:
     cocos2d::Object* listenerInstance;
 	SEL_AnimationStateEvent listenerMethod;
 	bool ownsAnimationStateData;
+	float poseSampleRate;
+	const SkeletonPoseCache::BakedAnimation* bakedAnimation;
+	spAnimation* bakedAnimationSource;
+	spSkin* bakedSkin;
+	bool bakedFlipX;
+	bool bakedFlipY;
+	unsigned int bakedGeneration;
 
 	void initialize ();
+	/* Returns false if the current animations must be applied live. */
+	bool applyBakedPose ();
 };
 
 }
@@ -300,6 +300,439 @@ static spAnimation* _spSkeletonJson_readAnimation (spSkeletonJson* self, Json* r
 	return animation;
 }
 
+/* Binary skeleton data, see tools/spine-converter/json2skel.py for the layout. */
+
+#define SKELETON_BINARY_VERSION 1
+
+typedef struct {
+	const unsigned char* cursor;
+	const unsigned char* end;
+	int/*bool*/truncated;
+} _spSkeletonInput;
+
+static int _spSkeletonInput_has (_spSkeletonInput* input, int length) {
+	if (input->truncated || input->end - input->cursor < length) {
+		input->truncated = 1;
+		return 0;
+	}
+	return 1;
+}
+
+static int readByte (_spSkeletonInput* input) {
+	if (!_spSkeletonInput_has(input, 1)) return 0;
+	return *input->cursor++;
+}
+
+static int readInt (_spSkeletonInput* input) {
+	unsigned int value;
+	if (!_spSkeletonInput_has(input, 4)) return 0;
+	value = input->cursor[0] | (input->cursor[1] << 8) | (input->cursor[2] << 16) | ((unsigned int)input->cursor[3] << 24);
+	input->cursor += 4;
+	return (int)value;
+}
+
+static float readFloat (_spSkeletonInput* input) {
+	union {
+		int intValue;
+		float floatValue;
+	} value;
+	value.intValue = readInt(input);
+	return value.floatValue;
+}
+
+/* Counts and indices are checked against the remaining data and the given limit, so a damaged file can't allocate
+ * arbitrarily or index out of bounds. Returns -1 on error. */
+static int readIndex (_spSkeletonInput* input, int limit) {
+	int value = readInt(input);
+	if (input->truncated || value < 0 || value >= limit) {
+		input->truncated = 1;
+		return -1;
+	}
+	return value;
+}
+
+/* Returns 0 on error. */
+static int readCount (_spSkeletonInput* input) {
+	int value = readIndex(input, (int)(input->end - input->cursor) + 1);
+	return value == -1 ? 0 : value;
+}
+
+/* Strings are used in place, every spine create and set function copies its names. */
+static const char* readString (_spSkeletonInput* input) {
+	int length;
+	const char* value;
+	if (!_spSkeletonInput_has(input, 2)) return 0;
+	length = input->cursor[0] | (input->cursor[1] << 8);
+	input->cursor += 2;
+	if (length == 0xffff) return 0;
+	if (!_spSkeletonInput_has(input, length + 1) || input->cursor[length] != 0) {
+		input->truncated = 1;
+		return 0;
+	}
+	value = (const char*)input->cursor;
+	input->cursor += length + 1;
+	return value;
+}
+
+/* The last frame has no curve, it's read but not stored. */
+static void readBinaryCurve (_spSkeletonInput* input, spCurveTimeline* timeline, int frameIndex, int frameCount) {
+	int isLast = frameIndex == frameCount - 1;
+	switch (readByte(input)) {
+	case 1:
+		if (!isLast) spCurveTimeline_setStepped(timeline, frameIndex);
+		break;
+	case 2: {
+		float cx1 = readFloat(input);
+		float cy1 = readFloat(input);
+		float cx2 = readFloat(input);
+		float cy2 = readFloat(input);
+		if (!isLast) spCurveTimeline_setCurve(timeline, frameIndex, cx1, cy1, cx2, cy2);
+		break;
+	}
+	}
+}
+
+static spAnimation* _spSkeletonJson_readBinaryAnimation (spSkeletonJson* self, _spSkeletonInput* input,
+		spSkeletonData *skeletonData) {
+	int i, ii;
+	const char* name = readString(input);
+	int timelineCount = readCount(input);
+	spAnimation* animation;
+
+	if (!name || input->truncated) return 0;
+
+	animation = spAnimation_create(name, timelineCount);
+	animation->timelineCount = 0;
+
+	for (i = 0; i < timelineCount; ++i) {
+		float duration = 0;
+		int frameCount, type = readByte(input);
+
+		switch (type) {
+		case TIMELINE_ROTATE: {
+			spRotateTimeline *timeline;
+			int boneIndex = readIndex(input, skeletonData->boneCount);
+			frameCount = readCount(input);
+			if (input->truncated || frameCount == 0) break;
+			timeline = spRotateTimeline_create(frameCount);
+			timeline->boneIndex = boneIndex;
+			animation->timelines[animation->timelineCount++] = SUPER_CAST(spTimeline, timeline);
+			for (ii = 0; ii < frameCount; ++ii) {
+				float time = readFloat(input);
+				float angle = readFloat(input);
+				spRotateTimeline_setFrame(timeline, ii, time, angle);
+				readBinaryCurve(input, SUPER(timeline), ii, frameCount);
+			}
+			duration = timeline->frames[frameCount * 2 - 2];
+			break;
+		}
+		case TIMELINE_SCALE:
+		case TIMELINE_TRANLATE: {
+			spTranslateTimeline *timeline;
+			float scale = type == TIMELINE_SCALE ? 1 : self->scale;
+			int boneIndex = readIndex(input, skeletonData->boneCount);
+			frameCount = readCount(input);
+			if (input->truncated || frameCount == 0) break;
+			timeline = type == TIMELINE_SCALE ? spScaleTimeline_create(frameCount) : spTranslateTimeline_create(frameCount);
+			timeline->boneIndex = boneIndex;
+			animation->timelines[animation->timelineCount++] = SUPER_CAST(spTimeline, timeline);
+			for (ii = 0; ii < frameCount; ++ii) {
+				float time = readFloat(input);
+				float x = readFloat(input) * scale;
+				float y = readFloat(input) * scale;
+				spTranslateTimeline_setFrame(timeline, ii, time, x, y);
+				readBinaryCurve(input, SUPER(timeline), ii, frameCount);
+			}
+			duration = timeline->frames[frameCount * 3 - 3];
+			break;
+		}
+		case TIMELINE_COLOR: {
+			spColorTimeline *timeline;
+			int slotIndex = readIndex(input, skeletonData->slotCount);
+			frameCount = readCount(input);
+			if (input->truncated || frameCount == 0) break;
+			timeline = spColorTimeline_create(frameCount);
+			timeline->slotIndex = slotIndex;
+			animation->timelines[animation->timelineCount++] = SUPER_CAST(spTimeline, timeline);
+			for (ii = 0; ii < frameCount; ++ii) {
+				float time = readFloat(input);
+				float r = readFloat(input);
+				float g = readFloat(input);
+				float b = readFloat(input);
+				float a = readFloat(input);
+				spColorTimeline_setFrame(timeline, ii, time, r, g, b, a);
+				readBinaryCurve(input, SUPER(timeline), ii, frameCount);
+			}
+			duration = timeline->frames[frameCount * 5 - 5];
+			break;
+		}
+		case TIMELINE_ATTACHMENT: {
+			spAttachmentTimeline *timeline;
+			int slotIndex = readIndex(input, skeletonData->slotCount);
+			frameCount = readCount(input);
+			if (input->truncated || frameCount == 0) break;
+			timeline = spAttachmentTimeline_create(frameCount);
+			timeline->slotIndex = slotIndex;
+			animation->timelines[animation->timelineCount++] = SUPER_CAST(spTimeline, timeline);
+			for (ii = 0; ii < frameCount; ++ii) {
+				float time = readFloat(input);
+				spAttachmentTimeline_setFrame(timeline, ii, time, readString(input));
+			}
+			duration = timeline->frames[frameCount - 1];
+			break;
+		}
+		case TIMELINE_EVENT: {
+			spEventTimeline* timeline;
+			frameCount = readCount(input);
+			if (input->truncated || frameCount == 0) break;
+			timeline = spEventTimeline_create(frameCount);
+			animation->timelines[animation->timelineCount++] = SUPER_CAST(spTimeline, timeline);
+			for (ii = 0; ii < frameCount; ++ii) {
+				spEvent* event;
+				const char* stringValue;
+				float time = readFloat(input);
+				int eventIndex = readIndex(input, skeletonData->eventCount);
+				if (eventIndex == -1) {
+					/* Frames without an event can't be disposed. */
+					CONST_CAST(int, timeline->framesLength) = ii;
+					break;
+				}
+				event = spEvent_create(skeletonData->events[eventIndex]);
+				event->intValue = readInt(input);
+				event->floatValue = readFloat(input);
+				stringValue = readString(input);
+				if (stringValue) MALLOC_STR(event->stringValue, stringValue);
+				spEventTimeline_setFrame(timeline, ii, time, event);
+			}
+			duration = timeline->frames[frameCount - 1];
+			break;
+		}
+		case TIMELINE_DRAWORDER: {
+			spDrawOrderTimeline* timeline;
+			int* drawOrder;
+			frameCount = readCount(input);
+			if (input->truncated || frameCount == 0) break;
+			timeline = spDrawOrderTimeline_create(frameCount, skeletonData->slotCount);
+			animation->timelines[animation->timelineCount++] = SUPER_CAST(spTimeline, timeline);
+			drawOrder = MALLOC(int, skeletonData->slotCount);
+			for (ii = 0; ii < frameCount; ++ii) {
+				float time = readFloat(input);
+				int iii, hasDrawOrder = readByte(input);
+				if (hasDrawOrder) {
+					for (iii = 0; iii < skeletonData->slotCount; ++iii)
+						drawOrder[iii] = readIndex(input, skeletonData->slotCount);
+				}
+				spDrawOrderTimeline_setFrame(timeline, ii, time, hasDrawOrder ? drawOrder : 0);
+			}
+			FREE(drawOrder);
+			duration = timeline->frames[frameCount - 1];
+			break;
+		}
+		default:
+			input->truncated = 1;
+		}
+
+		if (input->truncated) {
+			spAnimation_dispose(animation);
+			return 0;
+		}
+		if (duration > animation->duration) animation->duration = duration;
+	}
+
+	return animation;
+}
+
+spSkeletonData* spSkeletonJson_readSkeletonDataBinary (spSkeletonJson* self, const unsigned char* data, int length) {
+	int i, ii, count;
+	spSkeletonData* skeletonData;
+	_spSkeletonInput input;
+
+	FREE(self->error);
+	CONST_CAST(char*, self->error) = 0;
+
+	if (length < 8 || memcmp(data, "CCSK", 4) != 0) {
+		_spSkeletonJson_setError(self, 0, "Invalid skeleton binary: ", "bad signature");
+		return 0;
+	}
+	if ((data[4] | (data[5] << 8)) != SKELETON_BINARY_VERSION) {
+		_spSkeletonJson_setError(self, 0, "Invalid skeleton binary: ", "unsupported version");
+		return 0;
+	}
+
+	input.cursor = data + 8;
+	input.end = data + length;
+	input.truncated = 0;
+
+	skeletonData = spSkeletonData_create();
+
+	count = readCount(&input);
+	skeletonData->bones = MALLOC(spBoneData*, count);
+	for (i = 0; i < count && !input.truncated; ++i) {
+		spBoneData* boneData;
+		const char* name = readString(&input);
+		int parentIndex = readInt(&input);
+		if (!name || parentIndex >= i || parentIndex < -1) break;
+
+		boneData = spBoneData_create(name, parentIndex == -1 ? 0 : skeletonData->bones[parentIndex]);
+		boneData->length = readFloat(&input) * self->scale;
+		boneData->x = readFloat(&input) * self->scale;
+		boneData->y = readFloat(&input) * self->scale;
+		boneData->rotation = readFloat(&input);
+		boneData->scaleX = readFloat(&input);
+		boneData->scaleY = readFloat(&input);
+		boneData->inheritScale = readByte(&input);
+		boneData->inheritRotation = readByte(&input);
+
+		skeletonData->bones[i] = boneData;
+		++skeletonData->boneCount;
+	}
+	if (skeletonData->boneCount != count || input.truncated) goto invalid;
+
+	count = readCount(&input);
+	skeletonData->slots = MALLOC(spSlotData*, count);
+	for (i = 0; i < count && !input.truncated; ++i) {
+		spSlotData* slotData;
+		const char* name = readString(&input);
+		int boneIndex = readIndex(&input, skeletonData->boneCount);
+		if (!name || boneIndex == -1) break;
+
+		slotData = spSlotData_create(name, skeletonData->bones[boneIndex]);
+		slotData->r = readFloat(&input);
+		slotData->g = readFloat(&input);
+		slotData->b = readFloat(&input);
+		slotData->a = readFloat(&input);
+		spSlotData_setAttachmentName(slotData, readString(&input));
+		slotData->additiveBlending = readByte(&input);
+
+		skeletonData->slots[i] = slotData;
+		++skeletonData->slotCount;
+	}
+	if (skeletonData->slotCount != count || input.truncated) goto invalid;
+
+	count = readCount(&input);
+	skeletonData->skins = MALLOC(spSkin*, count);
+	for (i = 0; i < count && !input.truncated; ++i) {
+		spSkin *skin;
+		int attachmentCount;
+		const char* name = readString(&input);
+		if (!name) break;
+
+		skin = spSkin_create(name);
+		skeletonData->skins[i] = skin;
+		++skeletonData->skinCount;
+		if (strcmp(name, "default") == 0) skeletonData->defaultSkin = skin;
+
+		attachmentCount = readCount(&input);
+		for (ii = 0; ii < attachmentCount && !input.truncated; ++ii) {
+			spAttachment* attachment;
+			int slotIndex = readIndex(&input, skeletonData->slotCount);
+			const char* skinAttachmentName = readString(&input);
+			const char* attachmentName = readString(&input);
+			spAttachmentType type = (spAttachmentType)readByte(&input);
+			float x = 0, y = 0, scaleX = 1, scaleY = 1, rotation = 0, width = 0, height = 0;
+			int verticesCount = 0;
+			const unsigned char* vertices = 0;
+
+			if (!skinAttachmentName || !attachmentName) input.truncated = 1;
+			if (input.truncated) break;
+			switch (type) {
+			case ATTACHMENT_REGION:
+			case ATTACHMENT_REGION_SEQUENCE:
+				x = readFloat(&input);
+				y = readFloat(&input);
+				scaleX = readFloat(&input);
+				scaleY = readFloat(&input);
+				rotation = readFloat(&input);
+				width = readFloat(&input);
+				height = readFloat(&input);
+				break;
+			case ATTACHMENT_BOUNDING_BOX:
+				verticesCount = readCount(&input);
+				vertices = input.cursor;
+				if (_spSkeletonInput_has(&input, verticesCount * 4)) input.cursor += verticesCount * 4;
+				break;
+			default:
+				input.truncated = 1;
+			}
+			if (input.truncated) break;
+
+			attachment = spAttachmentLoader_newAttachment(self->attachmentLoader, skin, type, attachmentName);
+			if (!attachment) {
+				if (self->attachmentLoader->error1) {
+					spSkeletonData_dispose(skeletonData);
+					_spSkeletonJson_setError(self, 0, self->attachmentLoader->error1, self->attachmentLoader->error2);
+					return 0;
+				}
+				continue;
+			}
+
+			switch (attachment->type) {
+			case ATTACHMENT_REGION:
+			case ATTACHMENT_REGION_SEQUENCE: {
+				spRegionAttachment* regionAttachment = (spRegionAttachment*)attachment;
+				regionAttachment->x = x * self->scale;
+				regionAttachment->y = y * self->scale;
+				regionAttachment->scaleX = scaleX;
+				regionAttachment->scaleY = scaleY;
+				regionAttachment->rotation = rotation;
+				regionAttachment->width = width * self->scale;
+				regionAttachment->height = height * self->scale;
+				spRegionAttachment_updateOffset(regionAttachment);
+				break;
+			}
+			case ATTACHMENT_BOUNDING_BOX: {
+				spBoundingBoxAttachment* box = (spBoundingBoxAttachment*)attachment;
+				_spSkeletonInput vertexInput = {vertices, vertices + verticesCount * 4, 0};
+				int iii;
+				box->verticesCount = verticesCount;
+				box->vertices = MALLOC(float, verticesCount);
+				for (iii = 0; iii < verticesCount; ++iii)
+					box->vertices[iii] = readFloat(&vertexInput) * self->scale;
+				break;
+			}
+			}
+
+			spSkin_addAttachment(skin, slotIndex, skinAttachmentName, attachment);
+		}
+	}
+	if (skeletonData->skinCount != count || input.truncated) goto invalid;
+
+	/* Events. */
+	count = readCount(&input);
+	skeletonData->events = MALLOC(spEventData*, count);
+	for (i = 0; i < count && !input.truncated; ++i) {
+		spEventData* eventData;
+		const char* stringValue;
+		const char* name = readString(&input);
+		if (!name) break;
+
+		eventData = spEventData_create(name);
+		eventData->intValue = readInt(&input);
+		eventData->floatValue = readFloat(&input);
+		stringValue = readString(&input);
+		if (stringValue) MALLOC_STR(eventData->stringValue, stringValue);
+		skeletonData->events[skeletonData->eventCount++] = eventData;
+	}
+	if (skeletonData->eventCount != count || input.truncated) goto invalid;
+
+	/* Animations. */
+	count = readCount(&input);
+	skeletonData->animations = MALLOC(spAnimation*, count);
+	for (i = 0; i < count; ++i) {
+		spAnimation* animation = _spSkeletonJson_readBinaryAnimation(self, &input, skeletonData);
+		if (!animation) goto invalid;
+		skeletonData->animations[skeletonData->animationCount++] = animation;
+	}
+
+	if (input.truncated) goto invalid;
+	return skeletonData;
+
+invalid:
+	spSkeletonData_dispose(skeletonData);
+	_spSkeletonJson_setError(self, 0, "Invalid skeleton binary: ", "data is truncated or damaged");
+	return 0;
+}
+
 spSkeletonData* spSkeletonJson_readSkeletonDataFile (spSkeletonJson* self, const char* path) {
 	int length;
 	spSkeletonData* skeletonData;
@@ -308,7 +741,10 @@ spSkeletonData* spSkeletonJson_readSkeletonDataFile (spSkeletonJson* self, const
 		_spSkeletonJson_setError(self, 0, "Unable to read skeleton file: ", path);
 		return 0;
 	}
-	skeletonData = spSkeletonJson_readSkeletonData(self, json);
+	if (length >= 4 && memcmp(json, "CCSK", 4) == 0)
+		skeletonData = spSkeletonJson_readSkeletonDataBinary(self, (const unsigned char*)json, length);
+	else
+		skeletonData = spSkeletonJson_readSkeletonData(self, json);
 	FREE(json);
 	return skeletonData;
 }
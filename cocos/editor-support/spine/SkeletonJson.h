@@ -55,7 +55,10 @@ spSkeletonJson* spSkeletonJson_create (spAtlas* atlas);
 void spSkeletonJson_dispose (spSkeletonJson* self);
 
 spSkeletonData* spSkeletonJson_readSkeletonData (spSkeletonJson* self, const char* json);
+/* Reads either format, binary files are recognized by their signature. */
 spSkeletonData* spSkeletonJson_readSkeletonDataFile (spSkeletonJson* self, const char* path);
+/* Reads skeleton data written by tools/spine-converter/json2skel.py. */
+spSkeletonData* spSkeletonJson_readSkeletonDataBinary (spSkeletonJson* self, const unsigned char* data, int length);
 
 #ifdef SPINE_SHORT_NAMES
 typedef spSkeletonJson SkeletonJson;
@@ -64,6 +67,7 @@ typedef spSkeletonJson SkeletonJson;
 #define SkeletonJson_dispose(...) spSkeletonJson_dispose(__VA_ARGS__)
 #define SkeletonJson_readSkeletonData(...) spSkeletonJson_readSkeletonData(__VA_ARGS__)
 #define SkeletonJson_readSkeletonDataFile(...) spSkeletonJson_readSkeletonDataFile(__VA_ARGS__)
+#define SkeletonJson_readSkeletonDataBinary(...) spSkeletonJson_readSkeletonDataBinary(__VA_ARGS__)
 #endif
 
 #ifdef __cplusplus
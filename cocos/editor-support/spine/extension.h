@@ -55,7 +55,7 @@
 #define FREE(VALUE) _free((void*)VALUE)
 
 /* Allocates a new char[], assigns it to TO, and copies FROM to it. Can be used on const types. */
-#define MALLOC_STR(TO,FROM) strcpy(CONST_CAST(char*, TO) = (char*)malloc(strlen(FROM) + 1), FROM)
+#define MALLOC_STR(TO,FROM) strcpy(CONST_CAST(char*, TO) = MALLOC(char, strlen(FROM) + 1), FROM)
 
 #ifdef __STDC_VERSION__
 #define FMOD(A,B) fmodf(A, B)
@@ -63,7 +63,7 @@ char* _spUtil_readFile (const char* path, int* length)
         size = static_cast<int>(data.getSize());
         *length = size;
         // Allocates one more byte for string terminal, it will be safe when parsing JSON file in Spine runtime.
-        ret = (char*)malloc(size + 1);
+        ret = MALLOC(char, size + 1);
         ret[size] = '\0';
         memcpy(ret, data.getBytes(), size);
     }
@@ -112,6 +112,18 @@ void Layout::addChild(Node *child, int zOrder, int tag)
     _doLayoutDirty = true;
 }
 
+void Layout::removeChild(Node *child, bool cleanup)
+{
+    Widget::removeChild(child, cleanup);
+    _doLayoutDirty = true;
+}
+
+void Layout::removeAllChildrenWithCleanup(bool cleanup)
+{
+    Widget::removeAllChildrenWithCleanup(cleanup);
+    _doLayoutDirty = true;
+}
+
 bool Layout::isClippingEnabled()
 {
     return _clippingEnabled;
@@ -806,13 +818,24 @@ void Layout::doLayout()
         }
         case LAYOUT_RELATIVE:
         {
-            int unlayoutChildCount = _widgetChildren.size();
+            int unlayoutChildCount = 0;
             Size layoutSize = getSize();
+            // resolve the relative names once instead of searching the children for each widget
+            _relativeWidgets.clear();
             for (auto& subWidget : _widgetChildren)
             {
                 Widget* child = static_cast<Widget*>(subWidget);
                 RelativeLayoutParameter* layoutParameter = dynamic_cast<RelativeLayoutParameter*>(child->getLayoutParameter(LAYOUT_PARAMETER_RELATIVE));
-                layoutParameter->_put = false;
+                if (layoutParameter)
+                {
+                    layoutParameter->_put = false;
+                    unlayoutChildCount++;
+                    const char* relativeName = layoutParameter->getRelativeName();
+                    if (relativeName && strcmp(relativeName, ""))
+                    {
+                        _relativeWidgets.insert(std::make_pair(std::string(relativeName), child));
+                    }
+                }
             }
             while (unlayoutChildCount > 0)
             {
@@ -837,7 +860,11 @@ void Layout::doLayout()
                         float finalPosY = 0.0f;
                         if (relativeName && strcmp(relativeName, ""))
                         {
-                            relativeWidget = UIHelper::seekWidgetByRelativeName(this, relativeName);
+                            auto relativeIter = _relativeWidgets.find(relativeName);
+                            if (relativeIter != _relativeWidgets.end())
+                            {
+                                relativeWidget = relativeIter->second;
+                            }
                             if (relativeWidget)
                             {
                                 relativeWidgetLP = dynamic_cast<RelativeLayoutParameter*>(relativeWidget->getLayoutParameter(LAYOUT_PARAMETER_RELATIVE));
@@ -26,6 +26,7 @@
 #define __LAYOUT_H__
 
 #include "gui/UIWidget.h"
+#include <unordered_map>
 
 NS_CC_BEGIN
 
@@ -209,6 +210,10 @@ public:
      */
     virtual void addChild(Node* child, int zOrder, int tag) override;
     
+    virtual void removeChild(Node* child, bool cleanup = true) override;
+    
+    virtual void removeAllChildrenWithCleanup(bool cleanup) override;
+    
     virtual void visit();
     
     virtual void sortAllChildren() override;
@@ -261,6 +266,8 @@ protected:
     Rect _clippingRect;
     Layout* _clippingParent;
     bool _doLayoutDirty;
+    //children of a relative layout by relative name, filled when the layout is done
+    std::unordered_map<std::string, Widget*> _relativeWidgets;
 };
     
 }
@@ -25,11 +25,15 @@
 #include "gui/UIListView.h"
 #include "gui/UIHelper.h"
 #include "extensions/GUI/CCControlExtension/CCScale9Sprite.h"
+#include <algorithm>
 
 NS_CC_BEGIN
 
 namespace gui {
 
+// items within half a list view of the visible part are kept
+static const float VIRTUAL_ITEMS_MARGIN = 0.5f;
+
 ListView::ListView():
 _model(nullptr),
 _gravity(LISTVIEW_GRAVITY_CENTER_HORIZONTAL),
@@ -37,7 +41,14 @@ _itemsMargin(0.0f),
 _listViewEventListener(nullptr),
 _listViewEventSelector(nullptr),
 _curSelectedIndex(0),
-_refreshViewDirty(true)
+_refreshViewDirty(true),
+_dataSource(nullptr),
+_firstItemIndex(0),
+_measuredItemsLength(0.0f),
+_measuredItemsCount(0),
+_itemOffsetsDirty(false),
+_virtualItemsDirty(false),
+_virtualInnerPosition(Point::ZERO)
 {
     
 }
@@ -84,6 +95,11 @@ void ListView::setItemModel(Widget *model)
 
 void ListView::updateInnerContainerSize()
 {
+    if (_dataSource)
+    {
+        _itemOffsetsDirty = true;
+        return;
+    }
     switch (_direction)
     {
         case SCROLLVIEW_DIR_VERTICAL:
@@ -242,6 +258,7 @@ void ListView::remedyLayoutParameter(Widget *item)
 
 void ListView::pushBackDefaultItem()
 {
+    CCASSERT(!_dataSource, "The items of a virtual list view come from its data source");
     if (!_model)
     {
         return;
@@ -255,6 +272,7 @@ void ListView::pushBackDefaultItem()
 
 void ListView::insertDefaultItem(int index)
 {
+    CCASSERT(!_dataSource, "The items of a virtual list view come from its data source");
     if (!_model)
     {
         return;
@@ -268,6 +286,7 @@ void ListView::insertDefaultItem(int index)
 
 void ListView::pushBackCustomItem(Widget* item)
 {
+    CCASSERT(!_dataSource, "The items of a virtual list view come from its data source");
     _items.pushBack(item);
     remedyLayoutParameter(item);
     addChild(item);
@@ -276,6 +295,7 @@ void ListView::pushBackCustomItem(Widget* item)
 
 void ListView::insertCustomItem(Widget* item, int index)
 {
+    CCASSERT(!_dataSource, "The items of a virtual list view come from its data source");
     _items.insert(index, item);
     remedyLayoutParameter(item);
     addChild(item);
@@ -284,6 +304,7 @@ void ListView::insertCustomItem(Widget* item, int index)
 
 void ListView::removeItem(int index)
 {
+    CCASSERT(!_dataSource, "The items of a virtual list view come from its data source");
     Widget* item = getItem(index);
     if (!item)
     {
@@ -301,6 +322,15 @@ void ListView::removeLastItem()
 
 Widget* ListView::getItem(unsigned int index)
 {
+    if (_dataSource)
+    {
+        ssize_t itemIndex = (ssize_t)index - _firstItemIndex;
+        if (itemIndex < 0 || itemIndex >= _items.size())
+        {
+            return nullptr;
+        }
+        return _items.at(itemIndex);
+    }
     if ((int)index < 0 || index >= _items.size())
     {
         return nullptr;
@@ -319,7 +349,12 @@ unsigned int ListView::getIndex(Widget *item) const
     {
         return -1;
     }
-    return _items.getIndex(item);
+    ssize_t index = _items.getIndex(item);
+    if (_dataSource && index >= 0)
+    {
+        return (unsigned int)(_firstItemIndex + index);
+    }
+    return index;
 }
 
 void ListView::setGravity(ListViewGravity gravity)
@@ -359,6 +394,12 @@ void ListView::setDirection(SCROLLVIEW_DIR dir)
             break;
     }
     ScrollView::setDirection(dir);
+    if (_dataSource)
+    {
+        // the items are placed by the list view
+        _innerContainer->setLayoutType(LAYOUT_ABSOLUTE);
+        reloadData();
+    }
 }
     
 void ListView::requestRefreshView()
@@ -368,6 +409,13 @@ void ListView::requestRefreshView()
 
 void ListView::refreshView()
 {
+    if (_dataSource)
+    {
+        _itemOffsetsDirty = true;
+        _virtualItemsDirty = true;
+        updateVirtualItems();
+        return;
+    }
     int length = _items.size();
     for (int i=0; i<length; i++)
     {
@@ -386,6 +434,307 @@ void ListView::sortAllChildren()
         refreshView();
         _refreshViewDirty = false;
     }
+    updateVirtualItems();
+}
+
+void ListView::setDataSource(ListViewDataSource* dataSource)
+{
+    if (_dataSource == dataSource)
+    {
+        return;
+    }
+    for (auto& item : _items)
+    {
+        removeChild(item);
+    }
+    _items.clear();
+    _freedItems.clear();
+    _itemLengths.clear();
+    _itemMeasured.clear();
+    _itemOffsets.clear();
+    _firstItemIndex = 0;
+    _dataSource = dataSource;
+    if (_dataSource)
+    {
+        _innerContainer->setLayoutType(LAYOUT_ABSOLUTE);
+        reloadData();
+    }
+    else
+    {
+        setDirection(_direction);
+        _refreshViewDirty = true;
+    }
+}
+
+ListViewDataSource* ListView::getDataSource() const
+{
+    return _dataSource;
+}
+
+void ListView::reloadData()
+{
+    if (!_dataSource)
+    {
+        return;
+    }
+    while (!_items.empty())
+    {
+        recycleVirtualItem(_items.back());
+        _items.popBack();
+    }
+    _firstItemIndex = 0;
+    _measuredItemsLength = 0.0f;
+    _measuredItemsCount = 0;
+
+    bool vertical = (_direction == SCROLLVIEW_DIR_VERTICAL);
+    ssize_t count = _dataSource->numberOfItemsInListView(this);
+    _itemLengths.resize(count);
+    _itemMeasured.assign(count, false);
+    for (ssize_t i = 0; i < count; ++i)
+    {
+        Size size = _dataSource->estimatedItemSizeForIndex(this, i);
+        _itemLengths[i] = vertical ? size.height : size.width;
+    }
+    if (count > 0 && _itemLengths[0] <= 0.0f)
+    {
+        // without any estimation, the first item gives the average size of the items
+        _items.pushBack(createVirtualItem(0));
+    }
+    _itemOffsets.clear();
+    _itemOffsetsDirty = true;
+    _virtualItemsDirty = true;
+}
+
+Widget* ListView::dequeueItem()
+{
+    if (_freedItems.empty())
+    {
+        return nullptr;
+    }
+    Widget* item = _freedItems.back();
+    item->retain();
+    _freedItems.popBack();
+    item->autorelease();
+    return item;
+}
+
+float ListView::getItemLength(Widget* item) const
+{
+    const Size& size = item->getSize();
+    return (_direction == SCROLLVIEW_DIR_VERTICAL) ? size.height : size.width;
+}
+
+Widget* ListView::createVirtualItem(ssize_t index)
+{
+    Widget* item = _dataSource->itemAtIndex(this, index);
+    CCASSERT(item, "The data source of a list view must return an item");
+    if (item->getParent() != _innerContainer)
+    {
+        ScrollView::addChild(item);
+    }
+
+    // the real length of the item replaces the estimated one, and changes the average length of the items
+    float length = getItemLength(item);
+    if (!_itemMeasured[index])
+    {
+        _itemMeasured[index] = true;
+        _measuredItemsLength += length;
+        ++_measuredItemsCount;
+        _itemLengths[index] = length;
+        _itemOffsetsDirty = true;
+    }
+    else if (length != _itemLengths[index])
+    {
+        _measuredItemsLength += length - _itemLengths[index];
+        _itemLengths[index] = length;
+        _itemOffsetsDirty = true;
+    }
+    return item;
+}
+
+void ListView::recycleVirtualItem(Widget* item)
+{
+    _freedItems.pushBack(item);
+    if (item->getParent() == _innerContainer)
+    {
+        ScrollView::removeChild(item, true);
+    }
+}
+
+void ListView::updateVirtualItemOffsets()
+{
+    bool vertical = (_direction == SCROLLVIEW_DIR_VERTICAL);
+    Size innerSize = _innerContainer->getSize();
+    Point innerPosition = _innerContainer->getPosition();
+    float viewLength = vertical ? _size.height : _size.width;
+    float start = vertical ? innerPosition.y + innerSize.height - _size.height : -innerPosition.x;
+
+    // the first item keeps its place so that the items in sight don't jump when the estimations change
+    ssize_t anchor = (!_items.empty() && _firstItemIndex < (ssize_t)_itemOffsets.size()) ? _firstItemIndex : -1;
+    float anchorOffset = (anchor >= 0) ? _itemOffsets[anchor] : 0.0f;
+
+    ssize_t count = _itemLengths.size();
+    float average = (_measuredItemsCount > 0) ? _measuredItemsLength / _measuredItemsCount : 0.0f;
+    _itemOffsets.resize(count + 1);
+    float offset = 0.0f;
+    for (ssize_t i = 0; i < count; ++i)
+    {
+        _itemOffsets[i] = offset;
+        float length = (_itemMeasured[i] || _itemLengths[i] > 0.0f) ? _itemLengths[i] : average;
+        offset += MAX(length, 1.0f) + _itemsMargin;
+    }
+    float totalLength = (count > 0) ? offset - _itemsMargin : 0.0f;
+    _itemOffsets[count] = totalLength;
+
+    float innerLength = MAX(totalLength, viewLength);
+    if (anchor >= 0)
+    {
+        start += _itemOffsets[anchor] - anchorOffset;
+    }
+    else
+    {
+        start = MAX(0.0f, MIN(start, innerLength - viewLength));
+    }
+
+    if (vertical)
+    {
+        _innerContainer->setSize(Size(_size.width, innerLength));
+        _innerContainer->setPosition(Point(innerPosition.x, start + _size.height - innerLength));
+    }
+    else
+    {
+        _innerContainer->setSize(Size(innerLength, _size.height));
+        _innerContainer->setPosition(Point(-start, innerPosition.y));
+    }
+    _itemOffsetsDirty = false;
+}
+
+void ListView::layoutVirtualItem(Widget* item, ssize_t index)
+{
+    Size layoutSize = _innerContainer->getSize();
+    Point ap = item->getAnchorPoint();
+    Size cs = item->getSize();
+    float offset = _itemOffsets[index];
+    Point position;
+    if (_direction == SCROLLVIEW_DIR_VERTICAL)
+    {
+        position.y = layoutSize.height - offset - (1.0f - ap.y) * cs.height;
+        switch (_gravity)
+        {
+            case LISTVIEW_GRAVITY_RIGHT:
+                position.x = layoutSize.width - (1.0f - ap.x) * cs.width;
+                break;
+            case LISTVIEW_GRAVITY_CENTER_HORIZONTAL:
+                position.x = layoutSize.width / 2.0f - cs.width * (0.5f - ap.x);
+                break;
+            default:
+                position.x = ap.x * cs.width;
+                break;
+        }
+    }
+    else
+    {
+        position.x = offset + ap.x * cs.width;
+        switch (_gravity)
+        {
+            case LISTVIEW_GRAVITY_BOTTOM:
+                position.y = ap.y * cs.height;
+                break;
+            case LISTVIEW_GRAVITY_CENTER_VERTICAL:
+                position.y = layoutSize.height / 2.0f - cs.height * (0.5f - ap.y);
+                break;
+            default:
+                position.y = layoutSize.height - (1.0f - ap.y) * cs.height;
+                break;
+        }
+    }
+    item->setPosition(position);
+}
+
+void ListView::updateVirtualItems()
+{
+    if (!_dataSource)
+    {
+        return;
+    }
+    if (!_virtualItemsDirty && !_itemOffsetsDirty && _innerContainer->getPosition().equals(_virtualInnerPosition))
+    {
+        return;
+    }
+
+    bool vertical = (_direction == SCROLLVIEW_DIR_VERTICAL);
+    float viewLength = vertical ? _size.height : _size.width;
+    float margin = viewLength * VIRTUAL_ITEMS_MARGIN;
+    ssize_t count = _itemLengths.size();
+
+    // the items which appear replace estimated lengths with real ones, which moves the items after them
+    for (int pass = 0; pass < 4; ++pass)
+    {
+        if (_itemOffsetsDirty)
+        {
+            updateVirtualItemOffsets();
+        }
+
+        Size innerSize = _innerContainer->getSize();
+        Point innerPosition = _innerContainer->getPosition();
+        float start = vertical ? innerPosition.y + innerSize.height - _size.height : -innerPosition.x;
+        float end = start + viewLength;
+
+        ssize_t first = 0;
+        ssize_t last = -1;
+        if (count > 0)
+        {
+            auto begin = _itemOffsets.begin();
+            first = std::upper_bound(begin, begin + count, start - margin) - begin - 1;
+            last = std::lower_bound(begin, begin + count, end + margin) - begin - 1;
+            first = MAX(first, (ssize_t)0);
+            last = MAX(last, first);
+        }
+
+        while (!_items.empty() && _firstItemIndex < first)
+        {
+            recycleVirtualItem(_items.at(0));
+            _items.erase(0);
+            ++_firstItemIndex;
+        }
+        while (!_items.empty() && _firstItemIndex + _items.size() - 1 > last)
+        {
+            recycleVirtualItem(_items.back());
+            _items.popBack();
+        }
+        if (_items.empty())
+        {
+            _firstItemIndex = first;
+        }
+        while (_firstItemIndex > first)
+        {
+            --_firstItemIndex;
+            _items.insert(0, createVirtualItem(_firstItemIndex));
+        }
+        while (_firstItemIndex + _items.size() <= last)
+        {
+            _items.pushBack(createVirtualItem(_firstItemIndex + _items.size()));
+        }
+
+        if (!_itemOffsetsDirty)
+        {
+            break;
+        }
+    }
+    // carry on next frame if the lengths haven't settled yet
+    bool settled = !_itemOffsetsDirty;
+    if (_itemOffsetsDirty)
+    {
+        updateVirtualItemOffsets();
+    }
+
+    ssize_t length = _items.size();
+    for (ssize_t i = 0; i < length; ++i)
+    {
+        layoutVirtualItem(_items.at(i), _firstItemIndex + i);
+    }
+    _virtualItemsDirty = !settled;
+    _virtualInnerPosition = _innerContainer->getPosition();
 }
     
 void ListView::addEventListenerListView(Object *target, SEL_ListViewEvent selector)
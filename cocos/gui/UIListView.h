@@ -27,6 +27,7 @@
 #define __UILISTVIEW_H__
 
 #include "gui/UIScrollView.h"
+#include <vector>
 
 NS_CC_BEGIN
 
@@ -51,6 +52,43 @@ typedef enum
 typedef void (Object::*SEL_ListViewEvent)(Object*,ListViewEventType);
 #define listvieweventselector(_SELECTOR) (SEL_ListViewEvent)(&_SELECTOR)
 
+class ListView;
+
+/**
+ * Data source of a virtual list view.
+ *
+ * Only the items around the visible part of the list are created, they are recycled as the list scrolls.
+ * @since v3.0
+ */
+class ListViewDataSource
+{
+public:
+    virtual ~ListViewDataSource() {}
+
+    /**
+     * Returns the number of items in the list view.
+     */
+    virtual ssize_t numberOfItemsInListView(ListView* listView) = 0;
+
+    /**
+     * Returns the item widget at a given index.
+     *
+     * Call ListView::dequeueItem() to reuse an item which has scrolled out of the list view.
+     */
+    virtual Widget* itemAtIndex(ListView* listView, ssize_t index) = 0;
+
+    /**
+     * Estimated size of an item which hasn't been created yet.
+     *
+     * It is replaced with the real size of the item once it is shown.
+     * When it returns zero, the average size of the items shown so far is used.
+     */
+    virtual Size estimatedItemSizeForIndex(ListView* listView, ssize_t index)
+    {
+        return Size::ZERO;
+    }
+};
+
 class ListView : public ScrollView
 {
     
@@ -166,7 +204,29 @@ public:
     virtual std::string getDescription() const override;
     
     void requestRefreshView();
-    
+
+    /**
+     * Sets the data source of the list view and turns the list view into a virtual list view.
+     *
+     * Items are not added with pushBackCustomItem() and the like anymore, they are asked to the data source.
+     * getItems() only returns the items which exist at the moment. The data source is not retained.
+     *
+     * @param dataSource  the data source, nullptr to turn the virtual mode off.
+     */
+    void setDataSource(ListViewDataSource* dataSource);
+
+    ListViewDataSource* getDataSource() const;
+
+    /**
+     * Recycles all the items and asks the data source again for the number of items and their sizes.
+     */
+    void reloadData();
+
+    /**
+     * Returns an item which has scrolled out of a virtual list view, or nullptr if there isn't any.
+     */
+    Widget* dequeueItem();
+
 protected:
     virtual void addChild(Node* child) override{ScrollView::addChild(child);};
     virtual void addChild(Node * child, int zOrder) override{ScrollView::addChild(child, zOrder);};
@@ -186,6 +246,12 @@ protected:
     void selectedItemEvent();
     virtual void interceptTouchEvent(int handleState,Widget* sender,const Point &touchPoint) override;
     void refreshView();
+    void updateVirtualItems();
+    void updateVirtualItemOffsets();
+    void layoutVirtualItem(Widget* item, ssize_t index);
+    Widget* createVirtualItem(ssize_t index);
+    void recycleVirtualItem(Widget* item);
+    float getItemLength(Widget* item) const;
 protected:
     
     Widget* _model;
@@ -196,6 +262,21 @@ protected:
     SEL_ListViewEvent    _listViewEventSelector;
     int _curSelectedIndex;
     bool _refreshViewDirty;
+
+    ListViewDataSource* _dataSource;
+    //! index of _items.at(0) in the data source
+    ssize_t _firstItemIndex;
+    //! lengths of the items in the scroll direction, estimated for the items never shown, 0 when unknown
+    std::vector<float> _itemLengths;
+    std::vector<bool> _itemMeasured;
+    //! distance from the beginning of the list to each item, with the total length at the end
+    std::vector<float> _itemOffsets;
+    float _measuredItemsLength;
+    int _measuredItemsCount;
+    bool _itemOffsetsDirty;
+    bool _virtualItemsDirty;
+    Point _virtualInnerPosition;
+    Vector<Widget*> _freedItems;
 };
 
 }
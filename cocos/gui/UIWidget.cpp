@@ -324,6 +324,7 @@ void Widget::setSizePercent(const Point &percent)
 
 void Widget::updateSizeAndPosition()
 {
+    Size oldSize = _size;
     switch (_sizeType)
     {
         case SIZE_ABSOLUTE:
@@ -403,7 +404,11 @@ void Widget::updateSizeAndPosition()
         default:
             break;
     }
-    onSizeChanged();
+    // the children only depend on the size of the widget, they don't need to be updated when it is unchanged
+    if (!_size.equals(oldSize))
+    {
+        onSizeChanged();
+    }
     Point absPos = getPosition();
     switch (_positionType)
     {
@@ -516,6 +521,16 @@ void Widget::onSizeChanged()
             static_cast<Widget*>(child)->updateSizeAndPosition();
         }
     }
+    requestParentDoLayout();
+}
+
+void Widget::requestParentDoLayout()
+{
+    Layout* parent = dynamic_cast<Layout*>(_parent);
+    if (parent)
+    {
+        parent->requestDoLayout();
+    }
 }
 
 const Size& Widget::getContentSize() const
@@ -950,6 +965,7 @@ void Widget::setLayoutParameter(LayoutParameter *parameter)
         return;
     }
     _layoutParameterDictionary.insert(parameter->getLayoutType(), parameter);
+    requestParentDoLayout();
 }
 
 LayoutParameter* Widget::getLayoutParameter(LayoutParameterType type)
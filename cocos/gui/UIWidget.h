@@ -630,6 +630,9 @@ protected:
     //call back function called when size changed.
     virtual void onSizeChanged();
     
+    //the size or the layout parameter of the widget changed, the layout of its parent has to be done again.
+    void requestParentDoLayout();
+    
     //initializes state of widget.
     virtual bool init();
     
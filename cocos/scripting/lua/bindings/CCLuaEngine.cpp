@@ -141,6 +141,12 @@ int LuaEngine::executeSchedule(int nHandler, float dt, Node* pNode/* = NULL*/)
     return ret;
 }
 
+void LuaEngine::executeScheduleBatch(const std::vector<SchedulerScriptBatchEntry>& batch)
+{
+    _stack->executeScheduleBatch(batch);
+    _stack->clean();
+}
+
 int LuaEngine::executeLayerTouchEvent(Layer* pLayer, int eventType, Touch *pTouch)
 {
     return 0;
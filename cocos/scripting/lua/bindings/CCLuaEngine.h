@@ -117,6 +117,7 @@ public:
     
     virtual int sendEvent(ScriptEvent* message);
     virtual int sendEventReturnArray(ScriptEvent* message,int numResults,Array& resultArray);
+    virtual void executeScheduleBatch(const std::vector<SchedulerScriptBatchEntry>& batch);
 private:
     LuaEngine(void)
     : _stack(NULL)
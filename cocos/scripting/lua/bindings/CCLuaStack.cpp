@@ -59,6 +59,14 @@ extern "C" {
 #include "lua_cocos2dx_spine_auto.hpp"
 #include "lua_cocos2dx_spine_manual.hpp"
 
+#include <stdio.h>
+#include <chrono>
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_WIN32)
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <errno.h>
+#endif
+
 namespace {
 int lua_print(lua_State * luastate)
 {
@@ -101,6 +109,109 @@ int lua_print(lua_State * luastate)
 
     return 0;
 }
+
+// header of a bytecode cache file, followed by the dumped chunk. LuaJIT doesn't verify the bytecode
+// it loads, so a cache with a damaged chunk is rejected by its hash instead of being run.
+struct BytecodeCacheHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t sourceSize;
+    uint32_t bytecodeSize;
+    uint64_t sourceHash;
+    uint64_t bytecodeHash;
+};
+
+const char BYTECODE_CACHE_MAGIC[4] = { 'C', 'C', 'L', 'B' };
+const uint32_t BYTECODE_CACHE_VERSION = 2;
+
+// FNV-1a
+uint64_t hashBytes(const char *data, size_t size)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+int writeChunkToString(lua_State *L, const void *p, size_t size, void *ud)
+{
+    static_cast<std::string*>(ud)->append(static_cast<const char*>(p), size);
+    return 0;
+}
+
+bool createDirectory(const std::string& path)
+{
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_WIN32)
+    mode_t processMask = umask(0);
+    int ret = mkdir(path.c_str(), S_IRWXU | S_IRWXG | S_IRWXO);
+    umask(processMask);
+    return ret == 0 || errno == EEXIST;
+#else
+    BOOL ret = CreateDirectoryA(path.c_str(), NULL);
+    return ret || ERROR_ALREADY_EXISTS == GetLastError();
+#endif
+}
+
+bool readBytecodeCache(const std::string& cacheFile, uint64_t sourceHash, size_t sourceSize, std::string *bytecode)
+{
+    FILE *fp = fopen(cacheFile.c_str(), "rb");
+    if (!fp)
+    {
+        return false;
+    }
+
+    BytecodeCacheHeader header;
+    bool ok = fread(&header, sizeof(header), 1, fp) == 1
+        && memcmp(header.magic, BYTECODE_CACHE_MAGIC, sizeof(header.magic)) == 0
+        && header.version == BYTECODE_CACHE_VERSION
+        && header.sourceSize == sourceSize
+        && header.sourceHash == sourceHash
+        && header.bytecodeSize > 0;
+    if (ok)
+    {
+        bytecode->resize(header.bytecodeSize);
+        ok = fread(&(*bytecode)[0], 1, header.bytecodeSize, fp) == header.bytecodeSize
+            && hashBytes(bytecode->data(), bytecode->size()) == header.bytecodeHash;
+    }
+    fclose(fp);
+    return ok;
+}
+
+void writeBytecodeCache(const std::string& cacheFile, uint64_t sourceHash, size_t sourceSize, const std::string& bytecode)
+{
+    // write next to the cache file and rename, so an interrupted write never leaves a truncated cache behind
+    std::string tempFile = cacheFile + ".tmp";
+    FILE *fp = fopen(tempFile.c_str(), "wb");
+    if (!fp)
+    {
+        return;
+    }
+
+    BytecodeCacheHeader header;
+    memcpy(header.magic, BYTECODE_CACHE_MAGIC, sizeof(header.magic));
+    header.version = BYTECODE_CACHE_VERSION;
+    header.sourceSize = (uint32_t)sourceSize;
+    header.bytecodeSize = (uint32_t)bytecode.size();
+    header.sourceHash = sourceHash;
+    header.bytecodeHash = hashBytes(bytecode.data(), bytecode.size());
+
+    bool ok = fwrite(&header, sizeof(header), 1, fp) == 1
+        && fwrite(bytecode.data(), 1, bytecode.size(), fp) == bytecode.size();
+    ok = (fclose(fp) == 0) && ok;
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+    // rename() replaces the target atomically on POSIX, but fails on Windows if it exists
+    remove(cacheFile.c_str());
+#endif
+    if (!ok || rename(tempFile.c_str(), cacheFile.c_str()) != 0)
+    {
+        remove(tempFile.c_str());
+    }
+}
 }  // namespace {
 
 NS_CC_BEGIN
@@ -221,6 +332,113 @@ void LuaStack::addLuaLoader(lua_CFunction func)
 }
 
 
+const LuaStack::ModuleInfo& LuaStack::resolveModule(const char* moduleName)
+{
+    FileUtils *fileUtils = FileUtils::getInstance();
+    if (_moduleIndexSearchPaths != fileUtils->getSearchPaths()
+        || _moduleIndexResolutionsOrder != fileUtils->getSearchResolutionsOrder())
+    {
+        purgeModuleIndex();
+        _moduleIndexSearchPaths = fileUtils->getSearchPaths();
+        _moduleIndexResolutionsOrder = fileUtils->getSearchResolutionsOrder();
+    }
+
+    auto iter = _moduleIndex.find(moduleName);
+    if (iter != _moduleIndex.end())
+    {
+        return iter->second;
+    }
+
+    std::string filename(moduleName);
+    size_t pos = filename.rfind(".lua");
+    if (pos != std::string::npos)
+    {
+        filename = filename.substr(0, pos);
+    }
+    
+    pos = filename.find_first_of(".");
+    while (pos != std::string::npos)
+    {
+        filename.replace(pos, 1, "/");
+        pos = filename.find_first_of(".");
+    }
+    filename.append(".lua");
+
+    // a packed module is named relative to its archive, which isFileExist() doesn't look into
+    std::string fullPath = fileUtils->fullPathForFilename(filename);
+    if (!fileUtils->isFileExist(fullPath) && !fileUtils->isFileInSearchPacks(fullPath))
+    {
+        _unresolvedModule.filename = filename;
+        _unresolvedModule.fullPath.clear();
+        return _unresolvedModule;
+    }
+
+    ModuleInfo& module = _moduleIndex[moduleName];
+    module.filename = filename;
+    module.fullPath = fullPath;
+    return module;
+}
+
+void LuaStack::purgeModuleIndex()
+{
+    _moduleIndex.clear();
+}
+
+void LuaStack::setBytecodeCacheEnabled(bool enabled, const std::string& cachePath)
+{
+    _bytecodeCacheEnabled = enabled;
+    if (!enabled)
+    {
+        return;
+    }
+
+    _bytecodeCachePath = cachePath.empty() ? FileUtils::getInstance()->getWritablePath() + "luacache/" : cachePath;
+    if (_bytecodeCachePath[_bytecodeCachePath.length() - 1] != '/')
+    {
+        _bytecodeCachePath.append("/");
+    }
+
+    if (!createDirectory(_bytecodeCachePath))
+    {
+        CCLOG("[LUA] can not create bytecode cache directory %s", _bytecodeCachePath.c_str());
+        _bytecodeCacheEnabled = false;
+    }
+}
+
+int LuaStack::luaLoadBuffer(lua_State *L, const char *chunk, int chunkSize, const char *chunkName)
+{
+    // precompiled chunks start with the bytecode signature and need no cache
+    if (!_bytecodeCacheEnabled || chunkSize <= 0 || chunk[0] == LUA_SIGNATURE[0])
+    {
+        return luaL_loadbuffer(L, chunk, chunkSize, chunkName);
+    }
+
+    // one cache file per chunk name, validated by the hash of the source it was compiled from
+    char cacheName[32];
+    snprintf(cacheName, sizeof(cacheName), "%016llx.luac", (unsigned long long)hashBytes(chunkName, strlen(chunkName)));
+    std::string cacheFile = _bytecodeCachePath + cacheName;
+    uint64_t sourceHash = hashBytes(chunk, chunkSize);
+
+    std::string bytecode;
+    if (readBytecodeCache(cacheFile, sourceHash, chunkSize, &bytecode))
+    {
+        if (luaL_loadbuffer(L, bytecode.data(), bytecode.size(), chunkName) == 0)
+        {
+            return 0;
+        }
+        // written by an incompatible VM, compile the source again and replace it
+        lua_pop(L, 1);
+        bytecode.clear();
+    }
+
+    int ret = luaL_loadbuffer(L, chunk, chunkSize, chunkName);
+    if (ret == 0 && lua_dump(L, writeChunkToString, &bytecode) == 0 && !bytecode.empty())
+    {
+        writeBytecodeCache(cacheFile, sourceHash, chunkSize, bytecode);
+    }
+    return ret;
+}
+
 void LuaStack::removeScriptObjectByObject(Object* pObj)
 {
     toluafix_remove_ccobject_by_refid(_state, pObj->_luaID);
@@ -234,7 +452,10 @@ void LuaStack::removeScriptHandler(int nHandler)
 int LuaStack::executeString(const char *codes)
 {
     luaL_loadstring(_state, codes);
-    return executeFunction(0);
+    int ret = executeFunction(0);
+    // the code may have defined a new __G__TRACKBACK__
+    refreshTracebackHandler();
+    return ret;
 }
 
 int LuaStack::executeScriptFile(const char* filename)
@@ -251,6 +472,7 @@ int LuaStack::executeScriptFile(const char* filename)
     --_callFromLua;
     CC_ASSERT(_callFromLua >= 0);
     // lua_gc(_state, LUA_GCCOLLECT, 0);
+    refreshTracebackHandler();
     
     if (nRet != 0)
     {
@@ -398,12 +620,7 @@ int LuaStack::executeFunction(int numArgs)
     }
 
     int traceback = 0;
-    lua_getglobal(_state, "__G__TRACKBACK__");                         /* L: ... func arg1 arg2 ... G */
-    if (!lua_isfunction(_state, -1))
-    {
-        lua_pop(_state, 1);                                            /* L: ... func arg1 arg2 ... */
-    }
-    else
+    if (pushTracebackHandler())                                        /* L: ... func arg1 arg2 ... G */
     {
         lua_insert(_state, functionIndex - 1);                         /* L: ... G func arg1 arg2 ... */
         traceback = functionIndex - 1;
@@ -457,12 +674,130 @@ int LuaStack::executeFunctionByHandler(int nHandler, int numArgs)
         {
             lua_insert(_state, -(numArgs + 1));                        /* L: ... func arg1 arg2 ... */
         }
-        ret = executeFunction(numArgs);
+        if (_profilingEnabled)
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+            ret = executeFunction(numArgs);
+            std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+            recordHandlerProfile(nHandler, duration.count());
+        }
+        else
+        {
+            ret = executeFunction(numArgs);
+        }
     }
     lua_settop(_state, 0);
     return ret;
 }
 
+void LuaStack::executeScheduleBatch(const std::vector<SchedulerScriptBatchEntry>& batch)
+{
+    int top = lua_gettop(_state);
+    int traceback = pushTracebackHandler();                            /* L: ... [G] */
+    lua_pushstring(_state, TOLUA_REFID_FUNCTION_MAPPING);
+    lua_rawget(_state, LUA_REGISTRYINDEX);                             /* L: ... [G] refid_fun */
+    int functions = lua_gettop(_state);
+
+    ++_callFromLua;
+    for (const auto& due : batch)
+    {
+        // an earlier callback of the batch may have unscheduled or paused this one
+        if (due.entry->isMarkedForDeletion() || due.entry->isPaused())
+            continue;
+
+        int handler = due.entry->getHandler();
+        lua_rawgeti(_state, functions, handler);                       /* L: ... [G] refid_fun func */
+        if (!lua_isfunction(_state, -1))
+        {
+            CCLOG("[LUA ERROR] function refid '%d' does not reference a Lua function", handler);
+            lua_pop(_state, 1);
+            continue;
+        }
+        lua_pushnumber(_state, due.elapse);                            /* L: ... [G] refid_fun func dt */
+
+        std::chrono::high_resolution_clock::time_point start;
+        if (_profilingEnabled)
+        {
+            start = std::chrono::high_resolution_clock::now();
+        }
+        if (lua_pcall(_state, 1, 0, traceback))                        /* L: ... [G] refid_fun [error] */
+        {
+            if (traceback == 0)
+            {
+                CCLOG("[LUA ERROR] %s", lua_tostring(_state, -1));
+            }
+            lua_pop(_state, 1); // remove error message from stack
+        }
+        if (_profilingEnabled)
+        {
+            std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+            recordHandlerProfile(handler, duration.count());
+        }
+    }
+    --_callFromLua;
+
+    lua_settop(_state, top);                                           /* L: ... */
+}
+
+int LuaStack::pushTracebackHandler()
+{
+    if (_tracebackRef == LUA_NOREF)
+    {
+        lua_getglobal(_state, "__G__TRACKBACK__");                     /* L: ... G */
+        if (!lua_isfunction(_state, -1))
+        {
+            // not defined yet, look it up again next time
+            lua_pop(_state, 1);                                        /* L: ... */
+            return 0;
+        }
+        lua_pushvalue(_state, -1);                                     /* L: ... G G */
+        _tracebackRef = luaL_ref(_state, LUA_REGISTRYINDEX);           /* L: ... G */
+    }
+    else
+    {
+        lua_rawgeti(_state, LUA_REGISTRYINDEX, _tracebackRef);         /* L: ... G */
+    }
+    return lua_gettop(_state);
+}
+
+void LuaStack::refreshTracebackHandler()
+{
+    if (_tracebackRef != LUA_NOREF)
+    {
+        luaL_unref(_state, LUA_REGISTRYINDEX, _tracebackRef);
+        _tracebackRef = LUA_NOREF;
+    }
+}
+
+void LuaStack::setProfilingEnabled(bool enabled)
+{
+    _profilingEnabled = enabled;
+}
+
+void LuaStack::resetHandlerProfiles()
+{
+    _handlerProfiles.clear();
+}
+
+void LuaStack::recordHandlerProfile(int handler, double seconds)
+{
+    auto iter = _handlerProfiles.find(handler);
+    if (iter == _handlerProfiles.end())
+    {
+        HandlerProfile profile = { 1, seconds, seconds };
+        _handlerProfiles.insert(std::make_pair(handler, profile));
+        return;
+    }
+
+    HandlerProfile& profile = iter->second;
+    ++profile.calls;
+    profile.totalTime += seconds;
+    if (seconds > profile.maxTime)
+    {
+        profile.maxTime = seconds;
+    }
+}
+
 bool LuaStack::handleAssert(const char *msg)
 {
     if (_callFromLua == 0) return false;
@@ -508,12 +843,7 @@ int LuaStack::executeFunctionReturnArray(int handler,int numArgs,int numResults,
             }
             
             int traceback = 0;
-            lua_getglobal(_state, "__G__TRACKBACK__");                         /* L: ... func arg1 arg2 ... G */
-            if (!lua_isfunction(_state, -1))
-            {
-                lua_pop(_state, 1);                                            /* L: ... func arg1 arg2 ... */
-            }
-            else
+            if (pushTracebackHandler())                                        /* L: ... func arg1 arg2 ... G */
             {
                 lua_insert(_state, functionIndex - 1);                         /* L: ... G func arg1 arg2 ... */
                 traceback = functionIndex - 1;
@@ -27,10 +27,12 @@
 
 extern "C" {
 #include "lua.h"
+#include "lauxlib.h"
 }
 
 #include "cocos2d.h"
 #include "CCLuaValue.h"
+#include <unordered_map>
 
 NS_CC_BEGIN
 
@@ -118,19 +120,111 @@ public:
     virtual int executeFunctionReturnArray(int handler,int numArgs,int numResults,Array& resultArray);
 
     virtual bool handleAssert(const char *msg);
+
+    /**
+     @brief Call the schedule callbacks that are due in the current frame.
+     The traceback handler and the function reference table are looked up once for the
+     whole batch instead of once per callback, each callback still runs in its own protected call.
+     @since v3.0
+     */
+    virtual void executeScheduleBatch(const std::vector<SchedulerScriptBatchEntry>& batch);
+
+    /**
+     @brief Look up the global __G__TRACKBACK__ again on the next call.
+     The traceback handler is cached in the registry and refreshed after executeString() and
+     executeScriptFile(); call it when a callback replaces the global.
+     */
+    void refreshTracebackHandler();
+
+    /** Call count and time spent in a script handler */
+    struct HandlerProfile
+    {
+        unsigned int calls;
+        /** Seconds */
+        double totalTime;
+        double maxTime;
+    };
+
+    /**
+     @brief Record the call count and the time of every handler called through
+     executeFunctionByHandler() and executeScheduleBatch(). Disabled by default.
+     @since v3.0
+     */
+    void setProfilingEnabled(bool enabled);
+    bool isProfilingEnabled() const { return _profilingEnabled; }
+
+    /** Profiles recorded since profiling was enabled or last reset, by handler */
+    const std::unordered_map<int, HandlerProfile>& getHandlerProfiles() const { return _handlerProfiles; }
+    void resetHandlerProfiles();
+
+    /** A module name resolved by the cocos2dx loader */
+    struct ModuleInfo
+    {
+        /** Relative file name, e.g. "luaScript/mainMenu.lua" for "luaScript.mainMenu" */
+        std::string filename;
+        /** Full path of the file, empty if no search path contains it */
+        std::string fullPath;
+    };
+
+    /**
+     @brief Resolve a module name passed to require into its file.
+     A module that is found is kept in an index so it is only searched for once; the index
+     is purged automatically when the search paths or resolution order change. A module
+     that isn't found is searched for again on the next require, so files added later are found.
+     */
+    const ModuleInfo& resolveModule(const char* moduleName);
+
+    /**
+     @brief Forget every resolved module, e.g. after files were added to a search path.
+     */
+    void purgeModuleIndex();
+
+    /**
+     @brief Cache the compiled chunks loaded by luaLoadBuffer() as bytecode files.
+     A cached chunk is reused as long as the hash of its source is unchanged, so only
+     the first run pays for parsing the scripts. Disabled by default.
+     @param cachePath Directory of the cache files, FileUtils::getWritablePath() + "luacache/" if empty.
+     @since v3.0
+     */
+    void setBytecodeCacheEnabled(bool enabled, const std::string& cachePath = "");
+    bool isBytecodeCacheEnabled() const { return _bytecodeCacheEnabled; }
+
+    /**
+     @brief Same as luaL_loadbuffer(), but loads the chunk from the bytecode cache if it is up to date.
+     Precompiled chunks are loaded as they are.
+     */
+    virtual int luaLoadBuffer(lua_State *L, const char *chunk, int chunkSize, const char *chunkName);
     
 protected:
     LuaStack(void)
     : _state(NULL)
     , _callFromLua(0)
+    , _bytecodeCacheEnabled(false)
+    , _tracebackRef(LUA_NOREF)
+    , _profilingEnabled(false)
     {
     }
     
     bool init(void);
     bool initWithLuaState(lua_State *L);
+
+    /** Push the traceback handler, returns its stack index or 0 if scripts did not define one */
+    int pushTracebackHandler();
+    void recordHandlerProfile(int handler, double seconds);
     
     lua_State *_state;
     int _callFromLua;
+
+    std::unordered_map<std::string, ModuleInfo> _moduleIndex;
+    // the last module not found, misses aren't kept in the index
+    ModuleInfo _unresolvedModule;
+    std::vector<std::string> _moduleIndexSearchPaths;
+    std::vector<std::string> _moduleIndexResolutionsOrder;
+    bool _bytecodeCacheEnabled;
+    std::string _bytecodeCachePath;
+    int _tracebackRef;
+    bool _profilingEnabled;
+    std::unordered_map<int, HandlerProfile> _handlerProfiles;
 };
 
 NS_CC_END
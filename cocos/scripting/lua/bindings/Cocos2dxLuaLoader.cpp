@@ -22,6 +22,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ****************************************************************************/
 #include "Cocos2dxLuaLoader.h"
+#include "CCLuaEngine.h"
 #include <string>
 #include <algorithm>
 
@@ -31,26 +32,20 @@ extern "C"
 {
     int cocos2dx_lua_loader(lua_State *L)
     {
-        std::string filename(luaL_checkstring(L, 1));
-        size_t pos = filename.rfind(".lua");
-        if (pos != std::string::npos)
-        {
-            filename = filename.substr(0, pos);
-        }
+        // module names are resolved once and then looked up in the stack's index
+        LuaStack *stack = LuaEngine::getInstance()->getLuaStack();
+        const LuaStack::ModuleInfo& module = stack->resolveModule(luaL_checkstring(L, 1));
+        const std::string& filename = module.filename;
         
-        pos = filename.find_first_of(".");
-        while (pos != std::string::npos)
+        Data data;
+        if (!module.fullPath.empty())
         {
-            filename.replace(pos, 1, "/");
-            pos = filename.find_first_of(".");
+            data = FileUtils::getInstance()->getDataFromFile(module.fullPath);
         }
-        filename.append(".lua");
-        
-        Data data = FileUtils::getInstance()->getDataFromFile(filename);
         
         if (!data.isNull())
         {
-            if (luaL_loadbuffer(L, (char*)data.getBytes(), data.getSize(), filename.c_str()) != 0)
+            if (stack->luaLoadBuffer(L, (char*)data.getBytes(), (int)data.getSize(), filename.c_str()) != 0)
             {
                 luaL_error(L, "error loading module %s from file %s :\n\t%s",
                     lua_tostring(L, 1), filename.c_str(), lua_tostring(L, -1));
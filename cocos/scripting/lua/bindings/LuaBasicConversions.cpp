@@ -82,6 +82,178 @@ bool luaval_is_usertype(lua_State* L,int lo,const char* type, int def)
     return false;
 }
 
+namespace {
+
+/*
+ * The field names of the struct tables and the recycled tables are kept per lua state,
+ * so the conversions below neither hash key strings nor allocate tables on hot paths.
+ * Keys are pushed from registry references and fields are read with raw access.
+ */
+enum LuavalKey
+{
+    KEY_X,
+    KEY_Y,
+    KEY_WIDTH,
+    KEY_HEIGHT,
+    KEY_R,
+    KEY_G,
+    KEY_B,
+    KEY_A,
+    KEY_C,
+    KEY_D,
+    KEY_TX,
+    KEY_TY,
+    KEY_COUNT
+};
+
+const char* s_luavalKeyNames[KEY_COUNT] = { "x", "y", "width", "height", "r", "g", "b", "a", "c", "d", "tx", "ty" };
+
+enum LuavalStruct
+{
+    STRUCT_POINT,
+    STRUCT_SIZE,
+    STRUCT_RECT,
+    STRUCT_COLOR3B,
+    STRUCT_COLOR4B,
+    STRUCT_COLOR4F,
+    STRUCT_AFFINETRANSFORM,
+    STRUCT_COUNT
+};
+
+// recycled tables returned per struct type before the first one is reused
+const int RECYCLED_TABLES_PER_STRUCT = 8;
+
+struct LuavalCache
+{
+    int keyRefs[KEY_COUNT];
+    int recycledTablesRefs[STRUCT_COUNT];
+    int recycledTablesIndex[STRUCT_COUNT];
+    bool recycleTables;
+};
+
+// the state asked last, coroutines of the same state share its registry and its cache
+lua_State* s_luavalCacheState = nullptr;
+LuavalCache* s_luavalCache = nullptr;
+
+int luaval_cache_gc(lua_State* L)
+{
+    if (lua_touserdata(L, 1) == s_luavalCache)
+    {
+        s_luavalCacheState = nullptr;
+        s_luavalCache = nullptr;
+    }
+    return 0;
+}
+
+LuavalCache* luaval_find_cache(lua_State* L)
+{
+    lua_pushlightuserdata(L, &s_luavalCache);                       /* L: ... cachekey */
+    lua_rawget(L, LUA_REGISTRYINDEX);                               /* L: ... cache */
+    LuavalCache* cache = static_cast<LuavalCache*>(lua_touserdata(L, -1));
+    lua_pop(L, 1);                                                  /* L: ... */
+
+    if (nullptr == cache)
+    {
+        // owned by the state, its __gc forgets the cache when the state is closed
+        cache = static_cast<LuavalCache*>(lua_newuserdata(L, sizeof(LuavalCache)));  /* L: ... cache */
+        lua_newtable(L);                                            /* L: ... cache mt */
+        lua_pushcfunction(L, luaval_cache_gc);
+        lua_setfield(L, -2, "__gc");
+        lua_setmetatable(L, -2);                                    /* L: ... cache */
+        lua_pushlightuserdata(L, &s_luavalCache);                   /* L: ... cache cachekey */
+        lua_pushvalue(L, -2);                                       /* L: ... cache cachekey cache */
+        lua_rawset(L, LUA_REGISTRYINDEX);                           /* L: ... cache */
+        lua_pop(L, 1);                                              /* L: ... */
+
+        for (int i = 0; i < KEY_COUNT; ++i)
+        {
+            lua_pushstring(L, s_luavalKeyNames[i]);
+            cache->keyRefs[i] = luaL_ref(L, LUA_REGISTRYINDEX);
+        }
+
+        for (int i = 0; i < STRUCT_COUNT; ++i)
+        {
+            lua_createtable(L, RECYCLED_TABLES_PER_STRUCT, 0);      /* L: ... tables */
+            for (int j = 1; j <= RECYCLED_TABLES_PER_STRUCT; ++j)
+            {
+                lua_createtable(L, 0, 6);
+                lua_rawseti(L, -2, j);
+            }
+            cache->recycledTablesRefs[i] = luaL_ref(L, LUA_REGISTRYINDEX);  /* L: ... */
+            cache->recycledTablesIndex[i] = 0;
+        }
+        cache->recycleTables = false;
+    }
+
+    s_luavalCacheState = L;
+    s_luavalCache = cache;
+    return cache;
+}
+
+inline LuavalCache* luaval_get_cache(lua_State* L)
+{
+    return L == s_luavalCacheState ? s_luavalCache : luaval_find_cache(L);
+}
+
+inline int luaval_absindex(lua_State* L, int lo)
+{
+    return (lo < 0 && lo > LUA_REGISTRYINDEX) ? lua_gettop(L) + lo + 1 : lo;
+}
+
+// lo must be an absolute index
+inline lua_Number luaval_number_field(lua_State* L, LuavalCache* cache, int lo, LuavalKey key)
+{
+    lua_rawgeti(L, LUA_REGISTRYINDEX, cache->keyRefs[key]);         /* L: ... key */
+    lua_rawget(L, lo);                                              /* L: ... value */
+    if (lua_isnil(L, -1) && lua_getmetatable(L, lo))
+    {
+        // not a plain struct table, let __index provide the field
+        lua_pop(L, 2);                                              /* L: ... */
+        lua_rawgeti(L, LUA_REGISTRYINDEX, cache->keyRefs[key]);     /* L: ... key */
+        lua_gettable(L, lo);                                        /* L: ... value */
+    }
+    lua_Number value = lua_tonumber(L, -1);
+    lua_pop(L, 1);                                                  /* L: ... */
+    return value;
+}
+
+inline void luaval_push_struct_table(lua_State* L, LuavalCache* cache, LuavalStruct type, int fieldCount)
+{
+    if (!cache->recycleTables)
+    {
+        lua_createtable(L, 0, fieldCount);                          /* L: ... table */
+        return;
+    }
+
+    int& index = cache->recycledTablesIndex[type];
+    index = index % RECYCLED_TABLES_PER_STRUCT + 1;
+    lua_rawgeti(L, LUA_REGISTRYINDEX, cache->recycledTablesRefs[type]);  /* L: ... tables */
+    lua_rawgeti(L, -1, index);                                      /* L: ... tables table */
+    lua_remove(L, -2);                                              /* L: ... table */
+}
+
+// sets table[key] = value for the table on the top of the stack
+inline void luaval_set_number_field(lua_State* L, LuavalCache* cache, LuavalKey key, lua_Number value)
+{
+    lua_rawgeti(L, LUA_REGISTRYINDEX, cache->keyRefs[key]);         /* L: table key */
+    lua_pushnumber(L, value);                                       /* L: table key value */
+    lua_rawset(L, -3);                                              /* table[key] = value, L: table */
+}
+
+}  // namespace {
+
+void luaval_set_struct_table_recycling(lua_State* L, bool enabled)
+{
+    if (nullptr == L)
+        return;
+    luaval_get_cache(L)->recycleTables = enabled;
+}
+
+bool luaval_is_struct_table_recycling(lua_State* L)
+{
+    return nullptr != L && luaval_get_cache(L)->recycleTables;
+}
+
 bool luaval_to_ushort(lua_State* L, int lo, unsigned short* outValue)
 {
     if (nullptr == L || nullptr == outValue)
@@ -290,20 +462,15 @@ bool luaval_to_point(lua_State* L,int lo,Point* outValue)
 #endif
         ok = false;
     }
-
     
     if (ok)
     {
-        lua_pushstring(L, "x");
-        lua_gettable(L, lo);
-        outValue->x = lua_isnil(L, -1) ? 0 : lua_tonumber(L, -1);
-        lua_pop(L, 1);
-        
-        lua_pushstring(L, "y");
-        lua_gettable(L, lo);
-        outValue->y = lua_isnil(L, -1) ? 0 : lua_tonumber(L, -1);
-        lua_pop(L, 1);
+        lo = luaval_absindex(L, lo);
+        LuavalCache* cache = luaval_get_cache(L);
+        outValue->x = luaval_number_field(L, cache, lo, KEY_X);
+        outValue->y = luaval_number_field(L, cache, lo, KEY_Y);
     }
+    
     return ok;
 }
 
@@ -378,15 +545,10 @@ bool luaval_to_size(lua_State* L,int lo,Size* outValue)
     
     if (ok)
     {
-        lua_pushstring(L, "width");  /* L: paramStack key */
-        lua_gettable(L,lo);/* L: paramStack paramStack[lo][key] */
-        outValue->width = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);/* L: paramStack*/
-        
-        lua_pushstring(L, "height");
-        lua_gettable(L,lo);
-        outValue->height = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
+        lo = luaval_absindex(L, lo);
+        LuavalCache* cache = luaval_get_cache(L);
+        outValue->width = luaval_number_field(L, cache, lo, KEY_WIDTH);
+        outValue->height = luaval_number_field(L, cache, lo, KEY_HEIGHT);
     }
     
     return ok;
@@ -410,25 +572,12 @@ bool luaval_to_rect(lua_State* L,int lo,Rect* outValue)
     
     if (ok)
     {
-        lua_pushstring(L, "x");
-        lua_gettable(L,lo);
-        outValue->origin.x = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
-        
-        lua_pushstring(L, "y");
-        lua_gettable(L,lo);
-        outValue->origin.y = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
-        
-        lua_pushstring(L, "width");
-        lua_gettable(L,lo);
-        outValue->size.width = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
-        
-        lua_pushstring(L, "height");
-        lua_gettable(L,lo);
-        outValue->size.height = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
+        lo = luaval_absindex(L, lo);
+        LuavalCache* cache = luaval_get_cache(L);
+        outValue->origin.x = luaval_number_field(L, cache, lo, KEY_X);
+        outValue->origin.y = luaval_number_field(L, cache, lo, KEY_Y);
+        outValue->size.width = luaval_number_field(L, cache, lo, KEY_WIDTH);
+        outValue->size.height = luaval_number_field(L, cache, lo, KEY_HEIGHT);
     }
     
     return ok;
@@ -450,27 +599,14 @@ bool luaval_to_color4b(lua_State* L,int lo,Color4B* outValue)
         ok = false;
     }
     
-    if(ok)
+    if (ok)
     {
-        lua_pushstring(L, "r");
-        lua_gettable(L,lo);
-        outValue->r = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
-        
-        lua_pushstring(L, "g");
-        lua_gettable(L,lo);
-        outValue->g = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
-        
-        lua_pushstring(L, "b");
-        lua_gettable(L,lo);
-        outValue->b = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
-        
-        lua_pushstring(L, "a");
-        lua_gettable(L,lo);
-        outValue->a = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
+        lo = luaval_absindex(L, lo);
+        LuavalCache* cache = luaval_get_cache(L);
+        outValue->r = luaval_number_field(L, cache, lo, KEY_R);
+        outValue->g = luaval_number_field(L, cache, lo, KEY_G);
+        outValue->b = luaval_number_field(L, cache, lo, KEY_B);
+        outValue->a = luaval_number_field(L, cache, lo, KEY_A);
     }
     
     return ok;
@@ -494,25 +630,12 @@ bool luaval_to_color4f(lua_State* L,int lo,Color4F* outValue)
     
     if (ok)
     {
-        lua_pushstring(L, "r");
-        lua_gettable(L,lo);
-        outValue->r = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
-        
-        lua_pushstring(L, "g");
-        lua_gettable(L,lo);
-        outValue->g = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
-        
-        lua_pushstring(L, "b");
-        lua_gettable(L,lo);
-        outValue->b = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
-        
-        lua_pushstring(L, "a");
-        lua_gettable(L,lo);
-        outValue->a = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
+        lo = luaval_absindex(L, lo);
+        LuavalCache* cache = luaval_get_cache(L);
+        outValue->r = luaval_number_field(L, cache, lo, KEY_R);
+        outValue->g = luaval_number_field(L, cache, lo, KEY_G);
+        outValue->b = luaval_number_field(L, cache, lo, KEY_B);
+        outValue->a = luaval_number_field(L, cache, lo, KEY_A);
     }
     
     return ok;
@@ -536,20 +659,11 @@ bool luaval_to_color3b(lua_State* L,int lo,Color3B* outValue)
     
     if (ok)
     {
-        lua_pushstring(L, "r");
-        lua_gettable(L,lo);
-        outValue->r = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
-        
-        lua_pushstring(L, "g");
-        lua_gettable(L,lo);
-        outValue->g = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
-        
-        lua_pushstring(L, "b");
-        lua_gettable(L,lo);
-        outValue->b = lua_isnil(L,-1) ? 0 : lua_tonumber(L,-1);
-        lua_pop(L,1);
+        lo = luaval_absindex(L, lo);
+        LuavalCache* cache = luaval_get_cache(L);
+        outValue->r = luaval_number_field(L, cache, lo, KEY_R);
+        outValue->g = luaval_number_field(L, cache, lo, KEY_G);
+        outValue->b = luaval_number_field(L, cache, lo, KEY_B);
     }
     
     return ok;
@@ -573,36 +687,16 @@ bool luaval_to_affinetransform(lua_State* L,int lo, AffineTransform* outValue)
     
     if (ok)
     {
-        lua_pushstring(L, "a");
-        lua_gettable(L,lo);
-        outValue->a = lua_isnil(L,-1) ? 0 : (float)lua_tonumber(L,-1);
-        lua_pop(L,1);
-        
-        lua_pushstring(L, "b");
-        lua_gettable(L,lo);
-        outValue->b = lua_isnil(L,-1) ? 0 : (float)lua_tonumber(L,-1);
-        lua_pop(L,1);
-        
-        lua_pushstring(L, "c");
-        lua_gettable(L,lo);
-        outValue->b = lua_isnil(L,-1) ? 0 : (float)lua_tonumber(L,-1);
-        lua_pop(L,1);
-        
-        lua_pushstring(L, "d");
-        lua_gettable(L,lo);
-        outValue->b = lua_isnil(L,-1) ? 0 : (float)lua_tonumber(L,-1);
-        lua_pop(L,1);
-        
-        lua_pushstring(L, "tx");
-        lua_gettable(L,lo);
-        outValue->b = lua_isnil(L,-1) ? 0 : (float)lua_tonumber(L,-1);
-        lua_pop(L,1);
-        
-        lua_pushstring(L, "ty");
-        lua_gettable(L,lo);
-        outValue->b = lua_isnil(L,-1) ? 0 : (float)lua_tonumber(L,-1);
-        lua_pop(L,1);
+        lo = luaval_absindex(L, lo);
+        LuavalCache* cache = luaval_get_cache(L);
+        outValue->a = (float)luaval_number_field(L, cache, lo, KEY_A);
+        outValue->b = (float)luaval_number_field(L, cache, lo, KEY_B);
+        outValue->c = (float)luaval_number_field(L, cache, lo, KEY_C);
+        outValue->d = (float)luaval_number_field(L, cache, lo, KEY_D);
+        outValue->tx = (float)luaval_number_field(L, cache, lo, KEY_TX);
+        outValue->ty = (float)luaval_number_field(L, cache, lo, KEY_TY);
     }
+    
     return ok;
 }
 
@@ -1506,125 +1600,81 @@ void point_to_luaval(lua_State* L,const Point& pt)
 {
     if (NULL  == L)
         return;
-    lua_newtable(L);                                    /* L: table */
-    lua_pushstring(L, "x");                             /* L: table key */
-    lua_pushnumber(L, (lua_Number) pt.x);               /* L: table key value*/
-    lua_rawset(L, -3);                                  /* table[key] = value, L: table */
-    lua_pushstring(L, "y");                             /* L: table key */
-    lua_pushnumber(L, (lua_Number) pt.y);               /* L: table key value*/
-    lua_rawset(L, -3);                                  /* table[key] = value, L: table */
+    LuavalCache* cache = luaval_get_cache(L);
+    luaval_push_struct_table(L, cache, STRUCT_POINT, 2);    /* L: table */
+    luaval_set_number_field(L, cache, KEY_X, (lua_Number) pt.x);
+    luaval_set_number_field(L, cache, KEY_Y, (lua_Number) pt.y);
 }
 
 void size_to_luaval(lua_State* L,const Size& sz)
 {
     if (NULL  == L)
         return;
-    lua_newtable(L);                                    /* L: table */
-    lua_pushstring(L, "width");                         /* L: table key */
-    lua_pushnumber(L, (lua_Number) sz.width);           /* L: table key value*/
-    lua_rawset(L, -3);                                  /* table[key] = value, L: table */
-    lua_pushstring(L, "height");                        /* L: table key */
-    lua_pushnumber(L, (lua_Number) sz.height);          /* L: table key value*/
-    lua_rawset(L, -3);                                  /* table[key] = value, L: table */
+    LuavalCache* cache = luaval_get_cache(L);
+    luaval_push_struct_table(L, cache, STRUCT_SIZE, 2);    /* L: table */
+    luaval_set_number_field(L, cache, KEY_WIDTH, (lua_Number) sz.width);
+    luaval_set_number_field(L, cache, KEY_HEIGHT, (lua_Number) sz.height);
 }
 
 void rect_to_luaval(lua_State* L,const Rect& rt)
 {
     if (NULL  == L)
         return;
-    lua_newtable(L);                                    /* L: table */
-    lua_pushstring(L, "x");                             /* L: table key */
-    lua_pushnumber(L, (lua_Number) rt.origin.x);               /* L: table key value*/
-    lua_rawset(L, -3);                                  /* table[key] = value, L: table */
-    lua_pushstring(L, "y");                             /* L: table key */
-    lua_pushnumber(L, (lua_Number) rt.origin.y);               /* L: table key value*/
-    lua_rawset(L, -3);                                  /* table[key] = value, L: table */
-    lua_pushstring(L, "width");                         /* L: table key */
-    lua_pushnumber(L, (lua_Number) rt.size.width);           /* L: table key value*/
-    lua_rawset(L, -3);                                  /* table[key] = value, L: table */
-    lua_pushstring(L, "height");                        /* L: table key */
-    lua_pushnumber(L, (lua_Number) rt.size.height);          /* L: table key value*/
-    lua_rawset(L, -3);                                  /* table[key] = value, L: table */
+    LuavalCache* cache = luaval_get_cache(L);
+    luaval_push_struct_table(L, cache, STRUCT_RECT, 4);    /* L: table */
+    luaval_set_number_field(L, cache, KEY_X, (lua_Number) rt.origin.x);
+    luaval_set_number_field(L, cache, KEY_Y, (lua_Number) rt.origin.y);
+    luaval_set_number_field(L, cache, KEY_WIDTH, (lua_Number) rt.size.width);
+    luaval_set_number_field(L, cache, KEY_HEIGHT, (lua_Number) rt.size.height);
 }
 
 void color4b_to_luaval(lua_State* L,const Color4B& cc)
 {
     if (NULL  == L)
         return;
-    lua_newtable(L);                                    /* L: table */
-    lua_pushstring(L, "r");                             /* L: table key */
-    lua_pushnumber(L, (lua_Number) cc.r);               /* L: table key value*/
-    lua_rawset(L, -3);                                  /* table[key] = value, L: table */
-    lua_pushstring(L, "g");                             /* L: table key */
-    lua_pushnumber(L, (lua_Number) cc.g);               /* L: table key value*/
-    lua_rawset(L, -3);                                  /* table[key] = value, L: table */
-    lua_pushstring(L, "b");                         /* L: table key */
-    lua_pushnumber(L, (lua_Number) cc.b);           /* L: table key value*/
-    lua_rawset(L, -3);                                  /* table[key] = value, L: table */
-    lua_pushstring(L, "a");                        /* L: table key */
-    lua_pushnumber(L, (lua_Number) cc.a);          /* L: table key value*/
-    lua_rawset(L, -3);                                  /* table[key] = value, L: table */
+    LuavalCache* cache = luaval_get_cache(L);
+    luaval_push_struct_table(L, cache, STRUCT_COLOR4B, 4);    /* L: table */
+    luaval_set_number_field(L, cache, KEY_R, (lua_Number) cc.r);
+    luaval_set_number_field(L, cache, KEY_G, (lua_Number) cc.g);
+    luaval_set_number_field(L, cache, KEY_B, (lua_Number) cc.b);
+    luaval_set_number_field(L, cache, KEY_A, (lua_Number) cc.a);
 }
 
 void color4f_to_luaval(lua_State* L,const Color4F& cc)
 {
     if (NULL  == L)
         return;
-    lua_newtable(L);                                    /* L: table */
-    lua_pushstring(L, "r");                             /* L: table key */
-    lua_pushnumber(L, (lua_Number) cc.r);               /* L: table key value*/
-    lua_rawset(L, -3);                                  /* table[key] = value, L: table */
-    lua_pushstring(L, "g");                             /* L: table key */
-    lua_pushnumber(L, (lua_Number) cc.g);               /* L: table key value*/
-    lua_rawset(L, -3);                                  /* table[key] = value, L: table */
-    lua_pushstring(L, "b");                         /* L: table key */
-    lua_pushnumber(L, (lua_Number) cc.b);           /* L: table key value*/
-    lua_rawset(L, -3);                                  /* table[key] = value, L: table */
-    lua_pushstring(L, "a");                        /* L: table key */
-    lua_pushnumber(L, (lua_Number) cc.a);          /* L: table key value*/
-    lua_rawset(L, -3);                                  /* table[key] = value, L: table */
+    LuavalCache* cache = luaval_get_cache(L);
+    luaval_push_struct_table(L, cache, STRUCT_COLOR4F, 4);    /* L: table */
+    luaval_set_number_field(L, cache, KEY_R, (lua_Number) cc.r);
+    luaval_set_number_field(L, cache, KEY_G, (lua_Number) cc.g);
+    luaval_set_number_field(L, cache, KEY_B, (lua_Number) cc.b);
+    luaval_set_number_field(L, cache, KEY_A, (lua_Number) cc.a);
 }
 
 void color3b_to_luaval(lua_State* L,const Color3B& cc)
 {
     if (NULL  == L)
         return;
-    lua_newtable(L);                                    /* L: table */
-    lua_pushstring(L, "r");                             /* L: table key */
-    lua_pushnumber(L, (lua_Number) cc.r);               /* L: table key value*/
-    lua_rawset(L, -3);                                  /* table[key] = value, L: table */
-    lua_pushstring(L, "g");                             /* L: table key */
-    lua_pushnumber(L, (lua_Number) cc.g);               /* L: table key value*/
-    lua_rawset(L, -3);                                  /* table[key] = value, L: table */
-    lua_pushstring(L, "b");                             /* L: table key */
-    lua_pushnumber(L, (lua_Number) cc.b);               /* L: table key value*/
-    lua_rawset(L, -3);                                  /* table[key] = value, L: table */
+    LuavalCache* cache = luaval_get_cache(L);
+    luaval_push_struct_table(L, cache, STRUCT_COLOR3B, 3);    /* L: table */
+    luaval_set_number_field(L, cache, KEY_R, (lua_Number) cc.r);
+    luaval_set_number_field(L, cache, KEY_G, (lua_Number) cc.g);
+    luaval_set_number_field(L, cache, KEY_B, (lua_Number) cc.b);
 }
 
 void affinetransform_to_luaval(lua_State* L,const AffineTransform& inValue)
 {
     if (NULL  == L)
         return;
-    
-    lua_newtable(L);                                    /* L: table */
-    lua_pushstring(L, "a");                             /* L: table key */
-    lua_pushnumber(L, (lua_Number) inValue.a);               /* L: table key value*/
-    lua_rawset(L, -3);                                  /* table[key] = value, L: table */
-    lua_pushstring(L, "b");                             /* L: table key */
-    lua_pushnumber(L, (lua_Number) inValue.b);               /* L: table key value*/
-    lua_rawset(L, -3);                                  /* table[key] = value, L: table */
-    lua_pushstring(L, "c");                             /* L: table key */
-    lua_pushnumber(L, (lua_Number) inValue.c);               /* L: table key value*/
-    lua_rawset(L, -3);                                  /* table[key] = value, L: table */
-    lua_pushstring(L, "d");                             /* L: table key */
-    lua_pushnumber(L, (lua_Number) inValue.d);               /* L: table key value*/
-    lua_rawset(L, -3);                                  /* table[key] = value, L: table */
-    lua_pushstring(L, "tx");                             /* L: table key */
-    lua_pushnumber(L, (lua_Number) inValue.d);               /* L: table key value*/
-    lua_rawset(L, -3);                                  /* table[key] = value, L: table */
-    lua_pushstring(L, "ty");                             /* L: table key */
-    lua_pushnumber(L, (lua_Number) inValue.d);               /* L: table key value*/
-    lua_rawset(L, -3);                                  /* table[key] = value, L: table */
+    LuavalCache* cache = luaval_get_cache(L);
+    luaval_push_struct_table(L, cache, STRUCT_AFFINETRANSFORM, 6);    /* L: table */
+    luaval_set_number_field(L, cache, KEY_A, (lua_Number) inValue.a);
+    luaval_set_number_field(L, cache, KEY_B, (lua_Number) inValue.b);
+    luaval_set_number_field(L, cache, KEY_C, (lua_Number) inValue.c);
+    luaval_set_number_field(L, cache, KEY_D, (lua_Number) inValue.d);
+    luaval_set_number_field(L, cache, KEY_TX, (lua_Number) inValue.tx);
+    luaval_set_number_field(L, cache, KEY_TY, (lua_Number) inValue.ty);
 }
 
 void fontdefinition_to_luaval(lua_State* L,const FontDefinition& inValue)
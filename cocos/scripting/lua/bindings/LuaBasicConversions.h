@@ -23,6 +23,15 @@ cocos2d::log(__VA_ARGS__);                                                  \
 }                                                                           \
 
 extern bool luaval_is_usertype(lua_State* L,int lo,const char* type, int def);
+
+/**
+ * Point, Size, Rect, colors and AffineTransform are returned to lua as new tables by default.
+ * With recycling enabled they are taken from a small ring of tables per type instead, so a
+ * returned table is overwritten by a later call returning the same type: scripts have to copy
+ * the values they keep. The setting is shared by a lua state and its coroutines.
+ */
+extern void luaval_set_struct_table_recycling(lua_State* L, bool enabled);
+extern bool luaval_is_struct_table_recycling(lua_State* L);
 // to native
 extern bool luaval_to_ushort(lua_State* L, int lo, unsigned short* outValue);
 extern bool luaval_to_int32(lua_State* L,int lo,int* outValue);
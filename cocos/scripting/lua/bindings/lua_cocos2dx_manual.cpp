@@ -4396,6 +4396,112 @@ static void extendGridAction(lua_State* tolua_S)
     lua_pop(tolua_S, 1);
 }
 
+static int tolua_cocos2dx_setStructTableRecycling(lua_State* tolua_S)
+{
+    if (nullptr == tolua_S)
+        return 0;
+    
+#if COCOS2D_DEBUG >= 1
+    tolua_Error tolua_err;
+    if (!tolua_isboolean(tolua_S, 1, 0, &tolua_err))
+        goto tolua_lerror;
+#endif
+    
+    luaval_set_struct_table_recycling(tolua_S, tolua_toboolean(tolua_S, 1, 0) != 0);
+    return 0;
+    
+#if COCOS2D_DEBUG >= 1
+tolua_lerror:
+    tolua_error(tolua_S,"#ferror in function 'setStructTableRecycling'.",&tolua_err);
+    return 0;
+#endif
+}
+
+static int tolua_cocos2dx_isStructTableRecycling(lua_State* tolua_S)
+{
+    if (nullptr == tolua_S)
+        return 0;
+    
+    tolua_pushboolean(tolua_S, luaval_is_struct_table_recycling(tolua_S));
+    return 1;
+}
+
+static void registerStructTableRecycling(lua_State* tolua_S)
+{
+    tolua_module(tolua_S,"cc",0);
+    tolua_beginmodule(tolua_S,"cc");
+      tolua_function(tolua_S, "setStructTableRecycling", tolua_cocos2dx_setStructTableRecycling);
+      tolua_function(tolua_S, "isStructTableRecycling", tolua_cocos2dx_isStructTableRecycling);
+    tolua_endmodule(tolua_S);
+}
+
+static int tolua_cocos2dx_setScriptProfilingEnabled(lua_State* tolua_S)
+{
+    if (nullptr == tolua_S)
+        return 0;
+    
+#if COCOS2D_DEBUG >= 1
+    tolua_Error tolua_err;
+    if (!tolua_isboolean(tolua_S, 1, 0, &tolua_err))
+        goto tolua_lerror;
+#endif
+    
+    LuaEngine::getInstance()->getLuaStack()->setProfilingEnabled(tolua_toboolean(tolua_S, 1, 0) != 0);
+    return 0;
+    
+#if COCOS2D_DEBUG >= 1
+tolua_lerror:
+    tolua_error(tolua_S,"#ferror in function 'setScriptProfilingEnabled'.",&tolua_err);
+    return 0;
+#endif
+}
+
+static int tolua_cocos2dx_getScriptHandlerProfiles(lua_State* tolua_S)
+{
+    if (nullptr == tolua_S)
+        return 0;
+    
+    // { { handler = refid, func = function, calls = n, totalTime = seconds, maxTime = seconds }, ... }
+    const auto& profiles = LuaEngine::getInstance()->getLuaStack()->getHandlerProfiles();
+    lua_createtable(tolua_S, (int)profiles.size(), 0);                  /* L: profiles */
+    int index = 1;
+    for (const auto& item : profiles)
+    {
+        lua_createtable(tolua_S, 0, 5);                                 /* L: profiles profile */
+        lua_pushinteger(tolua_S, item.first);
+        lua_setfield(tolua_S, -2, "handler");
+        toluafix_get_function_by_refid(tolua_S, item.first);            // nil if the handler was removed
+        lua_setfield(tolua_S, -2, "func");
+        lua_pushnumber(tolua_S, item.second.calls);
+        lua_setfield(tolua_S, -2, "calls");
+        lua_pushnumber(tolua_S, item.second.totalTime);
+        lua_setfield(tolua_S, -2, "totalTime");
+        lua_pushnumber(tolua_S, item.second.maxTime);
+        lua_setfield(tolua_S, -2, "maxTime");
+        lua_rawseti(tolua_S, -2, index++);                              /* L: profiles */
+    }
+    return 1;
+}
+
+static int tolua_cocos2dx_resetScriptHandlerProfiles(lua_State* tolua_S)
+{
+    if (nullptr == tolua_S)
+        return 0;
+    
+    LuaEngine::getInstance()->getLuaStack()->resetHandlerProfiles();
+    return 0;
+}
+
+static void registerScriptProfiling(lua_State* tolua_S)
+{
+    tolua_module(tolua_S,"cc",0);
+    tolua_beginmodule(tolua_S,"cc");
+      tolua_function(tolua_S, "setScriptProfilingEnabled", tolua_cocos2dx_setScriptProfilingEnabled);
+      tolua_function(tolua_S, "getScriptHandlerProfiles", tolua_cocos2dx_getScriptHandlerProfiles);
+      tolua_function(tolua_S, "resetScriptHandlerProfiles", tolua_cocos2dx_resetScriptHandlerProfiles);
+    tolua_endmodule(tolua_S);
+}
+
 int register_all_cocos2dx_manual(lua_State* tolua_S)
 {
     if (NULL == tolua_S)
@@ -4435,6 +4541,8 @@ int register_all_cocos2dx_manual(lua_State* tolua_S)
     extendEventListenerMouse(tolua_S);
     extendActionCamera(tolua_S);
     extendGridAction(tolua_S);
+    registerStructTableRecycling(tolua_S);
+    registerScriptProfiling(tolua_S);
     
     return 0;
 }
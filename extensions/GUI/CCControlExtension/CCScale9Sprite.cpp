@@ -26,62 +26,99 @@ THE SOFTWARE.
 ****************************************************************************/
 
 #include "CCScale9Sprite.h"
+#include "CCQuadCommand.h"
+#include "CCRenderer.h"
 
 NS_CC_EXT_BEGIN
 
-enum positions
+// Mirrors Sprite::setTextureCoords(), without flipping
+static void setQuadTextureCoords(V3F_C4B_T2F_Quad& quad, Texture2D* texture, Rect rect, bool rotated)
 {
-    pCentre = 0,
-    pTop,
-    pLeft,
-    pRight,
-    pBottom,
-    pTopRight,
-    pTopLeft,
-    pBottomRight,
-    pBottomLeft
-};
+    rect = CC_RECT_POINTS_TO_PIXELS(rect);
+
+    float atlasWidth = (float)texture->getPixelsWide();
+    float atlasHeight = (float)texture->getPixelsHigh();
+
+    float left, right, top, bottom;
+
+    if (rotated)
+    {
+#if CC_FIX_ARTIFACTS_BY_STRECHING_TEXEL
+        left    = (2*rect.origin.x+1)/(2*atlasWidth);
+        right   = left+(rect.size.height*2-2)/(2*atlasWidth);
+        top     = (2*rect.origin.y+1)/(2*atlasHeight);
+        bottom  = top+(rect.size.width*2-2)/(2*atlasHeight);
+#else
+        left    = rect.origin.x/atlasWidth;
+        right   = (rect.origin.x+rect.size.height) / atlasWidth;
+        top     = rect.origin.y/atlasHeight;
+        bottom  = (rect.origin.y+rect.size.width) / atlasHeight;
+#endif // CC_FIX_ARTIFACTS_BY_STRECHING_TEXEL
+
+        quad.bl.texCoords.u = left;
+        quad.bl.texCoords.v = top;
+        quad.br.texCoords.u = left;
+        quad.br.texCoords.v = bottom;
+        quad.tl.texCoords.u = right;
+        quad.tl.texCoords.v = top;
+        quad.tr.texCoords.u = right;
+        quad.tr.texCoords.v = bottom;
+    }
+    else
+    {
+#if CC_FIX_ARTIFACTS_BY_STRECHING_TEXEL
+        left    = (2*rect.origin.x+1)/(2*atlasWidth);
+        right   = left + (rect.size.width*2-2)/(2*atlasWidth);
+        top     = (2*rect.origin.y+1)/(2*atlasHeight);
+        bottom  = top + (rect.size.height*2-2)/(2*atlasHeight);
+#else
+        left    = rect.origin.x/atlasWidth;
+        right   = (rect.origin.x + rect.size.width) / atlasWidth;
+        top     = rect.origin.y/atlasHeight;
+        bottom  = (rect.origin.y + rect.size.height) / atlasHeight;
+#endif // ! CC_FIX_ARTIFACTS_BY_STRECHING_TEXEL
+
+        quad.bl.texCoords.u = left;
+        quad.bl.texCoords.v = bottom;
+        quad.br.texCoords.u = right;
+        quad.br.texCoords.v = bottom;
+        quad.tl.texCoords.u = left;
+        quad.tl.texCoords.v = top;
+        quad.tr.texCoords.u = right;
+        quad.tr.texCoords.v = top;
+    }
+}
 
 Scale9Sprite::Scale9Sprite()
 : _spritesGenerated(false)
 , _spriteFrameRotated(false)
 , _positionsAreDirty(false)
-, _scale9Image(NULL)
-, _topLeft(NULL)
-, _top(NULL)
-, _topRight(NULL)
-, _left(NULL)
-, _centre(NULL)
-, _right(NULL)
-, _bottomLeft(NULL)
-, _bottom(NULL)
-, _bottomRight(NULL)
+, _texture(NULL)
+, _blendFunc(BlendFunc::ALPHA_PREMULTIPLIED)
+, _leftWidth(0)
+, _rightWidth(0)
+, _bottomHeight(0)
+, _topHeight(0)
 , _opacityModifyRGB(false)
 , _insetLeft(0)
 , _insetTop(0)
 , _insetRight(0)
 , _insetBottom(0)
 {
-
+    for (auto& quad : _quads)
+    {
+        quad = V3F_C4B_T2F_Quad();
+    }
 }
 
 Scale9Sprite::~Scale9Sprite()
 {
-    CC_SAFE_RELEASE(_topLeft);
-    CC_SAFE_RELEASE(_top);
-    CC_SAFE_RELEASE(_topRight);
-    CC_SAFE_RELEASE(_left);
-    CC_SAFE_RELEASE(_centre);
-    CC_SAFE_RELEASE(_right);
-    CC_SAFE_RELEASE(_bottomLeft);
-    CC_SAFE_RELEASE(_bottom);
-    CC_SAFE_RELEASE(_bottomRight);
-    CC_SAFE_RELEASE(_scale9Image);
+    CC_SAFE_RELEASE(_texture);
 }
 
 bool Scale9Sprite::init()
 {
-    return this->initWithBatchNode(NULL, Rect::ZERO, Rect::ZERO);
+    return this->initWithTexture(NULL, Rect::ZERO, false, Rect::ZERO);
 }
 
 bool Scale9Sprite::initWithBatchNode(SpriteBatchNode* batchnode, const Rect& rect, const Rect& capInsets)
@@ -91,9 +128,17 @@ bool Scale9Sprite::initWithBatchNode(SpriteBatchNode* batchnode, const Rect& rec
 
 bool Scale9Sprite::initWithBatchNode(SpriteBatchNode* batchnode, const Rect& rect, bool rotated, const Rect& capInsets)
 {
-    if(batchnode)
+    return this->initWithTexture(batchnode ? batchnode->getTexture() : NULL, rect, rotated, capInsets);
+}
+
+bool Scale9Sprite::initWithTexture(Texture2D* texture, const Rect& rect, bool rotated, const Rect& capInsets)
+{
+    // the slices carry their own MV-transformed vertices, see QuadCommand
+    this->setShaderProgram(ShaderCache::getInstance()->getProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR_NO_MVP));
+
+    if(texture)
     {
-        this->updateWithBatchNode(batchnode, rect, rotated, capInsets);
+        this->updateWithTexture(texture, rect, rotated, capInsets);
     }
     
     this->setAnchorPoint(Point(0.5f, 0.5f));
@@ -102,46 +147,28 @@ bool Scale9Sprite::initWithBatchNode(SpriteBatchNode* batchnode, const Rect& rec
     return true;
 }
 
-#define    TRANSLATE_X(x, y, xtranslate) \
-    x+=xtranslate;                       \
-
-#define    TRANSLATE_Y(x, y, ytranslate) \
-    y+=ytranslate;                       \
+bool Scale9Sprite::updateWithBatchNode(SpriteBatchNode* batchnode, const Rect& rect, bool rotated, const Rect& capInsets)
+{
+    return this->updateWithTexture(batchnode ? batchnode->getTexture() : NULL, rect, rotated, capInsets);
+}
 
-bool Scale9Sprite::updateWithBatchNode(SpriteBatchNode* batchnode, const Rect& originalRect, bool rotated, const Rect& capInsets)
+bool Scale9Sprite::updateWithTexture(Texture2D* texture, const Rect& originalRect, bool rotated, const Rect& capInsets)
 {
-    GLubyte opacity = getOpacity();
-    Color3B color = getColor();
     Rect rect(originalRect);
 
-    // Release old sprites
-    this->removeAllChildrenWithCleanup(true);
-
-    CC_SAFE_RELEASE(this->_centre);
-    CC_SAFE_RELEASE(this->_top);
-    CC_SAFE_RELEASE(this->_topLeft);
-    CC_SAFE_RELEASE(this->_topRight);
-    CC_SAFE_RELEASE(this->_left);
-    CC_SAFE_RELEASE(this->_right);
-    CC_SAFE_RELEASE(this->_bottomLeft);
-    CC_SAFE_RELEASE(this->_bottom);
-    CC_SAFE_RELEASE(this->_bottomRight);
-
-    
-    if(this->_scale9Image != batchnode)
+    if(this->_texture != texture)
     {
-        CC_SAFE_RELEASE(this->_scale9Image);
-        _scale9Image = batchnode;
-        CC_SAFE_RETAIN(_scale9Image);
+        CC_SAFE_RETAIN(texture);
+        CC_SAFE_RELEASE(this->_texture);
+        _texture = texture;
+        this->updateBlendFunc();
     }
     
-    if (!_scale9Image)
+    if (!_texture)
     {
         return false;
     }
 
-    _scale9Image->removeAllChildrenWithCleanup(true);
-
     _capInsets = capInsets;
     _spriteFrameRotated = rotated;
     
@@ -149,7 +176,7 @@ bool Scale9Sprite::updateWithBatchNode(SpriteBatchNode* batchnode, const Rect& o
     if ( rect.equals(Rect::ZERO) )
     {
         // Get the texture size as original
-        Size textureSize = _scale9Image->getTextureAtlas()->getTexture()->getContentSize();
+        Size textureSize = _texture->getContentSize();
     
         rect = Rect(0, 0, textureSize.width, textureSize.height);
     }
@@ -178,213 +205,53 @@ bool Scale9Sprite::updateWithBatchNode(SpriteBatchNode* batchnode, const Rect& o
     float center_h = _capInsetsInternal.size.height;
     float bottom_h = rect.size.height - (top_h + center_h);
 
-    // calculate rects
-
-    // ... top row
-    float x = 0.0;
-    float y = 0.0;
+    _leftWidth = left_w;
+    _rightWidth = right_w;
+    _topHeight = top_h;
+    _bottomHeight = bottom_h;
 
-    // top left
-    Rect lefttopbounds = Rect(x, y, left_w, top_h);
+    // calculate the texture rect of every slice, rows from bottom to top;
+    // texture space grows downwards so the bottom row starts below the top and center rows
+    const float columnX[3] = { 0.0f, left_w, left_w + center_w };
+    const float columnW[3] = { left_w, center_w, right_w };
+    const float rowY[3] = { top_h + center_h, top_h, 0.0f };
+    const float rowH[3] = { bottom_h, center_h, top_h };
 
-    // top center
-    TRANSLATE_X(x, y, left_w);
-    Rect centertopbounds = Rect(x, y, center_w, top_h);
-        
-    // top right
-    TRANSLATE_X(x, y, center_w);
-    Rect righttopbounds = Rect(x, y, right_w, top_h);
-
-    // ... center row
-    x = 0.0;
-    y = 0.0;
-    TRANSLATE_Y(x, y, top_h);
-
-    // center left
-    Rect leftcenterbounds = Rect(x, y, left_w, center_h);
-
-    // center center
-    TRANSLATE_X(x, y, left_w);
-    Rect centerbounds = Rect(x, y, center_w, center_h);
-
-    // center right
-    TRANSLATE_X(x, y, center_w);
-    Rect rightcenterbounds = Rect(x, y, right_w, center_h);
-
-    // ... bottom row
-    x = 0.0;
-    y = 0.0;
-    TRANSLATE_Y(x, y, top_h);
-    TRANSLATE_Y(x, y, center_h);
-
-    // bottom left
-    Rect leftbottombounds = Rect(x, y, left_w, bottom_h);
-
-    // bottom center
-    TRANSLATE_X(x, y, left_w);
-    Rect centerbottombounds = Rect(x, y, center_w, bottom_h);
-
-    // bottom right
-    TRANSLATE_X(x, y, center_w);
-    Rect rightbottombounds = Rect(x, y, right_w, bottom_h);
-
-    if (!rotated) {
-        // log("!rotated");
-
-        AffineTransform t = AffineTransform::IDENTITY;
+    AffineTransform t = AffineTransform::IDENTITY;
+    if (!rotated)
+    {
         t = AffineTransformTranslate(t, rect.origin.x, rect.origin.y);
-
-        centerbounds = RectApplyAffineTransform(centerbounds, t);
-        rightbottombounds = RectApplyAffineTransform(rightbottombounds, t);
-        leftbottombounds = RectApplyAffineTransform(leftbottombounds, t);
-        righttopbounds = RectApplyAffineTransform(righttopbounds, t);
-        lefttopbounds = RectApplyAffineTransform(lefttopbounds, t);
-        rightcenterbounds = RectApplyAffineTransform(rightcenterbounds, t);
-        leftcenterbounds = RectApplyAffineTransform(leftcenterbounds, t);
-        centerbottombounds = RectApplyAffineTransform(centerbottombounds, t);
-        centertopbounds = RectApplyAffineTransform(centertopbounds, t);
-
-        // Centre
-        _centre = Sprite::createWithTexture(_scale9Image->getTexture(), centerbounds);
-        _centre->retain();
-        _scale9Image->addChild(_centre, 0, pCentre);
-
-        
-        // Top
-        _top = Sprite::createWithTexture(_scale9Image->getTexture(), centertopbounds);
-        _top->retain();
-        _scale9Image->addChild(_top, 1, pTop);
-        
-        // Bottom
-        _bottom = Sprite::createWithTexture(_scale9Image->getTexture(), centerbottombounds);
-        _bottom->retain();
-        _scale9Image->addChild(_bottom, 1, pBottom);
-        
-        // Left
-        _left = Sprite::createWithTexture(_scale9Image->getTexture(), leftcenterbounds);
-        _left->retain();
-        _scale9Image->addChild(_left, 1, pLeft);
-        
-        // Right
-        _right = Sprite::createWithTexture(_scale9Image->getTexture(), rightcenterbounds);
-        _right->retain();
-        _scale9Image->addChild(_right, 1, pRight);
-        
-        // Top left
-        _topLeft = Sprite::createWithTexture(_scale9Image->getTexture(), lefttopbounds);
-        _topLeft->retain();
-        _scale9Image->addChild(_topLeft, 2, pTopLeft);
-        
-        // Top right
-        _topRight = Sprite::createWithTexture(_scale9Image->getTexture(), righttopbounds);
-        _topRight->retain();
-        _scale9Image->addChild(_topRight, 2, pTopRight);
-        
-        // Bottom left
-        _bottomLeft = Sprite::createWithTexture(_scale9Image->getTexture(), leftbottombounds);
-        _bottomLeft->retain();
-        _scale9Image->addChild(_bottomLeft, 2, pBottomLeft);
-        
-        // Bottom right
-        _bottomRight = Sprite::createWithTexture(_scale9Image->getTexture(), rightbottombounds);
-        _bottomRight->retain();
-        _scale9Image->addChild(_bottomRight, 2, pBottomRight);
-    } else {
+    }
+    else
+    {
         // set up transformation of coordinates
         // to handle the case where the sprite is stored rotated
         // in the spritesheet
-        // log("rotated");
-
-        AffineTransform t = AffineTransform::IDENTITY;
-
-        Rect rotatedcenterbounds = centerbounds;
-        Rect rotatedrightbottombounds = rightbottombounds;
-        Rect rotatedleftbottombounds = leftbottombounds;
-        Rect rotatedrighttopbounds = righttopbounds;
-        Rect rotatedlefttopbounds = lefttopbounds;
-        Rect rotatedrightcenterbounds = rightcenterbounds;
-        Rect rotatedleftcenterbounds = leftcenterbounds;
-        Rect rotatedcenterbottombounds = centerbottombounds;
-        Rect rotatedcentertopbounds = centertopbounds;
-        
         t = AffineTransformTranslate(t, rect.size.height+rect.origin.x, rect.origin.y);
         t = AffineTransformRotate(t, 1.57079633f);
-        
-        centerbounds = RectApplyAffineTransform(centerbounds, t);
-        rightbottombounds = RectApplyAffineTransform(rightbottombounds, t);
-        leftbottombounds = RectApplyAffineTransform(leftbottombounds, t);
-        righttopbounds = RectApplyAffineTransform(righttopbounds, t);
-        lefttopbounds = RectApplyAffineTransform(lefttopbounds, t);
-        rightcenterbounds = RectApplyAffineTransform(rightcenterbounds, t);
-        leftcenterbounds = RectApplyAffineTransform(leftcenterbounds, t);
-        centerbottombounds = RectApplyAffineTransform(centerbottombounds, t);
-        centertopbounds = RectApplyAffineTransform(centertopbounds, t);
-
-        rotatedcenterbounds.origin = centerbounds.origin;
-        rotatedrightbottombounds.origin = rightbottombounds.origin;
-        rotatedleftbottombounds.origin = leftbottombounds.origin;
-        rotatedrighttopbounds.origin = righttopbounds.origin;
-        rotatedlefttopbounds.origin = lefttopbounds.origin;
-        rotatedrightcenterbounds.origin = rightcenterbounds.origin;
-        rotatedleftcenterbounds.origin = leftcenterbounds.origin;
-        rotatedcenterbottombounds.origin = centerbottombounds.origin;
-        rotatedcentertopbounds.origin = centertopbounds.origin;
-
-        // Centre
-        _centre = Sprite::createWithTexture(_scale9Image->getTexture(), rotatedcenterbounds, true);
-        _centre->retain();
-        _scale9Image->addChild(_centre, 0, pCentre);
-        
-        // Top
-        _top = Sprite::createWithTexture(_scale9Image->getTexture(), rotatedcentertopbounds, true);
-        _top->retain();
-        _scale9Image->addChild(_top, 1, pTop);
-        
-        // Bottom
-        _bottom = Sprite::createWithTexture(_scale9Image->getTexture(), rotatedcenterbottombounds, true);
-        _bottom->retain();
-        _scale9Image->addChild(_bottom, 1, pBottom);
-        
-        // Left
-        _left = Sprite::createWithTexture(_scale9Image->getTexture(), rotatedleftcenterbounds, true);
-        _left->retain();
-        _scale9Image->addChild(_left, 1, pLeft);
-        
-        // Right
-        _right = Sprite::createWithTexture(_scale9Image->getTexture(), rotatedrightcenterbounds, true);
-        _right->retain();
-        _scale9Image->addChild(_right, 1, pRight);
-        
-        // Top left
-        _topLeft = Sprite::createWithTexture(_scale9Image->getTexture(), rotatedlefttopbounds, true);
-        _topLeft->retain();
-        _scale9Image->addChild(_topLeft, 2, pTopLeft);
-        
-        // Top right
-        _topRight = Sprite::createWithTexture(_scale9Image->getTexture(), rotatedrighttopbounds, true);
-        _topRight->retain();
-        _scale9Image->addChild(_topRight, 2, pTopRight);
-        
-        // Bottom left
-        _bottomLeft = Sprite::createWithTexture(_scale9Image->getTexture(), rotatedleftbottombounds, true);
-        _bottomLeft->retain();
-        _scale9Image->addChild(_bottomLeft, 2, pBottomLeft);
-        
-        // Bottom right
-        _bottomRight = Sprite::createWithTexture(_scale9Image->getTexture(), rotatedrightbottombounds, true);
-        _bottomRight->retain();
-        _scale9Image->addChild(_bottomRight, 2, pBottomRight);
     }
 
-    this->setContentSize(rect.size);
-    this->addChild(_scale9Image);
-    
-    if (_spritesGenerated)
+    for (int row = 0; row < 3; ++row)
     {
-        // Restore color and opacity
-        this->setOpacity(opacity);
-        this->setColor(color);
+        for (int column = 0; column < 3; ++column)
+        {
+            Rect bounds(columnX[column], rowY[row], columnW[column], rowH[row]);
+            Rect transformed = RectApplyAffineTransform(bounds, t);
+            if (rotated)
+            {
+                // a rotated texture rect keeps its unrotated size, like Sprite's
+                bounds.origin = transformed.origin;
+            }
+            else
+            {
+                bounds = transformed;
+            }
+            setQuadTextureCoords(_quads[row * 3 + column], _texture, bounds, rotated);
+        }
     }
+
+    this->setContentSize(rect.size);
+    this->updateColor();
     _spritesGenerated = true;
 
     return true;
@@ -398,69 +265,69 @@ void Scale9Sprite::setContentSize(const Size &size)
 
 void Scale9Sprite::updatePositions()
 {
-    // Check that instances are non-NULL
-    if(!((_topLeft) &&
-         (_topRight) &&
-         (_bottomRight) &&
-         (_bottomLeft) &&
-         (_centre))) {
-        // if any of the above sprites are NULL, return
+    if (!_texture)
+    {
         return;
     }
 
-    Size size = this->_contentSize;
+    // the corners keep their size, the edges and the centre stretch in between
+    const float x[4] = { 0.0f, _leftWidth, _contentSize.width - _rightWidth, _contentSize.width };
+    const float y[4] = { 0.0f, _bottomHeight, _contentSize.height - _topHeight, _contentSize.height };
 
-    float sizableWidth = size.width - _topLeft->getContentSize().width - _topRight->getContentSize().width;
-    float sizableHeight = size.height - _topLeft->getContentSize().height - _bottomRight->getContentSize().height;
-    
-    float horizontalScale = sizableWidth/_centre->getContentSize().width;
-    float verticalScale = sizableHeight/_centre->getContentSize().height;
-
-    _centre->setScaleX(horizontalScale);
-    _centre->setScaleY(verticalScale);
-
-    float rescaledWidth = _centre->getContentSize().width * horizontalScale;
-    float rescaledHeight = _centre->getContentSize().height * verticalScale;
-
-    float leftWidth = _bottomLeft->getContentSize().width;
-    float bottomHeight = _bottomLeft->getContentSize().height;
-
-    _bottomLeft->setAnchorPoint(Point(0,0));
-    _bottomRight->setAnchorPoint(Point(0,0));
-    _topLeft->setAnchorPoint(Point(0,0));
-    _topRight->setAnchorPoint(Point(0,0));
-    _left->setAnchorPoint(Point(0,0));
-    _right->setAnchorPoint(Point(0,0));
-    _top->setAnchorPoint(Point(0,0));
-    _bottom->setAnchorPoint(Point(0,0));
-    _centre->setAnchorPoint(Point(0,0));
-
-    // Position corners
-    _bottomLeft->setPosition(Point(0,0));
-    _bottomRight->setPosition(Point(leftWidth+rescaledWidth,0));
-    _topLeft->setPosition(Point(0, bottomHeight+rescaledHeight));
-    _topRight->setPosition(Point(leftWidth+rescaledWidth, bottomHeight+rescaledHeight));
-
-    // Scale and position borders
-    _left->setPosition(Point(0, bottomHeight));
-    _left->setScaleY(verticalScale);
-    _right->setPosition(Point(leftWidth+rescaledWidth,bottomHeight));
-    _right->setScaleY(verticalScale);
-    _bottom->setPosition(Point(leftWidth,0));
-    _bottom->setScaleX(horizontalScale);
-    _top->setPosition(Point(leftWidth,bottomHeight+rescaledHeight));
-    _top->setScaleX(horizontalScale);
-
-    // Position centre
-    _centre->setPosition(Point(leftWidth, bottomHeight));
+    for (int row = 0; row < 3; ++row)
+    {
+        for (int column = 0; column < 3; ++column)
+        {
+            V3F_C4B_T2F_Quad& quad = _quads[row * 3 + column];
+            quad.bl.vertices = Vertex3F(x[column], y[row], 0);
+            quad.br.vertices = Vertex3F(x[column + 1], y[row], 0);
+            quad.tl.vertices = Vertex3F(x[column], y[row + 1], 0);
+            quad.tr.vertices = Vertex3F(x[column + 1], y[row + 1], 0);
+        }
+    }
+}
+
+void Scale9Sprite::updateBlendFunc()
+{
+    // same as Sprite: premultiplied textures blend with ONE and modify RGB by opacity
+    if (!_texture || !_texture->hasPremultipliedAlpha())
+    {
+        _blendFunc = BlendFunc::ALPHA_NON_PREMULTIPLIED;
+        _opacityModifyRGB = false;
+    }
+    else
+    {
+        _blendFunc = BlendFunc::ALPHA_PREMULTIPLIED;
+        _opacityModifyRGB = true;
+    }
+}
+
+void Scale9Sprite::updateColor()
+{
+    Color4B color4(_displayedColor.r, _displayedColor.g, _displayedColor.b, _displayedOpacity);
+
+    if (_opacityModifyRGB)
+    {
+        color4.r *= _displayedOpacity/255.0f;
+        color4.g *= _displayedOpacity/255.0f;
+        color4.b *= _displayedOpacity/255.0f;
+    }
+
+    for (auto& quad : _quads)
+    {
+        quad.bl.colors = color4;
+        quad.br.colors = color4;
+        quad.tl.colors = color4;
+        quad.tr.colors = color4;
+    }
 }
 
 bool Scale9Sprite::initWithFile(const char* file, const Rect& rect,  const Rect& capInsets)
 {
     CCASSERT(file != NULL, "Invalid file for sprite");
     
-    SpriteBatchNode *batchnode = SpriteBatchNode::create(file, 9);
-    bool pReturn = this->initWithBatchNode(batchnode, rect, capInsets);
+    Texture2D *texture = Director::getInstance()->getTextureCache()->addImage(file);
+    bool pReturn = this->initWithTexture(texture, rect, false, capInsets);
     return pReturn;
 }
 
@@ -538,10 +405,7 @@ bool Scale9Sprite::initWithSpriteFrame(SpriteFrame* spriteFrame, const Rect& cap
     Texture2D* texture = spriteFrame->getTexture();
     CCASSERT(texture != NULL, "CCTexture must be not nil");
 
-    SpriteBatchNode *batchnode = SpriteBatchNode::createWithTexture(texture, 9);
-    CCASSERT(batchnode != NULL, "CCSpriteBatchNode must be not nil");
-
-    bool pReturn = this->initWithBatchNode(batchnode, spriteFrame->getRect(), spriteFrame->isRotated(), capInsets);
+    bool pReturn = this->initWithTexture(texture, spriteFrame->getRect(), spriteFrame->isRotated(), capInsets);
     return pReturn;
 }
 
@@ -626,7 +490,7 @@ Scale9Sprite* Scale9Sprite::createWithSpriteFrameName(const char* spriteFrameNam
 Scale9Sprite* Scale9Sprite::resizableSpriteWithCapInsets(const Rect& capInsets)
 {
     Scale9Sprite* pReturn = new Scale9Sprite();
-    if ( pReturn && pReturn->initWithBatchNode(_scale9Image, _spriteRect, capInsets) )
+    if ( pReturn && pReturn->initWithTexture(_texture, _spriteRect, _spriteFrameRotated, capInsets) )
     {
         pReturn->autorelease();
         return pReturn;
@@ -666,7 +530,7 @@ Size Scale9Sprite::getPreferredSize()
 void Scale9Sprite::setCapInsets(Rect capInsets)
 {
     Size contentSize = this->_contentSize;
-    this->updateWithBatchNode(this->_scale9Image, this->_spriteRect, _spriteFrameRotated, capInsets);
+    this->updateWithTexture(this->_texture, this->_spriteRect, _spriteFrameRotated, capInsets);
     this->setContentSize(contentSize);
 }
 
@@ -694,14 +558,10 @@ void Scale9Sprite::updateCapInset()
 
 void Scale9Sprite::setOpacityModifyRGB(bool var)
 {
-    if (!_scale9Image)
+    if (_opacityModifyRGB != var)
     {
-        return;
-    }
-    _opacityModifyRGB = var;
-    
-    for(auto child : _scale9Image->getChildren()){
-        child->setOpacityModifyRGB(_opacityModifyRGB);
+        _opacityModifyRGB = var;
+        this->updateColor();
     }
 }
 
@@ -712,8 +572,7 @@ bool Scale9Sprite::isOpacityModifyRGB() const
 
 void Scale9Sprite::setSpriteFrame(SpriteFrame * spriteFrame)
 {
-    SpriteBatchNode * batchnode = SpriteBatchNode::createWithTexture(spriteFrame->getTexture(), 9);
-    this->updateWithBatchNode(batchnode, spriteFrame->getRect(), spriteFrame->isRotated(), Rect::ZERO);
+    this->updateWithTexture(spriteFrame->getTexture(), spriteFrame->getRect(), spriteFrame->isRotated(), Rect::ZERO);
 
     // Reset insets
     this->_insetLeft = 0;
@@ -776,57 +635,16 @@ void Scale9Sprite::visit()
     Node::visit();
 }
 
-void Scale9Sprite::setColor(const Color3B& color)
+void Scale9Sprite::draw()
 {
-    if (!_scale9Image)
+    if (!_texture)
     {
         return;
     }
-    
-    Node::setColor(color);
-    
-    for(auto child : _scale9Image->getChildren()){
-        child->setColor(color);
-    }
-}
-
-void Scale9Sprite::setOpacity(GLubyte opacity)
-{
-    if (!_scale9Image)
-    {
-        return;
-    }
-    Node::setOpacity(opacity);
-    
-    for(auto child : _scale9Image->getChildren()){
-        child->setOpacity(opacity);
-    }
-}
 
-void Scale9Sprite::updateDisplayedColor(const cocos2d::Color3B &parentColor)
-{
-    if (!_scale9Image)
-    {
-        return;
-    }
-    Node::updateDisplayedColor(parentColor);
-
-    for(auto child : _scale9Image->getChildren()){
-        child->updateDisplayedColor(parentColor);
-    }
-}
-
-void Scale9Sprite::updateDisplayedOpacity(GLubyte parentOpacity)
-{
-    if (!_scale9Image)
-    {
-        return;
-    }
-    Node::updateDisplayedOpacity(parentOpacity);
-    
-    for(auto child : _scale9Image->getChildren()){
-        child->updateDisplayedOpacity(parentOpacity);
-    }
+    QuadCommand* renderCommand = QuadCommand::getCommandPool().generateCommand();
+    renderCommand->init(0, _vertexZ, _texture->getName(), _shaderProgram, _blendFunc, _quads, 9, _modelViewTransform);
+    Director::getInstance()->getRenderer()->addCommand(renderCommand);
 }
 
 NS_CC_EXT_END
@@ -259,14 +259,19 @@ public:
      * @lua NA
      */
     virtual void visit() override;
+    /**
+     * @js NA
+     * @lua NA
+     */
+    virtual void draw() override;
     virtual void setOpacityModifyRGB(bool bValue) override;
     virtual bool isOpacityModifyRGB(void) const override;
-    virtual void setOpacity(GLubyte opacity) override;
-    virtual void setColor(const Color3B& color) override;
-    virtual void updateDisplayedOpacity(GLubyte parentOpacity) override;
-    virtual void updateDisplayedColor(const Color3B& parentColor) override;
 
 protected:
+    virtual bool initWithTexture(Texture2D* texture, const Rect& rect, bool rotated, const Rect& capInsets);
+    virtual bool updateWithTexture(Texture2D* texture, const Rect& rect, bool rotated, const Rect& capInsets);
+    virtual void updateColor() override;
+    void updateBlendFunc();
     void updateCapInset();
     void updatePositions();
 
@@ -276,16 +281,16 @@ protected:
     Rect _capInsetsInternal;
     bool _positionsAreDirty;
 
-    SpriteBatchNode* _scale9Image;
-    Sprite* _topLeft;
-    Sprite* _top;
-    Sprite* _topRight;
-    Sprite* _left;
-    Sprite* _centre;
-    Sprite* _right;
-    Sprite* _bottomLeft;
-    Sprite* _bottom;
-    Sprite* _bottomRight;
+    /** The nine slices are drawn from this texture as one QuadCommand, no child nodes are created */
+    Texture2D* _texture;
+    BlendFunc _blendFunc;
+    /** Slices ordered left to right, bottom to top: _quads[row * 3 + column] */
+    V3F_C4B_T2F_Quad _quads[9];
+    /** Unscaled widths of the left and right columns and heights of the bottom and top rows, in points */
+    float _leftWidth;
+    float _rightWidth;
+    float _bottomHeight;
+    float _topHeight;
 
     bool _opacityModifyRGB;
 
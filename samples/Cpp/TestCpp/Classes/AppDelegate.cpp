@@ -5,6 +5,7 @@
 #include "SimpleAudioEngine.h"
 #include "cocostudio/CocoStudio.h"
 #include "extensions/cocos-ext.h"
+#include "spine/spine-cocos2dx.h"
 
 USING_NS_CC;
 using namespace CocosDenshion;
@@ -17,6 +18,7 @@ AppDelegate::~AppDelegate()
 {
 //    SimpleAudioEngine::end();
 	cocostudio::ArmatureDataManager::destoryInstance();
+	spine::SkeletonPoseCache::destroyInstance();
 }
 
 bool AppDelegate::applicationDidFinishLaunching()
@@ -27,6 +27,9 @@ Layer *CreateLayer(int index)
     case TEST_DIRECT_LOADING:
         pLayer = new TestDirectLoading();
         break;
+    case TEST_BINARY_LOADING:
+        pLayer = new TestBinaryLoading();
+        break;
     case TEST_DRAGON_BONES_2_0:
         pLayer = new TestDragonBones20();
         break;
@@ -36,6 +39,9 @@ Layer *CreateLayer(int index)
     case TEST_PERFORMANCE:
         pLayer = new TestPerformance();
         break;
+    case TEST_PERFORMANCE_PARALLEL:
+        pLayer = new TestPerformanceParallel();
+        break;
 //    case TEST_PERFORMANCE_BATCHNODE:
 //        pLayer = new TestPerformanceBatchNode();
 //        break;
@@ -281,7 +287,7 @@ void TestAsynchronousLoading::dataLoaded(float percent)
     if (label)
     {
         char pszPercent[255];
-        sprintf(pszPercent, "%s %f", subtitle().c_str(), percent * 100);
+        sprintf(pszPercent, "%s %f, files left : %d", subtitle().c_str(), percent * 100, DataReaderHelper::getInstance()->getAsyncPendingCount());
         label->setString(pszPercent);
     }
 
@@ -314,6 +320,30 @@ std::string TestDirectLoading::title() const
     return "Test Direct Loading";
 }
 
+void TestBinaryLoading::onEnter()
+{
+    ArmatureTestLayer::onEnter();
+
+    // replace the json resource with the one converted by json2csb.py
+    ArmatureDataManager::getInstance()->removeArmatureFileInfo("armature/bear.ExportJson");
+    ArmatureDataManager::getInstance()->removeArmatureFileInfo("armature/bear.csb");
+
+    ArmatureDataManager::getInstance()->addArmatureFileInfo("armature/bear.csb");
+
+    Armature *armature = Armature::create("bear");
+    armature->getAnimation()->playByIndex(0);
+    armature->setPosition(Point(VisibleRect::center().x, VisibleRect::center().y));
+    addChild(armature);
+}
+std::string TestBinaryLoading::title() const
+{
+    return "Test Binary Loading";
+}
+std::string TestBinaryLoading::subtitle() const
+{
+    return "bear.csb, converted from bear.ExportJson";
+}
+
 
 void TestCSWithSkeleton::onEnter()
 {
@@ -461,6 +491,22 @@ void TestPerformanceBatchNode::removeArmatureFromParent(int tag)
     batchNode->removeChildByTag(ArmaturePerformanceTag + armatureCount);
 }
 
+std::string TestPerformanceParallel::title() const
+{
+    return "Test Performance of parallel update";
+}
+std::string TestPerformanceParallel::subtitle() const
+{
+    char pszThreads[64];
+    sprintf(pszThreads, "Worker Threads : %i, Current Armature Count : ", WorkerPool::getInstance()->getThreadCount());
+    return pszThreads;
+}
+void TestPerformanceParallel::addArmatureToParent(cocostudio::Armature *armature)
+{
+    armature->setParallelUpdateEnabled(true);
+    TestPerformance::addArmatureToParent(armature);
+}
+
 
 void TestChangeZorder::onEnter()
 {
@@ -28,9 +28,11 @@ public:
 enum {
 	TEST_ASYNCHRONOUS_LOADING = 0,
     TEST_DIRECT_LOADING,
+    TEST_BINARY_LOADING,
 	TEST_COCOSTUDIO_WITH_SKELETON,
 	TEST_DRAGON_BONES_2_0,
 	TEST_PERFORMANCE,
+    TEST_PERFORMANCE_PARALLEL,
 //    TEST_PERFORMANCE_BATCHNODE,
 	TEST_CHANGE_ZORDER,
 	TEST_ANIMATION_EVENT,
@@ -88,6 +90,14 @@ public:
     virtual std::string title() const override;
 };
 
+class TestBinaryLoading : public ArmatureTestLayer
+{
+public:
+    virtual void onEnter();
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+};
+
 class TestCSWithSkeleton : public ArmatureTestLayer
 {
 	virtual void onEnter();
@@ -136,6 +146,13 @@ class TestPerformanceBatchNode : public TestPerformance
     cocostudio::BatchNode *batchNode;
 };
 
+class TestPerformanceParallel : public TestPerformance
+{
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+    virtual void addArmatureToParent(cocostudio::Armature *armature);
+};
+
 class TestChangeZorder : public ArmatureTestLayer
 {
 	virtual void onEnter();
@@ -1,6 +1,7 @@
 
 
 #include "UILayoutTest.h"
+#include <chrono>
 
 
 // UILayoutTest
@@ -760,6 +761,158 @@ bool UILayoutTest_Layout_Relative_Location::init()
     return false;
 }
 
+// UILayoutTest_Layout_Deep
+
+static const int s_deepLayoutLevels = 5;
+
+// the layout pass done while visiting the tree
+static void doLayoutTree(Widget* widget)
+{
+    widget->sortAllChildren();
+    for (auto& child : widget->getChildren())
+    {
+        doLayoutTree(static_cast<Widget*>(child));
+    }
+}
+
+UILayoutTest_Layout_Deep::UILayoutTest_Layout_Deep()
+: _root(nullptr)
+, _leaf(nullptr)
+, _timeLabel(nullptr)
+, _frames(0)
+, _leafTime(0.0f)
+, _rootTime(0.0f)
+{
+}
+
+UILayoutTest_Layout_Deep::~UILayoutTest_Layout_Deep()
+{
+}
+
+Layout* UILayoutTest_Layout_Deep::createLayoutTree(int level)
+{
+    static const LayoutType s_types[] = { LAYOUT_RELATIVE, LAYOUT_LINEAR_VERTICAL, LAYOUT_LINEAR_HORIZONTAL };
+    
+    Layout* layout = Layout::create();
+    layout->setLayoutType(s_types[level % 3]);
+    layout->setBackGroundColorType(LAYOUT_COLOR_SOLID);
+    layout->setBackGroundColor(Color3B(40 * level, 128, 255 - 40 * level));
+    if (level + 1 == s_deepLayoutLevels)
+    {
+        _leaf = layout;
+        return layout;
+    }
+    
+    for (int i = 0; i < 4; ++i)
+    {
+        Layout* child = createLayoutTree(level + 1);
+        child->setSizeType(SIZE_PERCENT);
+        child->setSizePercent(Point(0.45f, 0.45f));
+        if (layout->getLayoutType() == LAYOUT_RELATIVE)
+        {
+            RelativeLayoutParameter* rp = RelativeLayoutParameter::create();
+            rp->setRelativeName(StringUtils::format("child_%d", i).c_str());
+            if (i == 0)
+            {
+                rp->setAlign(RELATIVE_ALIGN_PARENT_TOP_LEFT);
+            }
+            else
+            {
+                rp->setRelativeToWidgetName(StringUtils::format("child_%d", i - 1).c_str());
+                rp->setAlign((i % 2) ? RELATIVE_LOCATION_RIGHT_OF_TOPALIGN : RELATIVE_LOCATION_BELOW_LEFTALIGN);
+            }
+            child->setLayoutParameter(rp);
+        }
+        else
+        {
+            LinearLayoutParameter* lp = LinearLayoutParameter::create();
+            lp->setMargin(Margin(1.0f, 1.0f, 1.0f, 1.0f));
+            child->setLayoutParameter(lp);
+        }
+        layout->addChild(child);
+    }
+    return layout;
+}
+
+bool UILayoutTest_Layout_Deep::init()
+{
+    if (UIScene::init())
+    {
+        Size widgetSize = _widget->getSize();
+        
+        // Add the alert
+        gui::Label* alert = gui::Label::create();
+        alert->setText("Layout 5 levels deep");
+        alert->setFontName("Marker Felt");
+        alert->setFontSize(20);
+        alert->setColor(Color3B(159, 168, 176));
+        alert->setPosition(Point(widgetSize.width / 2.0f, widgetSize.height / 2.0f - alert->getSize().height * 4.5f));
+        _uiLayer->addChild(alert);
+        
+        _timeLabel = gui::Label::create();
+        _timeLabel->setFontName("Marker Felt");
+        _timeLabel->setFontSize(20);
+        _timeLabel->setPosition(Point(widgetSize.width / 2.0f, widgetSize.height / 2.0f + alert->getSize().height * 4.0f));
+        _uiLayer->addChild(_timeLabel);
+        
+        Layout* root = static_cast<Layout*>(_uiLayer->getChildByTag(81));
+        
+        Layout* background = static_cast<Layout*>(root->getChildByName("background_Panel"));
+        Size backgroundSize = background->getSize();
+        
+        // 1 + 4 + 16 + 64 + 256 layouts
+        _root = createLayoutTree(0);
+        _root->setSize(Size(280, 150));
+        _root->setPosition(Point((widgetSize.width - backgroundSize.width) / 2.0f +
+                                 (backgroundSize.width - _root->getSize().width) / 2.0f,
+                                 (widgetSize.height - backgroundSize.height) / 2.0f +
+                                 (backgroundSize.height - _root->getSize().height) / 2.0f));
+        _uiLayer->addChild(_root);
+        
+        scheduleUpdate();
+        
+        return true;
+    }
+    
+    return false;
+}
+
+void UILayoutTest_Layout_Deep::update(float dt)
+{
+    // the size of a leaf changes every frame, the size of the root every 30 frames
+    ++_frames;
+    bool rootFrame = (_frames % 30 == 0);
+    
+    auto begin = std::chrono::high_resolution_clock::now();
+    if (rootFrame)
+    {
+        _root->setSize(Size(280 - (_frames / 30) % 2 * 20, 150));
+    }
+    else
+    {
+        _leaf->setSizePercent(Point(0.35f + (_frames % 2) * 0.1f, 0.45f));
+    }
+    doLayoutTree(_root);
+    auto end = std::chrono::high_resolution_clock::now();
+    
+    float time = std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count() / 1000.0f;
+    if (rootFrame)
+    {
+        _rootTime += time;
+    }
+    else
+    {
+        _leafTime += time;
+    }
+    
+    if (_frames % 60 == 0)
+    {
+        _timeLabel->setText(StringUtils::format("leaf resize: %.3f ms, root resize: %.3f ms", _leafTime / 58, _rootTime / 2));
+        _leafTime = 0.0f;
+        _rootTime = 0.0f;
+    }
+}
+
 /*
 // UILayoutTest_Layout_Grid
 
@@ -126,6 +126,26 @@ protected:
     UI_SCENE_CREATE_FUNC(UILayoutTest_Layout_Relative_Location)
 };
 
+class UILayoutTest_Layout_Deep : public UIScene
+{
+public:
+    UILayoutTest_Layout_Deep();
+    ~UILayoutTest_Layout_Deep();
+    bool init();
+    virtual void update(float dt) override;
+    
+protected:
+    UI_SCENE_CREATE_FUNC(UILayoutTest_Layout_Deep)
+    Layout* createLayoutTree(int level);
+    
+    Layout* _root;
+    Layout* _leaf;
+    gui::Label* _timeLabel;
+    int _frames;
+    float _leafTime;
+    float _rootTime;
+};
+
 /*
 class UILayoutTest_Layout_Grid : public UIScene
 {
@@ -369,3 +369,112 @@ void UIListViewTest_Horizontal::selectedItemEvent(Object *pSender, ScrollviewEve
     }
      */
 }
+
+// UIListViewTest_Virtual
+
+static const int s_virtualItemsCount = 10000;
+
+UIListViewTest_Virtual::UIListViewTest_Virtual()
+: _displayValueLabel(nullptr)
+, _createdItems(0)
+{
+    
+}
+
+UIListViewTest_Virtual::~UIListViewTest_Virtual()
+{
+}
+
+bool UIListViewTest_Virtual::init()
+{
+    if (UIScene::init())
+    {
+        Size widgetSize = _widget->getSize();
+        
+        _displayValueLabel = gui::Label::create();
+        _displayValueLabel->setText("10000 items, only the visible ones exist");
+        _displayValueLabel->setFontName("Marker Felt");
+        _displayValueLabel->setFontSize(24);
+        _displayValueLabel->setAnchorPoint(Point(0.5f, -1.0f));
+        _displayValueLabel->setPosition(Point(widgetSize.width / 2.0f, widgetSize.height / 2.0f + _displayValueLabel->getContentSize().height * 1.5f));
+        _uiLayer->addChild(_displayValueLabel);
+        
+        gui::Label* alert = gui::Label::create();
+        alert->setText("ListView virtual");
+        alert->setFontName("Marker Felt");
+        alert->setFontSize(30);
+        alert->setColor(Color3B(159, 168, 176));
+        alert->setPosition(Point(widgetSize.width / 2.0f, widgetSize.height / 2.0f - alert->getSize().height * 3.075f));
+        _uiLayer->addChild(alert);
+        
+        Layout* root = static_cast<Layout*>(_uiLayer->getChildByTag(81));
+        
+        Layout* background = dynamic_cast<Layout*>(root->getChildByName("background_Panel"));
+        Size backgroundSize = background->getContentSize();
+        
+        ListView* listView = ListView::create();
+        listView->setDirection(SCROLLVIEW_DIR_VERTICAL);
+        listView->setTouchEnabled(true);
+        listView->setBounceEnabled(true);
+        listView->setBackGroundImage("cocosgui/green_edit.png");
+        listView->setBackGroundImageScale9Enabled(true);
+        listView->setSize(Size(240, 130));
+        listView->setItemsMargin(2.0f);
+        listView->setPosition(Point((widgetSize.width - backgroundSize.width) / 2.0f +
+                                    (backgroundSize.width - listView->getSize().width) / 2.0f,
+                                    (widgetSize.height - backgroundSize.height) / 2.0f +
+                                    (backgroundSize.height - listView->getSize().height) / 2.0f));
+        listView->addEventListenerListView(this, listvieweventselector(UIListViewTest_Virtual::selectedItemEvent));
+        listView->setDataSource(this);
+        _uiLayer->addChild(listView);
+        
+        return true;
+    }
+    
+    return false;
+}
+
+ssize_t UIListViewTest_Virtual::numberOfItemsInListView(ListView* listView)
+{
+    return s_virtualItemsCount;
+}
+
+Widget* UIListViewTest_Virtual::itemAtIndex(ListView* listView, ssize_t index)
+{
+    Layout* item = static_cast<Layout*>(listView->dequeueItem());
+    if (!item)
+    {
+        item = Layout::create();
+        item->setTouchEnabled(true);
+        item->setBackGroundColorType(LAYOUT_COLOR_SOLID);
+        
+        gui::Label* label = gui::Label::create();
+        label->setFontName(font_UIListViewTest);
+        label->setFontSize(20);
+        item->addChild(label, 0, 1);
+        
+        ++_createdItems;
+    }
+    
+    // every fifth item is taller than its estimation
+    Size size(200, (index % 5 == 0) ? 50 : 30);
+    item->setSize(size);
+    item->setBackGroundColor((index % 2 == 0) ? Color3B(64, 96, 64) : Color3B(48, 72, 48));
+    
+    gui::Label* label = static_cast<gui::Label*>(item->getChildByTag(1));
+    label->setText(StringUtils::format("listview_item_%d", (int)index));
+    label->setPosition(Point(size.width / 2.0f, size.height / 2.0f));
+    
+    return item;
+}
+
+Size UIListViewTest_Virtual::estimatedItemSizeForIndex(ListView* listView, ssize_t index)
+{
+    return Size(200, 30);
+}
+
+void UIListViewTest_Virtual::selectedItemEvent(Object *pSender, ListViewEventType type)
+{
+    ListView* listView = static_cast<ListView*>(pSender);
+    _displayValueLabel->setText(StringUtils::format("item %d selected, %d items created", listView->getCurSelectedIndex(), _createdItems));
+}
@@ -57,4 +57,22 @@ protected:
     __Array* _array;
 };
 
+class UIListViewTest_Virtual : public UIScene, public ListViewDataSource
+{
+public:
+    UIListViewTest_Virtual();
+    ~UIListViewTest_Virtual();
+    bool init();
+    void selectedItemEvent(Object* pSender, ListViewEventType type);
+
+    virtual ssize_t numberOfItemsInListView(ListView* listView) override;
+    virtual Widget* itemAtIndex(ListView* listView, ssize_t index) override;
+    virtual Size estimatedItemSizeForIndex(ListView* listView, ssize_t index) override;
+
+protected:
+    UI_SCENE_CREATE_FUNC(UIListViewTest_Virtual)
+    gui::Label* _displayValueLabel;
+    int _createdItems;
+};
+
 #endif /* defined(__TestCpp__UIListViewTest__) */
@@ -76,6 +76,7 @@ static const char* s_testArray[] =
     "UILayoutTest_Layout_Linear_Horizontal",
     "UILayoutTest_Layout_Relative_Align_Parent",
     "UILayoutTest_Layout_Relative_Location",
+    "UILayoutTest_Layout_Deep",
     /*
     "UILayoutTest_Layout_Grid",
      */
@@ -87,6 +88,7 @@ static const char* s_testArray[] =
     "UIPageViewTest,",
     "UIListViewTest_Vertical",
     "UIListViewTest_Horizontal",
+    "UIListViewTest_Virtual",
     /*
     "UIGridViewTest_Mode_Column",
     "UIGridViewTest_Mode_Row",
@@ -289,6 +291,9 @@ Scene *UISceneManager::currentUIScene()
         case kUILayoutTest_Layout_Relative_Location:
             return UILayoutTest_Layout_Relative_Location::sceneWithTitle(s_testArray[_currentUISceneId]);
             
+        case kUILayoutTest_Layout_Deep:
+            return UILayoutTest_Layout_Deep::sceneWithTitle(s_testArray[_currentUISceneId]);
+            
             /*
         case kUILayoutTest_Layout_Grid:
             return UILayoutTest_Layout_Grid::sceneWithTitle(s_testArray[_currentUISceneId]);
@@ -318,6 +323,9 @@ Scene *UISceneManager::currentUIScene()
         case kUIListViewTest_Horizontal:
             return UIListViewTest_Horizontal::sceneWithTitle(s_testArray[_currentUISceneId]);
             
+        case kUIListViewTest_Virtual:
+            return UIListViewTest_Virtual::sceneWithTitle(s_testArray[_currentUISceneId]);
+            
             /*
         case kUIGridViewTest_Mode_Column:
             return UIGridViewTest_Mode_Column::sceneWithTitle(s_testArray[_currentUISceneId]);
@@ -79,6 +79,7 @@ enum
     kUILayoutTest_Layout_Linear_Horizontal,
     kUILayoutTest_Layout_Relative_Align_Parent,
     kUILayoutTest_Layout_Relative_Location,
+    kUILayoutTest_Layout_Deep,
     /*
     kUILayoutTest_Layout_Grid,
      */
@@ -90,6 +91,7 @@ enum
     kUIPageViewTest,
     kUIListViewTest_Vertical,
     kUIListViewTest_Horizontal,
+    kUIListViewTest_Virtual,
     /*
     kUIGridViewTest_Mode_Column,
     kUIGridViewTest_Mode_Row,
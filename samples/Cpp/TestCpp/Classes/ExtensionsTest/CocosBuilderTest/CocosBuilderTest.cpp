@@ -31,6 +31,9 @@ USING_NS_CC_EXT;
 using namespace cocosbuilder;
 
 void CocosBuilderTestScene::runThisTest() {
+    /* Reopening a test, and the TestHeader.ccbi every test embeds, replays the cached templates. */
+    cocosbuilder::CCBReader::setTemplateCacheEnabled(true);
+
     /* Create an autorelease NodeLoaderLibrary. */
     NodeLoaderLibrary * ccNodeLoaderLibrary = NodeLoaderLibrary::newDefaultNodeLoaderLibrary();
     
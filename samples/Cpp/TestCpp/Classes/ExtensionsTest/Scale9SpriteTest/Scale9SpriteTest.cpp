@@ -46,7 +46,8 @@ static std::function<Layer*()> createFunctions[] = {
     CL(S9_TexturePacker),
     CL(S9FrameNameSpriteSheetRotatedInsetsScaled),
     CL(S9FrameNameSpriteSheetRotatedSetCapInsetLater),
-    CL(S9CascadeOpacityAndColor)
+    CL(S9CascadeOpacityAndColor),
+    CL(S9ResizeManyPanels)
 };
 
 static int sceneIdx=-1;
@@ -679,3 +680,52 @@ std::string S9CascadeOpacityAndColor::subtitle() const
 {
     return "when parent change color/opacity, Scale9Sprite should also change";
 }
+
+//
+//// S9ResizeManyPanels
+//
+
+void S9ResizeManyPanels::onEnter()
+{
+    S9SpriteTestDemo::onEnter();
+    auto winSize = Director::getInstance()->getWinSize();
+
+    const int columns = 20;
+    const int rows = 10;
+    const float cellWidth = winSize.width / columns;
+    const float cellHeight = winSize.height * 0.6f / rows;
+
+    _panels.clear();
+    for (int i = 0; i < columns * rows; ++i)
+    {
+        auto panel = Scale9Sprite::create("Images/blocks9.png", Rect(0, 0, 96, 96), Rect(32, 32, 32, 32));
+        panel->setPosition(Point(cellWidth * (i % columns + 0.5f), winSize.height * 0.2f + cellHeight * (i / columns + 0.5f)));
+        this->addChild(panel);
+        _panels.push_back(panel);
+    }
+
+    _elapsed = 0;
+    this->scheduleUpdate();
+}
+
+void S9ResizeManyPanels::update(float dt)
+{
+    _elapsed += dt;
+
+    // only the vertices of the nine quads are rewritten, no child nodes are touched
+    for (size_t i = 0; i < _panels.size(); ++i)
+    {
+        float phase = _elapsed * 2 + i * 0.1f;
+        _panels[i]->setPreferredSize(Size(80 + 30 * sinf(phase), 80 + 30 * cosf(phase)));
+    }
+}
+
+std::string S9ResizeManyPanels::title() const
+{
+    return "200 Scale9Sprites resized every frame";
+}
+
+std::string S9ResizeManyPanels::subtitle() const
+{
+    return "Each panel is one QuadCommand, they should batch into a single draw call";
+}
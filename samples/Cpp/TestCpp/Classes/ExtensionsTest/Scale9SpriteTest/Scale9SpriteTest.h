@@ -27,6 +27,7 @@
 
 #include "testBasic.h"
 #include "BaseTest.h"
+#include "extensions/cocos-ext.h"
 
 
 class S9SpriteTestScene : public TestScene
@@ -226,4 +227,22 @@ public:
     
     virtual std::string title() const override;
     virtual std::string subtitle() const override;
-};
\ No newline at end of file
+};
+
+// S9ResizeManyPanels
+
+class S9ResizeManyPanels : public S9SpriteTestDemo
+{
+public:
+    CREATE_FUNC(S9ResizeManyPanels);
+
+    virtual void onEnter();
+    virtual void update(float dt) override;
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+private:
+    std::vector<cocos2d::extension::Scale9Sprite*> _panels;
+    float _elapsed;
+};
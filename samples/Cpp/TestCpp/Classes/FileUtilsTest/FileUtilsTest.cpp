@@ -5,6 +5,7 @@ static std::function<Layer*()> createFunctions[] = {
     CL(TestSearchPath),
     CL(TestFilenameLookup),
     CL(TestIsFileExist),
+    CL(TestSearchPack),
     CL(TextWritePlist),
 };
 
@@ -312,6 +313,52 @@ std::string TestIsFileExist::subtitle() const
     return "";
 }
 
+//#pragma mark - TestSearchPack
+
+void TestSearchPack::onEnter()
+{
+    FileUtilsDemo::onEnter();
+    auto s = Director::getInstance()->getWinSize();
+    auto sharedFileUtils = FileUtils::getInstance();
+    
+    // these files are only in the pack, the first one is stored and the others are deflated
+    sharedFileUtils->addSearchPack("Misc/packed_assets.zip");
+    
+    auto stored = Sprite::create("Images/packed_grossini.png");
+    stored->setPosition(Point(s.width/3, s.height/2));
+    this->addChild(stored);
+    
+    auto deflated = Sprite::create("Images/packed_blocks.png");
+    deflated->setPosition(Point(s.width/3*2, s.height/2));
+    this->addChild(deflated);
+    
+    std::string message = sharedFileUtils->getStringFromFile("Misc/packed_message.txt");
+    auto pTTF = LabelTTF::create(message.empty() ? "Misc/packed_message.txt not found" : message.c_str(), "", 14);
+    pTTF->setPosition(Point(s.width/2, s.height/4));
+    this->addChild(pTTF);
+}
+
+void TestSearchPack::onExit()
+{
+    FileUtils::getInstance()->removeAllSearchPacks();
+    
+    auto textureCache = Director::getInstance()->getTextureCache();
+    textureCache->removeTextureForKey("Images/packed_grossini.png");
+    textureCache->removeTextureForKey("Images/packed_blocks.png");
+    
+    FileUtilsDemo::onExit();
+}
+
+std::string TestSearchPack::title() const
+{
+    return "FileUtils: search pack";
+}
+
+std::string TestSearchPack::subtitle() const
+{
+    return "Sprites and text are read from Misc/packed_assets.zip";
+}
+
 //#pragma mark - TestWritePlist
 
 void TextWritePlist::onEnter()
@@ -73,6 +73,17 @@ public:
     virtual std::string subtitle() const override;
 };
 
+class TestSearchPack : public FileUtilsDemo
+{
+public:
+    CREATE_FUNC(TestSearchPack);
+
+    virtual void onEnter();
+    virtual void onExit();
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+};
+
 class TextWritePlist : public FileUtilsDemo
 {
 public:
@@ -2,6 +2,7 @@
 #include "../testResource.h"
 #include "renderer/CCRenderer.h"
 #include "renderer/CCCustomCommand.h"
+#include "CCFontAtlasCache.h"
 
 enum {
     kTagTileMap = 1,
@@ -67,7 +68,10 @@ static std::function<Layer*()> createFunctions[] =
     CL(LabelTTFUnicodeNew),
     CL(LabelBMFontTestNew),
     CL(LabelTTFDistanceField),
-    CL(LabelTTFDistanceFieldEffect)
+    CL(LabelTTFDistanceFieldEffect),
+    CL(LabelTTFDynamicGlyphChurn),
+    CL(LabelTTFAsyncGlyphs),
+    CL(LabelTTFChatLog)
 };
 
 #define MAX_LAYER    (sizeof(createFunctions) / sizeof(createFunctions[0]))
@@ -1240,3 +1244,165 @@ std::string LabelTTFDistanceFieldEffect::subtitle() const
 {
     return "Testing effect base on DistanceField";
 }
+
+LabelTTFDynamicGlyphChurn::LabelTTFDynamicGlyphChurn()
+{
+    auto size = Director::getInstance()->getWinSize();
+
+    // a static label, its glyphs are laid out again if they get evicted
+    auto label1 = Label::createWithTTF("美好的一天", "fonts/wt021.ttf", 40, size.width, TextHAlignment::CENTER, GlyphCollection::DYNAMIC);
+    label1->setPosition( Point(size.width/2, size.height*0.65f) );
+    label1->setAnchorPoint(Point(0.5, 0.5));
+    addChild(label1);
+
+    auto label2 = Label::createWithTTF("", "fonts/wt021.ttf", 40, size.width, TextHAlignment::CENTER, GlyphCollection::DYNAMIC);
+    label2->setPosition( Point(size.width/2, size.height*0.4f) );
+    label2->setAnchorPoint(Point(0.5, 0.5));
+    addChild(label2, 0, kTagBitmapAtlas1);
+
+    schedule(schedule_selector(LabelTTFDynamicGlyphChurn::updateText), 0.05f);
+}
+
+void LabelTTFDynamicGlyphChurn::updateText(float dt)
+{
+    // random CJK unified ideographs, the atlas fills up after a few seconds
+    unsigned short text[17];
+    for (int i = 0; i < 16; ++i)
+    {
+        text[i] = 0x4E00 + rand() % (0x9FA5 - 0x4E00);
+    }
+    text[16] = 0;
+
+    char* utf8 = cc_utf16_to_utf8(text, 16, nullptr, nullptr);
+    if (utf8)
+    {
+        auto label = static_cast<Label*>(getChildByTag(kTagBitmapAtlas1));
+        label->setString(utf8);
+        free(utf8);
+    }
+}
+
+std::string LabelTTFDynamicGlyphChurn::title() const
+{
+    return "New Label + .TTF glyph churn";
+}
+
+std::string LabelTTFDynamicGlyphChurn::subtitle() const
+{
+    return "New glyphs 20 times per second, least recently used ones are evicted";
+}
+
+static const char* s_prewarmedText = "今天天气很好，我们一起去公园散步吧";
+
+LabelTTFAsyncGlyphs::LabelTTFAsyncGlyphs()
+{
+    auto size = Director::getInstance()->getWinSize();
+
+    // only the atlases created from now on render on the worker thread
+    _asyncGlyphRasterization = FontAtlas::isAsyncGlyphRasterization();
+    FontAtlas::setAsyncGlyphRasterization(true);
+
+    _prewarmedAtlas = FontAtlasCache::getFontAtlasTTF("fonts/wt021.ttf", 36, GlyphCollection::DYNAMIC);
+    if (_prewarmedAtlas)
+    {
+        _prewarmedAtlas->prewarmLetterDefinitions(s_prewarmedText);
+    }
+
+    auto label = Label::createWithTTF("", "fonts/wt021.ttf", 36, size.width, TextHAlignment::CENTER, GlyphCollection::DYNAMIC);
+    label->setPosition( Point(size.width/2, size.height*0.4f) );
+    label->setAnchorPoint(Point(0.5, 0.5));
+    addChild(label, 0, kTagBitmapAtlas1);
+
+    scheduleOnce(schedule_selector(LabelTTFAsyncGlyphs::showPrewarmedText), 1.0f);
+    schedule(schedule_selector(LabelTTFAsyncGlyphs::updateText), 0.5f);
+}
+
+LabelTTFAsyncGlyphs::~LabelTTFAsyncGlyphs()
+{
+    FontAtlasCache::releaseFontAtlas(_prewarmedAtlas);
+    FontAtlas::setAsyncGlyphRasterization(_asyncGlyphRasterization);
+}
+
+void LabelTTFAsyncGlyphs::showPrewarmedText(float dt)
+{
+    auto size = Director::getInstance()->getWinSize();
+
+    // the glyphs were rendered while the test was shown, nothing to rasterize now
+    auto label = Label::createWithTTF(s_prewarmedText, "fonts/wt021.ttf", 36, size.width, TextHAlignment::CENTER, GlyphCollection::DYNAMIC);
+    label->setPosition( Point(size.width/2, size.height*0.65f) );
+    label->setAnchorPoint(Point(0.5, 0.5));
+    addChild(label);
+}
+
+void LabelTTFAsyncGlyphs::updateText(float dt)
+{
+    unsigned short text[9];
+    for (int i = 0; i < 8; ++i)
+    {
+        text[i] = 0x4E00 + rand() % (0x9FA5 - 0x4E00);
+    }
+    text[8] = 0;
+
+    char* utf8 = cc_utf16_to_utf8(text, 8, nullptr, nullptr);
+    if (utf8)
+    {
+        auto label = static_cast<Label*>(getChildByTag(kTagBitmapAtlas1));
+        label->setString(utf8);
+        free(utf8);
+    }
+}
+
+std::string LabelTTFAsyncGlyphs::title() const
+{
+    return "New Label + .TTF async glyphs";
+}
+
+std::string LabelTTFAsyncGlyphs::subtitle() const
+{
+    return "Top text was prewarmed, bottom glyphs are rendered on a worker thread";
+}
+
+LabelTTFChatLog::LabelTTFChatLog()
+: _messages(0)
+{
+    auto size = Director::getInstance()->getWinSize();
+
+    auto label = Label::createWithTTF("", "fonts/arial.ttf", 16, size.width * 0.8f, TextHAlignment::LEFT);
+    label->setPosition( Point(size.width * 0.1f, size.height * 0.8f) );
+    label->setAnchorPoint(Point(0, 1));
+    addChild(label, 0, kTagBitmapAtlas1);
+
+    schedule(schedule_selector(LabelTTFChatLog::appendMessage), 0.1f);
+}
+
+void LabelTTFChatLog::appendMessage(float dt)
+{
+    static const char* s_messages[] = {
+        "hello there, is anybody around?",
+        "the quick brown fox jumps over the lazy dog",
+        "ok",
+        "meet at the north gate in five minutes, bring potions",
+    };
+
+    char line[100];
+    snprintf(line, sizeof(line), "[%d] %s ", _messages, s_messages[_messages % 4]);
+    ++_messages;
+
+    // start over once the log fills the screen, the lines already laid out are reused until then
+    if (_log.size() > 1500)
+        _log.clear();
+    _log += line;
+
+    auto label = static_cast<Label*>(getChildByTag(kTagBitmapAtlas1));
+    label->setText(_log, label->getMaxLineWidth(), TextHAlignment::LEFT);
+}
+
+std::string LabelTTFChatLog::title() const
+{
+    return "New Label + .TTF chat log";
+}
+
+std::string LabelTTFChatLog::subtitle() const
+{
+    return "Messages are appended 10 times per second, only the last line is wrapped again";
+}
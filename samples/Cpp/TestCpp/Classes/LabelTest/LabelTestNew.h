@@ -344,6 +344,55 @@ public:
     virtual std::string subtitle() const override;
 };
 
+class LabelTTFDynamicGlyphChurn : public AtlasDemoNew
+{
+public:
+    CREATE_FUNC(LabelTTFDynamicGlyphChurn);
+
+    LabelTTFDynamicGlyphChurn();
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    void updateText(float dt);
+};
+
+class LabelTTFAsyncGlyphs : public AtlasDemoNew
+{
+public:
+    CREATE_FUNC(LabelTTFAsyncGlyphs);
+
+    LabelTTFAsyncGlyphs();
+    virtual ~LabelTTFAsyncGlyphs();
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    void showPrewarmedText(float dt);
+    void updateText(float dt);
+
+private:
+    FontAtlas *_prewarmedAtlas;
+    bool _asyncGlyphRasterization;
+};
+
+class LabelTTFChatLog : public AtlasDemoNew
+{
+public:
+    CREATE_FUNC(LabelTTFChatLog);
+
+    LabelTTFChatLog();
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    void appendMessage(float dt);
+
+private:
+    std::string _log;
+    int _messages;
+};
+
 
 // we don't support linebreak mode
 
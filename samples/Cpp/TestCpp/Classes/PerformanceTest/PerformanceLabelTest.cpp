@@ -1,10 +1,12 @@
 #include "PerformanceLabelTest.h"
 
+#include <chrono>
+
 enum {
     kMaxNodes = 200,
     kNodesIncrease = 10,
 
-    TEST_COUNT = 5,
+    TEST_COUNT = 6,
 };
 
 enum {
@@ -19,9 +21,13 @@ enum {
     kCaseLabelBMFontUpdate,
     kCaseLabelUpdate,
     kCaseLabelBMFontBigLabels,
-    kCaseLabelBigLabels
+    kCaseLabelBigLabels,
+    kCaseLabelTextPanel
 };
 
+// characters in the labels of the text panel case
+static const size_t kTextPanelLength = 2000;
+
 #define LongSentencesExample "Lorem ipsum dolor sit amet, consectetur adipisicing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua.\
 Lorem ipsum dolor sit amet, consectetur adipisicing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua.\
 Lorem ipsum dolor sit amet, consectetur adipisicing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua."
@@ -86,6 +92,9 @@ void LabelMainScene::initWithSubTest(int nodes)
 
     _lastRenderedCount = 0;
     _quantityNodes = 0;
+    _accumulativeTime = 0.0f;
+    _textPanelTime = 0.0f;
+    _textPanelUpdates = 0;
 
     _labelContainer = Layer::create();
     addChild(_labelContainer);
@@ -158,6 +167,8 @@ std::string LabelMainScene::title() const
         return "Testing LabelBMFont Big Labels";
     case kCaseLabelBigLabels:
         return "Testing Label Big Labels";
+    case kCaseLabelTextPanel:
+        return "Testing Label 2000 chars setString";
     default:
         break;
     }
@@ -241,6 +252,16 @@ void LabelMainScene::onIncrease(Object* sender)
             _quantityNodes++;
         }
         break;
+    case kCaseLabelTextPanel:
+        for( int i=0;i< kNodesIncrease;i++)
+        {
+            auto label = Label::createWithTTF(textPanelString(0), "fonts/arial.ttf", 12, size.width, TextHAlignment::LEFT, GlyphCollection::DYNAMIC,nullptr);
+            label->setPosition(Point((rand() % 50), rand()%((int)size.height/3)));
+            _labelContainer->addChild(label, 1, _quantityNodes);
+
+            _quantityNodes++;
+        }
+        break;
     default:
         break;
     }
@@ -302,8 +323,65 @@ void LabelMainScene::updateAutoTest(float dt)
     }
 }
 
+std::string LabelMainScene::textPanelString(float time)
+{
+    char prefix[20];
+    sprintf(prefix, "%.2f ", time);
+
+    std::string text(prefix);
+    while (text.size() < kTextPanelLength)
+        text.append(LongSentencesExample);
+    text.resize(kTextPanelLength);
+
+    return text;
+}
+
+void LabelMainScene::updateTextPanel(float dt)
+{
+    auto& children = _labelContainer->getChildren();
+    if (children.empty())
+        return;
+
+    std::string text = textPanelString(_accumulativeTime);
+
+    auto begin = std::chrono::high_resolution_clock::now();
+    for(const auto &child : children) {
+        Label* label = (Label*)child;
+        label->setString(text,false);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    _textPanelTime += std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count() / 1000.0f;
+    _textPanelUpdates += children.size();
+
+    // report once per second, the letter sprites and quads are what a label keeps per character
+    if (_textPanelUpdates >= children.size() * 60)
+    {
+        ssize_t letterSprites = 0;
+        ssize_t quadBytes = 0;
+        for(const auto &child : children) {
+            Label* label = (Label*)child;
+            letterSprites += label->getChildrenCount();
+            quadBytes += label->getTextureAtlas()->getCapacity() * sizeof(V3F_C4B_T2F_Quad);
+        }
+
+        log("Label setString of %d characters: %.3f ms per label, %d letter sprites, %d KB of quads for %d labels",
+            (int)kTextPanelLength, _textPanelTime / _textPanelUpdates, (int)letterSprites, (int)(quadBytes / 1024), (int)children.size());
+
+        _textPanelTime = 0.0f;
+        _textPanelUpdates = 0;
+    }
+}
+
 void LabelMainScene::updateText(float dt)
 {
+    if (_s_labelCurCase == kCaseLabelTextPanel)
+    {
+        _accumulativeTime += dt;
+        updateTextPanel(dt);
+        return;
+    }
+
     if(_s_labelCurCase > kCaseLabelUpdate)
         return;
 
@@ -371,6 +449,8 @@ void LabelMainScene::autoShowLabelTests(int curCase,int nodes)
     _lastRenderedCount = 0;
     _quantityNodes = 0;
     _accumulativeTime = 0.0f;
+    _textPanelTime = 0.0f;
+    _textPanelUpdates = 0;
     while(_quantityNodes < nodes)
         onIncrease(this);
 }
@@ -36,6 +36,7 @@ public:
     
     void  updateAutoTest(float dt);
     void  updateText(float dt);
+    void  updateTextPanel(float dt);
     void  onAutoTest(Object* sender);
 
     void  autoShowLabelTests(int curCase,int nodes);
@@ -48,10 +49,11 @@ public:
 
 private:
     static const  int MAX_AUTO_TEST_TIMES  = 35;
-    static const  int MAX_SUB_TEST_NUMS    = 5;
+    static const  int MAX_SUB_TEST_NUMS    = 6;
     
 
     void  dumpProfilerFPS();
+    static std::string textPanelString(float time);
     
     void  endAutoTest();
     void  nextAutoTest();
@@ -67,6 +69,9 @@ private:
     int            _executeTimes;
 
     float          _accumulativeTime;
+
+    float          _textPanelTime;
+    ssize_t        _textPanelUpdates;
 };
 
 void runLabelTest();
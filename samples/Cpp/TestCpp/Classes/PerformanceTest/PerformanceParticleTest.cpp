@@ -8,7 +8,7 @@ enum {
     kTagLabelAtlas = 4,
     kTagMenuLayer = 1000,
 
-    TEST_COUNT = 4,
+    TEST_COUNT = 5,
 };
 
 enum {
@@ -51,6 +51,9 @@ void ParticleMenuLayer::showCurrentTest()
     case 3:
         pNewScene = new ParticlePerformTest4;
         break;
+    case 4:
+        pNewScene = new ParticleUpdateBenchmark;
+        break;
     }
 
     s_nParCurIdx = _curCase;
@@ -557,6 +560,132 @@ void ParticlePerformTest4::doTest()
 
 }
 
+////////////////////////////////////////////////////////
+//
+// ParticleUpdateBenchmark
+//
+////////////////////////////////////////////////////////
+enum {
+    kBenchmarkSystems = 100,
+    kBenchmarkParticlesPerSystem = 1000,
+    kBenchmarkReportFrames = 60,
+};
+
+void ParticleUpdateBenchmark::initWithSubTest(int asubtest, int particles)
+{
+    subtestNumber = asubtest;
+    quantityParticles = particles;
+    lastRenderedCount = 0;
+    _updateTime = 0;
+    _updatedParticles = 0;
+    _frames = 0;
+
+    auto s = Director::getInstance()->getWinSize();
+
+    auto infoLabel = LabelTTF::create("measuring...", "Marker Felt", 30);
+    infoLabel->setColor(Color3B(0,200,20));
+    infoLabel->setPosition(Point(s.width/2, s.height/2));
+    addChild(infoLabel, 1, kTagInfoLayer);
+
+    auto menuLayer = new ParticleMenuLayer(true, TEST_COUNT, s_nParCurIdx);
+    addChild(menuLayer, 1, kTagMenuLayer);
+    menuLayer->release();
+
+    auto label = LabelTTF::create(title().c_str(), "Arial", 40);
+    addChild(label, 1);
+    label->setPosition(Point(s.width/2, s.height-32));
+    label->setColor(Color3B(255,255,40));
+
+    doTest();
+
+    schedule(schedule_selector(ParticleUpdateBenchmark::benchmarkStep));
+}
+
+std::string ParticleUpdateBenchmark::title() const
+{
+    return "Update 100 x 1000 particles";
+}
+
+void ParticleUpdateBenchmark::doTest()
+{
+    auto s = Director::getInstance()->getWinSize();
+    auto texture = Director::getInstance()->getTextureCache()->addImage("Images/fire.png");
+
+    // half of the systems use the gravity mode, the other half the radius mode
+    for (int i = 0; i < kBenchmarkSystems; ++i)
+    {
+        auto particleSystem = ParticleSystemQuad::createWithTotalParticles(kBenchmarkParticlesPerSystem);
+        particleSystem->setTexture(texture);
+        particleSystem->setDuration(-1);
+        particleSystem->setLife(2.0f);
+        particleSystem->setLifeVar(1);
+        particleSystem->setEmissionRate(kBenchmarkParticlesPerSystem / particleSystem->getLife());
+        particleSystem->setAngle(90);
+        particleSystem->setAngleVar(360);
+        particleSystem->setStartColor(Color4F(0.5f, 0.5f, 0.5f, 1.0f));
+        particleSystem->setStartColorVar(Color4F(0.5f, 0.5f, 0.5f, 1.0f));
+        particleSystem->setEndColor(Color4F(0.1f, 0.1f, 0.1f, 0.2f));
+        particleSystem->setStartSize(8.0f);
+        particleSystem->setEndSize(4.0f);
+        particleSystem->setStartSpin(0);
+        particleSystem->setEndSpin(360);
+
+        if (i % 2 == 0)
+        {
+            particleSystem->setEmitterMode(ParticleSystem::Mode::GRAVITY);
+            particleSystem->setGravity(Point(0,-90));
+            particleSystem->setSpeed(180);
+            particleSystem->setSpeedVar(50);
+            particleSystem->setRadialAccel(-20);
+            particleSystem->setTangentialAccel(30);
+        }
+        else
+        {
+            particleSystem->setEmitterMode(ParticleSystem::Mode::RADIUS);
+            particleSystem->setStartRadius(0);
+            particleSystem->setEndRadius(200);
+            particleSystem->setEndRadiusVar(50);
+            particleSystem->setRotatePerSecond(90);
+            particleSystem->setRotatePerSecondVar(30);
+        }
+
+        particleSystem->setPosition(Point(CCRANDOM_0_1() * s.width, CCRANDOM_0_1() * s.height));
+        addChild(particleSystem);
+
+        // the systems are updated by the benchmark, so they can be timed together
+        particleSystem->unscheduleUpdate();
+        _systems.push_back(particleSystem);
+    }
+}
+
+void ParticleUpdateBenchmark::benchmarkStep(float dt)
+{
+    struct timeval start, end;
+
+    gettimeofday(&start, nullptr);
+    for (const auto& system : _systems)
+    {
+        system->update(dt);
+        _updatedParticles += system->getParticleCount();
+    }
+    gettimeofday(&end, nullptr);
+
+    _updateTime += (end.tv_sec - start.tv_sec) * 1000.0f + (end.tv_usec - start.tv_usec) / 1000.0f;
+
+    if (++_frames == kBenchmarkReportFrames)
+    {
+        float particlesPerMs = _updateTime > 0 ? _updatedParticles / _updateTime : 0;
+        log("particles: %ld, update ms: %f, particles/ms: %f", _updatedParticles, _updateTime, particlesPerMs);
+
+        auto infoLabel = static_cast<LabelTTF*>(getChildByTag(kTagInfoLayer));
+        infoLabel->setString(StringUtils::format("%.0f particles/ms\n%.3f ms per frame", particlesPerMs, _updateTime / _frames));
+
+        _updateTime = 0;
+        _updatedParticles = 0;
+        _frames = 0;
+    }
+}
+
 void runParticleTest()
 {
     auto scene = new ParticlePerformTest1;
@@ -58,6 +58,22 @@ public:
     virtual void doTest();
 };
 
+class ParticleUpdateBenchmark : public ParticleMainScene
+{
+public:
+    virtual void initWithSubTest(int subtest, int particles) override;
+    virtual std::string title() const override;
+    virtual void doTest();
+
+    void benchmarkStep(float dt);
+
+protected:
+    std::vector<ParticleSystem*> _systems;
+    float _updateTime;
+    long _updatedParticles;
+    int _frames;
+};
+
 void runParticleTest();
 
 #endif
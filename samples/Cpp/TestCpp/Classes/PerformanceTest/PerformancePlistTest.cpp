@@ -0,0 +1,204 @@
+#include "PerformancePlistTest.h"
+
+enum
+{
+    TEST_COUNT = 1,
+};
+
+static int s_nPlistCurCase = 0;
+
+static float calculateDeltaTime( struct timeval *lastUpdate )
+{
+    struct timeval now;
+
+    gettimeofday( &now, NULL);
+
+    float dt = (now.tv_sec - lastUpdate->tv_sec) + (now.tv_usec - lastUpdate->tv_usec) / 1000000.0f;
+
+    return dt;
+}
+
+////////////////////////////////////////////////////////
+//
+// PlistMenuLayer
+//
+////////////////////////////////////////////////////////
+void PlistMenuLayer::showCurrentTest()
+{
+    Scene* scene = NULL;
+
+    switch (_curCase)
+    {
+    case 0:
+        scene = PlistLoadTest::scene();
+        break;
+    }
+    s_nPlistCurCase = _curCase;
+
+    if (scene)
+    {
+        Director::getInstance()->replaceScene(scene);
+    }
+}
+
+void PlistMenuLayer::onEnter()
+{
+    PerformBasicLayer::onEnter();
+
+    auto s = Director::getInstance()->getWinSize();
+
+    // Title
+    auto label = LabelTTF::create(title().c_str(), "Arial", 40);
+    addChild(label, 1);
+    label->setPosition(Point(s.width/2, s.height-32));
+    label->setColor(Color3B(255,255,40));
+
+    // Subtitle
+    std::string strSubTitle = subtitle();
+    if(strSubTitle.length())
+    {
+        auto l = LabelTTF::create(strSubTitle.c_str(), "Thonburi", 16);
+        addChild(l, 1);
+        l->setPosition(Point(s.width/2, s.height-80));
+    }
+
+    performTests();
+}
+
+std::string PlistMenuLayer::title() const
+{
+    return "no title";
+}
+
+std::string PlistMenuLayer::subtitle() const
+{
+    return "no subtitle";
+}
+
+////////////////////////////////////////////////////////
+//
+// PlistLoadTest
+//
+////////////////////////////////////////////////////////
+
+// a sprite sheet with more frames than any of the test resources, written to the writable path
+static const int PLIST_FRAMES = 5000;
+static const int PLIST_LOAD_LOOPS = 5;
+
+static std::string writeLargePlist()
+{
+    ValueMap frames;
+    for (int i = 0; i < PLIST_FRAMES; ++i)
+    {
+        ValueMap frame;
+        frame["frame"] = Value(StringUtils::format("{{%d,%d},{64,64}}", (i % 32) * 64, (i / 32) * 64));
+        frame["offset"] = Value("{0,0}");
+        frame["rotated"] = Value(i % 2);
+        frame["sourceColorRect"] = Value("{{0,0},{64,64}}");
+        frame["sourceSize"] = Value("{64,64}");
+        frames[StringUtils::format("plist_load_test_frame_%05d.png", i)] = Value(std::move(frame));
+    }
+
+    ValueMap metadata;
+    metadata["format"] = Value(2);
+    metadata["textureFileName"] = Value("plist_load_test.png");
+
+    ValueMap root;
+    root["frames"] = Value(std::move(frames));
+    root["metadata"] = Value(std::move(metadata));
+
+    std::string path = FileUtils::getInstance()->getWritablePath() + "PlistLoadTest.plist";
+    FileUtils::getInstance()->writeToFile(root, path);
+    return path;
+}
+
+static void countValues(const Value& value, int* count)
+{
+    ++(*count);
+    if (value.getType() == Value::Type::MAP)
+    {
+        for (const auto& element : value.asValueMap())
+        {
+            countValues(element.second, count);
+        }
+    }
+    else if (value.getType() == Value::Type::VECTOR)
+    {
+        for (const auto& element : value.asValueVector())
+        {
+            countValues(element, count);
+        }
+    }
+}
+
+void PlistLoadTest::performTests()
+{
+    std::string path = writeLargePlist();
+
+    struct timeval now;
+    ValueMap dict;
+    gettimeofday(&now, NULL);
+    for (int i = 0; i < PLIST_LOAD_LOOPS; ++i)
+    {
+        dict = FileUtils::getInstance()->getValueMapFromFile(path);
+    }
+    float parseTime = calculateDeltaTime(&now) * 1000 / PLIST_LOAD_LOOPS;
+
+    // looks up every frame and reads its rect, as SpriteFrameCache does
+    int rotated = 0;
+    auto& frames = dict["frames"].asValueMap();
+    gettimeofday(&now, NULL);
+    for (int i = 0; i < PLIST_FRAMES; ++i)
+    {
+        auto& frame = frames[StringUtils::format("plist_load_test_frame_%05d.png", i)].asValueMap();
+        rotated += frame["rotated"].asInt();
+        rotated += frame["frame"].asString().empty() ? 1 : 0;
+    }
+    float lookupTime = calculateDeltaTime(&now) * 1000;
+
+    int values = 0;
+    for (const auto& element : dict)
+    {
+        countValues(element.second, &values);
+    }
+    int valuesSize = values * (int)sizeof(Value) / 1024;
+
+    log("--------");
+    log("--- plist: %d frames, %d values of %d bytes ---", PLIST_FRAMES, values, (int)sizeof(Value));
+    log("parse  ms:%f", parseTime);
+    log("lookup ms:%f (%d)", lookupTime, rotated);
+    log("values KB:%d", valuesSize);
+
+    auto s = Director::getInstance()->getWinSize();
+    auto label = LabelTTF::create(StringUtils::format("parse: %.3f ms\nlookup: %.3f ms\n%d values, %d KB",
+                                                      parseTime, lookupTime, values, valuesSize), "Arial", 24);
+    addChild(label, 1);
+    label->setPosition(Point(s.width/2, s.height/2));
+}
+
+std::string PlistLoadTest::title() const
+{
+    return "Plist Load Test";
+}
+
+std::string PlistLoadTest::subtitle() const
+{
+    return "ms per parse of a 5000 frame plist, ms to look up every frame";
+}
+
+Scene* PlistLoadTest::scene()
+{
+    auto scene = Scene::create();
+    PlistLoadTest *layer = new PlistLoadTest(true, TEST_COUNT, s_nPlistCurCase);
+    scene->addChild(layer);
+    layer->release();
+
+    return scene;
+}
+
+void runPlistTest()
+{
+    s_nPlistCurCase = 0;
+    auto scene = PlistLoadTest::scene();
+    Director::getInstance()->replaceScene(scene);
+}
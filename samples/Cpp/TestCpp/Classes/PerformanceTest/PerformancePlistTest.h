@@ -0,0 +1,39 @@
+#ifndef __PERFORMANCE_PLIST_TEST_H__
+#define __PERFORMANCE_PLIST_TEST_H__
+
+#include "PerformanceTest.h"
+
+class PlistMenuLayer : public PerformBasicLayer
+{
+public:
+    PlistMenuLayer(bool bControlMenuVisible, int nMaxCases = 0, int nCurCase = 0)
+        :PerformBasicLayer(bControlMenuVisible, nMaxCases, nCurCase)
+    {
+    }
+
+    virtual void showCurrentTest();
+
+    virtual void onEnter();
+    virtual std::string title() const;
+    virtual std::string subtitle() const;
+    virtual void performTests() = 0;
+};
+
+class PlistLoadTest : public PlistMenuLayer
+{
+public:
+    PlistLoadTest(bool bControlMenuVisible, int nMaxCases = 0, int nCurCase = 0)
+        :PlistMenuLayer(bControlMenuVisible, nMaxCases, nCurCase)
+    {
+    }
+
+    virtual void performTests();
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    static Scene* scene();
+};
+
+void runPlistTest();
+
+#endif
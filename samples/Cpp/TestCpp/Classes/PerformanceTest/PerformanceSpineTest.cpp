@@ -0,0 +1,214 @@
+#include "PerformanceSpineTest.h"
+#include <spine/spine.h>
+#include <spine/extension.h>
+
+enum
+{
+    TEST_COUNT = 1,
+};
+
+static int s_nSpineCurCase = 0;
+
+static float calculateDeltaTime( struct timeval *lastUpdate )
+{
+    struct timeval now;
+
+    gettimeofday( &now, NULL);
+
+    float dt = (now.tv_sec - lastUpdate->tv_sec) + (now.tv_usec - lastUpdate->tv_usec) / 1000000.0f;
+
+    return dt;
+}
+
+////////////////////////////////////////////////////////
+//
+// SpineMenuLayer
+//
+////////////////////////////////////////////////////////
+void SpineMenuLayer::showCurrentTest()
+{
+    Scene* scene = NULL;
+
+    switch (_curCase)
+    {
+    case 0:
+        scene = SpineSkeletonLoadTest::scene();
+        break;
+    }
+    s_nSpineCurCase = _curCase;
+
+    if (scene)
+    {
+        Director::getInstance()->replaceScene(scene);
+    }
+}
+
+void SpineMenuLayer::onEnter()
+{
+    PerformBasicLayer::onEnter();
+
+    auto s = Director::getInstance()->getWinSize();
+
+    // Title
+    auto label = LabelTTF::create(title().c_str(), "Arial", 40);
+    addChild(label, 1);
+    label->setPosition(Point(s.width/2, s.height-32));
+    label->setColor(Color3B(255,255,40));
+
+    // Subtitle
+    std::string strSubTitle = subtitle();
+    if(strSubTitle.length())
+    {
+        auto l = LabelTTF::create(strSubTitle.c_str(), "Thonburi", 16);
+        addChild(l, 1);
+        l->setPosition(Point(s.width/2, s.height-80));
+    }
+
+    performTests();
+}
+
+std::string SpineMenuLayer::title() const
+{
+    return "no title";
+}
+
+std::string SpineMenuLayer::subtitle() const
+{
+    return "no subtitle";
+}
+
+////////////////////////////////////////////////////////
+//
+// SpineSkeletonLoadTest
+//
+////////////////////////////////////////////////////////
+static const char* s_spineSkeletons[] =
+{
+    "spine/spineboy",
+    "spine/goblins",
+};
+
+// a crowd of characters as loaded at startup
+static const int SPINE_SKELETON_LOADS = 30;
+
+// spine heap accounting, the hooks are only installed while a crowd is loaded and released.
+// Every block the runtime frees goes through FREE, so every block it allocates must go through MALLOC.
+static size_t s_spineHeapSize = 0;
+static size_t s_spineHeapPeak = 0;
+
+static void* countingMalloc(size_t size)
+{
+    size_t* block = (size_t*)malloc(size + sizeof(size_t) * 2);
+    block[0] = size;
+    s_spineHeapSize += size;
+    s_spineHeapPeak = std::max(s_spineHeapPeak, s_spineHeapSize);
+    return block + 2;
+}
+
+static void countingFree(void* ptr)
+{
+    if (ptr)
+    {
+        size_t* block = (size_t*)ptr - 2;
+        s_spineHeapSize -= block[0];
+        free(block);
+    }
+}
+
+float SpineSkeletonLoadTest::loadSkeletons(const char* suffix, size_t* peakBytes)
+{
+    struct timeval now;
+    std::vector<spAtlas*> atlases;
+    for (const auto& skeleton : s_spineSkeletons)
+    {
+        atlases.push_back(spAtlas_readAtlasFile((std::string(skeleton) + ".atlas").c_str()));
+    }
+
+    std::vector<std::string> files;
+    for (const auto& skeleton : s_spineSkeletons)
+    {
+        files.push_back(FileUtils::getInstance()->fullPathForFilename(std::string(skeleton) + suffix));
+    }
+
+    s_spineHeapSize = s_spineHeapPeak = 0;
+    _setMalloc(countingMalloc);
+    _setFree(countingFree);
+
+    std::vector<spSkeletonData*> crowd;
+    gettimeofday(&now, NULL);
+    for (int i = 0; i < SPINE_SKELETON_LOADS; ++i)
+    {
+        size_t index = i % atlases.size();
+        spSkeletonJson* json = spSkeletonJson_create(atlases[index]);
+        spSkeletonData* data = spSkeletonJson_readSkeletonDataFile(json, files[index].c_str());
+        if (!data)
+        {
+            log("%s: %s", files[index].c_str(), json->error);
+        }
+        crowd.push_back(data);
+        spSkeletonJson_dispose(json);
+    }
+    float time = calculateDeltaTime(&now) * 1000;
+
+    for (const auto& data : crowd)
+    {
+        if (data) spSkeletonData_dispose(data);
+    }
+
+    _setMalloc(malloc);
+    _setFree(free);
+    *peakBytes = s_spineHeapPeak;
+
+    for (const auto& atlas : atlases)
+    {
+        spAtlas_dispose(atlas);
+    }
+
+    return time;
+}
+
+void SpineSkeletonLoadTest::performTests()
+{
+    log("--------");
+    log("--- spine: %d skeletons ---", SPINE_SKELETON_LOADS);
+
+    size_t jsonPeak, binaryPeak;
+    float jsonTime = loadSkeletons(".json", &jsonPeak);
+    log("json   ms:%f peak spine heap:%d KB", jsonTime, (int)(jsonPeak / 1024));
+
+    float binaryTime = loadSkeletons(".skel", &binaryPeak);
+    log("binary ms:%f peak spine heap:%d KB", binaryTime, (int)(binaryPeak / 1024));
+
+    auto s = Director::getInstance()->getWinSize();
+    auto label = LabelTTF::create(StringUtils::format("json: %.3f ms, %d KB\nbinary: %.3f ms, %d KB",
+                                                      jsonTime, (int)(jsonPeak / 1024), binaryTime, (int)(binaryPeak / 1024)), "Arial", 24);
+    addChild(label, 1);
+    label->setPosition(Point(s.width/2, s.height/2));
+}
+
+std::string SpineSkeletonLoadTest::title() const
+{
+    return "Spine Skeleton Load Test";
+}
+
+std::string SpineSkeletonLoadTest::subtitle() const
+{
+    return "json vs binary skeleton data, 30 skeletons kept alive";
+}
+
+Scene* SpineSkeletonLoadTest::scene()
+{
+    auto scene = Scene::create();
+    SpineSkeletonLoadTest *layer = new SpineSkeletonLoadTest(true, TEST_COUNT, s_nSpineCurCase);
+    scene->addChild(layer);
+    layer->release();
+
+    return scene;
+}
+
+void runSpineTest()
+{
+    s_nSpineCurCase = 0;
+    auto scene = SpineSkeletonLoadTest::scene();
+    Director::getInstance()->replaceScene(scene);
+}
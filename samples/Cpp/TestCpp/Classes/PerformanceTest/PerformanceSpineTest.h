@@ -0,0 +1,40 @@
+#ifndef __PERFORMANCE_SPINE_TEST_H__
+#define __PERFORMANCE_SPINE_TEST_H__
+
+#include "PerformanceTest.h"
+
+class SpineMenuLayer : public PerformBasicLayer
+{
+public:
+    SpineMenuLayer(bool bControlMenuVisible, int nMaxCases = 0, int nCurCase = 0)
+        :PerformBasicLayer(bControlMenuVisible, nMaxCases, nCurCase)
+    {
+    }
+
+    virtual void showCurrentTest();
+
+    virtual void onEnter();
+    virtual std::string title() const;
+    virtual std::string subtitle() const;
+    virtual void performTests() = 0;
+};
+
+class SpineSkeletonLoadTest : public SpineMenuLayer
+{
+public:
+    SpineSkeletonLoadTest(bool bControlMenuVisible, int nMaxCases = 0, int nCurCase = 0)
+        :SpineMenuLayer(bControlMenuVisible, nMaxCases, nCurCase)
+    {
+    }
+
+    virtual void performTests();
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+    float loadSkeletons(const char* suffix, size_t* peakBytes);
+
+    static Scene* scene();
+};
+
+void runSpineTest();
+
+#endif
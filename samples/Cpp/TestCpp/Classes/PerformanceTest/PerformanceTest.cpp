@@ -7,6 +7,8 @@
 #include "PerformanceTouchesTest.h"
 #include "PerformanceAllocTest.h"
 #include "PerformanceLabelTest.h"
+#include "PerformanceSpineTest.h"
+#include "PerformancePlistTest.h"
 
 enum
 {
@@ -26,6 +28,8 @@ struct {
 	{ "Texture Perf Test",[](Object*sender){runTextureTest();} },
 	{ "Touches Perf Test",[](Object*sender){runTouchesTest();} },
     { "Label Perf Test",[](Object*sender){runLabelTest();} },
+    { "Spine Perf Test",[](Object*sender){runSpineTest();} },
+    { "Plist Perf Test",[](Object*sender){runPlistTest();} },
 };
 
 static const int g_testMax = sizeof(g_testsName)/sizeof(g_testsName[0]);
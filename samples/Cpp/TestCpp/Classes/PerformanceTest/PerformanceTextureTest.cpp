@@ -2,7 +2,7 @@
 
 enum
 {
-    TEST_COUNT = 1,
+    TEST_COUNT = 2,
 };
 
 static int s_nTexCurCase = 0;
@@ -32,6 +32,9 @@ void TextureMenuLayer::showCurrentTest()
     case 0:
         scene = TextureTest::scene();
         break;
+    case 1:
+        scene = SpriteFrameCacheLoadTest::scene();
+        break;
     }
     s_nTexCurCase = _curCase;
 
@@ -345,7 +348,88 @@ std::string TextureTest::subtitle() const
 Scene* TextureTest::scene()
 {
     auto scene = Scene::create();
-    TextureTest *layer = new TextureTest(false, TEST_COUNT, s_nTexCurCase);
+    TextureTest *layer = new TextureTest(true, TEST_COUNT, s_nTexCurCase);
+    scene->addChild(layer);
+    layer->release();
+
+    return scene;
+}
+
+////////////////////////////////////////////////////////
+//
+// SpriteFrameCacheLoadTest
+//
+////////////////////////////////////////////////////////
+static const char* s_spriteSheets[] =
+{
+    "animations/grossini",
+    "animations/grossini_blue",
+    "animations/grossini_gray",
+    "animations/grossini-aliases",
+    "zwoptex/grossini",
+    "zwoptex/grossini-generic",
+};
+
+static const int SPRITE_FRAME_LOAD_LOOPS = 50;
+
+float SpriteFrameCacheLoadTest::loadSpriteFrames(const char* suffix)
+{
+    struct timeval now;
+    auto cache = SpriteFrameCache::getInstance();
+    auto textureCache = Director::getInstance()->getTextureCache();
+
+    // textures are loaded up front, only the frame tables are measured
+    std::vector<Texture2D*> textures;
+    for (const auto& sheet : s_spriteSheets)
+    {
+        textures.push_back(textureCache->addImage(std::string(sheet) + ".png"));
+    }
+
+    cache->removeSpriteFrames();
+    gettimeofday(&now, NULL);
+    for (int i = 0; i < SPRITE_FRAME_LOAD_LOOPS; ++i)
+    {
+        for (size_t j = 0; j < textures.size(); ++j)
+        {
+            cache->addSpriteFramesWithFile(std::string(s_spriteSheets[j]) + suffix, textures[j]);
+        }
+        cache->removeSpriteFrames();
+    }
+
+    return calculateDeltaTime(&now) * 1000 / SPRITE_FRAME_LOAD_LOOPS;
+}
+
+void SpriteFrameCacheLoadTest::performTests()
+{
+    log("--------");
+    log("--- SpriteFrameCache: %d sprite sheets ---", (int)(sizeof(s_spriteSheets) / sizeof(s_spriteSheets[0])));
+
+    float plistTime = loadSpriteFrames(".plist");
+    log("plist  ms:%f", plistTime);
+
+    float binaryTime = loadSpriteFrames(".sfb");
+    log("binary ms:%f", binaryTime);
+
+    auto s = Director::getInstance()->getWinSize();
+    auto label = LabelTTF::create(StringUtils::format("plist: %.3f ms\nbinary: %.3f ms", plistTime, binaryTime), "Arial", 24);
+    addChild(label, 1);
+    label->setPosition(Point(s.width/2, s.height/2));
+}
+
+std::string SpriteFrameCacheLoadTest::title() const
+{
+    return "SpriteFrameCache Load Test";
+}
+
+std::string SpriteFrameCacheLoadTest::subtitle() const
+{
+    return "plist vs binary frame table, ms per load of all sheets";
+}
+
+Scene* SpriteFrameCacheLoadTest::scene()
+{
+    auto scene = Scene::create();
+    SpriteFrameCacheLoadTest *layer = new SpriteFrameCacheLoadTest(true, TEST_COUNT, s_nTexCurCase);
     scene->addChild(layer);
     layer->release();
 
@@ -35,6 +35,22 @@ public:
     static Scene* scene();
 };
 
+class SpriteFrameCacheLoadTest : public TextureMenuLayer
+{
+public:
+    SpriteFrameCacheLoadTest(bool bControlMenuVisible, int nMaxCases = 0, int nCurCase = 0)
+        :TextureMenuLayer(bControlMenuVisible, nMaxCases, nCurCase)
+    {
+    }
+
+    virtual void performTests();
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+    float loadSpriteFrames(const char* suffix);
+
+    static Scene* scene();
+};
+
 void runTextureTest();
 
 #endif
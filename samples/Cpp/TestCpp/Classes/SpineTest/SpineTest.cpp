@@ -73,6 +73,17 @@ bool SpineTestLayer::init () {
     skeletonNode->setPosition(Point(windowSize.width / 2, 20));
     addChild(skeletonNode);
     
+    MenuItemFont::setFontSize(18);
+    auto item = MenuItemFont::create("Pose Baking", [](Object* sender) {
+        auto scene = new SpineTestScene();
+        scene->addChild(SpinePoseBakingLayer::create());
+        Director::getInstance()->replaceScene(scene);
+        scene->release();
+    });
+    auto menu = Menu::create(item, NULL);
+    menu->setPosition(Point(windowSize.width - 60, windowSize.height - 20));
+    addChild(menu);
+    
     scheduleUpdate();
     
     return true;
@@ -101,3 +112,43 @@ void SpineTestLayer::animationStateEvent (SkeletonAnimation* node, int trackInde
             break;
     }
 }
+
+//------------------------------------------------------------------
+//
+// SpinePoseBakingLayer
+//
+//------------------------------------------------------------------
+bool SpinePoseBakingLayer::init () {
+    if (!Layer::init()) return false;
+    
+    Size windowSize = Director::getInstance()->getWinSize();
+    
+    // the instances share the poses baked by the first one
+    const int columns = 6;
+    const int rows = 3;
+    for (int i = 0; i < columns * rows; ++i)
+    {
+        auto skeleton = SkeletonAnimation::createWithFile("spine/spineboy.json", "spine/spineboy.atlas", 0.3f);
+        skeleton->setPoseBakingEnabled(true);
+        skeleton->setAnimation(0, "walk", true);
+        skeleton->timeScale = 0.5f + 0.1f * (i % 4);
+        skeleton->skeleton->flipX = i % 2;
+        skeleton->update(0);
+        skeleton->setPosition(Point(windowSize.width * (i % columns + 0.5f) / columns,
+                                    10 + (windowSize.height - 40) * (i / columns) / rows));
+        addChild(skeleton);
+    }
+    
+    MenuItemFont::setFontSize(18);
+    auto item = MenuItemFont::create("Live", [](Object* sender) {
+        auto scene = new SpineTestScene();
+        scene->addChild(SpineTestLayer::create());
+        Director::getInstance()->replaceScene(scene);
+        scene->release();
+    });
+    auto menu = Menu::create(item, NULL);
+    menu->setPosition(Point(windowSize.width - 60, windowSize.height - 20));
+    addChild(menu);
+    
+    return true;
+}
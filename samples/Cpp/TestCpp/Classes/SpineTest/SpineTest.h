@@ -49,4 +49,12 @@ public:
 	CREATE_FUNC (SpineTestLayer);
 };
 
+// A crowd playing one animation from poses baked into SkeletonPoseCache
+class SpinePoseBakingLayer: public cocos2d::Layer {
+public:
+	virtual bool init ();
+
+	CREATE_FUNC (SpinePoseBakingLayer);
+};
+
 #endif // _EXAMPLELAYER_H_
@@ -1313,7 +1313,7 @@ enum
 
 static int sceneIdx = -1; 
 
-#define MAX_LAYER    28
+#define MAX_LAYER    30
 
 Layer* createTileMalayer(int nIndex)
 {
@@ -1347,6 +1347,8 @@ Layer* createTileMalayer(int nIndex)
         case 25: return new TMXBug987();
         case 26: return new TMXBug787();
         case 27: return new TMXGIDObjectsTest();
+        case 28: return new TMXChunkedTest();
+        case 29: return new TMXLazyDecodingTest();
     }
 
     return NULL;
@@ -1522,3 +1524,93 @@ std::string TMXGIDObjectsTest::subtitle() const
 {
     return "Tiles are created from an object group";
 }
+
+//------------------------------------------------------------------
+//
+// TMXChunkedTest
+//
+//------------------------------------------------------------------
+TMXChunkedTest::TMXChunkedTest()
+{
+    // layers created while the default chunk size is set are rendered in chunks
+    TMXLayer::setDefaultChunkSize(16);
+    auto map = TMXTiledMap::create("TileMaps/orthogonal-test2.tmx");
+    TMXLayer::setDefaultChunkSize(0);
+    addChild(map, 0, kTagTileMap);
+
+    Size CC_UNUSED s = map->getContentSize();
+    CCLOG("ContentSize: %f, %f", s.width,s.height);
+
+    auto move = MoveBy::create(10, Point(-s.width / 2, -s.height / 2));
+    map->runAction(RepeatForever::create(Sequence::create(move, move->reverse(), NULL)));
+
+    // the chunks follow the color and opacity of the layer, as the tile sprites would
+    auto layer = map->getLayer("Layer 0");
+    layer->setCascadeColorEnabled(true);
+    layer->setCascadeOpacityEnabled(true);
+    layer->runAction(RepeatForever::create(Sequence::create(TintTo::create(2, 255, 128, 128),
+                                                            FadeTo::create(2, 96),
+                                                            FadeTo::create(2, 255),
+                                                            TintTo::create(2, 255, 255, 255),
+                                                            NULL)));
+
+    schedule(schedule_selector(TMXChunkedTest::updateTiles), 0.1f);
+}
+
+void TMXChunkedTest::updateTiles(float dt)
+{
+    auto map = (TMXTiledMap*) getChildByTag(kTagTileMap);
+    auto layer = map->getLayer("Layer 0");
+    auto ls = layer->getLayerSize();
+
+    // moves a hole along the diagonal, only the chunk of the modified tiles is rebuilt
+    static int s_diagonal = 0;
+    Point previous(s_diagonal % (int)ls.width, s_diagonal % (int)ls.height);
+    s_diagonal++;
+    Point current(s_diagonal % (int)ls.width, s_diagonal % (int)ls.height);
+
+    layer->setTileGID(layer->getTileGIDAt(current), previous);
+    layer->removeTileAt(current);
+}
+
+std::string TMXChunkedTest::title() const
+{
+    return "TMX chunked layer";
+}
+
+std::string TMXChunkedTest::subtitle() const
+{
+    return "Only the visible chunks are drawn, tinting doesn't rebuild them";
+}
+
+//------------------------------------------------------------------
+//
+// TMXLazyDecodingTest
+//
+//------------------------------------------------------------------
+TMXLazyDecodingTest::TMXLazyDecodingTest()
+{
+    // layers are decoded on background threads while the map is built,
+    // and read back from the layer cache the next time the test is run
+    TMXMapInfo::setLayerDecoding(TMXMapInfo::LayerDecoding::BACKGROUND);
+    TMXMapInfo::setLayerCacheEnabled(true);
+    auto map = TMXTiledMap::create("TileMaps/orthogonal-test2.tmx");
+    TMXMapInfo::setLayerCacheEnabled(false);
+    TMXMapInfo::setLayerDecoding(TMXMapInfo::LayerDecoding::IMMEDIATE);
+    addChild(map, 0, kTagTileMap);
+
+    Size CC_UNUSED s = map->getContentSize();
+    CCLOG("ContentSize: %f, %f", s.width,s.height);
+
+    map->runAction(ScaleBy::create(2, 0.5f));
+}
+
+std::string TMXLazyDecodingTest::title() const
+{
+    return "TMX background layer decoding";
+}
+
+std::string TMXLazyDecodingTest::subtitle() const
+{
+    return "Decoded layers are cached in the writable path";
+}
@@ -289,6 +289,23 @@ protected:
     
 };
 
+class TMXChunkedTest : public TileDemo
+{
+public:
+    TMXChunkedTest();
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+    void updateTiles(float dt);
+};
+
+class TMXLazyDecodingTest : public TileDemo
+{
+public:
+    TMXLazyDecodingTest();
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+};
+
 class TileMapTestScene : public TestScene
 {
 public:
@@ -50,7 +50,10 @@ bool AppDelegate::applicationDidFinishLaunching()
     // register lua engine
     LuaEngine* pEngine = LuaEngine::getInstance();
     ScriptEngineManager::getInstance()->setScriptEngine(pEngine);
-    
+
+    // required scripts are compiled on the first run and loaded as bytecode afterwards
+    pEngine->getLuaStack()->setBytecodeCacheEnabled(true);
+
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32 || CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID ||CC_TARGET_PLATFORM == CC_PLATFORM_IOS || CC_TARGET_PLATFORM == CC_PLATFORM_MAC)
     LuaStack* stack = pEngine->getLuaStack();
     register_assetsmanager_test_sample(stack->getLuaState());
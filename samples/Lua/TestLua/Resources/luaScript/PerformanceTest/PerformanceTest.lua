@@ -1,7 +1,7 @@
 require "luaScript/PerformanceTest/PerformanceSpriteTest"
 
-local MAX_COUNT     = 5
-local LINE_SPACE    = 40
+local MAX_COUNT     = 8
+local LINE_SPACE    = 32
 local kItemTagBasic = 1000
 
 local testsName =
@@ -10,7 +10,10 @@ local testsName =
     "PerformanceParticleTest",
     "PerformanceSpriteTest",
     "PerformanceTextureTest",
-    "PerformanceTouchesTest"
+    "PerformanceTouchesTest",
+    "PerformanceRequireTest",
+    "PerformanceBindingTest",
+    "PerformanceScheduleTest"
 }
 
 local s = cc.Director:getInstance():getWinSize()
@@ -1644,6 +1647,299 @@ local function runTouchesTest()
 end
 
 
+----------------------------------
+--PerformanceRequireTest
+----------------------------------
+local RequireTestParam =
+{
+    kModuleCount   = 300,
+    kFunctionCount = 40,
+    kModulePrefix  = "perf_require_",
+}
+
+local bRequireSearchPathAdded = false
+
+local function runRequireTest()
+    local pNewscene    = cc.Scene:create()
+    local pLayer       = cc.Layer:create()
+    local writablePath = cc.FileUtils:getInstance():getWritablePath()
+    local nGeneration  = 0
+    local pResultLabel = nil
+
+    if not bRequireSearchPathAdded then
+        cc.FileUtils:getInstance():addSearchPath(writablePath)
+        bRequireSearchPathAdded = true
+    end
+
+    local function GetModuleName(nIndex)
+        return RequireTestParam.kModulePrefix .. nIndex
+    end
+
+    --writes a tree of modules in the writable path, every module requires its parent,
+    --the generation changes every source so the bytecode cache of the last run is stale
+    local function WriteModules()
+        nGeneration = nGeneration + 1
+        for i = 1, RequireTestParam.kModuleCount do
+            local lines = {}
+            if i > 1 then
+                lines[#lines + 1] = string.format("local parent = require \"%s\"", GetModuleName(math.floor(i / 2)))
+            end
+            lines[#lines + 1] = "local M = {}"
+            for j = 1, RequireTestParam.kFunctionCount do
+                lines[#lines + 1] = string.format([[
+function M.f%d(a, b)
+    local t = { a, b, %d, %d, %d }
+    for k = 1, #t do
+        if t[k] > b then a = a + t[k] * 2 else b = b - k end
+    end
+    return { sum = a + b, name = "f%d" }
+end]], j, i, j, nGeneration, j)
+            end
+            lines[#lines + 1] = "return M"
+
+            local file = io.open(writablePath .. GetModuleName(i) .. ".lua", "w")
+            file:write(table.concat(lines, "\n"))
+            file:close()
+        end
+    end
+
+    --reads and compiles every source without the loader, what require costs without a cache
+    local function ParseAll()
+        local startTime = os.clock()
+        for i = 1, RequireTestParam.kModuleCount do
+            local file = io.open(writablePath .. GetModuleName(i) .. ".lua", "r")
+            local source = file:read("*a")
+            file:close()
+            assert(loadstring(source, GetModuleName(i)))
+        end
+        return os.clock() - startTime
+    end
+
+    local function RequireAll()
+        for i = 1, RequireTestParam.kModuleCount do
+            package.loaded[GetModuleName(i)] = nil
+        end
+        local startTime = os.clock()
+        for i = RequireTestParam.kModuleCount, 1, -1 do
+            require(GetModuleName(i))
+        end
+        return os.clock() - startTime
+    end
+
+    local function ShowResult(strName, fTime)
+        local strResult = string.format("%s: %d modules in %.1f ms", strName, RequireTestParam.kModuleCount, fTime * 1000)
+        print(strResult)
+        pResultLabel:setString(strResult)
+    end
+
+    local function onColdRequire()
+        WriteModules()
+        ShowResult("parse only", ParseAll())
+        ShowResult("require, cold cache", RequireAll())
+    end
+
+    local function onWarmRequire()
+        ShowResult("require, warm cache", RequireAll())
+    end
+
+    local pTitle = cc.LabelTTF:create("Require Performance Test", "Arial", 28)
+    pTitle:setPosition(cc.p(s.width / 2, s.height - 32))
+    pLayer:addChild(pTitle, 1)
+
+    local pSubtitle = cc.LabelTTF:create("Requires a generated script tree, see console for results", "Thonburi", 16)
+    pSubtitle:setPosition(cc.p(s.width / 2, s.height - 64))
+    pLayer:addChild(pSubtitle, 1)
+
+    pResultLabel = cc.LabelTTF:create("", "Arial", 20)
+    pResultLabel:setPosition(cc.p(s.width / 2, s.height / 2 - 40))
+    pLayer:addChild(pResultLabel, 1)
+
+    local pMenu = cc.Menu:create()
+    pMenu:setPosition(cc.p(0, 0))
+    cc.MenuItemFont:setFontName("Arial")
+    cc.MenuItemFont:setFontSize(24)
+    local pColdItem = cc.MenuItemFont:create("Regenerate scripts and require")
+    pColdItem:registerScriptTapHandler(onColdRequire)
+    pColdItem:setPosition(cc.p(s.width / 2, s.height / 2 + 40))
+    pMenu:addChild(pColdItem)
+    local pWarmItem = cc.MenuItemFont:create("Require again")
+    pWarmItem:registerScriptTapHandler(onWarmRequire)
+    pWarmItem:setPosition(cc.p(s.width / 2, s.height / 2))
+    pMenu:addChild(pWarmItem)
+    CreatePerfomBasicLayerMenu(pMenu)
+    pLayer:addChild(pMenu)
+
+    pNewscene:addChild(pLayer)
+    return pNewscene
+end
+
+----------------------------------
+--PerformanceBindingTest
+----------------------------------
+local BindingTestParam =
+{
+    kCallCount = 100000,
+}
+
+local function runBindingTest()
+    local pNewscene = cc.Scene:create()
+    local pLayer    = cc.Layer:create()
+    local pNode     = cc.Node:create()
+    local pResultLabel = nil
+    pLayer:addChild(pNode)
+
+    local point = cc.p(10, 20)
+    local size  = cc.size(30, 40)
+    local color = cc.c3b(255, 128, 0)
+
+    local tests =
+    {
+        { "setPosition(point)",   function() pNode:setPosition(point) end },
+        { "getPosition()",        function() pNode:getPosition() end },
+        { "setContentSize(size)", function() pNode:setContentSize(size) end },
+        { "getContentSize()",     function() pNode:getContentSize() end },
+        { "getBoundingBox()",     function() pNode:getBoundingBox() end },
+        { "setColor(color)",      function() pNode:setColor(color) end },
+        { "getColor()",           function() pNode:getColor() end },
+    }
+
+    local function RunTests(bRecycling)
+        local results = {}
+        cc.setStructTableRecycling(bRecycling)
+        for _, test in ipairs(tests) do
+            local func = test[2]
+            local startTime = os.clock()
+            for i = 1, BindingTestParam.kCallCount do
+                func()
+            end
+            local fCallsPerSecond = BindingTestParam.kCallCount / math.max(os.clock() - startTime, 0.000001)
+            local strResult = string.format("%s: %d calls/s", test[1], fCallsPerSecond)
+            print(strResult)
+            results[#results + 1] = strResult
+        end
+        cc.setStructTableRecycling(false)
+        pResultLabel:setString(table.concat(results, "\n"))
+    end
+
+    local pTitle = cc.LabelTTF:create("Binding Performance Test", "Arial", 28)
+    pTitle:setPosition(cc.p(s.width / 2, s.height - 32))
+    pLayer:addChild(pTitle, 1)
+
+    pResultLabel = cc.LabelTTF:create("", "Arial", 14)
+    pResultLabel:setPosition(cc.p(s.width / 2, s.height / 2 - 30))
+    pLayer:addChild(pResultLabel, 1)
+
+    local pMenu = cc.Menu:create()
+    pMenu:setPosition(cc.p(0, 0))
+    cc.MenuItemFont:setFontName("Arial")
+    cc.MenuItemFont:setFontSize(20)
+    local pNewTablesItem = cc.MenuItemFont:create("New tables")
+    pNewTablesItem:registerScriptTapHandler(function() RunTests(false) end)
+    pNewTablesItem:setPosition(cc.p(s.width / 3, s.height - 70))
+    pMenu:addChild(pNewTablesItem)
+    local pRecycledTablesItem = cc.MenuItemFont:create("Recycled tables")
+    pRecycledTablesItem:registerScriptTapHandler(function() RunTests(true) end)
+    pRecycledTablesItem:setPosition(cc.p(s.width * 2 / 3, s.height - 70))
+    pMenu:addChild(pRecycledTablesItem)
+    CreatePerfomBasicLayerMenu(pMenu)
+    pLayer:addChild(pMenu)
+
+    pNewscene:addChild(pLayer)
+    return pNewscene
+end
+
+----------------------------------
+--PerformanceScheduleTest
+----------------------------------
+local ScheduleTestParam =
+{
+    kHandlerCount   = 500,
+    kReportInterval = 1.0,
+}
+
+local function runScheduleTest()
+    local pNewscene = cc.Scene:create()
+    local pLayer    = cc.Layer:create()
+    local scheduler = cc.Director:getInstance():getScheduler()
+    local entries   = {}
+    local reportEntry = nil
+    local pResultLabel = nil
+    local nFrames = 0
+    local fFrameTime = 0
+
+    local function step(dt)
+        local x = 0
+        for i = 1, 10 do
+            x = x + math.sin(dt * i)
+        end
+        return x
+    end
+
+    local function report(dt)
+        local nCalls, fTime = 0, 0
+        local slowest = nil
+        for _, profile in ipairs(cc.getScriptHandlerProfiles()) do
+            nCalls = nCalls + profile.calls
+            fTime  = fTime + profile.totalTime
+            if nil == slowest or profile.maxTime > slowest.maxTime then
+                slowest = profile
+            end
+        end
+        cc.resetScriptHandlerProfiles()
+
+        local strResult = string.format("%d callbacks, %.2f ms per frame\n%d calls, %.2f us per call",
+            ScheduleTestParam.kHandlerCount, fFrameTime * 1000 / math.max(nFrames, 1),
+            nCalls, fTime * 1000000 / math.max(nCalls, 1))
+        if nil ~= slowest then
+            strResult = strResult .. string.format("\nslowest: handler %d, %.2f us", slowest.handler, slowest.maxTime * 1000000)
+        end
+        print(strResult)
+        pResultLabel:setString(strResult)
+        nFrames, fFrameTime = 0, 0
+    end
+
+    local function onNodeEvent(tag)
+        if tag == "enter" then
+            for i = 1, ScheduleTestParam.kHandlerCount do
+                entries[i] = scheduler:scheduleScriptFunc(step, 0, false)
+            end
+            reportEntry = scheduler:scheduleScriptFunc(report, ScheduleTestParam.kReportInterval, false)
+            cc.resetScriptHandlerProfiles()
+            cc.setScriptProfilingEnabled(true)
+        elseif tag == "exit" then
+            cc.setScriptProfilingEnabled(false)
+            for i = 1, #entries do
+                scheduler:unscheduleScriptEntry(entries[i])
+            end
+            entries = {}
+            scheduler:unscheduleScriptEntry(reportEntry)
+        end
+    end
+    pLayer:registerScriptHandler(onNodeEvent)
+
+    -- measures the whole frame, the scheduled callbacks are dispatched in one batch
+    pLayer:scheduleUpdateWithPriorityLua(function(dt)
+        nFrames = nFrames + 1
+        fFrameTime = fFrameTime + dt
+    end, 0)
+
+    local pTitle = cc.LabelTTF:create("Schedule Performance Test", "Arial", 28)
+    pTitle:setPosition(cc.p(s.width / 2, s.height - 32))
+    pLayer:addChild(pTitle, 1)
+
+    pResultLabel = cc.LabelTTF:create("", "Arial", 16)
+    pResultLabel:setPosition(cc.p(s.width / 2, s.height / 2))
+    pLayer:addChild(pResultLabel, 1)
+
+    local pMenu = cc.Menu:create()
+    pMenu:setPosition(cc.p(0, 0))
+    CreatePerfomBasicLayerMenu(pMenu)
+    pLayer:addChild(pMenu)
+
+    pNewscene:addChild(pLayer)
+    return pNewscene
+end
+
 ------------------------
 --
 ------------------------
@@ -1653,7 +1949,10 @@ local CreatePerformancesTestTable =
 	runParticleTest,
 	runSpriteTest,
 	runTextureTest,
-	runTouchesTest	
+	runTouchesTest,
+	runRequireTest,
+	runBindingTest,
+	runScheduleTest
 }
 
 local function CreatePerformancesTestScene(nPerformanceNo)
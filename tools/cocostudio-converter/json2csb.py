@@ -0,0 +1,172 @@
+#!/usr/bin/python
+# json2csb.py
+# Converts CocoStudio .json/.ExportJson exports (armatures and GUI layouts) into the binary
+# documents read by cocostudio::JsonDictionary::initWithBinary(). DataReaderHelper loads .csb
+# armature files and GUIReader::widgetFromJsonFile() accepts a .csb layout in place of the .json.
+#
+# Usage: json2csb.py input.json [output.csb]
+#
+# The binary document keeps the structure of the JSON document, so the existing readers decode it
+# with the same lookups, but nothing is parsed at load time and sub dictionaries are views into the
+# file instead of copies.
+#
+# Layout of a .csb file, all values little endian, blocks 4 byte aligned:
+#
+#   header
+#     char[4]   signature           'CCSB'
+#     uint16    version             1
+#     uint16    reserved
+#     uint32    string count
+#     uint32    offset of the string offsets, a uint32 file offset per string
+#     uint32    offset of the string characters
+#     uint32    size of the string characters, every string is null terminated
+#     value     root object
+#   value       uint8 type, uint8[3] reserved, then 4 bytes depending on the type
+#                 0 null        0
+#                 1 int         int32
+#                 2 uint        uint32, integers which don't fit into an int32
+#                 3 float       float32
+#                 4 string      uint32 string index
+#                 5 bool        uint32 0 or 1
+#                 6 array       uint32 offset of a block: uint32 count, then count values
+#                 7 object      uint32 offset of a block: uint32 count, then per member
+#                                 uint32 key string index and the value
+#               blocks always come after the value pointing at them
+#   strings     keys and string values are stored once
+
+import sys
+import os
+import struct
+import json
+from collections import OrderedDict
+
+SIGNATURE = b'CCSB'
+VERSION = 1
+HEADER_SIZE = 32
+
+TYPE_NULL = 0
+TYPE_INT = 1
+TYPE_UINT = 2
+TYPE_FLOAT = 3
+TYPE_STRING = 4
+TYPE_BOOL = 5
+TYPE_ARRAY = 6
+TYPE_OBJECT = 7
+
+try:
+    STRING_TYPES = (str, unicode)
+    INTEGER_TYPES = (int, long)
+except NameError:
+    STRING_TYPES = (str,)
+    INTEGER_TYPES = (int,)
+
+
+class Writer(object):
+    def __init__(self):
+        self.data = bytearray(HEADER_SIZE)
+        self.strings = []
+        self.string_indices = {}
+
+    def string_index(self, text):
+        index = self.string_indices.get(text)
+        if index is None:
+            index = len(self.strings)
+            self.strings.append(text)
+            self.string_indices[text] = index
+        return index
+
+    def value(self, value):
+        """Returns the type and payload of a value, containers are written as blocks later on."""
+        if value is None:
+            return TYPE_NULL, struct.pack('<I', 0)
+        if isinstance(value, bool):
+            return TYPE_BOOL, struct.pack('<I', 1 if value else 0)
+        if isinstance(value, INTEGER_TYPES):
+            if -2 ** 31 <= value < 2 ** 31:
+                return TYPE_INT, struct.pack('<i', value)
+            if 0 <= value < 2 ** 32:
+                return TYPE_UINT, struct.pack('<I', value)
+            return TYPE_FLOAT, struct.pack('<f', value)
+        if isinstance(value, float):
+            return TYPE_FLOAT, struct.pack('<f', value)
+        if isinstance(value, STRING_TYPES):
+            return TYPE_STRING, struct.pack('<I', self.string_index(value))
+        if isinstance(value, list):
+            return TYPE_ARRAY, None
+        if isinstance(value, dict):
+            return TYPE_OBJECT, None
+        raise ValueError('unsupported value %r' % (value,))
+
+    def block(self, container):
+        """Writes an array or object block and returns its offset, child blocks follow it."""
+        offset = len(self.data)
+        is_object = isinstance(container, dict)
+        items = list(container.items()) if is_object else [(None, item) for item in container]
+        record_size = 12 if is_object else 8
+
+        self.data += struct.pack('<I', len(items))
+        start = len(self.data)
+        self.data += bytearray(record_size * len(items))
+
+        for i, (key, item) in enumerate(items):
+            position = start + i * record_size
+            if is_object:
+                struct.pack_into('<I', self.data, position, self.string_index(key))
+                position += 4
+            self.write_value(position, item)
+        return offset
+
+    def write_value(self, position, item):
+        kind, payload = self.value(item)
+        if payload is None:
+            payload = struct.pack('<I', self.block(item))
+        self.data[position:position + 8] = struct.pack('<B3x', kind) + payload
+
+    def finish(self, root):
+        if not isinstance(root, (dict, list)):
+            raise ValueError('the root of the document must be an object or an array')
+        self.write_value(24, root)
+
+        offsets_offset = len(self.data)
+        self.data += bytearray(4 * len(self.strings))
+        string_data = len(self.data)
+        for i, text in enumerate(self.strings):
+            struct.pack_into('<I', self.data, offsets_offset + 4 * i, len(self.data))
+            self.data += text.encode('utf-8') + b'\0'
+        string_size = len(self.data) - string_data
+        if string_size == 0:
+            self.data += b'\0'
+            string_size = 1
+
+        struct.pack_into('<4sHHIIII', self.data, 0, SIGNATURE, VERSION, 0, len(self.strings),
+                         offsets_offset, string_data, string_size)
+        return bytes(self.data)
+
+
+def convert(root):
+    return Writer().finish(root)
+
+
+def main():
+    if len(sys.argv) < 2:
+        print('usage: %s input.json [output.csb]' % os.path.basename(sys.argv[0]))
+        return 1
+
+    src = sys.argv[1]
+    dst = sys.argv[2] if len(sys.argv) > 2 else os.path.splitext(src)[0] + '.csb'
+
+    f = open(src, 'rb')
+    text = f.read().decode('utf-8-sig')
+    f.close()
+    root = json.loads(text, object_pairs_hook=OrderedDict)
+
+    data = convert(root)
+    f = open(dst, 'wb')
+    f.write(data)
+    f.close()
+    print('%s -> %s (%d bytes)' % (src, dst, len(data)))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
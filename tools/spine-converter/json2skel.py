@@ -0,0 +1,281 @@
+#!/usr/bin/python
+# json2skel.py
+# Converts spine skeleton .json files into the binary skeleton format read by
+# spSkeletonJson_readSkeletonDataFile() and spSkeletonJson_readSkeletonDataBinary().
+#
+# Usage: json2skel.py input.json [output.skel]
+#
+# The binary file holds the same data as the JSON file with every default filled in and every
+# name resolved to an index, so the runtime reads it front to back without building a DOM.
+# Values are stored unscaled, the reader applies spSkeletonJson::scale like the JSON reader.
+#
+# Layout of a .skel file, all values little endian:
+#
+#   header
+#     char[4]   signature           'CCSK'
+#     uint16    version             1
+#     uint16    reserved
+#   string      uint16 length (0xffff for none), then length bytes and a terminating 0
+#   curve       uint8 type (0 linear, 1 stepped, 2 bezier), bezier is followed by float32 cx1, cy1, cx2, cy2
+#   bones       uint32 count, then per bone
+#                 string name, int32 parent index (-1 for none),
+#                 float32 length, x, y, rotation, scaleX, scaleY, uint8 inheritScale, inheritRotation
+#   slots       uint32 count, then per slot
+#                 string name, uint32 bone index, float32 r, g, b, a, string attachment, uint8 additive
+#   skins       uint32 count, then per skin
+#                 string name, uint32 attachment count, then per attachment
+#                   uint32 slot index, string skin attachment name, string attachment name, uint8 type
+#                   region, region sequence: float32 x, y, scaleX, scaleY, rotation, width, height
+#                   bounding box: uint32 vertex count, float32 vertices
+#   events      uint32 count, then per event
+#                 string name, int32 int, float32 float, string string
+#   animations  uint32 count, then per animation
+#                 string name, uint32 timeline count, then per timeline uint8 type and
+#                   rotate: uint32 bone index, uint32 frame count, frames of float32 time, angle, curve
+#                   translate, scale: uint32 bone index, uint32 frame count, frames of float32 time, x, y, curve
+#                   color: uint32 slot index, uint32 frame count, frames of float32 time, r, g, b, a, curve
+#                   attachment: uint32 slot index, uint32 frame count, frames of float32 time, string name
+#                   event: uint32 frame count, frames of
+#                     float32 time, uint32 event index, int32 int, float32 float, string string
+#                   draw order: uint32 frame count, frames of
+#                     float32 time, uint8 has draw order, then int32 slot index per slot if it has one
+
+import sys
+import os
+import struct
+import json
+from collections import OrderedDict
+
+SIGNATURE = b'CCSK'
+VERSION = 1
+NO_STRING = 0xffff
+
+# spTimelineType
+TIMELINE_SCALE = 0
+TIMELINE_ROTATE = 1
+TIMELINE_TRANSLATE = 2
+TIMELINE_COLOR = 3
+TIMELINE_ATTACHMENT = 4
+TIMELINE_EVENT = 5
+TIMELINE_DRAWORDER = 6
+
+# spAttachmentType
+ATTACHMENT_TYPES = {'region': 0, 'regionsequence': 1, 'boundingbox': 2}
+
+CURVE_LINEAR = 0
+CURVE_STEPPED = 1
+CURVE_BEZIER = 2
+
+
+class Writer(object):
+    def __init__(self):
+        self.data = bytearray()
+
+    def pack(self, fmt, *values):
+        self.data += struct.pack('<' + fmt, *values)
+
+    def string(self, text):
+        if text is None:
+            self.pack('H', NO_STRING)
+            return
+        raw = text.encode('utf-8')
+        if len(raw) >= NO_STRING:
+            raise ValueError("string '%s' is too long" % text)
+        self.pack('H', len(raw))
+        self.data += raw + b'\0'
+
+    def curve(self, frame):
+        curve = frame.get('curve')
+        if curve == 'stepped':
+            self.pack('B', CURVE_STEPPED)
+        elif isinstance(curve, list):
+            self.pack('B4f', CURVE_BEZIER, *curve[0:4])
+        else:
+            self.pack('B', CURVE_LINEAR)
+
+
+def to_color(text):
+    if text is None:
+        return [1.0, 1.0, 1.0, 1.0]
+    if len(text) != 8:
+        raise ValueError("invalid color '%s'" % text)
+    return [int(text[i:i + 2], 16) / 255.0 for i in range(0, 8, 2)]
+
+
+def index_of(names, name, what):
+    if name not in names:
+        raise ValueError('%s not found: %s' % (what, name))
+    return names.index(name)
+
+
+def write_animation(out, name, animation, bone_names, slot_names, events):
+    timelines = []
+    for bone_name, bone_map in animation.get('bones', {}).items():
+        bone_index = index_of(bone_names, bone_name, 'bone')
+        for timeline_name, frames in bone_map.items():
+            if timeline_name == 'rotate':
+                timelines.append((TIMELINE_ROTATE, bone_index, frames))
+            elif timeline_name == 'translate':
+                timelines.append((TIMELINE_TRANSLATE, bone_index, frames))
+            elif timeline_name == 'scale':
+                timelines.append((TIMELINE_SCALE, bone_index, frames))
+            else:
+                raise ValueError('invalid timeline type for a bone: %s' % timeline_name)
+    for slot_name, slot_map in animation.get('slots', {}).items():
+        slot_index = index_of(slot_names, slot_name, 'slot')
+        for timeline_name, frames in slot_map.items():
+            if timeline_name == 'color':
+                timelines.append((TIMELINE_COLOR, slot_index, frames))
+            elif timeline_name == 'attachment':
+                timelines.append((TIMELINE_ATTACHMENT, slot_index, frames))
+            else:
+                raise ValueError('invalid timeline type for a slot: %s' % timeline_name)
+    if 'events' in animation:
+        timelines.append((TIMELINE_EVENT, 0, animation['events']))
+    if 'draworder' in animation:
+        timelines.append((TIMELINE_DRAWORDER, 0, animation['draworder']))
+
+    out.string(name)
+    out.pack('I', len(timelines))
+    for kind, index, frames in timelines:
+        out.pack('B', kind)
+        if kind == TIMELINE_EVENT or kind == TIMELINE_DRAWORDER:
+            out.pack('I', len(frames))
+        else:
+            out.pack('II', index, len(frames))
+
+        for frame in frames:
+            time = frame.get('time', 0)
+            if kind == TIMELINE_ROTATE:
+                out.pack('2f', time, frame.get('angle', 0))
+                out.curve(frame)
+            elif kind == TIMELINE_TRANSLATE or kind == TIMELINE_SCALE:
+                out.pack('3f', time, frame.get('x', 0), frame.get('y', 0))
+                out.curve(frame)
+            elif kind == TIMELINE_COLOR:
+                out.pack('5f', time, *to_color(frame['color']))
+                out.curve(frame)
+            elif kind == TIMELINE_ATTACHMENT:
+                out.pack('f', time)
+                out.string(frame.get('name'))
+            elif kind == TIMELINE_EVENT:
+                event_index = index_of([e[0] for e in events], frame.get('name'), 'event')
+                default = events[event_index][1]
+                out.pack('fIif', time, event_index, frame.get('int', default.get('int', 0)),
+                         frame.get('float', default.get('float', 0)))
+                out.string(frame.get('string', default.get('string')))
+            else:
+                out.pack('f', time)
+                offsets = frame.get('offsets')
+                if offsets is None:
+                    out.pack('B', 0)
+                    continue
+                # same resolution of the offsets as the JSON reader
+                slot_count = len(slot_names)
+                draw_order = [-1] * slot_count
+                unchanged = []
+                original_index = 0
+                for offset in offsets:
+                    slot_index = index_of(slot_names, offset.get('slot'), 'slot')
+                    while original_index != slot_index:
+                        unchanged.append(original_index)
+                        original_index += 1
+                    draw_order[original_index + offset.get('offset', 0)] = original_index
+                    original_index += 1
+                while original_index < slot_count:
+                    unchanged.append(original_index)
+                    original_index += 1
+                for i in range(slot_count - 1, -1, -1):
+                    if draw_order[i] == -1:
+                        draw_order[i] = unchanged.pop()
+                out.pack('B', 1)
+                out.pack('%di' % slot_count, *draw_order)
+
+
+def convert(root):
+    out = Writer()
+    out.pack('4sHH', SIGNATURE, VERSION, 0)
+
+    bones = root.get('bones', [])
+    bone_names = [bone['name'] for bone in bones]
+    out.pack('I', len(bones))
+    for i, bone in enumerate(bones):
+        parent = bone.get('parent')
+        parent_index = -1 if parent is None else index_of(bone_names[0:i], parent, 'parent bone')
+        out.string(bone['name'])
+        out.pack('i6f2B', parent_index, bone.get('length', 0), bone.get('x', 0), bone.get('y', 0),
+                 bone.get('rotation', 0), bone.get('scaleX', 1), bone.get('scaleY', 1),
+                 bone.get('inheritScale', 1), bone.get('inheritRotation', 1))
+
+    slots = root.get('slots', [])
+    slot_names = [slot['name'] for slot in slots]
+    out.pack('I', len(slots))
+    for slot in slots:
+        out.string(slot['name'])
+        out.pack('I4f', index_of(bone_names, slot.get('bone'), 'slot bone'), *to_color(slot.get('color')))
+        out.string(slot.get('attachment'))
+        out.pack('B', slot.get('additive', 0))
+
+    skins = root.get('skins', {})
+    out.pack('I', len(skins))
+    for skin_name, skin in skins.items():
+        attachments = []
+        for slot_name, attachment_map in skin.items():
+            slot_index = index_of(slot_names, slot_name, 'skin slot')
+            for attachment_name, attachment in attachment_map.items():
+                attachments.append((slot_index, attachment_name, attachment))
+        out.string(skin_name)
+        out.pack('I', len(attachments))
+        for slot_index, skin_attachment_name, attachment in attachments:
+            type_name = attachment.get('type', 'region')
+            if type_name not in ATTACHMENT_TYPES:
+                raise ValueError('unknown attachment type: %s' % type_name)
+            out.pack('I', slot_index)
+            out.string(skin_attachment_name)
+            out.string(attachment.get('name', skin_attachment_name))
+            out.pack('B', ATTACHMENT_TYPES[type_name])
+            if type_name == 'boundingbox':
+                vertices = attachment.get('vertices', [])
+                out.pack('I%df' % len(vertices), len(vertices), *vertices)
+            else:
+                out.pack('7f', attachment.get('x', 0), attachment.get('y', 0), attachment.get('scaleX', 1),
+                         attachment.get('scaleY', 1), attachment.get('rotation', 0),
+                         attachment.get('width', 32), attachment.get('height', 32))
+
+    events = list(root.get('events', {}).items())
+    out.pack('I', len(events))
+    for event_name, event in events:
+        out.string(event_name)
+        out.pack('if', event.get('int', 0), event.get('float', 0))
+        out.string(event.get('string'))
+
+    animations = root.get('animations', {})
+    out.pack('I', len(animations))
+    for animation_name, animation in animations.items():
+        write_animation(out, animation_name, animation, bone_names, slot_names, events)
+
+    return bytes(out.data)
+
+
+def main():
+    if len(sys.argv) < 2:
+        print('usage: %s input.json [output.skel]' % os.path.basename(sys.argv[0]))
+        return 1
+
+    src = sys.argv[1]
+    dst = sys.argv[2] if len(sys.argv) > 2 else os.path.splitext(src)[0] + '.skel'
+
+    f = open(src, 'r')
+    root = json.load(f, object_pairs_hook=OrderedDict)
+    f.close()
+
+    data = convert(root)
+    f = open(dst, 'wb')
+    f.write(data)
+    f.close()
+    print('%s -> %s (%d bytes)' % (src, dst, len(data)))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,146 @@
+#!/usr/bin/python
+# plist2sfb.py
+# Converts sprite sheet .plist files (Zwoptex / TexturePacker, formats 0 - 3)
+# into the binary frame table read by SpriteFrameCache::addSpriteFramesWithBinaryFile().
+#
+# Usage: plist2sfb.py input.plist [output.sfb]
+#
+# Layout of a .sfb file, all values little endian:
+#
+#   header
+#     char[4]   signature           'CCSF'
+#     uint16    version             1
+#     uint16    reserved
+#     uint32    frame count
+#     uint32    alias count
+#     uint32    texture name offset (in the string table), 0xffffffff if none
+#     uint32    texture name length
+#     uint32    string table size
+#   frame records, frame count times
+#     uint32    name offset, name length
+#     float32   rect x, y, width, height
+#     float32   offset x, y
+#     float32   original size width, height
+#     uint32    rotated
+#   alias records, alias count times
+#     uint32    name offset, name length, frame index
+#   string table, names are not null terminated
+
+import sys
+import os
+import re
+import struct
+import plistlib
+
+SIGNATURE = b'CCSF'
+VERSION = 1
+NO_TEXTURE = 0xffffffff
+
+
+def read_plist(path):
+    f = open(path, 'rb')
+    try:
+        if hasattr(plistlib, 'load'):
+            return plistlib.load(f)
+        return plistlib.readPlist(f)
+    finally:
+        f.close()
+
+
+def parse_floats(text, count):
+    values = [float(v) for v in re.findall(r'[-+]?[0-9]*\.?[0-9]+(?:[eE][-+]?[0-9]+)?', text)]
+    if len(values) != count:
+        raise ValueError("can't parse '%s'" % text)
+    return values
+
+
+class StringTable(object):
+    def __init__(self):
+        self.data = bytearray()
+        self.offsets = {}
+
+    def add(self, text):
+        raw = text.encode('utf-8')
+        if raw not in self.offsets:
+            self.offsets[raw] = len(self.data)
+            self.data += raw
+        return self.offsets[raw], len(raw)
+
+
+def convert(plist):
+    frames_dict = plist['frames']
+    metadata = plist.get('metadata', {})
+    fmt = metadata.get('format', 0)
+    if fmt < 0 or fmt > 3:
+        raise ValueError('format %d is not supported' % fmt)
+
+    strings = StringTable()
+    frames = []
+    aliases = []
+
+    # keep the order stable so converted files are reproducible
+    for name in sorted(frames_dict.keys()):
+        info = frames_dict[name]
+        rotated = False
+        if fmt == 0:
+            rect = [info['x'], info['y'], info['width'], info['height']]
+            offset = [info['offsetX'], info['offsetY']]
+            size = [abs(info['originalWidth']), abs(info['originalHeight'])]
+        elif fmt == 1 or fmt == 2:
+            rect = parse_floats(info['frame'], 4)
+            if fmt == 2:
+                rotated = info.get('rotated', False)
+            offset = parse_floats(info['offset'], 2)
+            size = parse_floats(info['sourceSize'], 2)
+        else:
+            sprite_size = parse_floats(info['spriteSize'], 2)
+            texture_rect = parse_floats(info['textureRect'], 4)
+            rect = [texture_rect[0], texture_rect[1], sprite_size[0], sprite_size[1]]
+            rotated = info.get('textureRotated', False)
+            offset = parse_floats(info['spriteOffset'], 2)
+            size = parse_floats(info['spriteSourceSize'], 2)
+            for alias in info.get('aliases', []):
+                aliases.append((alias, len(frames)))
+
+        frames.append((strings.add(name), rect, offset, size, rotated))
+
+    texture_offset, texture_length = NO_TEXTURE, 0
+    texture_name = metadata.get('textureFileName', '')
+    if texture_name:
+        texture_offset, texture_length = strings.add(texture_name)
+
+    out = bytearray()
+    out += struct.pack('<4sHHIIIII', SIGNATURE, VERSION, 0, len(frames), len(aliases),
+                       texture_offset, texture_length, 0)
+    for (name_offset, name_length), rect, offset, size, rotated in frames:
+        out += struct.pack('<II4f2f2fI', name_offset, name_length,
+                           rect[0], rect[1], rect[2], rect[3],
+                           offset[0], offset[1], size[0], size[1], 1 if rotated else 0)
+    for alias, index in aliases:
+        alias_offset, alias_length = strings.add(alias)
+        out += struct.pack('<III', alias_offset, alias_length, index)
+
+    # string table size is only known now
+    struct.pack_into('<I', out, 24, len(strings.data))
+    out += strings.data
+    return bytes(out)
+
+
+def main():
+    if len(sys.argv) < 2:
+        print('usage: %s input.plist [output.sfb]' % os.path.basename(sys.argv[0]))
+        return 1
+
+    src = sys.argv[1]
+    dst = sys.argv[2] if len(sys.argv) > 2 else os.path.splitext(src)[0] + '.sfb'
+
+    data = convert(read_plist(src))
+    f = open(dst, 'wb')
+    f.write(data)
+    f.close()
+    print('%s -> %s (%d bytes)' % (src, dst, len(data)))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())